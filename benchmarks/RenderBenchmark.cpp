@@ -0,0 +1,321 @@
+/**
+ * @file RenderBenchmark.cpp
+ * @brief Frame time benchmark of the map viewport backends
+ *
+ * Draws a synthetic grid network through NetworkLayerItem
+ * and times scripted pans and zooms, first on the raster
+ * viewport (the tiled path) and then on the OpenGL
+ * viewport (the instanced batches). Each frame is a forced
+ * synchronous repaint; on OpenGL the GPU is drained with
+ * glFinish so the time covers the whole draw.
+ *
+ * Usage:
+ *   CargoNetSimRenderBenchmark [segments] [frames]
+ *
+ * segments defaults to 1000000 and frames to 120 per
+ * scenario. To reproduce the numbers without a display,
+ * run under a virtual X server with Mesa:
+ *   xvfb-run -s "-screen 0 1920x1080x24" \
+ *       ./CargoNetSimRenderBenchmark
+ * QT_QPA_PLATFORM=offscreen also works for the raster
+ * rows; the OpenGL rows are skipped when no 3.3 context
+ * can be created.
+ *
+ * @author Ahmed Aredah
+ * @date 2026-10-18
+ */
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "GUI/Items/NetworkLayerItem.h"
+#include "GUI/Widgets/GraphicsScene.h"
+#include "GUI/Widgets/GraphicsView.h"
+
+#ifdef CARGONET_HAS_OPENGL
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLWidget>
+#endif
+
+using CargoNetSim::GUI::GraphicsScene;
+using CargoNetSim::GUI::GraphicsView;
+using CargoNetSim::GUI::NetworkLayerItem;
+
+namespace
+{
+
+constexpr qreal NODE_SPACING = 10.0;
+constexpr int   WARMUP_FRAMES = 5;
+
+struct FrameStats
+{
+    double mean = 0.0;
+    double p50  = 0.0;
+    double p95  = 0.0;
+    double max  = 0.0;
+};
+
+/**
+ * @brief Builds a square grid with at least the given
+ * number of links
+ *
+ * A side of n nodes has 2 * n * (n - 1) links, so the
+ * side is the smallest n that reaches the requested
+ * count.
+ */
+NetworkLayerItem *buildGrid(int segments)
+{
+    int side = 2;
+    while (2LL * side * (side - 1) < segments)
+    {
+        ++side;
+    }
+
+    auto *layer = new NetworkLayerItem(
+        QStringLiteral("Benchmark"),
+        QStringLiteral("Default Region"));
+    layer->reserve(side * side, 2 * side * (side - 1));
+
+    for (int row = 0; row < side; ++row)
+    {
+        for (int col = 0; col < side; ++col)
+        {
+            const QString id =
+                QString::number(row * side + col);
+            layer->addNode(id, id,
+                           QPointF(col * NODE_SPACING,
+                                   row * NODE_SPACING));
+        }
+    }
+
+    int linkId = 0;
+    for (int row = 0; row < side; ++row)
+    {
+        for (int col = 0; col < side; ++col)
+        {
+            const int node = row * side + col;
+            if (col + 1 < side)
+            {
+                const QString id = QString::number(linkId++);
+                layer->addLink(id, id, node, node + 1);
+            }
+            if (row + 1 < side)
+            {
+                const QString id = QString::number(linkId++);
+                layer->addLink(id, id, node, node + side);
+            }
+        }
+    }
+
+    layer->finalize();
+    return layer;
+}
+
+/**
+ * @brief Repaints the viewport and waits for the frame to
+ * finish, returning the elapsed milliseconds
+ */
+double timeFrame(GraphicsView &view)
+{
+    QElapsedTimer timer;
+    timer.start();
+    view.viewport()->repaint();
+
+#ifdef CARGONET_HAS_OPENGL
+    if (auto *gl =
+            qobject_cast<QOpenGLWidget *>(view.viewport()))
+    {
+        gl->makeCurrent();
+        QOpenGLContext::currentContext()
+            ->functions()
+            ->glFinish();
+        gl->doneCurrent();
+    }
+#endif
+
+    return timer.nsecsElapsed() / 1.0e6;
+}
+
+FrameStats summarize(QVector<double> samples)
+{
+    FrameStats stats;
+    if (samples.isEmpty())
+    {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&samples](double quantile) {
+        const int index = qBound(
+            0,
+            static_cast<int>(
+                std::ceil(quantile * samples.size()))
+                - 1,
+            static_cast<int>(samples.size()) - 1);
+        return samples[index];
+    };
+
+    stats.mean =
+        std::accumulate(samples.begin(), samples.end(), 0.0)
+        / samples.size();
+    stats.p50 = at(0.50);
+    stats.p95 = at(0.95);
+    stats.max = samples.last();
+    return stats;
+}
+
+/**
+ * @brief Pans across the whole network at a zoom where
+ * every link is a few pixels long
+ */
+QVector<double> runPan(GraphicsView     &view,
+                       const QRectF     &bounds,
+                       int               frames)
+{
+    view.resetTransform();
+    view.scale(0.5, 0.5);
+
+    QVector<double> samples;
+    samples.reserve(frames);
+    for (int i = -WARMUP_FRAMES; i < frames; ++i)
+    {
+        const qreal t =
+            qMax(0, i) / qMax<qreal>(1.0, frames - 1);
+        view.centerOn(
+            bounds.left() + t * bounds.width(),
+            bounds.top() + t * bounds.height());
+        const double ms = timeFrame(view);
+        if (i >= 0)
+        {
+            samples.append(ms);
+        }
+    }
+    return samples;
+}
+
+/**
+ * @brief Zooms from the whole network down to single
+ * links and back around the network centre
+ */
+QVector<double> runZoom(GraphicsView     &view,
+                        const QRectF     &bounds,
+                        int               frames)
+{
+    view.fitInView(bounds, Qt::KeepAspectRatio);
+    view.centerOn(bounds.center());
+
+    // Half the frames zoom in, the other half zoom out;
+    // zooming in ends at 64 pixels per scene unit
+    const int   half = qMax(1, frames / 2);
+    const qreal step = std::pow(
+        64.0 * bounds.width() / view.width(), 1.0 / half);
+
+    QVector<double> samples;
+    samples.reserve(frames);
+    for (int i = -WARMUP_FRAMES; i < frames; ++i)
+    {
+        if (i >= 0)
+        {
+            const qreal factor =
+                i < half ? 1.0 / step : step;
+            view.scale(1.0 / factor, 1.0 / factor);
+        }
+        const double ms = timeFrame(view);
+        if (i >= 0)
+        {
+            samples.append(ms);
+        }
+    }
+    return samples;
+}
+
+void report(QTextStream &out, const QString &backend,
+            const QString        &scenario,
+            const QVector<double> &samples)
+{
+    const FrameStats stats = summarize(samples);
+    out << QStringLiteral("%1 %2 %3 %4 %5 %6")
+               .arg(backend, -8)
+               .arg(scenario, -6)
+               .arg(stats.mean, 9, 'f', 2)
+               .arg(stats.p50, 9, 'f', 2)
+               .arg(stats.p95, 9, 'f', 2)
+               .arg(stats.max, 9, 'f', 2)
+        << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QTextStream  out(stdout);
+
+    const QStringList args   = app.arguments();
+    const int segments =
+        args.size() > 1 ? args.at(1).toInt() : 1000000;
+    const int frames =
+        args.size() > 2 ? args.at(2).toInt() : 120;
+    if (segments <= 0 || frames <= 0)
+    {
+        out << "usage: " << args.first()
+            << " [segments] [frames]" << Qt::endl;
+        return 1;
+    }
+
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+    GraphicsScene     scene;
+    NetworkLayerItem *layer = buildGrid(segments);
+    scene.addItemWithId(layer, QStringLiteral("Benchmark"));
+    const QRectF bounds = layer->boundingRect();
+
+    out << "segments: " << layer->linkCount()
+        << ", nodes: " << layer->nodeCount()
+        << ", build: " << buildTimer.elapsed() << " ms"
+        << Qt::endl;
+
+    GraphicsView view(&scene);
+    view.resize(1280, 800);
+    view.show();
+    app.processEvents();
+
+    out << QStringLiteral("%1 %2 %3 %4 %5 %6")
+               .arg(QStringLiteral("backend"), -8)
+               .arg(QStringLiteral("run"), -6)
+               .arg(QStringLiteral("mean ms"), 9)
+               .arg(QStringLiteral("p50 ms"), 9)
+               .arg(QStringLiteral("p95 ms"), 9)
+               .arg(QStringLiteral("max ms"), 9)
+        << Qt::endl;
+
+    report(out, QStringLiteral("raster"),
+           QStringLiteral("pan"),
+           runPan(view, bounds, frames));
+    report(out, QStringLiteral("raster"),
+           QStringLiteral("zoom"),
+           runZoom(view, bounds, frames));
+
+    if (!view.setOpenGLEnabled(true))
+    {
+        out << "opengl: skipped, no OpenGL 3.3 context"
+            << Qt::endl;
+        return 0;
+    }
+    app.processEvents();
+
+    report(out, QStringLiteral("opengl"),
+           QStringLiteral("pan"),
+           runPan(view, bounds, frames));
+    report(out, QStringLiteral("opengl"),
+           QStringLiteral("zoom"),
+           runZoom(view, bounds, frames));
+
+    return 0;
+}
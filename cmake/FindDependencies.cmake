@@ -7,6 +7,16 @@ else()
     find_package(Qt6 COMPONENTS Core Gui Widgets Network Xml REQUIRED)
 endif()
 
+# The OpenGL viewport is optional; without it maps always
+# render with the raster engine
+if(CARGONET_ENABLE_OPENGL)
+    find_package(Qt6 COMPONENTS OpenGL OpenGLWidgets QUIET)
+    if(NOT Qt6OpenGLWidgets_FOUND)
+        message(STATUS "Qt6 OpenGLWidgets not found, building without the OpenGL viewport")
+        set(CARGONET_ENABLE_OPENGL OFF)
+    endif()
+endif()
+
 # Platform-specific paths
 if(WIN32)
     # Windows-specific paths
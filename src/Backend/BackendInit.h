@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Backend/Clients/BaseClient/ContainerManager.h"
 #include "Backend/Clients/BaseClient/RabbitMQHandler.h"
 #include "Backend/Clients/BaseClient/SimulationClientBase.h"
 #include <QtCore>
@@ -71,6 +72,10 @@ initializeBackend(const QString   &integrationExePath = "",
         "CargoNetSim::Backend::SimulationClientBase");
     qRegisterMetaType<SimulationClientBase *>(
         "CargoNetSim::Backend::SimulationClientBase*");
+    qRegisterMetaType<ContainerManager>(
+        "CargoNetSim::Backend::ContainerManager");
+    qRegisterMetaType<ContainerManager *>(
+        "CargoNetSim::Backend::ContainerManager*");
 
     // ShipClient classes
     qRegisterMetaType<ShipClient::ShipState>(
@@ -155,14 +160,6 @@ initializeBackend(const QString   &integrationExePath = "",
         CargoNetSim::Backend::TruckClient::AsyncTripManager
             *>("CargoNetSim::Backend::TruckClient::"
                "AsyncTripManager*");
-    qRegisterMetaType<CargoNetSim::Backend::TruckClient::
-                          ContainerManager>(
-        "CargoNetSim::Backend::TruckClient::"
-        "ContainerManager");
-    qRegisterMetaType<
-        CargoNetSim::Backend::TruckClient::ContainerManager
-            *>("CargoNetSim::Backend::TruckClient::"
-               "ContainerManager*");
     qRegisterMetaType<
         CargoNetSim::Backend::TruckClient::IntegrationNode>(
         "CargoNetSim::Backend::TruckClient::"
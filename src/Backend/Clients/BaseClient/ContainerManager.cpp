@@ -0,0 +1,496 @@
+/**
+ * @file ContainerManager.cpp
+ * @brief Implements container tracking across vehicles
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#include "ContainerManager.h"
+#include <QMetaMethod>
+#include <utility>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+ContainerManager::ContainerManager(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void ContainerManager::assignContainersToVehicle(
+    const QString                           &vehicleId,
+    const QList<ContainerCore::Container *> &containers)
+{
+    if (containers.isEmpty())
+    {
+        return;
+    }
+
+    // Create list to track assigned container IDs for
+    // signal
+    const bool  tracked = tracksAssigned();
+    QStringList containerIds;
+
+    for (auto *container : containers)
+    {
+        // Skip null containers
+        if (!container)
+        {
+            continue;
+        }
+
+        // Check if container is already assigned elsewhere
+        auto it = m_placements.constFind(container);
+        if (it != m_placements.constEnd())
+        {
+            // Skip if already assigned to this vehicle
+            if (it->vehicleId == vehicleId)
+            {
+                continue;
+            }
+
+            // Remove from previous vehicle
+            unplace(container, *it);
+        }
+
+        // Update container location
+        container->setContainerCurrentLocation(vehicleId);
+        place(container, vehicleId);
+
+        if (tracked)
+        {
+            containerIds.append(
+                container->getContainerID());
+        }
+    }
+
+    // Emit signal if any containers were assigned
+    if (!containerIds.isEmpty())
+    {
+        notifyAssigned(vehicleId, containerIds);
+    }
+}
+
+void ContainerManager::assignContainersToVehicles(
+    const QMap<QString, QList<ContainerCore::Container *>>
+        &assignments)
+{
+    beginBatch();
+    for (auto it = assignments.constBegin();
+         it != assignments.constEnd(); ++it)
+    {
+        assignContainersToVehicle(it.key(), it.value());
+    }
+    endBatch();
+}
+
+QList<ContainerCore::Container *>
+ContainerManager::removeContainersFromVehicle(
+    const QString                           &vehicleId,
+    const QList<ContainerCore::Container *> &containers)
+{
+    if (!m_containersByVehicle.contains(vehicleId)
+        || containers.isEmpty())
+    {
+        return QList<ContainerCore::Container *>();
+    }
+
+    const bool tracked = tracksRemoved();
+    QList<ContainerCore::Container *> removedContainers;
+    QStringList                       containerIds;
+
+    for (auto *container : containers)
+    {
+        // Skip null containers
+        if (!container)
+        {
+            continue;
+        }
+
+        // Check if container is assigned to this vehicle
+        auto it = m_placements.constFind(container);
+        if (it == m_placements.constEnd()
+            || it->vehicleId != vehicleId)
+        {
+            continue;
+        }
+
+        unplace(container, *it);
+
+        // Update container state
+        container->setContainerCurrentLocation(
+            "unassigned");
+
+        // Add to results
+        removedContainers.append(container);
+        if (tracked)
+        {
+            containerIds.append(
+                container->getContainerID());
+        }
+    }
+
+    // Emit signal if any containers were removed
+    if (!containerIds.isEmpty())
+    {
+        notifyRemoved(vehicleId, containerIds);
+    }
+
+    return removedContainers;
+}
+
+QList<ContainerCore::Container *>
+ContainerManager::removeContainersById(
+    const QStringList &containerIds)
+{
+    // Group the containers by their vehicle
+    QMap<QString, QList<ContainerCore::Container *>>
+        byVehicle;
+    for (const QString &containerId : containerIds)
+    {
+        ContainerCore::Container *container =
+            m_containersById.value(containerId, nullptr);
+        if (container)
+        {
+            byVehicle[m_placements.value(container)
+                          .vehicleId]
+                .append(container);
+        }
+    }
+
+    QList<ContainerCore::Container *> removed;
+    beginBatch();
+    for (auto it = byVehicle.constBegin();
+         it != byVehicle.constEnd(); ++it)
+    {
+        removed.append(
+            removeContainersFromVehicle(it.key(),
+                                        it.value()));
+    }
+    endBatch();
+    return removed;
+}
+
+QList<ContainerCore::Container *>
+ContainerManager::removeAllContainersFromVehicle(
+    const QString &vehicleId)
+{
+    auto vehicle = m_containersByVehicle.find(vehicleId);
+    if (vehicle == m_containersByVehicle.end())
+    {
+        return QList<ContainerCore::Container *>();
+    }
+
+    // Take all containers of the vehicle
+    const QVector<ContainerCore::Container *>
+        allContainers = std::move(vehicle.value());
+    m_containersByVehicle.erase(vehicle);
+
+    // Create container ID list for signal
+    const bool  tracked = tracksRemoved();
+    QStringList containerIds;
+    if (tracked)
+    {
+        containerIds.reserve(allContainers.size());
+    }
+
+    // Update mappings
+    for (auto *container : allContainers)
+    {
+        container->setContainerCurrentLocation(
+            "unassigned");
+        m_placements.remove(container);
+        unindex(container);
+        if (tracked)
+        {
+            containerIds.append(
+                container->getContainerID());
+        }
+    }
+
+    // Emit signal if any containers were removed
+    if (!containerIds.isEmpty())
+    {
+        notifyRemoved(vehicleId, containerIds);
+    }
+
+    return QList<ContainerCore::Container *>(
+        allContainers.begin(), allContainers.end());
+}
+
+void ContainerManager::clear()
+{
+    beginBatch();
+    const QStringList vehicleIds =
+        m_containersByVehicle.keys();
+    for (const QString &vehicleId : vehicleIds)
+    {
+        removeAllContainersFromVehicle(vehicleId);
+    }
+    endBatch();
+}
+
+bool ContainerManager::transferContainers(
+    const QString &sourceVehicleId,
+    const QString &destVehicleId,
+    const QList<ContainerCore::Container *> &containers)
+{
+    if (containers.isEmpty())
+    {
+        return false;
+    }
+
+    // Validate that containers are on source vehicle
+    for (const auto *container : containers)
+    {
+        if (!isContainerAssignedToVehicle(sourceVehicleId,
+                                          container))
+        {
+            return false;
+        }
+    }
+
+    if (sourceVehicleId == destVehicleId)
+    {
+        return true;
+    }
+
+    const bool  tracked = tracksTransferred();
+    QStringList containerIds;
+
+    for (auto *container : containers)
+    {
+        // A container listed twice has already moved
+        auto it = m_placements.constFind(container);
+        if (it->vehicleId != sourceVehicleId)
+        {
+            continue;
+        }
+
+        unplace(container, *it);
+        container->setContainerCurrentLocation(
+            destVehicleId);
+        place(container, destVehicleId);
+
+        if (tracked)
+        {
+            containerIds.append(
+                container->getContainerID());
+        }
+    }
+
+    // Emit transfer signal
+    if (tracked)
+    {
+        notifyTransferred(sourceVehicleId, destVehicleId,
+                          containerIds);
+    }
+
+    return true;
+}
+
+QList<ContainerCore::Container *>
+ContainerManager::getContainersForVehicle(
+    const QString &vehicleId) const
+{
+    auto vehicle =
+        m_containersByVehicle.constFind(vehicleId);
+    if (vehicle == m_containersByVehicle.constEnd())
+    {
+        return QList<ContainerCore::Container *>();
+    }
+    return *vehicle;
+}
+
+int ContainerManager::containerCount(
+    const QString &vehicleId) const
+{
+    auto vehicle =
+        m_containersByVehicle.constFind(vehicleId);
+    return vehicle == m_containersByVehicle.constEnd()
+               ? 0
+               : vehicle->size();
+}
+
+QString ContainerManager::getVehicleForContainer(
+    const ContainerCore::Container *container) const
+{
+    auto it = m_placements.constFind(container);
+    return it == m_placements.constEnd() ? QString()
+                                         : it->vehicleId;
+}
+
+bool ContainerManager::isContainerAssignedToVehicle(
+    const QString                  &vehicleId,
+    const ContainerCore::Container *container) const
+{
+    auto it = m_placements.constFind(container);
+    return it != m_placements.constEnd()
+           && it->vehicleId == vehicleId;
+}
+
+void ContainerManager::beginBatch()
+{
+    ++m_batchDepth;
+}
+
+void ContainerManager::endBatch()
+{
+    emitSignals(endBatchDeferred());
+}
+
+ContainerManager::PendingSignals
+ContainerManager::endBatchDeferred()
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0)
+    {
+        return PendingSignals();
+    }
+
+    // Take the pending changes; slots may start a new
+    // batch
+    return std::exchange(m_pending, PendingSignals());
+}
+
+void ContainerManager::emitSignals(
+    const PendingSignals &pending)
+{
+    for (auto it = pending.assigned.constBegin();
+         it != pending.assigned.constEnd(); ++it)
+    {
+        emit containersAssigned(it.key(), it.value());
+    }
+    for (auto it = pending.removed.constBegin();
+         it != pending.removed.constEnd(); ++it)
+    {
+        emit containersRemoved(it.key(), it.value());
+    }
+    for (auto it = pending.transferred.constBegin();
+         it != pending.transferred.constEnd(); ++it)
+    {
+        emit containersTransferred(
+            it.key().first, it.key().second, it.value());
+    }
+}
+
+void ContainerManager::place(
+    ContainerCore::Container *container,
+    const QString            &vehicleId)
+{
+    auto &vehicle = m_containersByVehicle[vehicleId];
+    m_placements.insert(
+        container,
+        Placement{vehicleId,
+                  static_cast<int>(vehicle.size())});
+    m_containersById.insert(container->getContainerID(),
+                            container);
+    vehicle.append(container);
+}
+
+void ContainerManager::unplace(
+    const ContainerCore::Container *container,
+    const Placement                &placement)
+{
+    // Copy first; the placement belongs to the index
+    const QString vehicleId = placement.vehicleId;
+    const int     slot      = placement.slot;
+
+    auto vehicle = m_containersByVehicle.find(vehicleId);
+    auto &list   = vehicle.value();
+
+    // Move the last container into the freed slot
+    ContainerCore::Container *last = list.last();
+    list[slot]                     = last;
+    list.removeLast();
+    if (last != container)
+    {
+        m_placements[last].slot = slot;
+    }
+    m_placements.remove(container);
+    unindex(container);
+
+    if (list.isEmpty())
+    {
+        m_containersByVehicle.erase(vehicle);
+    }
+}
+
+void ContainerManager::unindex(
+    const ContainerCore::Container *container)
+{
+    // Another container may have taken the identifier
+    auto it =
+        m_containersById.find(container->getContainerID());
+    if (it != m_containersById.end()
+        && it.value() == container)
+    {
+        m_containersById.erase(it);
+    }
+}
+
+bool ContainerManager::tracksAssigned() const
+{
+    static const QMetaMethod signal =
+        QMetaMethod::fromSignal(
+            &ContainerManager::containersAssigned);
+    return isSignalConnected(signal);
+}
+
+bool ContainerManager::tracksRemoved() const
+{
+    static const QMetaMethod signal =
+        QMetaMethod::fromSignal(
+            &ContainerManager::containersRemoved);
+    return isSignalConnected(signal);
+}
+
+bool ContainerManager::tracksTransferred() const
+{
+    static const QMetaMethod signal =
+        QMetaMethod::fromSignal(
+            &ContainerManager::containersTransferred);
+    return isSignalConnected(signal);
+}
+
+void ContainerManager::notifyAssigned(
+    const QString     &vehicleId,
+    const QStringList &containerIds)
+{
+    if (m_batchDepth > 0)
+    {
+        m_pending.assigned[vehicleId].append(containerIds);
+        return;
+    }
+    emit containersAssigned(vehicleId, containerIds);
+}
+
+void ContainerManager::notifyRemoved(
+    const QString     &vehicleId,
+    const QStringList &containerIds)
+{
+    if (m_batchDepth > 0)
+    {
+        m_pending.removed[vehicleId].append(containerIds);
+        return;
+    }
+    emit containersRemoved(vehicleId, containerIds);
+}
+
+void ContainerManager::notifyTransferred(
+    const QString &sourceId, const QString &destId,
+    const QStringList &containerIds)
+{
+    if (m_batchDepth > 0)
+    {
+        m_pending.transferred[qMakePair(sourceId, destId)]
+            .append(containerIds);
+        return;
+    }
+    emit containersTransferred(sourceId, destId,
+                               containerIds);
+}
+
+} // namespace Backend
+} // namespace CargoNetSim
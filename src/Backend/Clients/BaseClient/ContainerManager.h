@@ -0,0 +1,292 @@
+/**
+ * @file ContainerManager.h
+ * @brief Manages container tracking across vehicles
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <containerLib/container.h>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+/**
+ * @class ContainerManager
+ * @brief Tracks containers across transportation vehicles
+ *
+ * Provides a central registry for container location
+ * tracking and facilitates container transfers between
+ * vehicles. Used by the truck, ship and train clients.
+ *
+ * Each vehicle keeps its containers in a vector, and each
+ * container's entry in the reverse index stores its vehicle
+ * and its slot in that vector. Removing a container moves
+ * the vehicle's last container into the freed slot, so
+ * assignments, removals and transfers cost O(1) per
+ * container. The order of a vehicle's containers is
+ * therefore not preserved.
+ *
+ * Between beginBatch() and endBatch() signals are held
+ * back and merged, so that a batch emits at most one signal
+ * per vehicle (or per vehicle pair for transfers). Signal
+ * payloads are only built when a slot is connected.
+ *
+ * The class is not thread-safe; the owning client
+ * serializes access. A client that changes containers
+ * under its lock closes the batch there with
+ * endBatchDeferred() and emits the result with
+ * emitSignals() once the lock is released.
+ */
+class ContainerManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Signals held back by a batch, merged per
+     * vehicle (or per vehicle pair for transfers)
+     */
+    struct PendingSignals
+    {
+        QMap<QString, QStringList> assigned;
+        QMap<QString, QStringList> removed;
+        QMap<QPair<QString, QString>, QStringList>
+            transferred;
+    };
+
+    /**
+     * @brief Constructor
+     * @param parent The parent QObject
+     */
+    explicit ContainerManager(QObject *parent = nullptr);
+
+    /**
+     * @brief Assigns containers to a vehicle
+     * @param vehicleId The vehicle identifier
+     * @param containers List of containers to assign
+     */
+    void assignContainersToVehicle(
+        const QString &vehicleId,
+        const QList<ContainerCore::Container *>
+            &containers);
+
+    /**
+     * @brief Assigns containers to many vehicles at once
+     *
+     * Emits one signal per vehicle.
+     *
+     * @param assignments Containers by vehicle identifier
+     */
+    void assignContainersToVehicles(
+        const QMap<QString,
+                   QList<ContainerCore::Container *>>
+            &assignments);
+
+    /**
+     * @brief Removes containers from a vehicle
+     * @param vehicleId The vehicle identifier
+     * @param containers List of containers to remove
+     * @return List of removed containers
+     */
+    QList<ContainerCore::Container *>
+    removeContainersFromVehicle(
+        const QString &vehicleId,
+        const QList<ContainerCore::Container *>
+            &containers);
+
+    /**
+     * @brief Removes containers by identifier from
+     * whichever vehicles carry them
+     *
+     * Unknown identifiers are skipped. Emits one signal
+     * per vehicle.
+     *
+     * @param containerIds Container identifiers
+     * @return List of removed containers
+     */
+    QList<ContainerCore::Container *>
+    removeContainersById(const QStringList &containerIds);
+
+    /**
+     * @brief Removes all containers from a vehicle
+     * @param vehicleId The vehicle identifier
+     * @return List of all removed containers
+     */
+    QList<ContainerCore::Container *>
+    removeAllContainersFromVehicle(
+        const QString &vehicleId);
+
+    /**
+     * @brief Removes all containers from all vehicles
+     *
+     * Emits one signal per vehicle.
+     */
+    void clear();
+
+    /**
+     * @brief Transfers containers between vehicles
+     * @param sourceVehicleId Source vehicle identifier
+     * @param destVehicleId Destination vehicle identifier
+     * @param containers List of containers to transfer
+     * @return True if transfer was successful
+     */
+    bool transferContainers(
+        const QString &sourceVehicleId,
+        const QString &destVehicleId,
+        const QList<ContainerCore::Container *>
+            &containers);
+
+    /**
+     * @brief Gets containers assigned to a vehicle
+     * @param vehicleId The vehicle identifier
+     * @return List of assigned containers
+     */
+    QList<ContainerCore::Container *>
+    getContainersForVehicle(const QString &vehicleId) const;
+
+    /**
+     * @brief Gets the number of containers on a vehicle
+     * @param vehicleId The vehicle identifier
+     * @return Container count, 0 for unknown vehicles
+     */
+    int containerCount(const QString &vehicleId) const;
+
+    /**
+     * @brief Gets the vehicle ID for a container
+     * @param container The container to locate
+     * @return Vehicle ID or empty string if not found
+     */
+    QString getVehicleForContainer(
+        const ContainerCore::Container *container) const;
+
+    /**
+     * @brief Checks if a container is assigned to a vehicle
+     * @param vehicleId The vehicle identifier
+     * @param container The container to check
+     * @return True if the container is assigned to the
+     * vehicle
+     */
+    bool isContainerAssignedToVehicle(
+        const QString                  &vehicleId,
+        const ContainerCore::Container *container) const;
+
+    /**
+     * @brief Holds signals back until the matching
+     * endBatch(); batches may be nested
+     */
+    void beginBatch();
+
+    /**
+     * @brief Emits the merged signals of the outermost
+     * batch
+     */
+    void endBatch();
+
+    /**
+     * @brief Closes a batch without emitting its signals
+     * @return Signals of the outermost batch, empty for a
+     * nested one
+     */
+    PendingSignals endBatchDeferred();
+
+    /**
+     * @brief Emits signals returned by endBatchDeferred()
+     * @param pending The held-back signals
+     */
+    void emitSignals(const PendingSignals &pending);
+
+signals:
+    /**
+     * @brief Signal emitted when containers are assigned
+     * @param vehicleId The vehicle identifier
+     * @param containerIds List of container identifiers
+     */
+    void
+    containersAssigned(const QString     &vehicleId,
+                       const QStringList &containerIds);
+
+    /**
+     * @brief Signal emitted when containers are removed
+     * @param vehicleId The vehicle identifier
+     * @param containerIds List of container identifiers
+     */
+    void containersRemoved(const QString     &vehicleId,
+                           const QStringList &containerIds);
+
+    /**
+     * @brief Signal emitted when containers are transferred
+     * @param sourceId Source vehicle identifier
+     * @param destId Destination vehicle identifier
+     * @param containerIds List of container identifiers
+     */
+    void
+    containersTransferred(const QString     &sourceId,
+                          const QString     &destId,
+                          const QStringList &containerIds);
+
+private:
+    /**
+     * @brief Location of a container: its vehicle and its
+     * slot in that vehicle's vector
+     */
+    struct Placement
+    {
+        QString vehicleId;
+        int     slot = -1;
+    };
+
+    /** Appends a container to a vehicle */
+    void place(ContainerCore::Container *container,
+               const QString            &vehicleId);
+
+    /** Frees a container's slot; it must be placed */
+    void unplace(const ContainerCore::Container *container,
+                 const Placement                &placement);
+
+    /** Drops a container from the identifier index */
+    void unindex(const ContainerCore::Container *container);
+
+    /** Signal payloads are only built when connected */
+    bool tracksAssigned() const;
+    bool tracksRemoved() const;
+    bool tracksTransferred() const;
+
+    /** Emits or, inside a batch, merges a change */
+    void notifyAssigned(const QString     &vehicleId,
+                        const QStringList &containerIds);
+    void notifyRemoved(const QString     &vehicleId,
+                       const QStringList &containerIds);
+    void notifyTransferred(const QString     &sourceId,
+                           const QString     &destId,
+                           const QStringList &containerIds);
+
+    // Containers of each vehicle, in slot order
+    QHash<QString, QVector<ContainerCore::Container *>>
+        m_containersByVehicle;
+
+    // Vehicle and slot of each assigned container
+    QHash<const ContainerCore::Container *, Placement>
+        m_placements;
+
+    // Assigned containers by identifier
+    QHash<QString, ContainerCore::Container *>
+        m_containersById;
+
+    // Open batch depth and the changes held back
+    int            m_batchDepth = 0;
+    PendingSignals m_pending;
+};
+
+} // namespace Backend
+} // namespace CargoNetSim
@@ -2,6 +2,7 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QEventLoop>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QThread>
 #include <QTimer>
@@ -241,6 +242,78 @@ QString SimulationClientBase::getClientTypeString() const
     }
 }
 
+/**
+ * Select the columnar container payload format
+ */
+void SimulationClientBase::setColumnarContainerPayloads(
+    bool enabled)
+{
+    m_columnarContainers = enabled;
+}
+
+/**
+ * Check the container payload format
+ */
+bool SimulationClientBase::columnarContainerPayloads() const
+{
+    return m_columnarContainers;
+}
+
+/**
+ * Set the vehicle state recorder
+ */
+void SimulationClientBase::setStateRecorder(
+    std::shared_ptr<VehicleStateRecorder> recorder)
+{
+    std::atomic_store(&m_stateRecorder,
+                      std::move(recorder));
+}
+
+/**
+ * Get the vehicle state recorder
+ */
+std::shared_ptr<VehicleStateRecorder>
+SimulationClientBase::stateRecorder() const
+{
+    return std::atomic_load(&m_stateRecorder);
+}
+
+/**
+ * Record a vehicle state if recording is on
+ */
+void SimulationClientBase::recordVehicleState(
+    const QString &networkName, const QString &vehicleId,
+    const VehicleStateRecorder::Sample &sample) const
+{
+    if (auto recorder = stateRecorder())
+    {
+        recorder->record(networkName, vehicleId, sample);
+    }
+}
+
+/**
+ * Build the payload of a container list
+ */
+QJsonValue SimulationClientBase::containersPayload(
+    const QList<ContainerCore::Container *> &containers)
+    const
+{
+    if (m_columnarContainers)
+    {
+        return ContainerBatchCodec::encode(containers);
+    }
+
+    QJsonArray containersArray;
+    for (const auto *container : containers)
+    {
+        if (container)
+        {
+            containersArray.append(container->toJson());
+        }
+    }
+    return containersArray;
+}
+
 /**
  * Sends a command and waits for specific response events
  */
@@ -2,8 +2,10 @@
 
 #include "Backend/Clients/BaseClient/RabbitMQHandler.h"
 #include "Backend/Commons/ClientType.h"
+#include "Backend/Commons/ContainerBatchCodec.h"
 #include "Backend/Commons/LoggerInterface.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
+#include "Backend/Commons/VehicleStateRecorder.h"
 #include <QEventLoop>
 #include <QFuture>
 #include <QJsonObject>
@@ -17,6 +19,7 @@
 #include <QTimer>
 #include <QWaitCondition>
 #include <atomic>
+#include <memory>
 
 // Forward declaration
 namespace CargoNetSim
@@ -176,6 +179,40 @@ public:
         return m_rabbitMQHandler;
     }
 
+    /**
+     * @brief Selects the columnar container payload format
+     * @param enabled True to send containers as columnar
+     * batches, false for plain JSON arrays
+     *
+     * Received container lists are decoded in either
+     * format.
+     */
+    void setColumnarContainerPayloads(bool enabled);
+
+    /**
+     * @brief Checks the container payload format
+     * @return True if containers are sent as batches
+     */
+    bool columnarContainerPayloads() const;
+
+    /**
+     * @brief Records the vehicle states reported by the
+     * simulator
+     * @param recorder Recorder receiving one sample per
+     * reported state, nullptr to stop recording; shared so
+     * that a replaced recorder lives until its last client
+     * lets go of it
+     */
+    void setStateRecorder(
+        std::shared_ptr<VehicleStateRecorder> recorder);
+
+    /**
+     * @brief Gets the state recorder
+     * @return The recorder, nullptr if recording is off
+     */
+    std::shared_ptr<VehicleStateRecorder>
+    stateRecorder() const;
+
 signals:
     /**
      * @brief Emitted when an event is received
@@ -372,6 +409,8 @@ protected:
     // Event registry for synchronization
     QMap<QString, QJsonObject> m_receivedEvents;
     mutable QReadWriteLock     m_eventMutex;
+    Commons::LockName          m_eventMutexName{
+        &m_eventMutex, getClientTypeString() + ".events"};
     QWaitCondition             m_eventCondition;
 
     // Connection parameters
@@ -392,9 +431,36 @@ protected:
     // Terminal client reference
     TerminalSimulationClient *m_terminalClient;
 
+    /**
+     * @brief Builds the payload of a container list
+     * @param containers Containers to send
+     * @return Columnar batch or plain JSON array
+     */
+    QJsonValue containersPayload(
+        const QList<ContainerCore::Container *> &containers)
+        const;
+
     // Controller
     CargoNetSimController *m_controller = nullptr;
 
+    // Send containers as columnar batches
+    std::atomic<bool> m_columnarContainers{false};
+
+    // Receives vehicle states when recording is on; only
+    // accessed through std::atomic_load/atomic_store
+    std::shared_ptr<VehicleStateRecorder> m_stateRecorder;
+
+    /**
+     * @brief Records a vehicle state if recording is on
+     * @param networkName Network of the vehicle
+     * @param vehicleId Vehicle or trip identifier
+     * @param sample State to record
+     */
+    void recordVehicleState(
+        const QString                      &networkName,
+        const QString                      &vehicleId,
+        const VehicleStateRecorder::Sample &sample) const;
+
     // Command timeout constant
     static const int COMMAND_TIMEOUT_MS =
         1800000; // 30 minutes
@@ -408,7 +474,10 @@ private slots:
 
 private:
     // Command serialization
-    QReadWriteLock m_commandSerializationMutex;
+    QReadWriteLock    m_commandSerializationMutex;
+    Commons::LockName m_commandSerializationMutexName{
+        &m_commandSerializationMutex,
+        getClientTypeString() + ".commands"};
 
     // Currently processing flag for preventing concurrent
     // operations
@@ -76,7 +76,9 @@ ShipSimulationClient::ShipSimulationClient(
           "CargoNetSim.Command.ShipNetSim",
           QStringList{"CargoNetSim.Response.ShipNetSim"},
           ClientType::ShipClient)
+    , m_containerManager(new ContainerManager(this))
 {
+    m_requestClock.start();
     qDebug() << "ShipSimulatorClient initialized";
 }
 
@@ -445,20 +447,13 @@ bool ShipSimulationClient::addContainersToShip(
     const QString &networkName, const QString &shipId,
     const QList<ContainerCore::Container *> &containers)
 {
-    return executeSerializedCommand([&]() {
-        QJsonArray containersArray;
-        for (const auto *container : containers)
-        {
-            if (container)
-            {
-                containersArray.append(container->toJson());
-            }
-        }
+    bool added = executeSerializedCommand([&]() {
         QJsonObject params;
         params["networkName"] = networkName;
         params["shipID"]      = shipId;
-        params["containers"]  = containersArray;
-        bool success          = sendCommandAndWait(
+        params["containers"] =
+            containersPayload(containers);
+        bool success = sendCommandAndWait(
             "addContainersToShip", params,
             {"containersaddedtoship"});
         if (m_logger)
@@ -478,6 +473,23 @@ bool ShipSimulationClient::addContainersToShip(
         }
         return success;
     });
+
+    if (added)
+    {
+        // Signals are emitted after the lock is released
+        ContainerManager::PendingSignals pending;
+        {
+            Commons::ScopedWriteLock locker(
+                m_dataAccessMutex);
+            m_containerManager->beginBatch();
+            m_containerManager->assignContainersToVehicle(
+                QString("Ship_%1").arg(shipId), containers);
+            pending =
+                m_containerManager->endBatchDeferred();
+        }
+        m_containerManager->emitSignals(pending);
+    }
+    return added;
 }
 
 /**
@@ -567,6 +579,8 @@ bool ShipSimulationClient::
         const QString &networkName, const QString &shipId,
         const QStringList &terminalNames)
 {
+    // The containers leave the ship in
+    // onContainersUnloaded()
     return executeSerializedCommand([&]() {
         QJsonObject params;
         params["networkName"] = networkName;
@@ -663,13 +677,11 @@ const ShipState *ShipSimulationClient::getShipState(
         }
         return nullptr;
     }
-    const auto &states = m_shipState[networkName];
-    for (const auto *state : states)
+    const ShipState *state =
+        m_shipState[networkName].value(shipId, nullptr);
+    if (state)
     {
-        if (state && state->getShipId() == shipId)
-        {
-            return state;
-        }
+        return state;
     }
     if (m_logger)
     {
@@ -1152,6 +1164,7 @@ void ShipSimulationClient::onShipReachedDestination(
     QMap<QString, QStringList>
         unloadOperations; // Store operations to perform
                           // after releasing lock
+    QList<QPair<QString, ShipStatePointer>> received;
 
     // First critical section: Extract data and prepare
     // operations
@@ -1166,11 +1179,6 @@ void ShipSimulationClient::onShipReachedDestination(
              it != shipStatus.constEnd(); ++it)
         {
             QString networkName = it.key();
-            if (!m_shipState.contains(networkName))
-            {
-                m_shipState[networkName] =
-                    QList<ShipState *>();
-            }
 
             QJsonObject networkStatus =
                 it.value().toObject();
@@ -1188,10 +1196,12 @@ void ShipSimulationClient::onShipReachedDestination(
                     m_shipsDestinationTerminals.value(
                         shipId);
 
-                // Create and store ship state
-                ShipState *shipState =
-                    new ShipState(shipData);
-                m_shipState[networkName].append(shipState);
+                // Store ship state
+                ShipStatePointer state(
+                    new ShipState(shipData));
+                storeShipState(networkName, *state);
+                received.append(
+                    qMakePair(networkName, state));
                 shipIds.append(shipId);
 
                 // Store the unload operation for execution
@@ -1206,6 +1216,8 @@ void ShipSimulationClient::onShipReachedDestination(
         }
     }
 
+    publishShipStates(received);
+
     // Second section: Perform unload operations without
     // holding the lock
     for (auto it = unloadOperations.constBegin();
@@ -1269,23 +1281,37 @@ void ShipSimulationClient::onShipReachedSeaport(
 /**
  * @brief Handles containers unloaded event
  *
- * Logs when containers are unloaded from a ship.
+ * Removes the unloaded containers from their ships.
  *
  * @param message Event data
  */
 void ShipSimulationClient::onContainersUnloaded(
     const QJsonObject &message)
 {
-    // No shared state modification, no mutex needed
-    QJsonArray containers =
-        message.value("containers").toArray();
     QString portName = message.value("portName").toString();
-    QJsonObject containersObj;
-    containersObj["containers"] = containers;
-    QJsonDocument containersDoc(containersObj);
-    QString       containersJson =
-        containersDoc.toJson(QJsonDocument::Compact);
-    double currentTime = 0.0;
+
+    // Exactly the containers the server unloaded
+    QStringList containerIds;
+    const QList<ContainerCore::Container *> containers =
+        ContainerBatchCodec::decode(
+            message.value("containers"));
+    for (const auto *container : containers)
+    {
+        containerIds.append(container->getContainerID());
+    }
+    qDeleteAll(containers);
+
+    // Signals are emitted after the lock is released
+    ContainerManager::PendingSignals pending;
+    {
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        m_containerManager->beginBatch();
+        m_containerManager->removeContainersById(
+            containerIds);
+        pending = m_containerManager->endBatchDeferred();
+    }
+    m_containerManager->emitSignals(pending);
+
     if (m_logger)
     {
         m_logger->log("Containers unloaded at port: "
@@ -1333,57 +1359,78 @@ void ShipSimulationClient::onSimulationResultsAvailable(
 void ShipSimulationClient::onShipStateAvailable(
     const QJsonObject &message)
 {
-    // Mutex needed because we're modifying m_shipState
-    CargoNetSim::Backend::Commons::ScopedWriteLock locker(
-        m_dataAccessMutex);
     QJsonObject shipState =
         message.value("state").toObject();
 
-    // Implement state handling here
+    // Parse full reports before taking the lock; deltas
+    // are applied to the stored states under it
+    QList<QPair<QString, ShipStatePointer>> received;
+    QList<QPair<QString, QJsonObject>>      deltas;
     for (auto it = shipState.constBegin();
          it != shipState.constEnd(); ++it)
     {
-        QString networkName = it.key();
+        QJsonObject networkStatus = it.value().toObject();
+        if (networkStatus.contains("shipStates"))
+        {
+            received.append(qMakePair(
+                it.key(),
+                ShipStatePointer(
+                    new ShipState(
+                        networkStatus.value("shipStates")
+                            .toObject()))));
+        }
+        else if (networkStatus.contains("shipStateDelta"))
+        {
+            deltas.append(qMakePair(
+                it.key(),
+                networkStatus.value("shipStateDelta")
+                    .toObject()));
+        }
+    }
 
-        // Ensure the network exists in our map
-        if (!m_shipState.contains(networkName))
+    QMap<QString, QStringList> missingShips;
+    bool                       deltaApplied = false;
+    {
+        // Mutex needed because we're modifying m_shipState
+        CargoNetSim::Backend::Commons::ScopedWriteLock
+            locker(m_dataAccessMutex);
+        for (const auto &entry : received)
         {
-            m_shipState[networkName] = QList<ShipState *>();
+            storeShipState(entry.first, *entry.second);
         }
 
-        // Process ship states in this network
-        QJsonObject networkStatus = it.value().toObject();
-        if (networkStatus.contains("shipStates"))
+        for (const auto &entry : deltas)
         {
-            QJsonObject shipData =
-                networkStatus.value("shipStates")
-                    .toObject();
-            QString shipId =
-                shipData.value("shipID").toString();
-
-            // Check if we already have a state for this
-            // ship and remove it to avoid memory leaks
-            auto &shipStates = m_shipState[networkName];
-            for (int i = 0; i < shipStates.size(); ++i)
+            ShipState *state = applyShipStateDelta(
+                entry.first, entry.second);
+            if (!state)
             {
-                if (shipStates[i]->getShipId() == shipId)
-                {
-                    // Delete the old state and remove it
-                    // from the list
-                    delete shipStates[i];
-                    shipStates.removeAt(i);
-                    break;
-                }
+                missingShips[entry.first].append(
+                    entry.second.value("shipID")
+                        .toString());
+                continue;
             }
 
-            // Create new ship state from the received data
-            ShipState *shipState = new ShipState(shipData);
-
-            // Add to our state collection
-            shipStates.append(shipState);
+            // Copied for publication once per generation
+            m_deltaShips[entry.first].insert(
+                state->getShipId());
+            deltaApplied = true;
         }
     }
 
+    publishShipStates(received);
+    if (deltaApplied)
+    {
+        scheduleShipStatesFlush();
+    }
+
+    // Deltas need a base state; ask for full ones
+    for (auto it = missingShips.constBegin();
+         it != missingShips.constEnd(); ++it)
+    {
+        requestShipStates(it.key(), it.value());
+    }
+
     if (m_logger)
     {
         m_logger->log("Ship state available",
@@ -1395,6 +1442,278 @@ void ShipSimulationClient::onShipStateAvailable(
     }
 }
 
+/**
+ * @brief Stores the latest state of a ship
+ *
+ * Reuses the existing ShipState object of the ship so its
+ * address never changes between updates.
+ *
+ * @param networkName Network name
+ * @param state Parsed ship state
+ * @return The stored state
+ */
+ShipState *ShipSimulationClient::storeShipState(
+    const QString &networkName, const ShipState &state)
+{
+    ShipState *&stored =
+        m_shipState[networkName][state.getShipId()];
+    if (stored)
+    {
+        *stored = state;
+    }
+    else
+    {
+        stored = new ShipState(state);
+    }
+
+    // A requested full state has arrived
+    auto requested = m_requestedShips.find(networkName);
+    if (requested != m_requestedShips.end())
+    {
+        requested->remove(state.getShipId());
+    }
+
+    recordShipState(networkName, *stored);
+    return stored;
+}
+
+/**
+ * @brief Applies a state delta to a stored ship state
+ *
+ * Only the keys present in the delta are parsed.
+ *
+ * @param networkName Network name
+ * @param delta Partial state holding "shipID"
+ * @return The updated state, nullptr if none is stored
+ */
+ShipState *ShipSimulationClient::applyShipStateDelta(
+    const QString &networkName, const QJsonObject &delta)
+{
+    auto network = m_shipState.find(networkName);
+    if (network == m_shipState.end())
+    {
+        return nullptr;
+    }
+
+    auto it =
+        network->find(delta.value("shipID").toString());
+    if (it == network->end())
+    {
+        return nullptr;
+    }
+
+    ShipState *state = it.value();
+    const ShipState::Fields updated =
+        state->updateFromJson(delta);
+
+    // Environment-only deltas change no recorded column
+    if (updated
+        & (ShipState::Motion | ShipState::Status
+           | ShipState::Consumption | ShipState::Position))
+    {
+        recordShipState(networkName, *state);
+    }
+    return state;
+}
+
+/**
+ * @brief Records a ship's state if recording is on
+ *
+ * @param networkName Network name
+ * @param state Stored ship state
+ */
+void ShipSimulationClient::recordShipState(
+    const QString &networkName, const ShipState &state)
+{
+    if (!stateRecorder())
+    {
+        return;
+    }
+
+    VehicleStateRecorder::Sample sample;
+    sample.time = m_simulationTime
+                      ? m_simulationTime->getCurrentTime()
+                      : state.getTripTime();
+    sample.x          = state.getLongitude();
+    sample.y          = state.getLatitude();
+    sample.distance   = state.getTravelledDistance();
+    sample.speed      = state.getCurrentSpeed();
+    sample.energy     = state.getEnergyConsumption();
+    sample.emissions  = state.getCarbonEmissions();
+    sample.containers = state.getContainersCount();
+    recordVehicleState(networkName, state.getShipId(),
+                       sample);
+}
+
+/**
+ * @brief Requests full states of ships from the server
+ *
+ * @param networkName Network name
+ * @param shipIds Ships whose full states are needed
+ * @return True if the request was sent
+ */
+bool ShipSimulationClient::requestShipStates(
+    const QString &networkName, const QStringList &shipIds)
+{
+    // Skip ships already asked for recently
+    QStringList due;
+    {
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        const qint64 now = m_requestClock.elapsed();
+        QHash<QString, qint64> &requested =
+            m_requestedShips[networkName];
+        for (const QString &shipId : shipIds)
+        {
+            auto it = requested.constFind(shipId);
+            if (it != requested.constEnd()
+                && now - it.value()
+                       < STATE_REQUEST_RETRY_MS)
+            {
+                continue;
+            }
+            requested.insert(shipId, now);
+            due.append(shipId);
+        }
+    }
+
+    if (due.isEmpty())
+    {
+        return true;
+    }
+
+    QJsonObject params;
+    params["networkName"] = networkName;
+    params["shipIDs"]     = QJsonArray::fromStringList(due);
+
+    bool sent = sendCommand("getShipsState", params);
+    if (!sent)
+    {
+        qWarning() << "Failed to request full states of"
+                   << due.size() << "ships in"
+                   << networkName;
+
+        // Let the next delta retry at once
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        QHash<QString, qint64> &requested =
+            m_requestedShips[networkName];
+        for (const QString &shipId : due)
+        {
+            requested.remove(shipId);
+        }
+    }
+    return sent;
+}
+
+/**
+ * @brief Publishes a generation with updated ship states
+ *
+ * Only the ingesting thread changes the working
+ * generation; readers take the published copy without
+ * locking.
+ *
+ * @param states Updated states with their networks
+ */
+void ShipSimulationClient::publishShipStates(
+    const QList<QPair<QString, ShipStatePointer>> &states)
+{
+    if (states.isEmpty())
+    {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_publishMutex);
+        for (const auto &entry : states)
+        {
+            m_shipGeneration[entry.first].insert(
+                entry.second->getShipId(), entry.second);
+        }
+    }
+
+    scheduleShipStatesFlush();
+}
+
+/**
+ * @brief Queues a publication unless one is queued
+ */
+void ShipSimulationClient::scheduleShipStatesFlush()
+{
+    QMutexLocker locker(&m_publishMutex);
+    if (!m_flushScheduled)
+    {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(
+            this, &ShipSimulationClient::flushShipStates,
+            Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Publishes the staged states as one generation
+ */
+void ShipSimulationClient::flushShipStates()
+{
+    // Copy each ship changed by deltas once
+    QList<QPair<QString, ShipStatePointer>> changed;
+    {
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        for (auto it = m_deltaShips.constBegin();
+             it != m_deltaShips.constEnd(); ++it)
+        {
+            const auto network =
+                m_shipState.constFind(it.key());
+            if (network == m_shipState.constEnd())
+            {
+                continue;
+            }
+            for (const QString &shipId : it.value())
+            {
+                const ShipState *state =
+                    network->value(shipId, nullptr);
+                if (state)
+                {
+                    changed.append(qMakePair(
+                        it.key(),
+                        ShipStatePointer(
+                            new ShipState(*state))));
+                }
+            }
+        }
+        m_deltaShips.clear();
+    }
+
+    QMutexLocker locker(&m_publishMutex);
+    m_flushScheduled = false;
+    for (const auto &entry : changed)
+    {
+        m_shipGeneration[entry.first].insert(
+            entry.second->getShipId(), entry.second);
+    }
+    m_shipSnapshots.publish(m_shipGeneration);
+}
+
+/**
+ * @brief Gets the containers carried by each ship
+ *
+ * @return Container manager owned by the client
+ */
+ContainerManager *
+ShipSimulationClient::getContainerManager() const
+{
+    return m_containerManager;
+}
+
+/**
+ * @brief Gets the published generation of ship states
+ *
+ * @return Immutable snapshot of all networks
+ */
+ShipSimulationClient::ShipStatesSnapshot
+ShipSimulationClient::getShipStatesSnapshot() const
+{
+    return m_shipSnapshots.load();
+}
+
 /**
  * @brief Handles simulator state available event
  *
@@ -1447,11 +1766,23 @@ void ShipSimulationClient::onErrorOccurred(
 /**
  * @brief Handles server reset event
  *
- * Logs when the server is successfully reset.
+ * Drops pending state requests and the containers on
+ * board, and logs the reset.
  */
 void ShipSimulationClient::onServerReset()
 {
-    // No shared state modification, no mutex needed
+    // Requests sent before the reset are not answered,
+    // and the ships no longer exist
+    ContainerManager::PendingSignals pending;
+    {
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        m_requestedShips.clear();
+        m_containerManager->beginBatch();
+        m_containerManager->clear();
+        pending = m_containerManager->endBatchDeferred();
+    }
+    m_containerManager->emitSignals(pending);
+
     if (m_logger)
     {
         m_logger->log("Server reset successfully",
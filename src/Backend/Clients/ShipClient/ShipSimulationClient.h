@@ -21,20 +21,27 @@
 
 #include <QByteArray>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QPair>
 #include <QReadWriteLock>
+#include <QSet>
+#include <QSharedPointer>
 #include <QString>
 #include <containerLib/container.h>
 
+#include "Backend/Clients/BaseClient/ContainerManager.h"
 #include "Backend/Clients/BaseClient/SimulationClientBase.h"
 #include "Backend/Clients/ShipClient/ShipState.h"
 #include "Backend/Clients/ShipClient/SimulationResults.h"
 #include "Backend/Commons/ClientType.h"
+#include "Backend/Commons/SnapshotPublisher.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
 #include "Backend/Models/ShipSystem.h"
 
@@ -88,6 +95,24 @@ class ShipSimulationClient : public SimulationClientBase
     Q_OBJECT
 
 public:
+    /**
+     * @brief Shared, immutable state of one ship
+     */
+    using ShipStatePointer =
+        QSharedPointer<const ShipState>;
+
+    /**
+     * @brief Ship states by network name and ship ID
+     */
+    using ShipStates =
+        QMap<QString, QHash<QString, ShipStatePointer>>;
+
+    /**
+     * @brief Immutable, shared generation of ship states
+     */
+    using ShipStatesSnapshot =
+        Commons::SnapshotPublisher<ShipStates>::Snapshot;
+
     /**
      * @brief Constructs a ShipSimulationClient instance
      *
@@ -352,6 +377,53 @@ public:
     QMap<QString, QList<const ShipState *>>
     getAllShipsStates() const;
 
+    /**
+     * @brief Retrieves the latest published ship states
+     *
+     * States received during one pass of the client's
+     * event loop are published together once the pass
+     * ends. Does not take the data lock: the snapshot is
+     * immutable and stays valid for as long as it is held,
+     * regardless of later updates.
+     *
+     * Thread safety: Safe from any thread.
+     *
+     * @return Snapshot of all networks, never null
+     */
+    ShipStatesSnapshot getShipStatesSnapshot() const;
+
+    /**
+     * @brief Requests full states of ships from the server
+     *
+     * Used when a state delta arrives for a ship without a
+     * stored base state. The server answers with regular
+     * shipState events carrying full states.
+     *
+     * A ship stays pending until its full state arrives;
+     * while pending it is asked for again only after
+     * STATE_REQUEST_RETRY_MS, however many deltas arrive.
+     *
+     * @param networkName Network name
+     * @param shipIds Ships whose full states are needed
+     * @return True if the request was sent
+     */
+    bool requestShipStates(const QString     &networkName,
+                           const QStringList &shipIds);
+
+    /**
+     * @brief Gets the containers carried by each ship
+     *
+     * Ships are keyed "Ship_<shipId>". Containers are
+     * assigned when added to a ship and removed when
+     * unloaded at one of their next destinations.
+     *
+     * Thread safety: Not thread-safe; use from the
+     * client's thread.
+     *
+     * @return Container manager owned by the client
+     */
+    ContainerManager *getContainerManager() const;
+
 protected:
     /**
      * @brief Processes messages from the server
@@ -558,11 +630,11 @@ private:
      * @brief Handles containers unloaded event
      *
      * Processes the event when containers are unloaded from
-     * a ship. Only performs logging, no shared state is
-     * modified.
+     * a ship. The containers listed in the event are
+     * removed from the container manager.
      *
-     * Thread safety: No locks needed as this method only
-     * logs.
+     * Thread safety: Uses write lock; the manager's
+     * signals are emitted after it is released.
      *
      * @param message Event data in JSON format
      */
@@ -587,7 +659,11 @@ private:
      * @brief Handles ship state available event
      *
      * Processes the event when a ship's state is available.
-     * Updates the m_shipState data structure.
+     * Updates the m_shipState data structure. A network
+     * entry carries either a full state under "shipStates"
+     * or a partial one under "shipStateDelta"; deltas are
+     * applied in place and trigger requestShipStates() for
+     * ships without a stored state.
      *
      * Thread safety: Uses ScopedWriteLock to protect shared
      * state.
@@ -596,6 +672,77 @@ private:
      */
     void onShipStateAvailable(const QJsonObject &message);
 
+    /**
+     * @brief Stores the latest state of a ship
+     *
+     * Overwrites the existing state of the ship in place,
+     * so pointers handed out by getShipState() stay valid,
+     * or creates it on the first report.
+     *
+     * Thread safety: The caller holds the write lock.
+     *
+     * @param networkName Network name
+     * @param state Parsed ship state
+     * @return The stored state
+     */
+    ShipState *storeShipState(const QString   &networkName,
+                              const ShipState &state);
+
+    /**
+     * @brief Applies a state delta to a stored ship state
+     *
+     * Thread safety: The caller holds the write lock.
+     *
+     * @param networkName Network name
+     * @param delta Partial state holding "shipID"
+     * @return The updated state, nullptr if the ship has
+     * no stored state yet
+     */
+    ShipState *
+    applyShipStateDelta(const QString     &networkName,
+                        const QJsonObject &delta);
+
+    /**
+     * @brief Records a ship's state if recording is on;
+     * the caller holds the write lock
+     */
+    void recordShipState(const QString   &networkName,
+                         const ShipState &state);
+
+    /**
+     * @brief Stages updated states for the next generation
+     *
+     * The generation is published by flushShipStates(),
+     * queued once per event-loop pass, so a burst of
+     * messages costs one publication.
+     *
+     * Thread safety: Takes only m_publishMutex, which
+     * readers never touch.
+     *
+     * @param states Updated states with their networks
+     */
+    void publishShipStates(
+        const QList<QPair<QString, ShipStatePointer>>
+            &states);
+
+    /**
+     * @brief Queues flushShipStates() unless it is queued
+     */
+    void scheduleShipStatesFlush();
+
+    /**
+     * @brief Publishes the staged states as one generation
+     *
+     * Ships changed by deltas are copied here, once per
+     * generation however many deltas they received. The
+     * copy shares the state's containers with the stored
+     * state.
+     *
+     * Thread safety: Takes the write lock, then
+     * m_publishMutex.
+     */
+    void flushShipStates();
+
     /**
      * @brief Handles simulator state available event
      *
@@ -629,10 +776,11 @@ private:
      * @brief Handles server reset event
      *
      * Processes the event when the server is reset.
-     * Only performs logging, no shared state is modified.
+     * Clears the pending state requests and the containers
+     * on board.
      *
-     * Thread safety: No locks needed as this method only
-     * logs.
+     * Thread safety: Uses write lock; the manager's
+     * signals are emitted after it is released.
      */
     void onServerReset();
 
@@ -659,6 +807,8 @@ private:
      * and ScopedWriteLock for write operations.
      */
     mutable QReadWriteLock m_dataAccessMutex;
+    Commons::LockName      m_dataAccessMutexName{
+        &m_dataAccessMutex, "ShipClient.data"};
 
     /**
      * @var m_networkData
@@ -674,11 +824,41 @@ private:
      * @var m_shipState
      * @brief Stores ship states by network
      *
-     * Maps network names to lists of ShipState pointers.
-     * Access to this structure is protected by
+     * Maps network names to ShipState pointers keyed by
+     * ship ID. Access to this structure is protected by
      * m_dataAccessMutex.
      */
-    QMap<QString, QList<ShipState *>> m_shipState;
+    QMap<QString, QHash<QString, ShipState *>> m_shipState;
+
+    /**
+     * @var m_deltaShips
+     * @brief Ships changed by deltas since the last
+     * publication, by network
+     *
+     * Protected by m_dataAccessMutex.
+     */
+    QHash<QString, QSet<QString>> m_deltaShips;
+
+    /**
+     * @var m_requestedShips
+     * @brief Ships whose full state was requested and has
+     * not arrived, with the request time, by network
+     *
+     * Protected by m_dataAccessMutex.
+     */
+    QHash<QString, QHash<QString, qint64>> m_requestedShips;
+
+    /**
+     * @var m_requestClock
+     * @brief Monotonic clock of the full state requests
+     */
+    QElapsedTimer m_requestClock;
+
+    /**
+     * @brief Minimum time between two full state requests
+     * for the same ship
+     */
+    static constexpr qint64 STATE_REQUEST_RETRY_MS = 2000;
 
     /**
      * @var m_loadedShips
@@ -690,6 +870,42 @@ private:
      */
     QMap<QString, Backend::Ship *> m_loadedShips;
 
+    /**
+     * @var m_shipGeneration
+     * @brief Working copy of the next published generation
+     *
+     * Protected by m_publishMutex.
+     */
+    ShipStates m_shipGeneration;
+
+    /**
+     * @var m_shipSnapshots
+     * @brief Published generations of ship states
+     */
+    Commons::SnapshotPublisher<ShipStates> m_shipSnapshots;
+
+    /**
+     * @var m_publishMutex
+     * @brief Serializes publishers of m_shipSnapshots
+     */
+    QMutex m_publishMutex;
+
+    /**
+     * @var m_flushScheduled
+     * @brief Whether flushShipStates() is queued
+     *
+     * Protected by m_publishMutex.
+     */
+    bool m_flushScheduled = false;
+
+    /**
+     * @var m_containerManager
+     * @brief Containers on board of each ship
+     *
+     * Protected by m_dataAccessMutex.
+     */
+    ContainerManager *m_containerManager;
+
     /**
      * @var m_shipsDestinationTerminals
      * @brief Maps ship IDs to destination terminals
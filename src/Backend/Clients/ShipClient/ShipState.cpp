@@ -1,5 +1,6 @@
 #include "ShipState.h"
 #include <QDebug>
+#include <QHash>
 
 namespace CargoNetSim
 {
@@ -8,40 +9,88 @@ namespace Backend
 namespace ShipClient
 {
 
+namespace
+{
+
+/**
+ * @brief Top-level keys of a ship state payload
+ */
+enum class StateKey
+{
+    ShipId,
+    TravelledDistance,
+    CurrentAcceleration,
+    PreviousAcceleration,
+    CurrentSpeed,
+    PreviousSpeed,
+    TotalThrust,
+    TotalResistance,
+    VesselWeight,
+    CargoWeight,
+    IsOn,
+    OutOfEnergy,
+    Loaded,
+    ReachedDestination,
+    TripTime,
+    ContainersCount,
+    ClosestPort,
+    Consumption,
+    EnergySources,
+    Position,
+    Environment,
+    Unknown
+};
+
+StateKey stateKey(const QString &key)
+{
+    static const QHash<QString, StateKey> keys = {
+        {"shipID", StateKey::ShipId},
+        {"travelledDistance", StateKey::TravelledDistance},
+        {"currentAcceleration",
+         StateKey::CurrentAcceleration},
+        {"previousAcceleration",
+         StateKey::PreviousAcceleration},
+        {"currentSpeed", StateKey::CurrentSpeed},
+        {"previousSpeed", StateKey::PreviousSpeed},
+        {"totalThrust", StateKey::TotalThrust},
+        {"totalResistance", StateKey::TotalResistance},
+        {"vesselWeight", StateKey::VesselWeight},
+        {"cargoWeight", StateKey::CargoWeight},
+        {"isOn", StateKey::IsOn},
+        {"outOfEnergy", StateKey::OutOfEnergy},
+        {"loaded", StateKey::Loaded},
+        {"reachedDestination",
+         StateKey::ReachedDestination},
+        {"tripTime", StateKey::TripTime},
+        {"containersCount", StateKey::ContainersCount},
+        {"closestPort", StateKey::ClosestPort},
+        {"consumption", StateKey::Consumption},
+        {"energySources", StateKey::EnergySources},
+        {"position", StateKey::Position},
+        {"environment", StateKey::Environment}};
+    return keys.value(key, StateKey::Unknown);
+}
+
+} // namespace
+
 ShipState::ShipState(const QJsonObject &shipData)
-    : m_shipId(shipData.value("shipID").toString("Unknown"))
-    , m_travelledDistance(
-          shipData.value("travelledDistance").toDouble(0.0))
-    , m_currentAcceleration(
-          shipData.value("currentAcceleration")
-              .toDouble(0.0))
-    , m_previousAcceleration(
-          shipData.value("previousAcceleration")
-              .toDouble(0.0))
-    , m_currentSpeed(
-          shipData.value("currentSpeed").toDouble(0.0))
-    , m_previousSpeed(
-          shipData.value("previousSpeed").toDouble(0.0))
-    , m_totalThrust(
-          shipData.value("totalThrust").toDouble(0.0))
-    , m_totalResistance(
-          shipData.value("totalResistance").toDouble(0.0))
-    , m_vesselWeight(
-          shipData.value("vesselWeight").toDouble(0.0))
-    , m_cargoWeight(
-          shipData.value("cargoWeight").toDouble(0.0))
-    , m_isOn(shipData.value("isOn").toBool(false))
-    , m_outOfEnergy(
-          shipData.value("outOfEnergy").toBool(false))
-    , m_loaded(shipData.value("loaded").toBool(false))
-    , m_reachedDestination(
-          shipData.value("reachedDestination")
-              .toBool(false))
-    , m_tripTime(shipData.value("tripTime").toDouble(0.0))
-    , m_containersCount(
-          shipData.value("containersCount").toInt(0))
-    , m_closestPort(
-          shipData.value("closestPort").toString("Unknown"))
+    : m_shipId("Unknown")
+    , m_travelledDistance(0.0)
+    , m_currentAcceleration(0.0)
+    , m_previousAcceleration(0.0)
+    , m_currentSpeed(0.0)
+    , m_previousSpeed(0.0)
+    , m_totalThrust(0.0)
+    , m_totalResistance(0.0)
+    , m_vesselWeight(0.0)
+    , m_cargoWeight(0.0)
+    , m_isOn(false)
+    , m_outOfEnergy(false)
+    , m_loaded(false)
+    , m_reachedDestination(false)
+    , m_tripTime(0.0)
+    , m_containersCount(0)
+    , m_closestPort("Unknown")
     , m_energyConsumption(0.0)
     , m_carbonDioxideEmitted(0.0)
     , m_latitude(0.0)
@@ -53,36 +102,149 @@ ShipState::ShipState(const QJsonObject &shipData)
     , m_waveLength(0.0)
     , m_waveAngularFrequency(0.0)
 {
-    // Parse consumption data
-    QJsonObject consumption =
-        shipData.value("consumption").toObject();
-    if (!consumption.isEmpty())
-    {
-        m_energyConsumption =
-            consumption.value("energyConsumption")
-                .toDouble(0.0);
-        m_carbonDioxideEmitted =
-            consumption.value("carbonDioxideEmitted")
-                .toDouble(0.0);
+    updateFromJson(shipData);
+}
+
+ShipState::Fields
+ShipState::updateFromJson(const QJsonObject &shipData)
+{
+    Fields updated;
 
-        // Parse fuel consumption
-        QJsonArray fuelConsumption =
-            consumption.value("fuelConsumption").toArray();
-        for (const QJsonValue &fuelEntry : fuelConsumption)
+    // Visit only the keys present in the payload
+    for (auto it = shipData.constBegin();
+         it != shipData.constEnd(); ++it)
+    {
+        const QJsonValue value = it.value();
+        switch (stateKey(it.key()))
         {
-            QJsonObject fuelObj  = fuelEntry.toObject();
-            QString     fuelType = fuelObj.value("fuelType")
-                                   .toString("Unknown");
-            double consumedVolume =
-                fuelObj.value("consumedVolumeLiters")
-                    .toDouble(0.0);
-            m_fuelConsumption[fuelType] = consumedVolume;
+        case StateKey::ShipId:
+            m_shipId = value.toString("Unknown");
+            break;
+        case StateKey::TravelledDistance:
+            m_travelledDistance = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::CurrentAcceleration:
+            m_currentAcceleration = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::PreviousAcceleration:
+            m_previousAcceleration = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::CurrentSpeed:
+            m_currentSpeed = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::PreviousSpeed:
+            m_previousSpeed = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::TotalThrust:
+            m_totalThrust = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::TotalResistance:
+            m_totalResistance = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::TripTime:
+            m_tripTime = value.toDouble(0.0);
+            updated |= Motion;
+            break;
+        case StateKey::VesselWeight:
+            m_vesselWeight = value.toDouble(0.0);
+            updated |= Status;
+            break;
+        case StateKey::CargoWeight:
+            m_cargoWeight = value.toDouble(0.0);
+            updated |= Status;
+            break;
+        case StateKey::IsOn:
+            m_isOn = value.toBool(false);
+            updated |= Status;
+            break;
+        case StateKey::OutOfEnergy:
+            m_outOfEnergy = value.toBool(false);
+            updated |= Status;
+            break;
+        case StateKey::Loaded:
+            m_loaded = value.toBool(false);
+            updated |= Status;
+            break;
+        case StateKey::ReachedDestination:
+            m_reachedDestination = value.toBool(false);
+            updated |= Status;
+            break;
+        case StateKey::ContainersCount:
+            m_containersCount = value.toInt(0);
+            updated |= Status;
+            break;
+        case StateKey::ClosestPort:
+            m_closestPort = value.toString("Unknown");
+            updated |= Status;
+            break;
+        case StateKey::Consumption:
+            updateConsumption(value.toObject());
+            updated |= Consumption;
+            break;
+        case StateKey::EnergySources:
+            updateEnergySources(value.toArray());
+            updated |= EnergySources;
+            break;
+        case StateKey::Position:
+            updatePosition(value.toObject());
+            updated |= Position;
+            break;
+        case StateKey::Environment:
+            updateEnvironment(value.toObject());
+            updated |= Environment;
+            break;
+        case StateKey::Unknown:
+            break;
         }
     }
+    return updated;
+}
+
+void ShipState::updateConsumption(
+    const QJsonObject &consumption)
+{
+    auto it = consumption.constFind("energyConsumption");
+    if (it != consumption.constEnd())
+    {
+        m_energyConsumption = it.value().toDouble(0.0);
+    }
+    it = consumption.constFind("carbonDioxideEmitted");
+    if (it != consumption.constEnd())
+    {
+        m_carbonDioxideEmitted = it.value().toDouble(0.0);
+    }
+
+    // A fuel list replaces the previous one
+    it = consumption.constFind("fuelConsumption");
+    if (it == consumption.constEnd())
+    {
+        return;
+    }
+    m_fuelConsumption.clear();
+    for (const QJsonValue &fuelEntry : it.value().toArray())
+    {
+        QJsonObject fuelObj  = fuelEntry.toObject();
+        QString     fuelType = fuelObj.value("fuelType")
+                               .toString("Unknown");
+        double consumedVolume =
+            fuelObj.value("consumedVolumeLiters")
+                .toDouble(0.0);
+        m_fuelConsumption[fuelType] = consumedVolume;
+    }
+}
 
-    // Parse energy sources
-    QJsonArray energySources =
-        shipData.value("energySources").toArray();
+void ShipState::updateEnergySources(
+    const QJsonArray &energySources)
+{
+    m_energySources.clear();
+    m_energySources.reserve(energySources.size());
     for (const QJsonValue &sourceValue : energySources)
     {
         QJsonObject source = sourceValue.toObject();
@@ -97,41 +259,53 @@ ShipState::ShipState(const QJsonObject &shipData)
             source.value("weight").toDouble(0.0);
         m_energySources.append(sourceMap);
     }
+}
 
-    // Parse position data
-    QJsonObject position =
-        shipData.value("position").toObject();
-    if (!position.isEmpty())
+void ShipState::updatePosition(const QJsonObject &position)
+{
+    auto it = position.constFind("latitude");
+    if (it != position.constEnd())
+    {
+        m_latitude = it.value().toDouble(0.0);
+    }
+    it = position.constFind("longitude");
+    if (it != position.constEnd())
     {
-        m_latitude =
-            position.value("latitude").toDouble(0.0);
-        m_longitude =
-            position.value("longitude").toDouble(0.0);
+        m_longitude = it.value().toDouble(0.0);
+    }
 
-        QJsonArray posArray =
-            position.value("position").toArray();
+    it = position.constFind("position");
+    if (it != position.constEnd())
+    {
+        const QJsonArray posArray = it.value().toArray();
+        m_position.clear();
+        m_position.reserve(posArray.size());
         for (const QJsonValue &pos : posArray)
         {
             m_position.append(pos.toDouble(0.0));
         }
     }
+}
 
-    // Parse environmental data
-    QJsonObject env =
-        shipData.value("environment").toObject();
-    if (!env.isEmpty())
+void ShipState::updateEnvironment(const QJsonObject &env)
+{
+    for (auto it = env.constBegin(); it != env.constEnd();
+         ++it)
     {
-        m_waterDepth =
-            env.value("waterDepth").toDouble(0.0);
-        m_salinity = env.value("salinity").toDouble(0.0);
-        m_temperature =
-            env.value("temperature").toDouble(0.0);
-        m_waveHeight =
-            env.value("waveHeight").toDouble(0.0);
-        m_waveLength =
-            env.value("waveLength").toDouble(0.0);
-        m_waveAngularFrequency =
-            env.value("waveAngularFrequency").toDouble(0.0);
+        const QString key   = it.key();
+        const double  value = it.value().toDouble(0.0);
+        if (key == "waterDepth")
+            m_waterDepth = value;
+        else if (key == "salinity")
+            m_salinity = value;
+        else if (key == "temperature")
+            m_temperature = value;
+        else if (key == "waveHeight")
+            m_waveHeight = value;
+        else if (key == "waveLength")
+            m_waveLength = value;
+        else if (key == "waveAngularFrequency")
+            m_waveAngularFrequency = value;
     }
 }
 
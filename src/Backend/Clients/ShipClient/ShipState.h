@@ -2,6 +2,7 @@
 
 #include <QByteArray>
 #include <QDateTime>
+#include <QFlags>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
@@ -26,12 +27,43 @@ namespace ShipClient
 class ShipState
 {
 public:
+    /**
+     * @brief Groups of fields a JSON update can touch
+     */
+    enum Field : quint32
+    {
+        NoFields      = 0x00,
+        Motion        = 0x01, ///< Distance, speed, forces
+        Status        = 0x02, ///< Flags, weights, cargo
+        Consumption   = 0x04, ///< Energy, fuel, emissions
+        EnergySources = 0x08,
+        Position      = 0x10,
+        Environment   = 0x20,
+        AllFields     = 0x3F
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
     /**
      * @brief Constructor from JSON data
      * @param shipData Ship state data as JSON
      */
     explicit ShipState(const QJsonObject &shipData);
 
+    /**
+     * @brief Updates the fields present in a payload
+     *
+     * Accepts a full state or a delta holding "shipID" and
+     * only the changed keys; absent keys keep their
+     * values. Nested objects ("consumption", "position",
+     * "environment") are merged key by key, while the
+     * fuel, energy source and position lists are replaced
+     * when present.
+     *
+     * @param shipData Full or partial ship state
+     * @return Groups that had at least one key present
+     */
+    Fields updateFromJson(const QJsonObject &shipData);
+
     /**
      * @brief Get value of a specific metric
      * @param metricName Name of the metric
@@ -84,6 +116,12 @@ public:
     double getWaveAngularFrequency() const;
 
 private:
+    void updateConsumption(const QJsonObject &consumption);
+    void
+    updateEnergySources(const QJsonArray &energySources);
+    void updatePosition(const QJsonObject &position);
+    void updateEnvironment(const QJsonObject &env);
+
     QString m_shipId;
     double  m_travelledDistance;
     double  m_currentAcceleration;
@@ -124,6 +162,8 @@ private:
     double m_waveAngularFrequency;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(ShipState::Fields)
+
 } // namespace ShipClient
 } // namespace Backend
 } // namespace CargoNetSim
@@ -0,0 +1,864 @@
+#include "LocalTerminalGraph.h"
+#include "Backend/Commons/ThreadSafetyUtils.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+namespace
+{
+// Arrival mode used for the origin terminal
+constexpr int NO_MODE = -2;
+
+// Number of arrival mode slots per terminal state
+constexpr int MODE_SLOTS = 4;
+
+// Route attributes that contribute to the edge cost
+const QStringList EDGE_COST_ATTRIBUTES = {
+    "cost",     "travelTime", "distance", "carbonEmissions",
+    "risk",     "energyConsumption"};
+
+int modeSlot(int mode)
+{
+    return mode < 0 ? 0
+                    : std::min(mode + 1, MODE_SLOTS - 1);
+}
+
+int slotMode(int slot)
+{
+    return slot == 0 ? NO_MODE : slot - 1;
+}
+} // namespace
+
+LocalTerminalGraph::LocalTerminalGraph() {}
+
+LocalTerminalGraph::~LocalTerminalGraph()
+{
+    clear();
+}
+
+void LocalTerminalGraph::clear()
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    // Delete the owned terminal copies
+    for (TerminalNode &node : m_nodes)
+    {
+        delete node.terminal;
+        node.terminal = nullptr;
+    }
+    m_nodes.clear();
+    m_edges.clear();
+    m_nameIndex.clear();
+    m_freeNodes.clear();
+    m_activeCount = 0;
+}
+
+void LocalTerminalGraph::setCostFunctionParameters(
+    const QVariantMap &parameters)
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    m_weights.clear();
+    for (auto it = parameters.constBegin();
+         it != parameters.constEnd(); ++it)
+    {
+        // "default" maps to -1, modes to their number
+        bool ok   = false;
+        int  mode = it.key().toInt(&ok);
+        if (!ok)
+        {
+            if (it.key() != "default")
+            {
+                continue;
+            }
+            mode = -1;
+        }
+
+        QHash<QString, double> weights;
+        QVariantMap modeParams = it.value().toMap();
+        for (auto wIt = modeParams.constBegin();
+             wIt != modeParams.constEnd(); ++wIt)
+        {
+            weights[wIt.key()] = wIt.value().toDouble();
+        }
+        m_weights[mode] = weights;
+    }
+
+    recomputeCosts();
+}
+
+bool LocalTerminalGraph::addTerminal(
+    const Terminal *terminal)
+{
+    if (!terminal)
+    {
+        return false;
+    }
+
+    Commons::ScopedWriteLock locker(m_lock);
+
+    // Reuse the slot of a terminal known by any name
+    int index = -1;
+    for (const QString &name : terminal->getNames())
+    {
+        index = m_nameIndex.value(name, -1);
+        if (index >= 0)
+        {
+            break;
+        }
+    }
+
+    if (index < 0)
+    {
+        if (!m_freeNodes.isEmpty())
+        {
+            index = m_freeNodes.takeLast();
+        }
+        else
+        {
+            index = m_nodes.size();
+            m_nodes.append(TerminalNode());
+        }
+        m_activeCount++;
+    }
+
+    TerminalNode &node = m_nodes[index];
+    delete node.terminal;
+
+    // Keep a private copy; callers may delete theirs
+    node.terminal = new Terminal(
+        terminal->getNames(), terminal->getDisplayName(),
+        terminal->getConfig(), terminal->getInterfaces(),
+        terminal->getRegion(), nullptr);
+    for (const QString &name : terminal->getNames())
+    {
+        if (!node.names.contains(name))
+        {
+            node.names.append(name);
+        }
+        m_nameIndex[name] = index;
+    }
+    node.handlingCost = computeTerminalCost(node.terminal);
+    node.active       = true;
+
+    return true;
+}
+
+bool LocalTerminalGraph::addTerminalAlias(
+    const QString &terminalId, const QString &alias)
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    int index = resolve(terminalId);
+    if (index < 0 || alias.isEmpty())
+    {
+        return false;
+    }
+
+    if (!m_nodes[index].names.contains(alias))
+    {
+        m_nodes[index].names.append(alias);
+    }
+    m_nameIndex[alias] = index;
+    return true;
+}
+
+bool LocalTerminalGraph::removeTerminal(
+    const QString &terminalId)
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    int index = resolve(terminalId);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    // Drop every route touching the terminal
+    TerminalNode &node = m_nodes[index];
+    const QVector<int> arcs = node.arcs;
+    for (int arc : arcs)
+    {
+        detachEdge(arcEdge(arc));
+    }
+
+    for (const QString &name : node.names)
+    {
+        m_nameIndex.remove(name);
+    }
+    delete node.terminal;
+    node = TerminalNode();
+
+    m_freeNodes.append(index);
+    m_activeCount--;
+    return true;
+}
+
+bool LocalTerminalGraph::hasTerminal(
+    const QString &terminalId) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    return resolve(terminalId) >= 0;
+}
+
+QString LocalTerminalGraph::canonicalName(
+    const QString &terminalId) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    int index = resolve(terminalId);
+    return index < 0 ? QString()
+                     : m_nodes[index].names.first();
+}
+
+int LocalTerminalGraph::terminalCount() const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    return m_activeCount;
+}
+
+QStringList LocalTerminalGraph::terminalAliases(
+    const QString &terminalId) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    int index = resolve(terminalId);
+    return index < 0 ? QStringList()
+                     : m_nodes[index].names.mid(1);
+}
+
+QJsonObject LocalTerminalGraph::terminalJson(
+    const QString &terminalId) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+
+    int index = resolve(terminalId);
+    if (index < 0)
+    {
+        return QJsonObject();
+    }
+
+    const TerminalNode &node     = m_nodes[index];
+    const Terminal     *terminal = node.terminal;
+
+    // Same layout as the server's terminal events
+    QJsonObject json = terminal->getConfig();
+    json["terminal_name"] = node.names.first();
+    json["aliases"] =
+        QJsonArray::fromStringList(node.names.mid(1));
+    json["display_name"] = terminal->getDisplayName();
+    json["region"]       = terminal->getRegion();
+
+    QJsonObject interfacesJson;
+    const auto  interfaces = terminal->getInterfaces();
+    for (auto it = interfaces.constBegin();
+         it != interfaces.constEnd(); ++it)
+    {
+        QJsonArray modesArray;
+        for (TransportationTypes::TransportationMode mode :
+             it.value())
+        {
+            modesArray.append(static_cast<int>(mode));
+        }
+        interfacesJson[QString::number(
+            static_cast<int>(it.key()))] = modesArray;
+    }
+    json["interfaces"] = interfacesJson;
+
+    return json;
+}
+
+bool LocalTerminalGraph::addRoute(const PathSegment *route)
+{
+    if (!route)
+    {
+        return false;
+    }
+
+    Commons::ScopedWriteLock locker(m_lock);
+
+    int from = resolve(route->getStart());
+    int to   = resolve(route->getEnd());
+    if (from < 0 || to < 0 || from == to)
+    {
+        qWarning() << "Cannot add local route"
+                   << route->getPathSegmentId()
+                   << ": unknown or identical endpoints";
+        return false;
+    }
+
+    int mode = TransportationTypes::toInt(route->getMode());
+
+    // Replace an existing route of the same mode
+    int edgeIndex = findEdge(from, to, mode);
+    if (edgeIndex < 0)
+    {
+        edgeIndex = m_edges.size();
+        m_edges.append(RouteEdge());
+        m_nodes[from].arcs.append(edgeIndex * 2);
+        m_nodes[to].arcs.append(edgeIndex * 2 + 1);
+    }
+
+    RouteEdge &edge = m_edges[edgeIndex];
+    edge.routeId    = route->getPathSegmentId();
+    edge.from       = from;
+    edge.to         = to;
+    edge.mode       = mode;
+    edge.attributes = route->getAttributes();
+    edge.cost       = computeEdgeCost(edge);
+    edge.active     = true;
+
+    return true;
+}
+
+bool LocalTerminalGraph::changeRouteWeight(
+    const QString &start, const QString &end, int mode,
+    const QJsonObject &attributes)
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    int edgeIndex =
+        findEdge(resolve(start), resolve(end), mode);
+    if (edgeIndex < 0)
+    {
+        return false;
+    }
+
+    RouteEdge &edge = m_edges[edgeIndex];
+    for (auto it = attributes.constBegin();
+         it != attributes.constEnd(); ++it)
+    {
+        edge.attributes[it.key()] = it.value();
+    }
+    edge.cost = computeEdgeCost(edge);
+    return true;
+}
+
+QJsonArray LocalTerminalGraph::findTopPaths(
+    const QString &start, const QString &end, int n,
+    TransportationTypes::TransportationMode mode,
+    bool                                    skipDelays)
+{
+    Commons::ScopedReadLock locker(m_lock);
+
+    QJsonArray results;
+    int        source = resolve(start);
+    int        target = resolve(end);
+    if (source < 0 || target < 0 || source == target
+        || n <= 0)
+    {
+        return results;
+    }
+
+    int modeFilter =
+        mode == TransportationTypes::TransportationMode::Any
+            ? -1
+            : TransportationTypes::toInt(mode);
+
+    // Yen's algorithm: accepted paths and candidates
+    QVector<ArcPath>   accepted;
+    QVector<ArcPath>   candidates;
+    QSet<QVector<int>> seen;
+
+    ArcPath first;
+    if (!shortestArcs(source, NO_MODE, target, modeFilter,
+                      skipDelays, QSet<int>(), QSet<int>(),
+                      first.arcs))
+    {
+        return results;
+    }
+    evaluate(first, source, skipDelays);
+    accepted.append(first);
+    seen.insert(first.arcs);
+
+    while (accepted.size() < n)
+    {
+        const ArcPath previous = accepted.last();
+
+        // Terminals visited by the previous path
+        QVector<int> previousNodes;
+        previousNodes.append(source);
+        for (int arc : previous.arcs)
+        {
+            previousNodes.append(arcHead(arc));
+        }
+
+        for (int i = 0; i < previous.arcs.size(); ++i)
+        {
+            int          spurNode = previousNodes[i];
+            QVector<int> rootArcs = previous.arcs.mid(0, i);
+            int          arrivalMode =
+                i == 0 ? NO_MODE : arcMode(rootArcs.last());
+
+            // Ban the next arc of every accepted path
+            // sharing this root
+            QSet<int> bannedArcs;
+            for (const ArcPath &path : accepted)
+            {
+                if (path.arcs.size() > i
+                    && path.arcs.mid(0, i) == rootArcs)
+                {
+                    bannedArcs.insert(path.arcs[i]);
+                }
+            }
+
+            // Keep the spur path off the root path's
+            // terminals
+            QSet<int> bannedNodes;
+            for (int j = 0; j < i; ++j)
+            {
+                bannedNodes.insert(previousNodes[j]);
+            }
+
+            QVector<int> spurArcs;
+            if (!shortestArcs(spurNode, arrivalMode, target,
+                              modeFilter, skipDelays,
+                              bannedNodes, bannedArcs,
+                              spurArcs))
+            {
+                continue;
+            }
+
+            ArcPath candidate;
+            candidate.arcs = rootArcs + spurArcs;
+            if (seen.contains(candidate.arcs)
+                || !isLoopless(candidate.arcs, source))
+            {
+                continue;
+            }
+            seen.insert(candidate.arcs);
+            evaluate(candidate, source, skipDelays);
+            candidates.append(candidate);
+        }
+
+        if (candidates.isEmpty())
+        {
+            break;
+        }
+
+        // Promote the cheapest candidate
+        auto best = std::min_element(
+            candidates.begin(), candidates.end(),
+            [](const ArcPath &a, const ArcPath &b) {
+                return a.totalCost() < b.totalCost();
+            });
+        accepted.append(*best);
+        candidates.erase(best);
+    }
+
+    for (int k = 0; k < accepted.size(); ++k)
+    {
+        results.append(pathToJson(accepted[k], k + 1,
+                                  source, skipDelays));
+    }
+    return results;
+}
+
+bool LocalTerminalGraph::isLoopless(
+    const QVector<int> &arcs, int source) const
+{
+    QSet<int> visited;
+    visited.insert(source);
+    for (int arc : arcs)
+    {
+        if (visited.contains(arcHead(arc)))
+        {
+            return false;
+        }
+        visited.insert(arcHead(arc));
+    }
+    return true;
+}
+
+int LocalTerminalGraph::arcTail(int arc) const
+{
+    const RouteEdge &edge = m_edges[arcEdge(arc)];
+    return arc % 2 == 0 ? edge.from : edge.to;
+}
+
+int LocalTerminalGraph::arcHead(int arc) const
+{
+    const RouteEdge &edge = m_edges[arcEdge(arc)];
+    return arc % 2 == 0 ? edge.to : edge.from;
+}
+
+int LocalTerminalGraph::arcMode(int arc) const
+{
+    return m_edges[arcEdge(arc)].mode;
+}
+
+int LocalTerminalGraph::resolve(
+    const QString &terminalId) const
+{
+    return m_nameIndex.value(terminalId, -1);
+}
+
+double LocalTerminalGraph::weightFor(
+    int mode, const QString &key) const
+{
+    // Mode-specific weight, then default, then 1.0 like
+    // the client-side parameter completion
+    auto modeIt = m_weights.constFind(mode);
+    if (modeIt != m_weights.constEnd()
+        && modeIt->contains(key))
+    {
+        return modeIt->value(key);
+    }
+    return m_weights.value(-1).value(key, 1.0);
+}
+
+double LocalTerminalGraph::computeEdgeCost(
+    const RouteEdge &edge) const
+{
+    double cost = 0.0;
+    for (const QString &key : EDGE_COST_ATTRIBUTES)
+    {
+        if (edge.attributes.contains(key))
+        {
+            cost += weightFor(edge.mode, key)
+                    * edge.attributes[key].toDouble();
+        }
+    }
+    return std::max(cost, 0.0);
+}
+
+double LocalTerminalGraph::computeTerminalCost(
+    const Terminal *terminal) const
+{
+    if (!terminal)
+    {
+        return 0.0;
+    }
+
+    QJsonObject config     = terminal->getConfig();
+    double      delayHours = 0.0;
+    double      directCost = 0.0;
+
+    // Expected dwell time in hours
+    if (config.contains("dwell_time"))
+    {
+        QJsonObject dwell =
+            config["dwell_time"].toObject();
+        QString method =
+            dwell["method"].toString("gamma");
+        QJsonObject params = dwell["parameters"].toObject();
+
+        if (method.compare("exponential",
+                           Qt::CaseInsensitive)
+            == 0)
+        {
+            delayHours = params["scale"].toDouble(
+                             2.0 * 24.0 * 3600.0)
+                         / 3600.0;
+        }
+        else if (method.compare("normal",
+                                Qt::CaseInsensitive)
+                 == 0)
+        {
+            delayHours =
+                params["mean"].toDouble(2.0 * 24.0 * 3600.0)
+                / 3600.0;
+        }
+        else if (method.compare("lognormal",
+                                Qt::CaseInsensitive)
+                 == 0)
+        {
+            double mean = params["mean"].toDouble(
+                std::log(2.0 * 24.0 * 3600.0));
+            double sigma = params["sigma"].toDouble(0.25);
+            delayHours =
+                std::exp(mean + sigma * sigma / 2.0)
+                / 3600.0;
+        }
+        else
+        {
+            delayHours =
+                params["shape"].toDouble(2.0)
+                * params["scale"].toDouble(24.0 * 3600.0)
+                / 3600.0;
+        }
+    }
+
+    // Expected customs delay
+    bool customsApplied = false;
+    if (config.contains("customs"))
+    {
+        QJsonObject customs = config["customs"].toObject();
+        double probability =
+            customs["probability"].toDouble(0.0);
+        double delayMean =
+            customs["delay_mean"].toDouble(0.0);
+        if (probability > 0.0 && delayMean > 0.0)
+        {
+            delayHours += probability * delayMean;
+            customsApplied = true;
+        }
+    }
+
+    // Direct handling fees
+    if (config.contains("cost"))
+    {
+        QJsonObject cost = config["cost"].toObject();
+        directCost += cost["fixed_fees"].toDouble(0.0);
+        if (customsApplied)
+        {
+            directCost +=
+                cost["customs_fees"].toDouble(0.0);
+        }
+        directCost += cost["risk_factor"].toDouble(0.0);
+    }
+
+    return delayHours * weightFor(-1, "terminal_delay")
+           + directCost * weightFor(-1, "terminal_cost");
+}
+
+void LocalTerminalGraph::recomputeCosts()
+{
+    for (TerminalNode &node : m_nodes)
+    {
+        if (node.active)
+        {
+            node.handlingCost =
+                computeTerminalCost(node.terminal);
+        }
+    }
+    for (RouteEdge &edge : m_edges)
+    {
+        if (edge.active)
+        {
+            edge.cost = computeEdgeCost(edge);
+        }
+    }
+}
+
+int LocalTerminalGraph::findEdge(int from, int to,
+                                 int mode) const
+{
+    if (from < 0 || to < 0)
+    {
+        return -1;
+    }
+
+    for (int arc : m_nodes[from].arcs)
+    {
+        const RouteEdge &edge = m_edges[arcEdge(arc)];
+        if (edge.active && edge.mode == mode
+            && arcHead(arc) == to)
+        {
+            return arcEdge(arc);
+        }
+    }
+    return -1;
+}
+
+void LocalTerminalGraph::detachEdge(int edgeIndex)
+{
+    RouteEdge &edge = m_edges[edgeIndex];
+    if (!edge.active)
+    {
+        return;
+    }
+    m_nodes[edge.from].arcs.removeOne(edgeIndex * 2);
+    m_nodes[edge.to].arcs.removeOne(edgeIndex * 2 + 1);
+    edge.active = false;
+}
+
+double LocalTerminalGraph::transferCost(
+    int node, int arrivalMode, int departureMode,
+    bool skipDelays) const
+{
+    // Origin costs are charged once per path
+    if (arrivalMode == NO_MODE)
+    {
+        return 0.0;
+    }
+    if (skipDelays && arrivalMode == departureMode)
+    {
+        return 0.0;
+    }
+    return m_nodes[node].handlingCost;
+}
+
+bool LocalTerminalGraph::shortestArcs(
+    int source, int arrivalMode, int target, int modeFilter,
+    bool skipDelays, const QSet<int> &bannedNodes,
+    const QSet<int> &bannedArcs, QVector<int> &arcs) const
+{
+    using Entry = std::pair<double, int>;
+
+    const int stateCount = m_nodes.size() * MODE_SLOTS;
+    std::vector<double> dist(
+        stateCount,
+        std::numeric_limits<double>::infinity());
+    std::vector<int> prevState(stateCount, -1);
+    std::vector<int> prevArc(stateCount, -1);
+
+    std::priority_queue<Entry, std::vector<Entry>,
+                        std::greater<Entry>>
+        queue;
+
+    const int startState =
+        source * MODE_SLOTS + modeSlot(arrivalMode);
+    dist[startState] = 0.0;
+    queue.push({0.0, startState});
+
+    int reached = -1;
+    while (!queue.empty())
+    {
+        auto [cost, state] = queue.top();
+        queue.pop();
+        if (cost > dist[state])
+        {
+            continue;
+        }
+
+        int node = state / MODE_SLOTS;
+        if (node == target)
+        {
+            reached = state;
+            break;
+        }
+
+        int inMode = slotMode(state % MODE_SLOTS);
+        for (int arc : m_nodes[node].arcs)
+        {
+            if (bannedArcs.contains(arc))
+            {
+                continue;
+            }
+
+            const RouteEdge &edge = m_edges[arcEdge(arc)];
+            if (modeFilter >= 0 && edge.mode != modeFilter)
+            {
+                continue;
+            }
+
+            int head = arcHead(arc);
+            if (head == source || bannedNodes.contains(head)
+                || !m_nodes[head].active)
+            {
+                continue;
+            }
+
+            double next = cost + edge.cost
+                          + transferCost(node, inMode,
+                                         edge.mode,
+                                         skipDelays);
+            int nextState =
+                head * MODE_SLOTS + modeSlot(edge.mode);
+            if (next < dist[nextState])
+            {
+                dist[nextState]      = next;
+                prevState[nextState] = state;
+                prevArc[nextState]   = arc;
+                queue.push({next, nextState});
+            }
+        }
+    }
+
+    if (reached < 0)
+    {
+        return false;
+    }
+
+    // Walk the predecessor chain back to the source
+    arcs.clear();
+    for (int state = reached; state != startState;
+         state      = prevState[state])
+    {
+        arcs.append(prevArc[state]);
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return !arcs.isEmpty();
+}
+
+void LocalTerminalGraph::evaluate(ArcPath &path, int source,
+                                  bool skipDelays) const
+{
+    path.edgeCost     = 0.0;
+    path.terminalCost = m_nodes[source].handlingCost;
+
+    int previousMode = NO_MODE;
+    for (int arc : path.arcs)
+    {
+        const RouteEdge &edge = m_edges[arcEdge(arc)];
+        path.edgeCost += edge.cost;
+        path.terminalCost +=
+            transferCost(arcTail(arc), previousMode,
+                         edge.mode, skipDelays);
+        previousMode = edge.mode;
+    }
+
+    if (!path.arcs.isEmpty())
+    {
+        path.terminalCost +=
+            m_nodes[arcHead(path.arcs.last())].handlingCost;
+    }
+}
+
+QJsonObject LocalTerminalGraph::pathToJson(
+    const ArcPath &path, int pathId, int source,
+    bool skipDelays) const
+{
+    QJsonObject json;
+    json["path_id"]              = pathId;
+    json["total_path_cost"]      = path.totalCost();
+    json["total_edge_costs"]     = path.edgeCost;
+    json["total_terminal_costs"] = path.terminalCost;
+
+    // Terminals with the cost charged at each of them
+    QJsonArray terminalsArray;
+    QJsonObject origin;
+    origin["terminal"] = m_nodes[source].names.first();
+    origin["handling_cost"] = m_nodes[source].handlingCost;
+    origin["costs_skipped"] = false;
+    terminalsArray.append(origin);
+
+    QJsonArray segmentsArray;
+    for (int i = 0; i < path.arcs.size(); ++i)
+    {
+        int              arc  = path.arcs[i];
+        const RouteEdge &edge = m_edges[arcEdge(arc)];
+        int              head = arcHead(arc);
+
+        QJsonObject segment;
+        segment["from"] =
+            m_nodes[arcTail(arc)].names.first();
+        segment["to"]   = m_nodes[head].names.first();
+        segment["mode"] = edge.mode;
+        segment["attributes"] = edge.attributes;
+        segment["weight"]     = edge.cost;
+        segmentsArray.append(segment);
+
+        double charged = m_nodes[head].handlingCost;
+        if (i + 1 < path.arcs.size())
+        {
+            charged = transferCost(
+                head, edge.mode,
+                arcMode(path.arcs[i + 1]), skipDelays);
+        }
+
+        QJsonObject terminal;
+        terminal["terminal"] = m_nodes[head].names.first();
+        terminal["handling_cost"] = charged;
+        terminal["costs_skipped"] =
+            charged == 0.0
+            && m_nodes[head].handlingCost > 0.0;
+        terminalsArray.append(terminal);
+    }
+
+    json["terminals_in_path"] = terminalsArray;
+    json["segments"]          = segmentsArray;
+    return json;
+}
+
+} // namespace Backend
+} // namespace CargoNetSim
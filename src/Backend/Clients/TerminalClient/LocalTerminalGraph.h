@@ -0,0 +1,317 @@
+#pragma once
+
+/**
+ * @file LocalTerminalGraph.h
+ * @brief Defines LocalTerminalGraph, an in-process
+ * terminal graph with top-k path finding
+ * @author Ahmed Aredah
+ * @date March 21, 2025
+ *
+ * This file declares the LocalTerminalGraph class, an
+ * embedded stand-in for the TerminalSim server graph. It
+ * holds terminals and multimodal routes locally and
+ * answers top-k path queries without a message broker.
+ *
+ * @note Part of the CargoNetSim::Backend namespace.
+ */
+
+#include "Backend/Commons/ThreadSafetyUtils.h"
+#include "Backend/Commons/TransportationMode.h"
+#include "Backend/Models/PathSegment.h"
+#include "Backend/Models/Terminal.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+/**
+ * @class LocalTerminalGraph
+ * @brief In-process multimodal terminal graph
+ *
+ * Mirrors the TerminalSim graph semantics so that the
+ * TerminalSimulationClient can answer path queries
+ * locally:
+ * - Terminals are addressed by canonical name or alias
+ * - Routes connect two terminals by one mode and may be
+ *   traversed in both directions; parallel routes with
+ *   different modes are kept
+ * - Edge cost is the weighted sum of the route attributes
+ *   using the cost function parameters of the route mode
+ * - Terminal cost is the expected dwell and customs delay
+ *   weighted by terminal_delay plus the direct fees
+ *   weighted by terminal_cost
+ * - Origin and destination terminals are always charged;
+ *   intermediate terminals are skipped when the mode does
+ *   not change and same-mode delays are skipped
+ *
+ * Top-k loopless paths are found with Yen's algorithm on
+ * a (terminal, arrival mode) state graph so mode-change
+ * costs are exact. Results are returned in the same JSON
+ * layout as the server's pathFound event.
+ *
+ * Thread Safety: all public methods are guarded by an
+ * internal read-write lock.
+ */
+class LocalTerminalGraph
+{
+public:
+    /**
+     * @brief Constructs an empty graph
+     */
+    LocalTerminalGraph();
+
+    /**
+     * @brief Destroys the graph and owned terminals
+     */
+    ~LocalTerminalGraph();
+
+    LocalTerminalGraph(const LocalTerminalGraph &) = delete;
+    LocalTerminalGraph &
+    operator=(const LocalTerminalGraph &) = delete;
+
+    /**
+     * @brief Removes all terminals and routes
+     */
+    void clear();
+
+    /**
+     * @brief Sets cost function parameters
+     * @param parameters Weights keyed by "default" and by
+     * mode number, as sent to the server
+     *
+     * Recomputes all edge and terminal costs.
+     */
+    void setCostFunctionParameters(
+        const QVariantMap &parameters);
+
+    /**
+     * @brief Adds or replaces a terminal
+     * @param terminal Terminal to copy into the graph
+     * @return True if the terminal was stored
+     */
+    bool addTerminal(const Terminal *terminal);
+
+    /**
+     * @brief Adds an alias to a terminal
+     * @param terminalId Terminal name or alias
+     * @param alias New alias
+     * @return True if the terminal exists
+     */
+    bool addTerminalAlias(const QString &terminalId,
+                          const QString &alias);
+
+    /**
+     * @brief Removes a terminal and its routes
+     * @param terminalId Terminal name or alias
+     * @return True if the terminal existed
+     */
+    bool removeTerminal(const QString &terminalId);
+
+    /**
+     * @brief Checks whether a terminal exists
+     * @param terminalId Terminal name or alias
+     * @return True if found
+     */
+    bool hasTerminal(const QString &terminalId) const;
+
+    /**
+     * @brief Resolves a name or alias to the canonical name
+     * @param terminalId Terminal name or alias
+     * @return Canonical name, empty if unknown
+     */
+    QString canonicalName(const QString &terminalId) const;
+
+    /**
+     * @brief Gets the number of terminals
+     * @return Terminal count
+     */
+    int terminalCount() const;
+
+    /**
+     * @brief Gets the aliases of a terminal
+     * @param terminalId Terminal name or alias
+     * @return All names except the canonical one
+     */
+    QStringList terminalAliases(
+        const QString &terminalId) const;
+
+    /**
+     * @brief Serializes a terminal like the server does
+     * @param terminalId Terminal name or alias
+     * @return Terminal JSON, empty if unknown
+     */
+    QJsonObject terminalJson(
+        const QString &terminalId) const;
+
+    /**
+     * @brief Adds or replaces a route
+     * @param route Route to copy into the graph
+     * @return True if both endpoints exist
+     *
+     * A route with the same endpoints and mode replaces
+     * the existing one.
+     */
+    bool addRoute(const PathSegment *route);
+
+    /**
+     * @brief Updates the attributes of a route
+     * @param start Starting terminal name or alias
+     * @param end Ending terminal name or alias
+     * @param mode Transportation mode as integer
+     * @param attributes Attributes to merge
+     * @return True if the route exists
+     */
+    bool changeRouteWeight(const QString     &start,
+                           const QString     &end,
+                           int                mode,
+                           const QJsonObject &attributes);
+
+    /**
+     * @brief Finds the top N loopless paths
+     * @param start Starting terminal name or alias
+     * @param end Ending terminal name or alias
+     * @param n Number of paths to return
+     * @param mode Mode filter, Any for all modes
+     * @param skipDelays Skip same mode terminal costs
+     * @return Path JSON objects ordered by total cost
+     */
+    QJsonArray findTopPaths(
+        const QString &start, const QString &end, int n,
+        TransportationTypes::TransportationMode mode,
+        bool                                    skipDelays);
+
+private:
+    /**
+     * @brief Terminal stored in the graph
+     */
+    struct TerminalNode
+    {
+        Terminal    *terminal     = nullptr;
+        QStringList  names;
+        double       handlingCost = 0.0;
+        QVector<int> arcs; // Outgoing arc ids
+        bool         active       = false;
+    };
+
+    /**
+     * @brief Undirected route between two terminals
+     */
+    struct RouteEdge
+    {
+        QString     routeId;
+        int         from = -1;
+        int         to   = -1;
+        int         mode = 0;
+        QJsonObject attributes;
+        double      cost   = 0.0;
+        bool        active = false;
+    };
+
+    /**
+     * @brief Candidate path as a sequence of arcs
+     */
+    struct ArcPath
+    {
+        QVector<int> arcs;
+        double       edgeCost     = 0.0;
+        double       terminalCost = 0.0;
+
+        double totalCost() const
+        {
+            return edgeCost + terminalCost;
+        }
+    };
+
+    // Arc helpers; arc id = edge * 2 + direction
+    int arcEdge(int arc) const
+    {
+        return arc / 2;
+    }
+    int arcTail(int arc) const;
+    int arcHead(int arc) const;
+    int arcMode(int arc) const;
+
+    // True if the arcs from source pass no terminal twice
+    bool isLoopless(const QVector<int> &arcs,
+                    int                 source) const;
+
+    int    resolve(const QString &terminalId) const;
+    double weightFor(int mode, const QString &key) const;
+    double computeEdgeCost(const RouteEdge &edge) const;
+    double
+    computeTerminalCost(const Terminal *terminal) const;
+    void   recomputeCosts();
+    int    findEdge(int from, int to, int mode) const;
+    void   detachEdge(int edgeIndex);
+
+    /**
+     * @brief Cost charged when passing a terminal
+     * @param node Terminal index
+     * @param arrivalMode Arrival mode, -2 at the origin
+     * @param departureMode Departure mode
+     * @param skipDelays Skip same mode terminal costs
+     * @return Terminal cost, zero at the origin
+     */
+    double transferCost(int node, int arrivalMode,
+                        int departureMode,
+                        bool skipDelays) const;
+
+    /**
+     * @brief Dijkstra search on the state graph
+     *
+     * States are per arrival mode, so the walk found may
+     * pass a terminal twice under different modes when a
+     * detour to a cheaper transfer undercuts a direct
+     * transfer; findTopPaths() drops such candidates.
+     *
+     * @param source Source terminal index
+     * @param arrivalMode Mode used to reach the source
+     * @param target Target terminal index
+     * @param modeFilter Mode filter, -1 for any
+     * @param skipDelays Skip same mode terminal costs
+     * @param bannedNodes Terminals that cannot be used
+     * @param bannedArcs Arcs that cannot be used
+     * @param arcs Output arcs of the path found
+     * @return True if the target is reachable
+     */
+    bool shortestArcs(int source, int arrivalMode,
+                      int target, int modeFilter,
+                      bool                 skipDelays,
+                      const QSet<int>     &bannedNodes,
+                      const QSet<int>     &bannedArcs,
+                      QVector<int>        &arcs) const;
+
+    void evaluate(ArcPath &path, int source,
+                  bool skipDelays) const;
+
+    QJsonObject pathToJson(const ArcPath &path, int pathId,
+                           int  source,
+                           bool skipDelays) const;
+
+    mutable QReadWriteLock m_lock;
+    Commons::LockName      m_lockName{
+        &m_lock, "LocalTerminalGraph"};
+
+    QVector<TerminalNode> m_nodes;
+    QVector<RouteEdge>    m_edges;
+    QHash<QString, int>   m_nameIndex;
+    QVector<int>          m_freeNodes;
+    int                   m_activeCount = 0;
+
+    // Weights keyed by mode number, or -1 for default
+    QHash<int, QHash<QString, double>> m_weights;
+};
+
+} // namespace Backend
+} // namespace CargoNetSim
@@ -39,6 +39,7 @@ TerminalSimulationClient::~TerminalSimulationClient()
 
     // Clear alias map
     m_terminalAliases.clear();
+    m_aliasNames.clear();
 
     // Clean up shortest path segments
     for (const QList<PathSegment *> &segments :
@@ -84,9 +85,32 @@ TerminalSimulationClient::~TerminalSimulationClient()
     qDebug() << "TerminalSimulationClient destroyed";
 }
 
+// Select the local path engine
+void TerminalSimulationClient::setLocalEngineEnabled(
+    bool enabled)
+{
+    m_localEngineEnabled = enabled;
+    qDebug() << "Local path engine"
+             << (enabled ? "enabled" : "disabled");
+}
+
+// Check whether the local path engine is used
+bool TerminalSimulationClient::isLocalEngineEnabled() const
+{
+    return m_localEngineEnabled;
+}
+
 // Reset server state
 bool TerminalSimulationClient::resetServer()
 {
+    if (m_localEngineEnabled)
+    {
+        // Clear the local graph and the mirrored state
+        m_localGraph.clear();
+        onServerReset(QJsonObject());
+        return true;
+    }
+
     // Execute reset command in serialized manner
     return executeSerializedCommand([this]() {
         // Send reset command with no parameters
@@ -124,77 +148,24 @@ void TerminalSimulationClient::initializeClient(
 bool TerminalSimulationClient::setCostFunctionParameters(
     const QVariantMap &parameters)
 {
-    // Execute command with serialization
-    return executeSerializedCommand([&]() {
-        // Create a complete parameter map with defaults
-        QVariantMap completeParams = parameters;
-
-        // Required mode entries
-        QStringList requiredModes = {
-            "default",
-            QString::number(static_cast<int>(
-                TransportationTypes::TransportationMode::
-                    Ship)),
-            QString::number(static_cast<int>(
-                TransportationTypes::TransportationMode::
-                    Train)),
-            QString::number(static_cast<int>(
-                TransportationTypes::TransportationMode::
-                    Truck))};
-
-        // Required attributes for each mode
-        QStringList requiredAttrs = {
-            "cost",           "travelTime",
-            "distance",       "carbonEmissions",
-            "risk",           "energyConsumption",
-            "terminal_delay", "terminal_cost"};
-
-        // Ensure all modes exist with default values
-        for (const QString &mode : requiredModes)
-        {
-            if (!completeParams.contains(mode)
-                || !completeParams[mode]
-                        .canConvert<QVariantMap>())
-            {
-                // Create mode with all default values
-                QVariantMap defaultModeParams;
-                for (const QString &attr : requiredAttrs)
-                {
-                    defaultModeParams[attr] = 1.0;
-                }
-                completeParams[mode] = defaultModeParams;
-                qDebug() << "Created default parameters "
-                            "for mode:"
-                         << mode;
-            }
-            else
-            {
-                // Mode exists, ensure all attributes exist
-                QVariantMap modeParams =
-                    completeParams[mode].toMap();
-                bool modeUpdated = false;
+    // Create a complete parameter map with defaults
+    QVariantMap completeParams =
+        completeCostFunctionParameters(parameters);
 
-                for (const QString &attr : requiredAttrs)
-                {
-                    if (!modeParams.contains(attr)
-                        || !modeParams[attr]
-                                .canConvert<double>())
-                    {
-                        modeParams[attr] = 1.0;
-                        modeUpdated      = true;
-                        qDebug()
-                            << "Added default value for"
-                            << attr << "in mode" << mode;
-                    }
-                }
+    {
+        Commons::ScopedWriteLock locker(m_dataMutex);
+        m_syncedCostParameters = QJsonObject();
+    }
 
-                if (modeUpdated)
-                {
-                    completeParams[mode] = modeParams;
-                }
-            }
-        }
+    if (m_localEngineEnabled)
+    {
+        m_localGraph.setCostFunctionParameters(
+            completeParams);
+        return true;
+    }
 
+    // Execute command with serialization
+    return executeSerializedCommand([&]() {
         // Parameters are now complete with defaults,
         // prepare request
         QJsonObject params;
@@ -208,10 +179,104 @@ bool TerminalSimulationClient::setCostFunctionParameters(
     });
 }
 
+// Fill missing cost function parameters
+QVariantMap
+TerminalSimulationClient::completeCostFunctionParameters(
+    const QVariantMap &parameters)
+{
+    QVariantMap completeParams = parameters;
+
+    // Required mode entries
+    QStringList requiredModes = {
+        "default",
+        QString::number(static_cast<int>(
+            TransportationTypes::TransportationMode::Ship)),
+        QString::number(static_cast<int>(
+            TransportationTypes::TransportationMode::
+                Train)),
+        QString::number(static_cast<int>(
+            TransportationTypes::TransportationMode::
+                Truck))};
+
+    // Required attributes for each mode
+    QStringList requiredAttrs = {
+        "cost",           "travelTime",
+        "distance",       "carbonEmissions",
+        "risk",           "energyConsumption",
+        "terminal_delay", "terminal_cost"};
+
+    // Ensure all modes exist with default values
+    for (const QString &mode : requiredModes)
+    {
+        if (!completeParams.contains(mode)
+            || !completeParams[mode]
+                    .canConvert<QVariantMap>())
+        {
+            // Create mode with all default values
+            QVariantMap defaultModeParams;
+            for (const QString &attr : requiredAttrs)
+            {
+                defaultModeParams[attr] = 1.0;
+            }
+            completeParams[mode] = defaultModeParams;
+            qDebug() << "Created default parameters "
+                        "for mode:"
+                     << mode;
+        }
+        else
+        {
+            // Mode exists, ensure all attributes exist
+            QVariantMap modeParams =
+                completeParams[mode].toMap();
+            bool modeUpdated = false;
+
+            for (const QString &attr : requiredAttrs)
+            {
+                if (!modeParams.contains(attr)
+                    || !modeParams[attr]
+                            .canConvert<double>())
+                {
+                    modeParams[attr] = 1.0;
+                    modeUpdated      = true;
+                    qDebug() << "Added default value for"
+                             << attr << "in mode" << mode;
+                }
+            }
+
+            if (modeUpdated)
+            {
+                completeParams[mode] = modeParams;
+            }
+        }
+    }
+
+    return completeParams;
+}
+
 // Add terminal
 bool TerminalSimulationClient::addTerminal(
     const Terminal *terminal)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        if (!terminal)
+        {
+            qCritical() << "Null terminal pointer";
+            return false;
+        }
+        if (!m_localGraph.addTerminal(terminal))
+        {
+            qCritical() << "Local graph rejected terminal"
+                        << terminal->getCanonicalName();
+            return false;
+        }
+        mirrorLocalTerminals(
+            {terminal->getCanonicalName()});
+        return true;
+    }
+
     // Execute command with serialization
     return executeSerializedCommand([&]() {
         // Validate terminal pointer
@@ -230,6 +295,37 @@ bool TerminalSimulationClient::addTerminal(
 bool TerminalSimulationClient::addTerminals(
     const QList<Terminal *> &terminals)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        QStringList added;
+        for (const Terminal *terminal : terminals)
+        {
+            if (!terminal)
+            {
+                qWarning()
+                    << "Skipping null terminal pointer";
+                continue;
+            }
+            if (!m_localGraph.addTerminal(terminal))
+            {
+                qWarning()
+                    << "Local graph rejected terminal"
+                    << terminal->getCanonicalName();
+                continue;
+            }
+            added.append(terminal->getCanonicalName());
+        }
+        if (added.isEmpty())
+        {
+            qCritical() << "No valid terminals to add";
+            return false;
+        }
+        mirrorLocalTerminals(added);
+        return true;
+    }
+
     // Execute command with serialization
     return executeSerializedCommand([&]() {
         // Validate input
@@ -274,6 +370,19 @@ bool TerminalSimulationClient::addTerminals(
 bool TerminalSimulationClient::addTerminalAlias(
     const QString &terminalId, const QString &alias)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        if (!m_localGraph.addTerminalAlias(terminalId,
+                                           alias))
+        {
+            return false;
+        }
+        mirrorLocalTerminals({terminalId});
+        return true;
+    }
+
     // Execute alias addition serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for alias addition
@@ -291,6 +400,11 @@ bool TerminalSimulationClient::addTerminalAlias(
 QStringList TerminalSimulationClient::getTerminalAliases(
     const QString &terminalId)
 {
+    if (m_localEngineEnabled)
+    {
+        return m_localGraph.terminalAliases(terminalId);
+    }
+
     // Execute alias fetch command serially
     executeSerializedCommand([&]() {
         // Prepare parameters for alias retrieval
@@ -314,6 +428,22 @@ QStringList TerminalSimulationClient::getTerminalAliases(
 bool TerminalSimulationClient::removeTerminal(
     const QString &terminalId)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        QString name =
+            m_localGraph.canonicalName(terminalId);
+        if (!m_localGraph.removeTerminal(terminalId))
+        {
+            return false;
+        }
+        QJsonObject params;
+        params["terminal_name"] = name;
+        onTerminalRemoved(QJsonObject{{"params", params}});
+        return true;
+    }
+
     // Execute removal command serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for removal
@@ -328,6 +458,11 @@ bool TerminalSimulationClient::removeTerminal(
 // Get terminal count
 int TerminalSimulationClient::getTerminalCount()
 {
+    if (m_localEngineEnabled)
+    {
+        return m_localGraph.terminalCount();
+    }
+
     // Execute count fetch serially
     executeSerializedCommand([&]() {
         // Send count command with no parameters
@@ -344,6 +479,21 @@ int TerminalSimulationClient::getTerminalCount()
 Terminal *TerminalSimulationClient::getTerminalStatus(
     const QString &terminalId)
 {
+    if (m_localEngineEnabled)
+    {
+        // The mirror is refreshed when the graph changes
+        QString name =
+            m_localGraph.canonicalName(terminalId);
+        if (name.isEmpty())
+        {
+            return nullptr;
+        }
+        Commons::ScopedReadLock locker(m_dataMutex);
+        return m_terminalStatus.value(name, nullptr);
+    }
+
+    // Always fetch; a known terminal is refreshed in place
+    // so pointers handed out earlier stay valid
     // Execute status fetch serially
     executeSerializedCommand([&]() {
         // Validate input parameter
@@ -361,13 +511,21 @@ Terminal *TerminalSimulationClient::getTerminalStatus(
     });
     // Access status thread-safely
     Commons::ScopedReadLock locker(m_dataMutex);
-    return m_terminalStatus.value(terminalId, nullptr);
+    return m_terminalStatus.value(
+        canonicalTerminalId(terminalId), nullptr);
 }
 
 // Add route
 bool TerminalSimulationClient::addRoute(
     const PathSegment *route)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        return m_localGraph.addRoute(route);
+    }
+
     // Execute route addition serially
     return executeSerializedCommand([&]() {
         // Validate route pointer
@@ -385,6 +543,18 @@ bool TerminalSimulationClient::addRoute(
 bool TerminalSimulationClient::addRoutes(
     const QList<PathSegment *> &routes)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        bool added = false;
+        for (const PathSegment *route : routes)
+        {
+            added = m_localGraph.addRoute(route) || added;
+        }
+        return added;
+    }
+
     // Execute command with serialization
     return executeSerializedCommand([&]() {
         // Validate input
@@ -429,6 +599,14 @@ bool TerminalSimulationClient::changeRouteWeight(
     const QString &start, const QString &end, int mode,
     const QJsonObject &attributes)
 {
+    invalidateGraphShadow();
+
+    if (m_localEngineEnabled)
+    {
+        return m_localGraph.changeRouteWeight(
+            start, end, mode, attributes);
+    }
+
     // Execute weight update serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for weight update
@@ -443,10 +621,252 @@ bool TerminalSimulationClient::changeRouteWeight(
     });
 }
 
+// Synchronize the server graph with the given state
+bool TerminalSimulationClient::syncGraph(
+    const QList<Terminal *>    &terminals,
+    const QList<PathSegment *> &routes,
+    const QVariantMap          &costParameters)
+{
+    if (m_localEngineEnabled)
+    {
+        // Rebuilding the local graph is cheap
+        return resetServer()
+               && setCostFunctionParameters(costParameters)
+               && (terminals.isEmpty()
+                   || addTerminals(terminals))
+               && (routes.isEmpty() || addRoutes(routes));
+    }
+
+    // Desired server state
+    QMap<QString, QJsonObject> desiredTerminals;
+    for (const Terminal *terminal : terminals)
+    {
+        if (terminal)
+        {
+            desiredTerminals[terminal->getCanonicalName()] =
+                terminal->toJson();
+        }
+    }
+
+    QMap<QString, QJsonObject> desiredRoutes;
+    for (const PathSegment *route : routes)
+    {
+        if (route)
+        {
+            desiredRoutes[routeSyncKey(
+                route->getStart(), route->getEnd(),
+                TransportationTypes::toInt(
+                    route->getMode()))] = route->toJson();
+        }
+    }
+
+    QJsonObject desiredCost = QJsonObject::fromVariantMap(
+        completeCostFunctionParameters(costParameters));
+
+    // Snapshot the shadow of the server graph
+    bool                       synced;
+    QMap<QString, QJsonObject> syncedTerminals;
+    QMap<QString, QJsonObject> syncedRoutes;
+    QJsonObject                syncedCost;
+    {
+        Commons::ScopedReadLock locker(m_dataMutex);
+        synced          = m_graphSynced;
+        syncedTerminals = m_syncedTerminals;
+        syncedRoutes    = m_syncedRoutes;
+        syncedCost      = m_syncedCostParameters;
+    }
+
+    // Terminals to remove; changed terminals are removed
+    // and added again, which drops their routes
+    QStringList   terminalsToRemove;
+    QSet<QString> droppedTerminals;
+    for (auto it = syncedTerminals.constBegin();
+         it != syncedTerminals.constEnd(); ++it)
+    {
+        if (desiredTerminals.value(it.key()) != it.value())
+        {
+            terminalsToRemove.append(it.key());
+            droppedTerminals.insert(it.key());
+        }
+    }
+
+    QJsonArray terminalsToAdd;
+    for (auto it = desiredTerminals.constBegin();
+         it != desiredTerminals.constEnd(); ++it)
+    {
+        if (!syncedTerminals.contains(it.key())
+            || droppedTerminals.contains(it.key()))
+        {
+            terminalsToAdd.append(it.value());
+        }
+    }
+
+    // Routes the server keeps after terminal removal
+    QMap<QString, QJsonObject> keptRoutes;
+    for (auto it = syncedRoutes.constBegin();
+         it != syncedRoutes.constEnd(); ++it)
+    {
+        if (!droppedTerminals.contains(
+                it.value()["start_terminal"].toString())
+            && !droppedTerminals.contains(
+                it.value()["end_terminal"].toString()))
+        {
+            keptRoutes.insert(it.key(), it.value());
+        }
+    }
+
+    // A kept route that is no longer wanted cannot be
+    // removed on its own
+    bool fullSync = !synced;
+    for (auto it = keptRoutes.constBegin();
+         !fullSync && it != keptRoutes.constEnd(); ++it)
+    {
+        fullSync = !desiredRoutes.contains(it.key());
+    }
+
+    QJsonArray         routesToAdd;
+    QList<QJsonObject> routesToReweight;
+    for (auto it = desiredRoutes.constBegin();
+         it != desiredRoutes.constEnd(); ++it)
+    {
+        if (fullSync || !keptRoutes.contains(it.key()))
+        {
+            routesToAdd.append(it.value());
+        }
+        else if (keptRoutes.value(it.key())["attributes"]
+                 != it.value()["attributes"])
+        {
+            routesToReweight.append(it.value());
+        }
+    }
+
+    if (fullSync)
+    {
+        terminalsToRemove.clear();
+        terminalsToAdd = QJsonArray();
+        for (const QJsonObject &terminalJson :
+             desiredTerminals)
+        {
+            terminalsToAdd.append(terminalJson);
+        }
+    }
+
+    qDebug() << "Graph sync:"
+             << (fullSync ? "full upload" : "incremental")
+             << "- terminals removed"
+             << terminalsToRemove.size() << "added"
+             << terminalsToAdd.size() << "- routes added"
+             << routesToAdd.size() << "re-weighted"
+             << routesToReweight.size();
+
+    bool success = executeSerializedCommand([&]() {
+        if (fullSync
+            && !sendCommandAndWait("resetServer",
+                                   QJsonObject(),
+                                   {"serverReset"}))
+        {
+            return false;
+        }
+
+        if (fullSync || desiredCost != syncedCost)
+        {
+            QJsonObject params;
+            params["parameters"] = desiredCost;
+            if (!sendCommandAndWait(
+                    "set_cost_function_parameters", params,
+                    {"costFunctionUpdated"}))
+            {
+                return false;
+            }
+        }
+
+        for (const QString &terminalId : terminalsToRemove)
+        {
+            QJsonObject params;
+            params["terminal_name"] = terminalId;
+            if (!sendCommandAndWait("remove_terminal",
+                                    params,
+                                    {"terminalRemoved"}))
+            {
+                return false;
+            }
+        }
+
+        if (!terminalsToAdd.isEmpty())
+        {
+            QJsonObject params;
+            params["terminals"] = terminalsToAdd;
+            if (!sendCommandAndWait("add_terminals", params,
+                                    {"terminalsAdded"}))
+            {
+                return false;
+            }
+        }
+
+        if (!routesToAdd.isEmpty())
+        {
+            QJsonObject params;
+            params["routes"] = routesToAdd;
+            if (!sendCommandAndWait("add_routes", params,
+                                    {"routesAdded"}))
+            {
+                return false;
+            }
+        }
+
+        for (const QJsonObject &route : routesToReweight)
+        {
+            QJsonObject params;
+            params["start_terminal"] =
+                route["start_terminal"];
+            params["end_terminal"] = route["end_terminal"];
+            params["mode"]         = route["mode"];
+            params["attributes"]   = route["attributes"];
+            if (!sendCommandAndWait("change_route_weight",
+                                    params,
+                                    {"routeAdded"}))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    });
+
+    // Record what the server now holds
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    m_graphSynced = success;
+    if (success)
+    {
+        m_syncedTerminals      = desiredTerminals;
+        m_syncedRoutes         = desiredRoutes;
+        m_syncedCostParameters = desiredCost;
+    }
+    return success;
+}
+
+// Build the shadow key of a route
+QString
+TerminalSimulationClient::routeSyncKey(const QString &start,
+                                       const QString &end,
+                                       int            mode)
+{
+    return start + "|" + end + "|" + QString::number(mode);
+}
+
+// Force the next sync to upload the whole graph
+void TerminalSimulationClient::invalidateGraphShadow()
+{
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    m_graphSynced = false;
+}
+
 // Connect terminals by interface modes
 bool TerminalSimulationClient::
     connectTerminalsByInterfaceModes()
 {
+    invalidateGraphShadow();
+
     // Execute connection command serially
     return executeSerializedCommand([&]() {
         // Send command with no parameters
@@ -460,6 +880,8 @@ bool TerminalSimulationClient::
 bool TerminalSimulationClient::
     connectTerminalsInRegionByMode(const QString &region)
 {
+    invalidateGraphShadow();
+
     // Execute region connection serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for region connection
@@ -476,6 +898,8 @@ bool TerminalSimulationClient::
 bool TerminalSimulationClient::connectRegionsByMode(
     int mode)
 {
+    invalidateGraphShadow();
+
     // Execute mode connection serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for mode connection
@@ -517,6 +941,16 @@ QList<Path *> TerminalSimulationClient::findTopPaths(
     TransportationTypes::TransportationMode mode,
     bool                                    skipDelays)
 {
+    if (m_localEngineEnabled)
+    {
+        QJsonObject result;
+        result["start_terminal"] = start;
+        result["end_terminal"]   = end;
+        result["paths"] = m_localGraph.findTopPaths(
+            start, end, n, mode, skipDelays);
+        return storeTopPaths(result);
+    }
+
     int modeInt = TransportationTypes::toInt(mode);
     // Execute top paths finding serially
     executeSerializedCommand([&]() {
@@ -534,8 +968,16 @@ QList<Path *> TerminalSimulationClient::findTopPaths(
     });
     // Access paths thread-safely
     Commons::ScopedReadLock locker(m_dataMutex);
-    QString                 key = start + "-" + end;
-    return m_topPaths.value(key, QList<Path *>());
+    return m_topPaths.value(topPathsKey(start, end),
+                            QList<Path *>());
+}
+
+// Build the key of a stored top paths result
+QString
+TerminalSimulationClient::topPathsKey(const QString &start,
+                                      const QString &end)
+{
+    return start + "-" + end;
 }
 
 // Add single container
@@ -592,15 +1034,8 @@ bool TerminalSimulationClient::addContainers(
         // Prepare parameters for containers addition
         QJsonObject params;
         params["terminal_id"] = terminalId;
-        QJsonArray containersArray;
-        for (const auto *container : containers)
-        {
-            if (container)
-            {
-                containersArray.append(container->toJson());
-            }
-        }
-        params["containers"] = containersArray;
+        params["containers"] =
+            containersPayload(containers);
         if (addTime >= 0.0)
         {
             params["adding_time"] = addTime;
@@ -720,6 +1155,8 @@ QList<ContainerCore::Container *> TerminalSimulationClient::
             "dequeue_containers_by_next_destination",
             params, {"containersFetched"});
     });
+    // Dequeuing changes the terminal's count
+    invalidateTerminalCache(terminalId);
     // Access dequeued containers thread-safely
     Commons::ScopedReadLock locker(m_dataMutex);
     return m_containers.value(
@@ -730,58 +1167,178 @@ QList<ContainerCore::Container *> TerminalSimulationClient::
 int TerminalSimulationClient::getContainerCount(
     const QString &terminalId)
 {
-    // Execute count fetch serially
-    executeSerializedCommand([&]() {
-        // Prepare parameters for count fetch
-        QJsonObject params;
-        params["terminal_id"] = terminalId;
-        // Send count fetch command
-        return sendCommandAndWait("get_container_count",
-                                  params,
-                                  {"capacityFetched"});
-    });
-    // Access count thread-safely and cast
-    Commons::ScopedReadLock locker(m_dataMutex);
-    double count = m_capacities.value(terminalId, 0.0);
-    return static_cast<int>(count);
+    return static_cast<int>(fetchTerminalQuery(
+        TerminalQuery::ContainerCount, terminalId));
 }
 
 // Get available capacity
 double TerminalSimulationClient::getAvailableCapacity(
     const QString &terminalId)
 {
-    // Execute capacity fetch serially
-    executeSerializedCommand([&]() {
-        // Prepare parameters for capacity fetch
-        QJsonObject params;
-        params["terminal_id"] = terminalId;
-        // Send capacity fetch command
-        return sendCommandAndWait("get_available_capacity",
-                                  params,
-                                  {"capacityFetched"});
-    });
-    // Access capacity thread-safely
-    Commons::ScopedReadLock locker(m_dataMutex);
-    return m_capacities.value(terminalId, 0.0);
+    return fetchTerminalQuery(
+        TerminalQuery::AvailableCapacity, terminalId);
 }
 
 // Get maximum capacity
 double TerminalSimulationClient::getMaxCapacity(
     const QString &terminalId)
 {
-    // Execute max capacity fetch serially
-    executeSerializedCommand([&]() {
-        // Prepare parameters for max capacity fetch
+    return fetchTerminalQuery(TerminalQuery::MaxCapacity,
+                              terminalId);
+}
+
+// Read a cached container count
+bool TerminalSimulationClient::cachedContainerCount(
+    const QString &terminalId, int &count) const
+{
+    Commons::ScopedReadLock locker(m_dataMutex);
+    double                  value = 0.0;
+    if (!lookupTerminalQuery(TerminalQuery::ContainerCount,
+                             terminalId, value))
+    {
+        return false;
+    }
+    count = static_cast<int>(value);
+    return true;
+}
+
+// Read a cached available capacity
+bool TerminalSimulationClient::cachedAvailableCapacity(
+    const QString &terminalId, double &capacity) const
+{
+    Commons::ScopedReadLock locker(m_dataMutex);
+    return lookupTerminalQuery(
+        TerminalQuery::AvailableCapacity, terminalId,
+        capacity);
+}
+
+// Drop cached capacity and count values
+void TerminalSimulationClient::invalidateTerminalCache(
+    const QString &terminalId)
+{
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    bumpCacheGeneration(terminalId);
+}
+
+// Answer a terminal query from the cache or the server
+double TerminalSimulationClient::fetchTerminalQuery(
+    TerminalQuery query, const QString &terminalId)
+{
+    // Serve valid cached values without a round-trip
+    quint64 generation;
+    QString name;
+    {
+        Commons::ScopedReadLock locker(m_dataMutex);
+        double                  value = 0.0;
+        if (lookupTerminalQuery(query, terminalId, value))
+        {
+            return value;
+        }
+        generation = m_cacheGeneration;
+        name       = canonicalTerminalId(terminalId);
+    }
+
+    QString command;
+    switch (query)
+    {
+    case TerminalQuery::ContainerCount:
+        command = "get_container_count";
+        break;
+    case TerminalQuery::AvailableCapacity:
+        command = "get_available_capacity";
+        break;
+    case TerminalQuery::MaxCapacity:
+        command = "get_max_capacity";
+        break;
+    }
+
+    // Execute fetch serially
+    bool fetched = executeSerializedCommand([&]() {
+        // Prepare parameters for the fetch
         QJsonObject params;
-        params["terminal_id"] = terminalId;
-        // Send max capacity fetch command
-        return sendCommandAndWait("get_max_capacity",
-                                  params,
+        params["terminal_id"] = name;
+        // Send fetch command
+        return sendCommandAndWait(command, params,
                                   {"capacityFetched"});
     });
-    // Access max capacity thread-safely
-    Commons::ScopedReadLock locker(m_dataMutex);
-    return m_capacities.value(terminalId, 0.0);
+
+    // Access value thread-safely and remember it with
+    // the generation it was requested at, so an
+    // invalidation racing the fetch wins
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    double value = m_capacities.value(name, 0.0);
+    if (fetched)
+    {
+        m_queryCache[qMakePair(static_cast<int>(query),
+                               name)] = {value, generation};
+    }
+    return value;
+}
+
+// Look up a valid cache entry
+bool TerminalSimulationClient::lookupTerminalQuery(
+    TerminalQuery query, const QString &terminalId,
+    double &value) const
+{
+    const QString name = canonicalTerminalId(terminalId);
+    auto          it   = m_queryCache.constFind(
+        qMakePair(static_cast<int>(query), name));
+    if (it == m_queryCache.constEnd())
+    {
+        return false;
+    }
+
+    // Entries requested before an invalidation are stale
+    if (it->generation < m_cacheEpoch
+        || it->generation
+               < m_terminalGenerations.value(name, 0))
+    {
+        return false;
+    }
+
+    value = it->value;
+    return true;
+}
+
+// Invalidate cached values
+void TerminalSimulationClient::bumpCacheGeneration(
+    const QString &terminalId)
+{
+    ++m_cacheGeneration;
+    if (terminalId.isEmpty())
+    {
+        m_cacheEpoch = m_cacheGeneration;
+        m_queryCache.clear();
+        m_terminalGenerations.clear();
+        return;
+    }
+
+    const QString name = canonicalTerminalId(terminalId);
+    m_terminalGenerations[name] = m_cacheGeneration;
+    for (TerminalQuery query :
+         {TerminalQuery::ContainerCount,
+          TerminalQuery::AvailableCapacity,
+          TerminalQuery::MaxCapacity})
+    {
+        m_queryCache.remove(
+            qMakePair(static_cast<int>(query), name));
+    }
+}
+
+// Map an alias to its terminal's name
+QString TerminalSimulationClient::canonicalTerminalId(
+    const QString &terminalId) const
+{
+    if (m_localEngineEnabled)
+    {
+        QString name =
+            m_localGraph.canonicalName(terminalId);
+        if (!name.isEmpty())
+        {
+            return name;
+        }
+    }
+    return m_aliasNames.value(terminalId, terminalId);
 }
 
 // Clear terminal containers
@@ -819,6 +1376,8 @@ QJsonObject TerminalSimulationClient::serializeGraph()
 bool TerminalSimulationClient::deserializeGraph(
     const QJsonObject &graphData)
 {
+    invalidateGraphShadow();
+
     // Execute deserialize command serially
     return executeSerializedCommand([&]() {
         // Prepare parameters for deserialize
@@ -953,28 +1512,7 @@ void TerminalSimulationClient::onTerminalAdded(
     QJsonObject result = message["result"].toObject();
     QString     name   = result["terminal_name"].toString();
     Commons::ScopedWriteLock locker(m_dataMutex);
-    Terminal                *existing =
-        m_terminalStatus.value(name, nullptr);
-    if (existing)
-    {
-        delete existing;
-    }
-    Terminal *terminal = Terminal::fromJson(result);
-    terminal->setParent(this);
-
-    m_terminalStatus[name] = terminal;
-
-    // Update aliases if present
-    if (result.contains("aliases"))
-    {
-        QJsonArray  aliases = result["aliases"].toArray();
-        QStringList aliasList;
-        for (const QJsonValue &val : aliases)
-        {
-            aliasList.append(val.toString());
-        }
-        m_terminalAliases[name] = aliasList;
-    }
+    storeTerminalStatus(result);
     qDebug() << "Terminal added:" << name;
 }
 
@@ -990,38 +1528,60 @@ void TerminalSimulationClient::onTerminalsAdded(
     // Process each terminal in the array
     for (const QJsonValue &terminalValue : terminalsArray)
     {
-        QJsonObject terminalJson = terminalValue.toObject();
-        QString     name =
-            terminalJson["terminal_name"].toString();
+        storeTerminalStatus(terminalValue.toObject());
+    }
+}
 
-        // Clean up existing terminal if present
-        Terminal *existing =
-            m_terminalStatus.value(name, nullptr);
-        if (existing)
-        {
-            delete existing;
-        }
+// Store one terminal's status
+void TerminalSimulationClient::storeTerminalStatus(
+    const QJsonObject &terminalJson)
+{
+    QString name = terminalJson["terminal_name"].toString();
 
-        // Create new terminal from JSON
-        Terminal *terminal =
-            Terminal::fromJson(terminalJson);
-        terminal->setParent(this);
+    // Create terminal from JSON
+    Terminal *terminal = Terminal::fromJson(terminalJson);
+    if (!terminal)
+    {
+        return;
+    }
 
-        // Store in map
+    // Refresh a known terminal in place; paths point to it
+    Terminal *existing =
+        m_terminalStatus.value(name, nullptr);
+    if (existing)
+    {
+        existing->updateFrom(*terminal);
+        delete terminal;
+    }
+    else
+    {
+        terminal->setParent(this);
         m_terminalStatus[name] = terminal;
+    }
+
+    // A refreshed terminal may have a new capacity
+    bumpCacheGeneration(name);
 
-        // Update aliases if present
-        if (terminalJson.contains("aliases"))
+    // Update aliases if present
+    if (terminalJson.contains("aliases"))
+    {
+        QJsonArray aliases =
+            terminalJson["aliases"].toArray();
+        QStringList aliasList;
+        for (const QJsonValue &val : aliases)
         {
-            QJsonArray aliases =
-                terminalJson["aliases"].toArray();
-            QStringList aliasList;
-            for (const QJsonValue &val : aliases)
-            {
-                aliasList.append(val.toString());
-            }
-            m_terminalAliases[name] = aliasList;
+            aliasList.append(val.toString());
+        }
+        for (const QString &alias :
+             m_terminalAliases.value(name))
+        {
+            m_aliasNames.remove(alias);
         }
+        for (const QString &alias : aliasList)
+        {
+            m_aliasNames[alias] = name;
+        }
+        m_terminalAliases[name] = aliasList;
     }
 }
 
@@ -1067,28 +1627,35 @@ void TerminalSimulationClient::onRoutesAdded(
 void TerminalSimulationClient::onPathsFound(
     const QJsonObject &message)
 {
-    // Extract result and parameters from message
-    QJsonObject result = message["result"].toObject();
-    QString     start = result["start_terminal"].toString();
-    QString     end   = result["end_terminal"].toString();
-    QJsonArray  paths = result["paths"].toArray();
-    QString     key   = start + "-" + end;
+    // Store the paths of the single OD pair
+    storeTopPaths(message["result"].toObject());
+}
 
-    // Lock mutex for thread-safe update
-    Commons::ScopedWriteLock locker(m_dataMutex);
+// Store the top paths of one OD pair
+QList<Path *> TerminalSimulationClient::storeTopPaths(
+    const QJsonObject &result)
+{
+    // Extract parameters from the result
+    QString    start = result["start_terminal"].toString();
+    QString    end   = result["end_terminal"].toString();
+    QJsonArray paths = result["paths"].toArray();
+    QString    key   = topPathsKey(start, end);
 
-    // Clean up old top paths
-    QList<Path *> oldPaths = m_topPaths.value(key);
-    for (Path *oldPath : oldPaths)
+    QList<Path *> stored;
     {
-        delete oldPath;
-    }
-    m_topPaths[key]
-        .clear(); // Clear the list after deleting
+        // Lock mutex for thread-safe update
+        Commons::ScopedWriteLock locker(m_dataMutex);
 
-    // Handle top paths
-    if (paths.size() > 0)
-    {
+        // Clean up old top paths
+        QList<Path *> oldPaths = m_topPaths.value(key);
+        for (Path *oldPath : oldPaths)
+        {
+            delete oldPath;
+        }
+        m_topPaths[key]
+            .clear(); // Clear the list after deleting
+
+        // Handle top paths
         for (const QJsonValue &pathVal : paths)
         {
             QJsonObject pathObj = pathVal.toObject();
@@ -1096,10 +1663,34 @@ void TerminalSimulationClient::onPathsFound(
                 pathObj, m_terminalStatus, this);
             m_topPaths[key].push_back(path);
         }
+        stored = m_topPaths.value(key);
     }
 
     // Log event for auditing
     qDebug() << "Path found from" << start << "to" << end;
+
+    // Stream the result to listeners outside the lock
+    emit pathsFound(start, end, paths);
+
+    return stored;
+}
+
+// Mirror local terminals into the status map
+void TerminalSimulationClient::mirrorLocalTerminals(
+    const QStringList &terminalIds)
+{
+    QJsonArray terminalsArray;
+    for (const QString &terminalId : terminalIds)
+    {
+        QJsonObject terminalJson =
+            m_localGraph.terminalJson(terminalId);
+        if (!terminalJson.isEmpty())
+        {
+            terminalsArray.append(terminalJson);
+        }
+    }
+    onTerminalsAdded(
+        QJsonObject{{"result", terminalsArray}});
 }
 
 // Handle containers added event
@@ -1113,6 +1704,9 @@ void TerminalSimulationClient::onContainersAdded(
     // Lock mutex for thread-safe update
     Commons::ScopedWriteLock locker(m_dataMutex);
 
+    // Counts and capacities of the terminal changed
+    bumpCacheGeneration(terminalId);
+
     // Log event for auditing
     qDebug() << "Containers added to terminal:"
              << terminalId;
@@ -1132,6 +1726,7 @@ void TerminalSimulationClient::onServerReset(
     }
     m_terminalStatus.clear();
     m_terminalAliases.clear();
+    m_aliasNames.clear();
 
     // Clean up all shortest path segments
     for (const QList<PathSegment *> &segments :
@@ -1172,6 +1767,15 @@ void TerminalSimulationClient::onServerReset(
     m_pingResponse    = QJsonObject();
     m_terminalCount   = 0;
 
+    // The server graph is empty, the shadow is stale
+    m_syncedTerminals.clear();
+    m_syncedRoutes.clear();
+    m_syncedCostParameters = QJsonObject();
+    m_graphSynced          = false;
+
+    // Every cached value predates the reset
+    bumpCacheGeneration(QString());
+
     // Log event for auditing
     qDebug() << "Server reset successfully";
 }
@@ -1198,6 +1802,10 @@ void TerminalSimulationClient::onTerminalRemoved(
     // Lock mutex for thread-safe update
     Commons::ScopedWriteLock locker(m_dataMutex);
 
+    // The removal may have named the terminal by an alias
+    terminalId = canonicalTerminalId(terminalId);
+    bumpCacheGeneration(terminalId);
+
     // Remove and delete terminal if exists
     Terminal *terminal = m_terminalStatus.take(terminalId);
     if (terminal)
@@ -1205,7 +1813,11 @@ void TerminalSimulationClient::onTerminalRemoved(
         delete terminal;
     }
 
-    m_terminalAliases.remove(terminalId);
+    for (const QString &alias :
+         m_terminalAliases.take(terminalId))
+    {
+        m_aliasNames.remove(alias);
+    }
 
     // Log event for auditing
     qDebug() << "Terminal removed:" << terminalId;
@@ -1230,8 +1842,10 @@ void TerminalSimulationClient::onTerminalCount(
 void TerminalSimulationClient::onContainersFetched(
     const QJsonObject &message)
 {
-    // Extract containers and parameters
-    QJsonArray  containers = message["result"].toArray();
+    // Extract containers and parameters; the result may
+    // be a plain array or a columnar batch
+    QJsonArray containers =
+        ContainerBatchCodec::decodeJson(message["result"]);
     QJsonObject params     = message["params"].toObject();
     QString terminalId = params["terminal_id"].toString();
 
@@ -1283,7 +1897,8 @@ void TerminalSimulationClient::onCapacityFetched(
     Commons::ScopedWriteLock locker(m_dataMutex);
 
     // Store capacity in map
-    m_capacities[terminalId] = capacity;
+    m_capacities[canonicalTerminalId(terminalId)] =
+        capacity;
 
     // Log event for tracking
     qDebug() << "Capacity fetched for:" << terminalId;
@@ -18,17 +18,21 @@
  */
 
 #include "Backend/Clients/BaseClient/SimulationClientBase.h"
+#include "Backend/Clients/TerminalClient/LocalTerminalGraph.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
 #include "Backend/Models/Path.h"
 #include "Backend/Models/PathSegment.h"
 #include "Backend/Models/Terminal.h"
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QPair>
 #include <QReadWriteLock>
 #include <QString>
+#include <atomic>
 #include <containerLib/container.h>
 
 namespace CargoNetSim
@@ -84,6 +88,24 @@ public:
      */
     ~TerminalSimulationClient() override;
 
+    /**
+     * @brief Selects the embedded local path engine
+     * @param enabled True to answer graph commands locally
+     *
+     * When enabled, terminal, route and path commands are
+     * answered by an in-process LocalTerminalGraph instead
+     * of the TerminalSim server, so path finding works
+     * without a message broker. Container and capacity
+     * commands still require the server.
+     */
+    void setLocalEngineEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether the local path engine is used
+     * @return True if graph commands are answered locally
+     */
+    bool isLocalEngineEnabled() const;
+
     /**
      * @brief Resets the server to initial state
      * @return True if reset succeeds, else false
@@ -181,9 +203,10 @@ public:
 
     /**
      * @brief Gets status of a terminal
-     * @param terminalId Terminal identifier
+     * @param terminalId Terminal name or alias
      * @return Terminal pointer, nullptr if not found
-     * @note Caller must delete the returned pointer
+     * @note The terminal stays owned by the client; later
+     * calls refresh it in place
      *
      * Fetches and returns terminal status as an object.
      */
@@ -223,6 +246,28 @@ public:
                       const QString &end, int mode,
                       const QJsonObject &attributes);
 
+    /**
+     * @brief Brings the server graph to the given state
+     * @param terminals Terminals the graph should hold
+     * @param routes Routes the graph should hold
+     * @param costParameters Cost function parameters
+     * @return True if the server graph matches afterwards
+     *
+     * Compares the request with a shadow of what was last
+     * synchronized and sends only the differences: removed
+     * and changed terminals are removed, new and changed
+     * terminals and their routes are added, and routes
+     * whose attributes changed are re-weighted. Falls back
+     * to a reset and full upload on the first call, after
+     * any direct graph mutation, after a server reset, or
+     * when a route must be removed, since the server has
+     * no route removal command.
+     */
+    Q_INVOKABLE bool
+    syncGraph(const QList<Terminal *>    &terminals,
+              const QList<PathSegment *> &routes,
+              const QVariantMap          &costParameters);
+
     // Auto-connection
     /**
      * @brief Connects terminals by interface modes
@@ -283,6 +328,15 @@ public:
         TransportationTypes::TransportationMode mode,
         bool skipDelays = true);
 
+    /**
+     * @brief Builds the key used to store top paths
+     * @param start Starting terminal ID
+     * @param end Ending terminal ID
+     * @return Key in the form "start-end"
+     */
+    static QString topPathsKey(const QString &start,
+                               const QString &end);
+
     // Container Management
     /**
      * @brief Adds a container to a terminal
@@ -427,6 +481,35 @@ public:
     Q_INVOKABLE double
     getMaxCapacity(const QString &terminalId);
 
+    /**
+     * @brief Reads a cached container count
+     * @param terminalId Terminal identifier
+     * @param count Receives the count on a hit
+     * @return True if a valid cached value exists
+     *
+     * Thread-safe and never contacts the server; callers on
+     * other threads can use it before a blocking query.
+     */
+    bool cachedContainerCount(const QString &terminalId,
+                              int           &count) const;
+
+    /**
+     * @brief Reads a cached available capacity
+     * @param terminalId Terminal identifier
+     * @param capacity Receives the capacity on a hit
+     * @return True if a valid cached value exists
+     */
+    bool
+    cachedAvailableCapacity(const QString &terminalId,
+                            double        &capacity) const;
+
+    /**
+     * @brief Drops cached capacity and count values
+     * @param terminalId Terminal identifier, empty for all
+     */
+    void invalidateTerminalCache(
+        const QString &terminalId = QString());
+
     /**
      * @brief Clears containers from a terminal
      * @param terminalId Terminal identifier
@@ -465,6 +548,23 @@ public:
      */
     Q_INVOKABLE QJsonObject ping(const QString &echo = "");
 
+signals:
+    /**
+     * @brief Emitted when paths for an OD pair arrive
+     * @param start Starting terminal ID
+     * @param end Ending terminal ID
+     * @param paths Path records as sent by the server
+     *
+     * Emitted for every top-path query as soon as the
+     * pair's result is stored. The paths are passed by
+     * value because the stored Path objects are replaced
+     * by the pair's next result; receivers rebuild them
+     * with Path::fromJson().
+     */
+    void pathsFound(const QString    &start,
+                    const QString    &end,
+                    const QJsonArray &paths);
+
 protected:
     /**
      * @brief Processes incoming server messages
@@ -506,6 +606,118 @@ private:
      */
     void onPathsFound(const QJsonObject &message);
 
+    /**
+     * @brief Stores the top paths of one OD pair result
+     * @param result Path result object from the server
+     * @return Paths stored for the pair
+     *
+     * Replaces any paths previously stored for the pair
+     * and emits pathsFound() once the lock is released.
+     */
+    QList<Path *> storeTopPaths(const QJsonObject &result);
+
+    /**
+     * @brief Terminal values answered from the query cache
+     */
+    enum class TerminalQuery
+    {
+        ContainerCount,
+        AvailableCapacity,
+        MaxCapacity
+    };
+
+    /**
+     * @brief Cached query value and the cache generation it
+     * was requested at
+     */
+    struct CachedQueryValue
+    {
+        double  value      = 0.0;
+        quint64 generation = 0;
+    };
+
+    /**
+     * @brief Answers a terminal query from the cache or the
+     * server
+     * @param query Value to fetch
+     * @param terminalId Terminal identifier
+     * @return Cached or freshly fetched value
+     */
+    double fetchTerminalQuery(TerminalQuery  query,
+                              const QString &terminalId);
+
+    /**
+     * @brief Looks up a valid cache entry; lock held
+     * @param query Value to look up
+     * @param terminalId Terminal identifier
+     * @param value Receives the value on a hit
+     * @return True on a hit
+     */
+    bool lookupTerminalQuery(TerminalQuery  query,
+                             const QString &terminalId,
+                             double        &value) const;
+
+    /**
+     * @brief Invalidates cached values; lock held
+     * @param terminalId Terminal identifier, empty for all
+     */
+    void bumpCacheGeneration(const QString &terminalId);
+
+    /**
+     * @brief Maps an alias to its terminal's name; lock
+     * held
+     * @param terminalId Terminal name or alias
+     * @return The terminal name, or terminalId if unknown
+     */
+    QString
+    canonicalTerminalId(const QString &terminalId) const;
+
+    /**
+     * @brief Stores a terminal's status; lock held
+     * @param terminalJson Terminal JSON from an event
+     *
+     * A known terminal is updated in place rather than
+     * replaced, since paths hold pointers to it.
+     */
+    void
+    storeTerminalStatus(const QJsonObject &terminalJson);
+
+    /**
+     * @brief Mirrors local terminals into the status map
+     * @param terminalIds Terminal names or aliases
+     *
+     * Feeds the local graph's terminal JSON through
+     * onTerminalsAdded() so paths resolve their terminals
+     * exactly as with server results. Called only when the
+     * local graph changes.
+     */
+    void
+    mirrorLocalTerminals(const QStringList &terminalIds);
+
+    /**
+     * @brief Fills missing cost function parameters
+     * @param parameters Cost parameters as a QVariantMap
+     * @return Parameters with every mode and attribute set
+     */
+    static QVariantMap completeCostFunctionParameters(
+        const QVariantMap &parameters);
+
+    /**
+     * @brief Builds the shadow key of a route
+     * @param start Starting terminal ID
+     * @param end Ending terminal ID
+     * @param mode Transportation mode as integer
+     * @return Key identifying the route on the server
+     */
+    static QString routeSyncKey(const QString &start,
+                                const QString &end,
+                                int            mode);
+
+    /**
+     * @brief Forces the next syncGraph() to fully resync
+     */
+    void invalidateGraphShadow();
+
     /**
      * @brief Handles containers added event
      * @param message Event data from server
@@ -561,6 +773,8 @@ private:
      * improving performance for read-heavy workloads.
      */
     mutable QReadWriteLock m_dataMutex;
+    Commons::LockName      m_dataMutexName{
+        &m_dataMutex, "TerminalClient.data"};
 
     /**
      * @brief Map of terminal IDs to Terminal pointers
@@ -572,6 +786,12 @@ private:
      */
     QMap<QString, QStringList> m_terminalAliases;
 
+    /**
+     * @brief Terminal names by alias, so that cache keys
+     * do not depend on how a terminal is referred to
+     */
+    QHash<QString, QString> m_aliasNames;
+
     /**
      * @brief Map of path keys to PathSegment lists
      */
@@ -607,6 +827,59 @@ private:
      * @brief Current count of terminals
      */
     int m_terminalCount = 0;
+
+    /**
+     * @brief Cached terminal query values by query and
+     * terminal
+     */
+    QHash<QPair<int, QString>, CachedQueryValue>
+        m_queryCache;
+
+    /**
+     * @brief Generation at which each terminal was last
+     * invalidated
+     */
+    QHash<QString, quint64> m_terminalGenerations;
+
+    /**
+     * @brief Generation of the last global invalidation
+     */
+    quint64 m_cacheEpoch = 0;
+
+    /**
+     * @brief Counter advanced by every invalidation
+     */
+    quint64 m_cacheGeneration = 0;
+
+    /**
+     * @brief Terminal JSON last synchronized, by name
+     */
+    QMap<QString, QJsonObject> m_syncedTerminals;
+
+    /**
+     * @brief Route JSON last synchronized, by route key
+     */
+    QMap<QString, QJsonObject> m_syncedRoutes;
+
+    /**
+     * @brief Cost parameters last synchronized
+     */
+    QJsonObject m_syncedCostParameters;
+
+    /**
+     * @brief Whether the shadow matches the server graph
+     */
+    bool m_graphSynced = false;
+
+    /**
+     * @brief Embedded graph used by the local engine
+     */
+    LocalTerminalGraph m_localGraph;
+
+    /**
+     * @brief Whether graph commands are answered locally
+     */
+    std::atomic<bool> m_localEngineEnabled{false};
 };
 
 } // namespace Backend
@@ -36,6 +36,7 @@ TrainSimulationClient::TrainSimulationClient(
           "CargoNetSim.Command.NeTrainSim",
           QStringList{"CargoNetSim.Response.NeTrainSim"},
           ClientType::TrainClient)
+    , m_containerManager(new ContainerManager(this))
 {
     // Initialize progress bar (placeholder)
     // ProgressBarManager::getInstance()->addProgressBar(
@@ -399,22 +400,13 @@ bool TrainSimulationClient::addContainersToTrain(
     const QString &networkName, const QString &trainId,
     const QList<ContainerCore::Container *> &containers)
 {
-    return executeSerializedCommand([&]() {
-        // Prepare containers array for JSON
-        QJsonArray containersArray;
-        for (const auto *container : containers)
-        {
-            if (container)
-            {
-                containersArray.append(container->toJson());
-            }
-        }
-
+    bool added = executeSerializedCommand([&]() {
         // Build command parameters
         QJsonObject params;
         params["networkName"] = networkName;
         params["trainID"]     = trainId;
-        params["containers"]  = containersArray;
+        params["containers"] =
+            containersPayload(containers);
 
         // Send command and wait for response
         bool success = sendCommandAndWait(
@@ -440,13 +432,32 @@ bool TrainSimulationClient::addContainersToTrain(
         }
         return success;
     });
+
+    if (added)
+    {
+        // Signals are emitted after the lock is released
+        ContainerManager::PendingSignals pending;
+        {
+            Commons::ScopedWriteLock locker(
+                m_dataAccessMutex);
+            m_containerManager->beginBatch();
+            m_containerManager->assignContainersToVehicle(
+                QString("Train_%1").arg(trainId),
+                containers);
+            pending =
+                m_containerManager->endBatchDeferred();
+        }
+        m_containerManager->emitSignals(pending);
+    }
+    return added;
 }
 
 bool TrainSimulationClient::unloadTrain(
     const QString &networkName, const QString &trainId,
     const QStringList &containersDestinationNames)
 {
-    // Execute in a serialized command block
+    // The containers leave the train in
+    // onContainersUnloaded()
     return executeSerializedCommand([&]() {
         // Build command parameters
         QJsonObject params{
@@ -522,12 +533,11 @@ const TrainState *TrainSimulationClient::getTrainState(
         return nullptr;
     }
 
-    for (const auto *state : m_trainState[networkName])
+    const TrainState *state =
+        m_trainState[networkName].value(trainId, nullptr);
+    if (state)
     {
-        if (state && state->getTrainUserId() == trainId)
-        {
-            return state;
-        }
+        return state;
     }
 
     if (m_logger)
@@ -729,37 +739,70 @@ void TrainSimulationClient::onTrainReachedDestination(
     QList<std::tuple<QString, QString, QStringList>>
         unloadTasks;
 
+    // Parse the reports before taking the lock
+    QList<QPair<QString, TrainStatePointer>> received;
+    QJsonObject trainStatus = message["state"].toObject();
+    for (auto it = trainStatus.begin();
+         it != trainStatus.end(); ++it)
+    {
+        QJsonObject data = it.value()
+                               .toObject()["trainState"]
+                               .toObject();
+        received.append(qMakePair(
+            it.key(),
+            TrainStatePointer(new TrainState(data))));
+    }
+
+    const bool recording = stateRecorder() != nullptr;
+
     // First phase - process data with lock
     {
         Commons::ScopedWriteLock locker(m_dataAccessMutex);
 
-        QJsonObject trainStatus =
-            message["state"].toObject();
-
-        for (auto it = trainStatus.begin();
-             it != trainStatus.end(); ++it)
+        for (const auto &entry : received)
         {
-            QString network = it.key();
-
-            if (!m_trainState.contains(network))
+            const QString    &network = entry.first;
+            const TrainState &report  = *entry.second;
+
+            // Overwrite a previous report of the train in
+            // place so handed-out pointers stay valid
+            TrainState *&state =
+                m_trainState[network]
+                            [report.getTrainUserId()];
+            if (state)
             {
-                m_trainState[network] =
-                    QList<TrainState *>();
+                *state = report;
+            }
+            else
+            {
+                state = new TrainState(report);
             }
-
-            QJsonObject data = it.value()
-                                   .toObject()["trainState"]
-                                   .toObject();
-
-            TrainState *state = new TrainState(data);
-            m_trainState[network].append(state);
             trainIds.append(state->getTrainUserId());
 
+            if (recording)
+            {
+                VehicleStateRecorder::Sample sample;
+                sample.time =
+                    m_simulationTime
+                        ? m_simulationTime->getCurrentTime()
+                        : state->getTripTime();
+                sample.distance =
+                    state->getTravelledDistance();
+                sample.speed = state->getCurrentSpeed();
+                sample.energy =
+                    state->getTotalEnergyConsumed();
+                sample.emissions =
+                    state->getTotalCarbonDioxideEmitted();
+                sample.containers =
+                    state->getContainersCount();
+                recordVehicleState(network,
+                                   state->getTrainUserId(),
+                                   sample);
+            }
+
             // Instead of unloading here, collect tasks for
             // later execution
-            int containersCount =
-                data["containersCount"].toInt();
-            if (containersCount > 0
+            if (state->getContainersCount() > 0
                 && m_loadedTrains.contains(
                     state->getTrainUserId()))
             {
@@ -775,6 +818,8 @@ void TrainSimulationClient::onTrainReachedDestination(
         }
     }
 
+    publishTrainStates(received);
+
     // Second phase - process unload tasks without holding
     // the lock
     for (const auto &task : unloadTasks)
@@ -865,6 +910,49 @@ void TrainSimulationClient::onTrainsAddedToSimulator(
     }
 }
 
+void TrainSimulationClient::publishTrainStates(
+    const QList<QPair<QString, TrainStatePointer>> &states)
+{
+    if (states.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_publishMutex);
+    for (const auto &entry : states)
+    {
+        m_trainGeneration[entry.first].insert(
+            entry.second->getTrainUserId(), entry.second);
+    }
+
+    if (!m_flushScheduled)
+    {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(
+            this, &TrainSimulationClient::flushTrainStates,
+            Qt::QueuedConnection);
+    }
+}
+
+void TrainSimulationClient::flushTrainStates()
+{
+    QMutexLocker locker(&m_publishMutex);
+    m_flushScheduled = false;
+    m_trainSnapshots.publish(m_trainGeneration);
+}
+
+TrainSimulationClient::TrainStatesSnapshot
+TrainSimulationClient::getTrainStatesSnapshot() const
+{
+    return m_trainSnapshots.load();
+}
+
+ContainerManager *
+TrainSimulationClient::getContainerManager() const
+{
+    return m_containerManager;
+}
+
 void TrainSimulationClient::onErrorOccurred(
     const QJsonObject &message)
 {
@@ -885,26 +973,43 @@ void TrainSimulationClient::onErrorOccurred(
 
 void TrainSimulationClient::onServerReset()
 {
-    // Lock mutex for safe data access
-    Commons::ScopedWriteLock locker(m_dataAccessMutex);
-
-    // Clean up simulation results
-    for (auto &results : m_networkData)
+    // Signals are emitted after the lock is released
+    ContainerManager::PendingSignals pending;
     {
-        delete results;
-    }
-    m_networkData.clear();
+        // Lock mutex for safe data access
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
 
-    // Clean up train states
-    for (auto &states : m_trainState)
-    {
-        qDeleteAll(states);
-    }
-    m_trainState.clear();
+        // Clean up simulation results
+        for (auto &results : m_networkData)
+        {
+            delete results;
+        }
+        m_networkData.clear();
 
-    // Clean up loaded trains
-    qDeleteAll(m_loadedTrains);
-    m_loadedTrains.clear();
+        // Clean up train states
+        for (auto &states : m_trainState)
+        {
+            qDeleteAll(states);
+        }
+        m_trainState.clear();
+
+        // Readers still holding the old generation keep it
+        {
+            QMutexLocker publishLocker(&m_publishMutex);
+            m_trainGeneration.clear();
+            m_trainSnapshots.publish(m_trainGeneration);
+        }
+
+        // Clean up loaded trains
+        qDeleteAll(m_loadedTrains);
+        m_loadedTrains.clear();
+
+        // The trains and their containers are gone
+        m_containerManager->beginBatch();
+        m_containerManager->clear();
+        pending = m_containerManager->endBatchDeferred();
+    }
+    m_containerManager->emitSignals(pending);
 
     // Log event using logger if available
     if (m_logger)
@@ -1073,7 +1178,8 @@ void TrainSimulationClient::onContainersUnloaded(
     // Extract terminal and container data
     QString terminalId = message["terminalID"].toString();
     QString networkName = message["networkName"].toString();
-    QJsonArray containers = message["containers"].toArray();
+    QJsonArray containers = ContainerBatchCodec::decodeJson(
+        message["containers"]);
 
     // Wrap containers in a JSON object
     QJsonObject   containersObj{{"containers", containers}};
@@ -1094,6 +1200,27 @@ void TrainSimulationClient::onContainersUnloaded(
             fullTerminalID, containersJson, currentTime);
     }
 
+    // Exactly the containers the server unloaded
+    QStringList containerIds;
+    const QList<ContainerCore::Container *> unloaded =
+        ContainerBatchCodec::decode(message["containers"]);
+    for (const auto *container : unloaded)
+    {
+        containerIds.append(container->getContainerID());
+    }
+    qDeleteAll(unloaded);
+
+    // Signals are emitted after the lock is released
+    ContainerManager::PendingSignals pending;
+    {
+        Commons::ScopedWriteLock locker(m_dataAccessMutex);
+        m_containerManager->beginBatch();
+        m_containerManager->removeContainersById(
+            containerIds);
+        pending = m_containerManager->endBatchDeferred();
+    }
+    m_containerManager->emitSignals(pending);
+
     // Log event using logger if available
     if (m_logger)
     {
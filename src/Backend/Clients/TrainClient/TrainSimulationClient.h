@@ -13,19 +13,24 @@
 
 #pragma once
 
+#include "Backend/Clients/BaseClient/ContainerManager.h"
 #include "Backend/Clients/BaseClient/SimulationClientBase.h"
 #include "Backend/Commons/ClientType.h"
+#include "Backend/Commons/SnapshotPublisher.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
 #include "Backend/Models/TrainSystem.h"
 #include "SimulationResults.h"
 #include "TrainState.h"
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
 #include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QPair>
 #include <QReadWriteLock>
+#include <QSharedPointer>
 #include <QString>
 #include <containerLib/container.h>
 
@@ -63,6 +68,11 @@ class NeTrainSimNetwork;
  * properly protected
  * - Prevents potential deadlocks through timeout mechanisms
  *
+ * The train server reports a train's state only when it
+ * reaches its destination, so a state recorder set on
+ * this client gets one sample per arrival, without
+ * coordinates, rather than a per-tick trajectory.
+ *
  * @ingroup TrainSimulation
  */
 class TrainSimulationClient : public SimulationClientBase
@@ -70,6 +80,24 @@ class TrainSimulationClient : public SimulationClientBase
     Q_OBJECT
 
 public:
+    /**
+     * @brief Shared, immutable state of one train
+     */
+    using TrainStatePointer =
+        QSharedPointer<const TrainState>;
+
+    /**
+     * @brief Train states by network name and train ID
+     */
+    using TrainStates =
+        QMap<QString, QHash<QString, TrainStatePointer>>;
+
+    /**
+     * @brief Immutable, shared generation of train states
+     */
+    using TrainStatesSnapshot =
+        Commons::SnapshotPublisher<TrainStates>::Snapshot;
+
     /**
      * @brief Constructs a TrainSimulationClient instance
      *
@@ -273,6 +301,30 @@ public:
     QMap<QString, QList<const TrainState *>>
     getAllTrainsStates() const;
 
+    /**
+     * @brief Retrieves the latest published train states
+     *
+     * Reports received during one pass of the client's
+     * event loop are published together once the pass
+     * ends. Does not take the data lock; the snapshot does
+     * not change while it is held.
+     *
+     * @return Snapshot of all networks, never null
+     */
+    TrainStatesSnapshot getTrainStatesSnapshot() const;
+
+    /**
+     * @brief Gets the containers carried by each train
+     *
+     * Trains are keyed "Train_<trainId>". Containers are
+     * assigned when added to a train and removed when
+     * unloaded at one of their next destinations. Use from
+     * the client's thread only.
+     *
+     * @return Container manager owned by the client
+     */
+    ContainerManager *getContainerManager() const;
+
 protected:
     /**
      * @brief Processes messages from the server
@@ -287,6 +339,24 @@ protected:
     processMessage(const QJsonObject &message) override;
 
 private:
+    /**
+     * @brief Stages updated states for the next generation
+     *
+     * The generation is published by flushTrainStates(),
+     * queued once per event-loop pass. Takes only
+     * m_publishMutex, which readers never touch.
+     *
+     * @param states Updated states with their networks
+     */
+    void publishTrainStates(
+        const QList<QPair<QString, TrainStatePointer>>
+            &states);
+
+    /**
+     * @brief Publishes the staged states as one generation
+     */
+    void flushTrainStates();
+
     /**
      * @brief Internal method to unload containers from a
      * train
@@ -379,7 +449,8 @@ private:
     /**
      * @brief Handles server reset event
      *
-     * Processes the event when the server is reset.
+     * Processes the event when the server is reset and
+     * clears the trains and the containers on board.
      */
     void onServerReset();
 
@@ -444,7 +515,8 @@ private:
      * @brief Handles containers unloaded event
      *
      * Processes the event when containers are unloaded from
-     * a train.
+     * a train. The containers listed in the event are
+     * removed from the container manager.
      *
      * @param message Event data in JSON format
      */
@@ -465,6 +537,8 @@ private:
      * improving performance for read-heavy workloads.
      */
     mutable QReadWriteLock m_dataAccessMutex;
+    Commons::LockName      m_dataAccessMutexName{
+        &m_dataAccessMutex, "TrainClient.data"};
 
     /**
      * @var m_networkData
@@ -478,9 +552,11 @@ private:
      * @var m_trainState
      * @brief Stores train states by network
      *
-     * Maps network names to lists of TrainState pointers.
+     * Maps network names to TrainState pointers keyed by
+     * train ID.
      */
-    QMap<QString, QList<TrainState *>> m_trainState;
+    QMap<QString, QHash<QString, TrainState *>>
+        m_trainState;
 
     /**
      * @var m_loadedTrains
@@ -489,6 +565,43 @@ private:
      * Maps train IDs to Train pointers for the simulation.
      */
     QMap<QString, Backend::Train *> m_loadedTrains;
+
+    /**
+     * @var m_trainGeneration
+     * @brief Working copy of the next published generation
+     *
+     * Protected by m_publishMutex.
+     */
+    TrainStates m_trainGeneration;
+
+    /**
+     * @var m_trainSnapshots
+     * @brief Published generations of train states
+     */
+    Commons::SnapshotPublisher<TrainStates>
+        m_trainSnapshots;
+
+    /**
+     * @var m_publishMutex
+     * @brief Serializes publishers of m_trainSnapshots
+     */
+    QMutex m_publishMutex;
+
+    /**
+     * @var m_flushScheduled
+     * @brief Whether flushTrainStates() is queued
+     *
+     * Protected by m_publishMutex.
+     */
+    bool m_flushScheduled = false;
+
+    /**
+     * @var m_containerManager
+     * @brief Containers on board of each train
+     *
+     * Protected by m_dataAccessMutex.
+     */
+    ContainerManager *m_containerManager;
 };
 
 } // namespace TrainClient
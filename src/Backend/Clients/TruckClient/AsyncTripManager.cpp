@@ -6,6 +6,9 @@
  */
 
 #include "AsyncTripManager.h"
+#include <QDebug>
+#include <QMetaObject>
+#include <utility>
 
 namespace CargoNetSim
 {
@@ -16,73 +19,153 @@ namespace TruckClient
 
 AsyncTripManager::AsyncTripManager(QObject *parent)
     : QObject(parent)
+    , m_timeoutTimer(new QTimer(this))
 {
+    m_clock.start();
+
+    // Timeouts are checked once per second while enabled
+    m_timeoutTimer->setInterval(1000);
+    connect(m_timeoutTimer, &QTimer::timeout, this,
+            &AsyncTripManager::expireTrips);
+}
+
+void AsyncTripManager::setLauncher(TripLauncher launcher)
+{
+    QMutexLocker locker(&m_mutex);
+    m_launcher = std::move(launcher);
+}
+
+void AsyncTripManager::setCanceller(
+    TripCanceller canceller)
+{
+    QMutexLocker locker(&m_mutex);
+    m_canceller = std::move(canceller);
+}
+
+void AsyncTripManager::setMaxInFlight(int maxTrips)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_maxInFlight = qMax(0, maxTrips);
+    }
+    dispatch();
+}
+
+int AsyncTripManager::maxInFlight() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxInFlight;
+}
+
+void AsyncTripManager::setTripTimeout(int seconds)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_tripTimeout = qMax(0, seconds);
+    }
+
+    // The timer belongs to the manager's thread
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            if (tripTimeout() > 0)
+            {
+                m_timeoutTimer->start();
+            }
+            else
+            {
+                m_timeoutTimer->stop();
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+int AsyncTripManager::tripTimeout() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tripTimeout;
+}
+
+int AsyncTripManager::inFlightCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_running.size();
+}
+
+int AsyncTripManager::queuedCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_queued.size();
 }
 
 QFuture<TripResult>
 AsyncTripManager::addTripAsync(const TripRequest &request)
 {
-    // Create a placeholder trip ID
-    // (the actual ID will be assigned by the simulator)
-    QString tempTripId =
-        QString("%1_%2_%3_%4")
-            .arg(request.networkName)
-            .arg(request.originId)
-            .arg(request.destinationId)
-            .arg(QDateTime::currentMSecsSinceEpoch());
+    return addTripsAsync(QList<TripRequest>{request});
+}
+
+QFuture<TripResult> AsyncTripManager::addTripsAsync(
+    const QList<TripRequest> &requests)
+{
+    QSharedPointer<Batch> batch =
+        startBatch(requests.size());
+    QFuture<TripResult> future = batch->promise.future();
+
+    if (requests.isEmpty())
+    {
+        batch->promise.finish();
+        return future;
+    }
 
-    // Register the trip with the placeholder ID
-    return registerTrip(tempTripId, request);
+    {
+        QMutexLocker locker(&m_mutex);
+
+        // Queue the requests behind the earlier ones
+        for (int i = 0; i < requests.size(); ++i)
+        {
+            m_queued.enqueue(Trip{batch, i, requests[i]});
+        }
+    }
+
+    dispatch();
+
+    return future;
 }
 
 QFuture<TripResult>
 AsyncTripManager::registerTrip(const QString     &tripId,
                                const TripRequest &request)
 {
-    // Create a promise for this trip
-    QPromise<TripResult> promise;
-    QFuture<TripResult>  future = promise.future();
-
-    // Store the promise with request details
-    TripPromiseData *promiseData = new TripPromiseData();
-    promiseData->promise         = std::move(promise);
-    promiseData->request         = request;
+    QSharedPointer<Batch> batch  = startBatch(1);
+    QFuture<TripResult>   future = batch->promise.future();
 
-    // Add to pending trips map
-    m_pendingTrips.insert(tripId, promiseData);
+    QMutexLocker locker(&m_mutex);
+    startRunning(tripId, Trip{batch, 0, request});
 
     return future;
 }
 
 bool AsyncTripManager::cancelTrip(const QString &tripId)
 {
-    if (!m_pendingTrips.contains(tripId))
     {
-        return false;
-    }
-
-    // Get the promise data
-    TripPromiseData *data = m_pendingTrips[tripId];
+        QMutexLocker locker(&m_mutex);
 
-    // Create a cancelled result
-    TripResult result;
-    result.tripId          = tripId;
-    result.networkName     = data->request.networkName;
-    result.originId        = data->request.originId;
-    result.destinationId   = data->request.destinationId;
-    result.distance        = 0.0;
-    result.fuelConsumption = 0.0;
-    result.travelTime      = 0.0;
-    result.successful      = false;
-    result.errorMessage    = "Trip cancelled by user";
-
-    // Set the result and finish the promise
-    data->promise.addResult(result);
-    data->promise.finish();
+        auto it = m_running.find(tripId);
+        if (it == m_running.end())
+        {
+            return false;
+        }
+        const Trip trip = it.value();
+        m_running.erase(it);
 
-    // Remove from pending trips
-    m_pendingTrips.remove(tripId);
+        complete(trip,
+                 failedResult(tripId, trip.request,
+                              "Trip cancelled by user"));
+        m_toCancel.append(tripId);
+    }
 
+    // Stop the trip in the simulator as well
+    sendCancellations();
     return true;
 }
 
@@ -90,15 +173,6 @@ void AsyncTripManager::onTripEnded(
     const QString &networkName, const QString &tripId,
     const QJsonObject &resultData)
 {
-    if (!m_pendingTrips.contains(tripId))
-    {
-        // Unknown trip - might be handled elsewhere
-        return;
-    }
-
-    // Get the promise data
-    TripPromiseData *data = m_pendingTrips[tripId];
-
     // Create the result
     TripResult result;
     result.tripId      = tripId;
@@ -115,44 +189,348 @@ void AsyncTripManager::onTripEnded(
     result.successful   = true;
     result.errorMessage = "";
 
-    // Set the result and finish the promise
-    data->promise.addResult(result);
-    data->promise.finish();
-
-    // Remove from pending trips
-    m_pendingTrips.remove(tripId);
+    QMutexLocker locker(&m_mutex);
+    endTrip(tripId, result);
 }
 
 void AsyncTripManager::onTripError(
     const QString &tripId, const QString &errorMessage)
 {
-    if (!m_pendingTrips.contains(tripId))
+    // The request fields are filled in by endTrip()
+    QMutexLocker locker(&m_mutex);
+    endTrip(tripId, failedResult(tripId, TripRequest(),
+                                 errorMessage));
+}
+
+void AsyncTripManager::flush()
+{
+    QList<Completion> completed;
     {
-        // Unknown trip - might be handled elsewhere
-        return;
+        QMutexLocker locker(&m_mutex);
+
+        // Stopping a cancelled batch adds trip ends, so
+        // drain until none are left
+        while (!m_completed.isEmpty())
+        {
+            const QList<Completion> pending = std::exchange(
+                m_completed, QList<Completion>());
+            for (const Completion &completion : pending)
+            {
+                stopIfCanceled(completion.trip.batch);
+                completed.append(completion);
+            }
+        }
+
+        m_flushScheduled = false;
     }
 
-    // Get the promise data
-    TripPromiseData *data = m_pendingTrips[tripId];
+    // Futures are updated without the lock: finishing one
+    // runs its continuations, which may call back into the
+    // manager
+    QList<TripResult>                     results;
+    QHash<Batch *, QSharedPointer<Batch>> touched;
+    for (const Completion &completion : completed)
+    {
+        const QSharedPointer<Batch> &batch =
+            completion.trip.batch;
+        batch->promise.addResult(completion.result,
+                                 completion.trip.index);
+        touched.insert(batch.data(), batch);
+        results.append(completion.result);
+    }
 
-    // Create the result with error
+    // Count the results once they are added, so that only
+    // the flush adding the last one finishes a batch
+    struct Update
+    {
+        QSharedPointer<Batch> batch;
+        int                   ended;
+        bool                  finished;
+    };
+    QList<Update> updates;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Completion &completion : completed)
+        {
+            ++completion.trip.batch->ended;
+            --completion.trip.batch->remaining;
+        }
+        for (const auto &batch : touched)
+        {
+            updates.append(Update{batch, batch->ended,
+                                  batch->remaining == 0});
+        }
+    }
+
+    // One progress update per batch
+    for (const Update &update : updates)
+    {
+        update.batch->promise.setProgressValue(
+            update.ended);
+        if (update.finished)
+        {
+            update.batch->promise.finish();
+        }
+    }
+
+    // Refill the freed slots; trips failing to start are
+    // applied by the next flush
+    dispatch();
+
+    if (!results.isEmpty())
+    {
+        emit tripsCompleted(results);
+    }
+}
+
+QSharedPointer<AsyncTripManager::Batch>
+AsyncTripManager::startBatch(int size)
+{
+    auto batch       = QSharedPointer<Batch>::create();
+    batch->remaining = size;
+    batch->promise.start();
+    batch->promise.setProgressRange(0, size);
+    return batch;
+}
+
+TripResult AsyncTripManager::failedResult(
+    const QString &tripId, const TripRequest &request,
+    const QString &errorMessage)
+{
     TripResult result;
     result.tripId          = tripId;
-    result.networkName     = data->request.networkName;
-    result.originId        = data->request.originId;
-    result.destinationId   = data->request.destinationId;
+    result.networkName     = request.networkName;
+    result.originId        = request.originId;
+    result.destinationId   = request.destinationId;
     result.distance        = 0.0;
     result.fuelConsumption = 0.0;
     result.travelTime      = 0.0;
     result.successful      = false;
     result.errorMessage    = errorMessage;
+    return result;
+}
+
+void AsyncTripManager::dispatch()
+{
+    while (true)
+    {
+        QList<Trip>        trips;
+        QList<TripRequest> requests;
+        TripLauncher       launcher;
+        {
+            QMutexLocker locker(&m_mutex);
+
+            const int busy = m_running.size() + m_launching;
+            const int freeSlots =
+                m_maxInFlight > 0 ? m_maxInFlight - busy
+                                  : m_queued.size();
+
+            // Take the next requests, skipping the ones of
+            // cancelled batches
+            while (!m_queued.isEmpty()
+                   && trips.size() < freeSlots)
+            {
+                Trip trip = m_queued.dequeue();
+                if (trip.batch->promise.isCanceled())
+                {
+                    stopIfCanceled(trip.batch);
+                    complete(
+                        trip,
+                        failedResult(QString(),
+                                     trip.request,
+                                     "Trip cancelled"));
+                    continue;
+                }
+                requests.append(trip.request);
+                trips.append(std::move(trip));
+            }
+            if (trips.isEmpty())
+            {
+                break;
+            }
+
+            // The trips keep their slots while launching
+            m_launching += trips.size();
+            launcher = m_launcher;
+        }
 
-    // Set the result and finish the promise
-    data->promise.addResult(result);
-    data->promise.finish();
+        // Launch without the lock; trip ends arriving
+        // meanwhile are kept by endTrip()
+        QStringList tripIds;
+        if (launcher)
+        {
+            tripIds = launcher(requests);
+        }
+        else
+        {
+            qWarning() << "No trip launcher set; failing"
+                       << trips.size() << "trips";
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_launching -= trips.size();
+        for (int i = 0; i < trips.size(); ++i)
+        {
+            const QString tripId = tripIds.value(i);
+            if (tripId.isEmpty())
+            {
+                complete(trips[i],
+                         failedResult(
+                             tripId, trips[i].request,
+                             "Failed to add trip"));
+                continue;
+            }
+            startRunning(tripId, std::move(trips[i]));
+        }
+
+        // The ends left belong to trips started elsewhere
+        if (m_launching == 0)
+        {
+            m_earlyEnds.clear();
+        }
+    }
+
+    sendCancellations();
+}
+
+void AsyncTripManager::startRunning(const QString &tripId,
+                                    Trip           trip)
+{
+    trip.startedAt = m_clock.elapsed();
+    m_running.insert(tripId, std::move(trip));
+
+    // The trip may have ended before its launch returned
+    auto early = m_earlyEnds.find(tripId);
+    if (early != m_earlyEnds.end())
+    {
+        const TripResult result = early.value();
+        m_earlyEnds.erase(early);
+        endTrip(tripId, result);
+    }
+}
+
+void AsyncTripManager::endTrip(const QString    &tripId,
+                               const TripResult &result)
+{
+    const Trip trip = m_running.take(tripId);
+    if (!trip.batch)
+    {
+        // Keep the end until the pending launches return;
+        // otherwise the trip is handled elsewhere
+        if (m_launching > 0)
+        {
+            m_earlyEnds.insert(tripId, result);
+        }
+        return;
+    }
+
+    complete(trip, result.successful
+                       ? result
+                       : failedResult(tripId, trip.request,
+                                      result.errorMessage));
+}
 
-    // Remove from pending trips
-    m_pendingTrips.remove(tripId);
+void AsyncTripManager::stopIfCanceled(
+    const QSharedPointer<Batch> &batch)
+{
+    if (batch->stopped || !batch->promise.isCanceled())
+    {
+        return;
+    }
+    batch->stopped = true;
+
+    // Queued trips of the batch are dropped on dequeue
+    for (auto it = m_running.begin();
+         it != m_running.end();)
+    {
+        if (it->batch != batch)
+        {
+            ++it;
+            continue;
+        }
+
+        m_toCancel.append(it.key());
+        complete(it.value(),
+                 failedResult(it.key(), it->request,
+                              "Trip cancelled"));
+        it = m_running.erase(it);
+    }
+}
+
+void AsyncTripManager::sendCancellations()
+{
+    QStringList   tripIds;
+    TripCanceller canceller;
+    {
+        QMutexLocker locker(&m_mutex);
+        tripIds = std::exchange(m_toCancel, QStringList());
+        canceller = m_canceller;
+    }
+
+    if (!canceller)
+    {
+        return;
+    }
+    for (const QString &tripId : tripIds)
+    {
+        if (!canceller(tripId))
+        {
+            qWarning()
+                << "Failed to send cancellation of trip"
+                << tripId;
+        }
+    }
+}
+
+void AsyncTripManager::expireTrips()
+{
+    QStringList expired;
+    int         timeout = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        timeout = m_tripTimeout;
+        if (timeout <= 0)
+        {
+            return;
+        }
+
+        const qint64 startedBefore =
+            m_clock.elapsed() - timeout * 1000LL;
+        for (auto it = m_running.constBegin();
+             it != m_running.constEnd(); ++it)
+        {
+            if (it->startedAt <= startedBefore)
+            {
+                expired.append(it.key());
+            }
+        }
+
+        // Stop them in the simulator as well
+        m_toCancel.append(expired);
+    }
+
+    const QString message =
+        QString("No trip end within %1 s").arg(timeout);
+    for (const QString &tripId : expired)
+    {
+        onTripError(tripId, message);
+    }
+    sendCancellations();
+}
+
+void AsyncTripManager::complete(const Trip       &trip,
+                                const TripResult &result)
+{
+    m_completed.append(Completion{trip, result});
+
+    // Coalesce the trip ends of this event loop pass
+    if (!m_flushScheduled)
+    {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this,
+                                  &AsyncTripManager::flush,
+                                  Qt::QueuedConnection);
+    }
 }
 
 } // namespace TruckClient
@@ -8,12 +8,20 @@
 #pragma once
 
 #include <QFuture>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QJsonObject>
-#include <QMap>
+#include <QList>
+#include <QMutex>
 #include <QObject>
 #include <QPromise>
+#include <QQueue>
+#include <QSharedPointer>
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 #include <containerLib/container.h>
+#include <functional>
 
 namespace CargoNetSim
 {
@@ -56,22 +64,119 @@ struct TripResult
 
 /**
  * @class AsyncTripManager
- * @brief Manages asynchronous trip operations
+ * @brief Runs trips through a bounded asynchronous
+ * pipeline
+ *
+ * Requests are queued and handed to the launcher in
+ * batches, keeping at most maxInFlight() trips running in
+ * the simulator; every trip end frees a slot for the next
+ * queued request. The trips submitted together share one
+ * promise: the returned future holds result i for request
+ * i and reports progress as trips end, so a whole cohort
+ * is awaited through a single future.
+ *
+ * Trip ends are buffered and applied once per event loop
+ * pass: the futures are updated, tripsCompleted() is
+ * emitted once for all of them, and the freed slots are
+ * refilled with a single launcher call.
  *
- * Provides a Future/Promise based API for handling trips
- * that complete asynchronously after simulation runs.
+ * cancelTrip() ends a trip's result, frees its slot and
+ * asks the canceller to stop it in the simulator.
+ * Cancelling a batch future drops its queued requests and
+ * cancels its running trips at the next flush or dispatch.
+ * With a trip timeout set, trips without an end for that
+ * long fail through onTripError() and are cancelled, so a
+ * lost or rejected trip does not hold its slot forever.
+ *
+ * Thread-safe. The launcher, the canceller and the future
+ * updates run without the manager's mutex held, so they
+ * may call back into the manager. A trip end that arrives
+ * while its launcher call has not returned yet is kept
+ * until the launcher reports the trip's ID.
  */
 class AsyncTripManager : public QObject
 {
     Q_OBJECT
 
 public:
+    /**
+     * @brief Starts trips in the simulator
+     *
+     * Returns the trip identifiers in the order of the
+     * requests, empty strings for trips that failed.
+     */
+    using TripLauncher = std::function<QStringList(
+        const QList<TripRequest> &)>;
+
+    /**
+     * @brief Stops a running trip in the simulator
+     *
+     * Returns true if the cancellation was sent.
+     */
+    using TripCanceller =
+        std::function<bool(const QString &)>;
+
     /**
      * @brief Constructor
      * @param parent The parent QObject
      */
     explicit AsyncTripManager(QObject *parent = nullptr);
 
+    /**
+     * @brief Sets the function that starts queued trips
+     * @param launcher Trip launcher
+     */
+    void setLauncher(TripLauncher launcher);
+
+    /**
+     * @brief Sets the function that stops cancelled trips
+     * @param canceller Trip canceller, may be empty
+     */
+    void setCanceller(TripCanceller canceller);
+
+    /**
+     * @brief Sets the in-flight window
+     *
+     * Widening the window dispatches queued requests right
+     * away; narrowing it lets the running trips finish.
+     *
+     * @param maxTrips Maximum number of running trips, 0
+     * for no limit
+     */
+    void setMaxInFlight(int maxTrips);
+
+    /**
+     * @brief Gets the in-flight window
+     * @return Maximum number of running trips, 0 if
+     * unlimited
+     */
+    int maxInFlight() const;
+
+    /**
+     * @brief Sets the time a running trip may go without
+     * an end before it fails
+     * @param seconds Timeout in wall-clock seconds, 0 to
+     * wait forever
+     */
+    void setTripTimeout(int seconds);
+
+    /**
+     * @brief Gets the trip timeout
+     * @return Timeout in seconds, 0 if disabled
+     */
+    int tripTimeout() const;
+
+    /**
+     * @brief Gets the number of running trips
+     */
+    int inFlightCount() const;
+
+    /**
+     * @brief Gets the number of requests waiting for a
+     * slot
+     */
+    int queuedCount() const;
+
     /**
      * @brief Adds a trip asynchronously
      * @param request The trip request
@@ -81,7 +186,19 @@ public:
     addTripAsync(const TripRequest &request);
 
     /**
-     * @brief Registers a known trip for tracking
+     * @brief Adds a cohort of trips asynchronously
+     * @param requests The trip requests
+     * @return Future that completes when every trip has
+     * ended; result i belongs to request i
+     */
+    QFuture<TripResult>
+    addTripsAsync(const QList<TripRequest> &requests);
+
+    /**
+     * @brief Registers a trip started elsewhere
+     *
+     * The trip takes a slot of the window until it ends.
+     *
      * @param tripId Trip identifier
      * @param request Original trip request
      * @return Future that will complete when trip ends
@@ -91,7 +208,7 @@ public:
                  const TripRequest &request);
 
     /**
-     * @brief Cancels a pending trip
+     * @brief Cancels a running trip
      * @param tripId Trip identifier
      * @return True if trip was cancelled
      */
@@ -116,16 +233,129 @@ public slots:
     void onTripError(const QString &tripId,
                      const QString &errorMessage);
 
+    /**
+     * @brief Applies the buffered trip ends and refills
+     * the window
+     *
+     * Runs once per event loop pass on its own; calling it
+     * directly applies the trip ends right away.
+     */
+    void flush();
+
+signals:
+    /**
+     * @brief Emitted once per flush for the trips that
+     * ended since the previous one
+     * @param results Results of the ended trips
+     */
+    void tripsCompleted(const QList<TripResult> &results);
+
 private:
-    // Container for trip promises
-    struct TripPromiseData
+    // Shared promise of the trips submitted together; the
+    // counters are guarded by the mutex
+    struct Batch
     {
         QPromise<TripResult> promise;
-        TripRequest          request;
+        int                  remaining = 0;
+        int                  ended     = 0;
+        bool                 stopped   = false;
     };
 
-    // Map of trip IDs to promise data
-    QMap<QString, TripPromiseData *> m_pendingTrips;
+    // A queued or running trip and its slot in the batch
+    struct Trip
+    {
+        QSharedPointer<Batch> batch;
+        int                   index = 0;
+        TripRequest           request;
+        qint64                startedAt = 0;
+    };
+
+    // A trip end waiting for the next flush
+    struct Completion
+    {
+        Trip       trip;
+        TripResult result;
+    };
+
+    /** Creates a started batch of the given size */
+    static QSharedPointer<Batch> startBatch(int size);
+
+    /** Builds the result of a trip that did not end */
+    static TripResult
+    failedResult(const QString     &tripId,
+                 const TripRequest &request,
+                 const QString     &errorMessage);
+
+    /**
+     * Launches queued trips into free slots; called
+     * without the mutex held
+     */
+    void dispatch();
+
+    /** Inserts a launched trip, applying an early end */
+    void startRunning(const QString &tripId, Trip trip);
+
+    /**
+     * Ends a running trip, or keeps the end of a trip
+     * whose launch has not returned
+     */
+    void endTrip(const QString    &tripId,
+                 const TripResult &result);
+
+    /**
+     * Queues the running trips of a cancelled batch for
+     * cancellation
+     */
+    void stopIfCanceled(
+        const QSharedPointer<Batch> &batch);
+
+    /**
+     * Sends the queued cancellations; called without the
+     * mutex held
+     */
+    void sendCancellations();
+
+    /** Fails the trips running longer than the timeout */
+    void expireTrips();
+
+    /** Buffers a trip end for the next flush */
+    void complete(const Trip       &trip,
+                  const TripResult &result);
+
+    mutable QMutex m_mutex;
+
+    TripLauncher  m_launcher;
+    TripCanceller m_canceller;
+
+    // In-flight window, 0 if unlimited
+    int m_maxInFlight = 0;
+
+    // Requests waiting for a slot, in submission order
+    QQueue<Trip> m_queued;
+
+    // Running trips by trip ID
+    QHash<QString, Trip> m_running;
+
+    // Trips handed to the launcher that has not returned;
+    // they hold their slots
+    int m_launching = 0;
+
+    // Ends of trips not yet in m_running while launches
+    // are outstanding
+    QHash<QString, TripResult> m_earlyEnds;
+
+    // Trips to stop in the simulator
+    QStringList m_toCancel;
+
+    // Trip timeout in seconds, 0 if disabled, checked by
+    // m_timeoutTimer against m_clock
+    int           m_tripTimeout = 0;
+    QElapsedTimer m_clock;
+    QTimer       *m_timeoutTimer;
+
+    // Trip ends since the last flush
+    QList<Completion> m_completed;
+    bool              m_flushScheduled = false;
 };
 
 } // namespace TruckClient
@@ -75,10 +75,13 @@ QString MessageFormatter::formatAddTrip(
                           .arg(static_cast<int>(startTime))
                           .arg(linkIds.size());
 
-    // Add each link ID to the content
+    // Add each link ID to the content; routes can have
+    // thousands of links
+    content.reserve(content.size() + linkIds.size() * 8);
     for (int linkId : linkIds)
     {
-        content += QString("/%1").arg(linkId);
+        content += QLatin1Char('/');
+        content += QString::number(linkId);
     }
 
     return formatMessage(msgId, false,
@@ -86,6 +89,21 @@ QString MessageFormatter::formatAddTrip(
                          MessageCode::ADD_TRIP, content);
 }
 
+QString MessageFormatter::formatCancelTrip(int msgId,
+                                           int tripId)
+{
+    return formatMessage(msgId, false,
+                         MessageType::TRIP_CTRL,
+                         MessageCode::CANCEL_TRIP,
+                         QString::number(tripId));
+}
+
+QString
+MessageFormatter::formatBatch(const QStringList &messages)
+{
+    return messages.join(QLatin1Char('\n'));
+}
+
 QJsonObject
 MessageFormatter::parseMessage(const QString &message)
 {
@@ -11,6 +11,7 @@
 #include <QJsonObject>
 #include <QList>
 #include <QString>
+#include <QStringList>
 
 namespace CargoNetSim
 {
@@ -124,6 +125,26 @@ public:
                                  double startTime,
                                  const QList<int> &linkIds);
 
+    /**
+     * @brief Formats a cancel trip message
+     * @param msgId Message identifier
+     * @param tripId Trip identifier
+     * @return Formatted message string
+     */
+    static QString formatCancelTrip(int msgId, int tripId);
+
+    /**
+     * @brief Joins messages into one batch body
+     *
+     * Messages are separated by newlines, one message per
+     * line, so the receiver can split the batch and handle
+     * each line like a single message.
+     *
+     * @param messages Formatted messages
+     * @return Batch message string
+     */
+    static QString formatBatch(const QStringList &messages);
+
     /**
      * @brief Parses a message string into components
      * @param message The message to parse
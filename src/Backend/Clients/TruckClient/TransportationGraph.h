@@ -421,13 +421,12 @@ TransportationGraph<T>::convertNodePathToLinkPath(
         T fromNode = nodePath[i];
         T toNode   = nodePath[i + 1];
 
-        // Get link ID from edge attributes
-        QMap<QString, QVariant> attrs =
-            this->getEdgeAttributes(fromNode, toNode);
+        QVariant linkId = this->getEdgeAttribute(
+            fromNode, toNode, "link_id");
 
-        if (attrs.contains("link_id"))
+        if (linkId.isValid())
         {
-            linkPath.append(attrs["link_id"].toInt());
+            linkPath.append(linkId.toInt());
         }
     }
 
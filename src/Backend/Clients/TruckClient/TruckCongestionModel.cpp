@@ -0,0 +1,121 @@
+/**
+ * @file TruckCongestionModel.cpp
+ * @brief Implements the link load model used for
+ * congestion-aware truck routing
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#include "TruckCongestionModel.h"
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+namespace TruckClient
+{
+
+TruckCongestionModel::TruckCongestionModel(
+    QSharedPointer<const TruckRoutingGraph> graph)
+    : m_graph(graph)
+{
+    clear();
+}
+
+void TruckCongestionModel::addRoute(
+    const QList<int> &linkIds, int vehicles)
+{
+    loadRoute(linkIds, vehicles);
+}
+
+void TruckCongestionModel::removeRoute(
+    const QList<int> &linkIds, int vehicles)
+{
+    loadRoute(linkIds, -vehicles);
+}
+
+void TruckCongestionModel::clear()
+{
+    if (!m_graph)
+    {
+        m_vehicles.clear();
+        m_travelTimes.clear();
+        return;
+    }
+
+    m_vehicles.fill(0, m_graph->edgeCount());
+    m_travelTimes = m_graph->freeFlowTimes();
+}
+
+void TruckCongestionModel::setAssignmentPeriod(
+    double seconds)
+{
+    m_assignmentPeriod =
+        seconds > 0.0 ? seconds : DEFAULT_ASSIGNMENT_PERIOD;
+
+    for (int edge = 0; edge < m_vehicles.size(); ++edge)
+    {
+        if (m_vehicles[edge] > 0)
+        {
+            m_travelTimes[edge] = edgeTime(edge);
+        }
+    }
+}
+
+int TruckCongestionModel::linkVehicles(int linkId) const
+{
+    if (!m_graph)
+    {
+        return 0;
+    }
+
+    int edge = m_graph->edgeOfLink(linkId);
+    return edge >= 0 ? m_vehicles[edge] : 0;
+}
+
+float TruckCongestionModel::linkTravelTime(
+    int linkId) const
+{
+    if (!m_graph)
+    {
+        return -1.0f;
+    }
+
+    int edge = m_graph->edgeOfLink(linkId);
+    return edge >= 0 ? m_travelTimes[edge] : -1.0f;
+}
+
+void TruckCongestionModel::loadRoute(
+    const QList<int> &linkIds, int delta)
+{
+    if (!m_graph || delta == 0)
+    {
+        return;
+    }
+
+    for (int linkId : linkIds)
+    {
+        int edge = m_graph->edgeOfLink(linkId);
+        if (edge < 0)
+        {
+            continue;
+        }
+
+        m_vehicles[edge] =
+            qMax(0, m_vehicles[edge] + delta);
+        m_travelTimes[edge] = edgeTime(edge);
+    }
+}
+
+float TruckCongestionModel::edgeTime(int edge) const
+{
+    // Vehicles per hour entering within the period
+    const double flow =
+        m_vehicles[edge] * 3600.0 / m_assignmentPeriod;
+    return m_graph->congestedTime(edge,
+                                  static_cast<float>(flow));
+}
+
+} // namespace TruckClient
+} // namespace Backend
+} // namespace CargoNetSim
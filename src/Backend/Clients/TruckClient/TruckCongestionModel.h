@@ -0,0 +1,147 @@
+/**
+ * @file TruckCongestionModel.h
+ * @brief Defines the link load model used for
+ * congestion-aware truck routing
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#pragma once
+
+#include "TruckRoutingGraph.h"
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+namespace TruckClient
+{
+
+/**
+ * @class TruckCongestionModel
+ * @brief Tracks the trucks assigned to each link and the
+ * resulting BPR travel times
+ *
+ * The trucks assigned to a link are taken to enter it
+ * within one assignment period, so the BPR flow of a link
+ * is its vehicle count divided by the period, in vehicles
+ * per hour. The period defaults to one hour; the truck
+ * client sets it to its reroute interval.
+ *
+ * Vehicle counts and travel times are kept in flat arrays
+ * indexed like the edges of a TruckRoutingGraph. Adding or
+ * removing a route recomputes the times of that route's
+ * links only, so the cost of an update is proportional to
+ * the route length, not the network size.
+ *
+ * travelTimes() returns an implicitly shared copy that can
+ * be passed to TruckRoutingGraph::findRoutes() after the
+ * owner's lock is released; the model detaches from it on
+ * the next update.
+ *
+ * The class is not thread-safe; the owner serializes
+ * access.
+ */
+class TruckCongestionModel
+{
+public:
+    /**
+     * @brief Constructs a model without a graph
+     */
+    TruckCongestionModel() = default;
+
+    /**
+     * @brief Constructs an unloaded model of a graph
+     * @param graph Graph whose edges are tracked
+     */
+    explicit TruckCongestionModel(
+        QSharedPointer<const TruckRoutingGraph> graph);
+
+    /**
+     * @brief Loads the links of a route
+     * @param linkIds Route links; unknown links are
+     * ignored
+     * @param vehicles Vehicles to add to each link
+     */
+    void addRoute(const QList<int> &linkIds,
+                  int               vehicles = 1);
+
+    /**
+     * @brief Unloads the links of a route
+     * @param linkIds Route links; unknown links are
+     * ignored
+     * @param vehicles Vehicles to remove from each link
+     */
+    void removeRoute(const QList<int> &linkIds,
+                     int               vehicles = 1);
+
+    /**
+     * @brief Removes all vehicles
+     */
+    void clear();
+
+    /**
+     * @brief Sets the period over which the assigned
+     * vehicles enter their links
+     *
+     * Recomputes the travel times of all loaded links.
+     *
+     * @param seconds Period in seconds; non-positive values
+     * restore the one hour default
+     */
+    void setAssignmentPeriod(double seconds);
+
+    /**
+     * @brief Gets the current travel time of each edge
+     */
+    QVector<float> travelTimes() const
+    {
+        return m_travelTimes;
+    }
+
+    /**
+     * @brief Gets the vehicles on a link
+     * @return The count, 0 for unknown links
+     */
+    int linkVehicles(int linkId) const;
+
+    /**
+     * @brief Gets the current travel time of a link
+     * @return The time, -1 for unknown links
+     */
+    float linkTravelTime(int linkId) const;
+
+private:
+    /**
+     * @brief Changes the load of the links of a route
+     */
+    void loadRoute(const QList<int> &linkIds, int delta);
+
+    /**
+     * @brief Gets the BPR travel time of an edge from its
+     * vehicle count
+     */
+    float edgeTime(int edge) const;
+
+    /** Graph whose edges are tracked */
+    QSharedPointer<const TruckRoutingGraph> m_graph;
+
+    /** Vehicles on each edge */
+    QVector<int> m_vehicles;
+
+    /** Current travel time of each edge */
+    QVector<float> m_travelTimes;
+
+    static constexpr double DEFAULT_ASSIGNMENT_PERIOD =
+        3600.0;
+
+    /** Seconds in which the assigned vehicles enter */
+    double m_assignmentPeriod = DEFAULT_ASSIGNMENT_PERIOD;
+};
+
+} // namespace TruckClient
+} // namespace Backend
+} // namespace CargoNetSim
@@ -96,6 +96,9 @@ void IntegrationNetwork::initializeNetwork(
         attributes["link_id"]    = link->getLinkId();
         attributes["free_speed"] = link->getFreeSpeed();
         attributes["lanes"]      = link->getLanes();
+        attributes["saturation_flow"] =
+            link->getSaturationFlow()
+            * link->getSaturationFlowScale();
 
         m_graph->addEdge(fromNode, toNode, weight,
                          attributes);
@@ -348,13 +351,12 @@ QVector<int> IntegrationNetwork::getPathLinks(
         int fromNode = pathNodes[i];
         int toNode   = pathNodes[i + 1];
 
-        // Get link ID from edge attributes
-        QMap<QString, QVariant> edgeAttrs =
-            m_graph->getEdgeAttributes(fromNode, toNode);
+        QVariant linkId = m_graph->getEdgeAttribute(
+            fromNode, toNode, "link_id");
 
-        if (edgeAttrs.contains("link_id"))
+        if (linkId.isValid())
         {
-            pathLinks.append(edgeAttrs["link_id"].toInt());
+            pathLinks.append(linkId.toInt());
         }
     }
 
@@ -0,0 +1,238 @@
+/**
+ * @file TruckRoutingGraph.cpp
+ * @brief Implements the compact routing graph of the
+ * truck client
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#include "TruckRoutingGraph.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+namespace TruckClient
+{
+
+TruckRoutingGraph::TruckRoutingGraph(
+    const TransportationGraph<int> &graph)
+{
+    m_nodeIds = graph.getNodes();
+    m_nodeIndex.reserve(m_nodeIds.size());
+    m_nodePoints.reserve(m_nodeIds.size());
+    for (int i = 0; i < m_nodeIds.size(); ++i)
+    {
+        m_nodeIndex.insert(m_nodeIds[i], i);
+
+        QMap<QString, QVariant> attrs =
+            graph.getNodeAttributes(m_nodeIds[i]);
+        m_nodePoints.append(
+            QPointF(attrs.value("x").toDouble(),
+                    attrs.value("y").toDouble()));
+    }
+
+    m_edgeOffsets.reserve(m_nodeIds.size() + 1);
+    for (int source = 0; source < m_nodeIds.size();
+         ++source)
+    {
+        m_edgeOffsets.append(m_edgeTargets.size());
+
+        const int fromId = m_nodeIds[source];
+        for (const auto &edge :
+             graph.getOutgoingEdges(fromId))
+        {
+            // Attributes are read once here, never during
+            // a search
+            QMap<QString, QVariant> attrs =
+                graph.getEdgeAttributes(fromId, edge.first);
+            auto target = m_nodeIndex.constFind(edge.first);
+            if (!attrs.contains("link_id")
+                || target == m_nodeIndex.constEnd())
+            {
+                continue;
+            }
+
+            int   linkId = attrs["link_id"].toInt();
+            float speed =
+                attrs.value("free_speed", 50.0f).toFloat();
+            float lanes =
+                attrs.value("lanes", 1.0f).toFloat();
+            float satFlow =
+                attrs.value("saturation_flow", 1800.0f)
+                    .toFloat();
+
+            m_linkEdges.insert(linkId,
+                               m_edgeTargets.size());
+            m_edgeSources.append(source);
+            m_edgeTargets.append(*target);
+            m_edgeWeights.append(edge.second);
+            m_edgeLinkIds.append(linkId);
+            m_edgeFreeTimes.append(
+                speed > 0.0f ? edge.second / speed
+                             : edge.second);
+            m_edgeCapacities.append(lanes * satFlow);
+        }
+    }
+    m_edgeOffsets.append(m_edgeTargets.size());
+}
+
+bool TruckRoutingGraph::linkStart(int      linkId,
+                                  QPointF &point) const
+{
+    const int edge = edgeOfLink(linkId);
+    if (edge < 0)
+    {
+        return false;
+    }
+
+    point = m_nodePoints[m_edgeSources[edge]];
+    return true;
+}
+
+float TruckRoutingGraph::congestedTime(int   edge,
+                                       float flow) const
+{
+    const float capacity = m_edgeCapacities[edge];
+    if (capacity <= 0.0f || flow <= 0.0f)
+    {
+        return m_edgeFreeTimes[edge];
+    }
+
+    float vc = flow / capacity;
+    return m_edgeFreeTimes[edge]
+           * (1.0f + 0.15f * std::pow(vc, 4.0f));
+}
+
+QList<int> TruckRoutingGraph::findRoute(
+    int originId, int destinationId,
+    const QVector<float> *edgeCosts) const
+{
+    return findRoutes(originId, {destinationId}, edgeCosts)
+        .value(destinationId);
+}
+
+QHash<int, QList<int>> TruckRoutingGraph::findRoutes(
+    int originId, const QSet<int> &destinationIds,
+    const QVector<float> *edgeCosts) const
+{
+    QHash<int, QList<int>> routes;
+
+    auto origin = m_nodeIndex.constFind(originId);
+    if (origin == m_nodeIndex.constEnd())
+    {
+        return routes;
+    }
+
+    QSet<int> targets;
+    for (int destinationId : destinationIds)
+    {
+        auto it = m_nodeIndex.constFind(destinationId);
+        if (it != m_nodeIndex.constEnd())
+        {
+            targets.insert(*it);
+        }
+    }
+    if (targets.isEmpty())
+    {
+        return routes;
+    }
+
+    // Costs of another graph would index the wrong edges
+    const bool useCosts =
+        edgeCosts && edgeCosts->size() == edgeCount();
+
+    QVector<int> previousEdge;
+    search(*origin, targets,
+           useCosts ? *edgeCosts : m_edgeWeights,
+           previousEdge);
+
+    for (int target : targets)
+    {
+        if (target != *origin && previousEdge[target] < 0)
+        {
+            continue; // Unreachable
+        }
+        routes.insert(m_nodeIds[target],
+                      tracePath(target, previousEdge));
+    }
+    return routes;
+}
+
+void TruckRoutingGraph::search(
+    int origin, QSet<int> targets,
+    const QVector<float> &costs,
+    QVector<int>         &previousEdge) const
+{
+    // Edge costs are stored as float, but sums over long
+    // routes are kept in double so near-equal routes are
+    // still told apart
+    const int nodeCount = m_nodeIds.size();
+    QVector<double> distances(
+        nodeCount, std::numeric_limits<double>::infinity());
+    previousEdge.fill(-1, nodeCount);
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>,
+                        std::greater<Entry>>
+        queue;
+
+    distances[origin] = 0.0;
+    queue.push({0.0, origin});
+
+    while (!queue.empty())
+    {
+        const auto [distance, node] = queue.top();
+        queue.pop();
+
+        // Skip entries superseded by a shorter distance
+        if (distance > distances[node])
+        {
+            continue;
+        }
+
+        targets.remove(node);
+        if (targets.isEmpty())
+        {
+            break;
+        }
+
+        for (int edge = m_edgeOffsets[node];
+             edge < m_edgeOffsets[node + 1]; ++edge)
+        {
+            const int    next = m_edgeTargets[edge];
+            const double candidate =
+                distance + costs[edge];
+            if (candidate < distances[next])
+            {
+                distances[next]    = candidate;
+                previousEdge[next] = edge;
+                queue.push({candidate, next});
+            }
+        }
+    }
+}
+
+QList<int> TruckRoutingGraph::tracePath(
+    int target, const QVector<int> &previousEdge) const
+{
+    QList<int> links;
+    for (int edge = previousEdge[target]; edge >= 0;
+         edge = previousEdge[m_edgeSources[edge]])
+    {
+        links.append(m_edgeLinkIds[edge]);
+    }
+    std::reverse(links.begin(), links.end());
+    return links;
+}
+
+} // namespace TruckClient
+} // namespace Backend
+} // namespace CargoNetSim
@@ -0,0 +1,215 @@
+/**
+ * @file TruckRoutingGraph.h
+ * @brief Defines the compact routing graph of the truck
+ * client
+ * @author Ahmed Aredah
+ * @date 2025-03-22
+ */
+
+#pragma once
+
+#include "TransportationGraph.h"
+#include <QHash>
+#include <QList>
+#include <QPointF>
+#include <QSet>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+namespace TruckClient
+{
+
+/**
+ * @class TruckRoutingGraph
+ * @brief Read-only, integer-indexed copy of a truck
+ * network graph used for route searches
+ *
+ * Nodes are renumbered to dense indices and the outgoing
+ * edges of all nodes are stored back to back in flat
+ * arrays, each edge carrying its target, weight and link
+ * ID inline. A search therefore touches only contiguous
+ * vectors, and turning a node path into a link path reads
+ * the link IDs recorded during the search instead of
+ * looking up edge attributes per hop.
+ *
+ * The graph is a snapshot: later changes to the source
+ * graph are not reflected until it is rebuilt.
+ */
+class TruckRoutingGraph
+{
+public:
+    /**
+     * @brief Constructs an empty graph
+     */
+    TruckRoutingGraph() = default;
+
+    /**
+     * @brief Builds the graph from a network graph
+     *
+     * Edge weights are the link lengths of the source
+     * graph; edges without a "link_id" attribute are
+     * skipped. Free-flow times and capacities are derived
+     * from the "free_speed", "lanes" and "saturation_flow"
+     * attributes with the defaults of
+     * TransportationGraph::calculatePathMetric().
+     *
+     * @param graph Source graph, e.g. from
+     * IntegrationNetwork::getGraph()
+     */
+    explicit TruckRoutingGraph(
+        const TransportationGraph<int> &graph);
+
+    /**
+     * @brief Checks whether the graph has no nodes
+     */
+    bool isEmpty() const
+    {
+        return m_nodeIds.isEmpty();
+    }
+
+    /**
+     * @brief Checks whether a node exists
+     * @param nodeId Node identifier of the network
+     */
+    bool hasNode(int nodeId) const
+    {
+        return m_nodeIndex.contains(nodeId);
+    }
+
+    int edgeCount() const
+    {
+        return m_edgeTargets.size();
+    }
+
+    /**
+     * @brief Gets the edge index of a network link
+     * @return The index, -1 if the link is not in the graph
+     */
+    int edgeOfLink(int linkId) const
+    {
+        return m_linkEdges.value(linkId, -1);
+    }
+
+    /**
+     * @brief Gets where a network link starts
+     * @param linkId Network link ID
+     * @param point Receives the "x" and "y" attributes of
+     * the link's upstream node
+     * @return False if the link is not in the graph
+     */
+    bool linkStart(int linkId, QPointF &point) const;
+
+    /**
+     * @brief Gets the uncongested travel time of each edge
+     */
+    const QVector<float> &freeFlowTimes() const
+    {
+        return m_edgeFreeTimes;
+    }
+
+    /**
+     * @brief Gets the BPR travel time of an edge
+     *
+     * Uses t0 * (1 + 0.15 * (v/c)^4) like
+     * TransportationGraph::calculateCongestion(), with the
+     * capacity c in vehicles per hour.
+     *
+     * @param edge Edge index
+     * @param flow Flow v on the edge in vehicles per hour
+     */
+    float congestedTime(int edge, float flow) const;
+
+    /**
+     * @brief Finds the links of the shortest route
+     * @param originId Origin node identifier
+     * @param destinationId Destination node identifier
+     * @param edgeCosts Cost of each edge, indexed like
+     * freeFlowTimes(); nullptr routes on length
+     * @return Link IDs in travel order, empty if the
+     * destination is unreachable
+     */
+    QList<int>
+    findRoute(int originId, int destinationId,
+              const QVector<float> *edgeCosts =
+                  nullptr) const;
+
+    /**
+     * @brief Finds the shortest routes from one origin to
+     * several destinations with a single search
+     * @param originId Origin node identifier
+     * @param destinationIds Destination node identifiers
+     * @param edgeCosts Cost of each edge, nullptr routes
+     * on length
+     * @return Link IDs by destination; unreachable
+     * destinations are omitted
+     */
+    QHash<int, QList<int>>
+    findRoutes(int                   originId,
+               const QSet<int>      &destinationIds,
+               const QVector<float> *edgeCosts =
+                   nullptr) const;
+
+private:
+    /**
+     * @brief Runs Dijkstra from an origin until all
+     * targets are settled
+     * @param origin Dense index of the origin
+     * @param targets Dense indices to settle; the search
+     * stops once none is left
+     * @param costs Cost of each edge
+     * @param previousEdge Receives the edge used to reach
+     * each node, -1 if none
+     */
+    void search(int origin, QSet<int> targets,
+                const QVector<float> &costs,
+                QVector<int>         &previousEdge) const;
+
+    /**
+     * @brief Collects the links leading to a node
+     * @param target Dense index of the destination
+     * @param previousEdge Result of search()
+     */
+    QList<int>
+    tracePath(int                 target,
+              const QVector<int> &previousEdge) const;
+
+    /** Network node IDs by dense index */
+    QVector<int> m_nodeIds;
+
+    /** Dense indices by network node ID */
+    QHash<int, int> m_nodeIndex;
+
+    /** Coordinates of each node by dense index */
+    QVector<QPointF> m_nodePoints;
+
+    /** First edge of each node; one extra end entry */
+    QVector<int> m_edgeOffsets;
+
+    /** Dense index of the source node of each edge */
+    QVector<int> m_edgeSources;
+
+    /** Dense index of the target node of each edge */
+    QVector<int> m_edgeTargets;
+
+    /** Length of each edge */
+    QVector<float> m_edgeWeights;
+
+    /** Network link ID of each edge */
+    QVector<int> m_edgeLinkIds;
+
+    /** Travel time of each edge at free speed */
+    QVector<float> m_edgeFreeTimes;
+
+    /** Capacity of each edge in vehicles per hour */
+    QVector<float> m_edgeCapacities;
+
+    /** Edge indices by network link ID */
+    QHash<int, int> m_linkEdges;
+};
+
+} // namespace TruckClient
+} // namespace Backend
+} // namespace CargoNetSim
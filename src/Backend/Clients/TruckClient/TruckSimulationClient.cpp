@@ -12,6 +12,7 @@
 #include <QFileInfo>
 #include <QFuture>
 #include <QJsonDocument>
+#include <QSet>
 
 namespace CargoNetSim
 {
@@ -34,7 +35,6 @@ TruckSimulationClient::TruckSimulationClient(
     , m_tripIdCounter(10000)
     , m_lastRequestId(-1)
     , m_sentMsgCounter(0)
-    , m_networkGraph(nullptr)
 {
 }
 
@@ -58,13 +58,14 @@ TruckSimulationClient::~TruckSimulationClient()
     }
 
     // Clean up truck states
-    for (auto &stateList : m_truckStates)
+    for (auto &states : m_truckStates)
     {
-        qDeleteAll(stateList);
+        qDeleteAll(states);
     }
 
     m_processes.clear();
     m_truckStates.clear();
+    m_changedTruckStates.clear();
 }
 
 void TruckSimulationClient::initializeClient(
@@ -82,6 +83,17 @@ void TruckSimulationClient::initializeClient(
     m_asyncTripManager = new AsyncTripManager(this);
     m_containerManager = new ContainerManager(this);
 
+    // Queued trips are started and cancelled through this
+    // client
+    m_asyncTripManager->setLauncher(
+        [this](const QList<TripRequest> &trips) {
+            return addTrips(trips);
+        });
+    m_asyncTripManager->setCanceller(
+        [this](const QString &tripId) {
+            return sendCancelTrip(tripId);
+        });
+
     // Connect signals between components
     connect(this, &TruckSimulationClient::tripEndedWithData,
             m_tripEndCallbackManager,
@@ -217,24 +229,11 @@ QString TruckSimulationClient::addTrip(
     int     tripId    = m_tripIdCounter++;
     QString tripIdStr = QString::number(tripId);
 
-    // Find route links
-    QList<int> linkIds;
-    if (m_networkGraph)
-    {
-        QVector<QString> nodes =
-            m_networkGraph->findShortestPath(originId,
-                                             destinationId);
+    const int origin      = originId.toInt();
+    const int destination = destinationId.toInt();
 
-        linkIds =
-            m_networkGraph->convertNodePathToLinkPath(nodes)
-                .toList();
-    }
-    else
-    {
-        // Fallback to default link IDs if no graph is
-        // available
-        linkIds = {1, 2, 3};
-    }
+    // Find route links
+    QList<int> linkIds = findRoute(origin, destination);
 
     // Get current simulation time as start time
     double startTime =
@@ -242,8 +241,8 @@ QString TruckSimulationClient::addTrip(
 
     // Create add trip message
     QString msg = MessageFormatter::formatAddTrip(
-        m_sentMsgCounter++, tripId, originId.toInt(),
-        destinationId.toInt(), startTime, linkIds);
+        m_sentMsgCounter++, tripId, origin, destination,
+        startTime, linkIds);
 
     // Send the command
     bool sent = sendCommand(msg.toUtf8(), QJsonObject(),
@@ -254,25 +253,170 @@ QString TruckSimulationClient::addTrip(
         return QString();
     }
 
-    Commons::ScopedWriteLock locker(m_dataMutex);
+    // Signals are emitted after the lock is released
+    ContainerManager::PendingSignals pending;
+    {
+        Commons::ScopedWriteLock locker(m_dataMutex);
 
-    // Create new truck state
-    auto *state = new TruckState(
-        networkName, tripId, originId, destinationId, this);
+        loadTripRoute(tripId, linkIds);
 
-    // Add to tracking
-    m_truckStates[networkName].append(state);
+        // Create new truck state
+        auto *state =
+            new TruckState(networkName, tripId, originId,
+                           destinationId, this);
 
-    // Assign containers to the trip
-    if (!containers.isEmpty())
-    {
+        // Add to tracking
+        m_truckStates[networkName].insert(tripIdStr, state);
+        m_changedTruckStates.insert(state);
+
+        // Assign containers to the trip
+        m_containerManager->beginBatch();
         m_containerManager->assignContainersToVehicle(
             QString("Truck_%1").arg(tripIdStr), containers);
+        pending = m_containerManager->endBatchDeferred();
     }
+    m_containerManager->emitSignals(pending);
 
     return tripIdStr;
 }
 
+QStringList TruckSimulationClient::addTrips(
+    const QList<TripRequest> &trips)
+{
+    QStringList tripIds;
+    if (trips.isEmpty())
+    {
+        return tripIds;
+    }
+
+    QVector<int> tripNumbers(trips.size());
+    for (int &tripId : tripNumbers)
+    {
+        tripId = m_tripIdCounter++;
+    }
+
+    // Group the trips by origin, keeping the first-seen
+    // order of the origins
+    QHash<int, QVector<int>> tripsByOrigin;
+    QVector<int>             origins;
+    for (int i = 0; i < trips.size(); ++i)
+    {
+        QVector<int> &group =
+            tripsByOrigin[trips[i].originId];
+        if (group.isEmpty())
+        {
+            origins.append(trips[i].originId);
+        }
+        group.append(i);
+    }
+
+    // Search each origin once for all of its destinations
+    // and load its trips before the next search
+    QVector<QList<int>> routes(trips.size());
+    for (int origin : origins)
+    {
+        const QVector<int> &group = tripsByOrigin[origin];
+
+        QSet<int> destinations;
+        for (int i : group)
+        {
+            destinations.insert(trips[i].destinationId);
+        }
+        QHash<int, QList<int>> found =
+            findRoutes(origin, destinations);
+
+        Commons::ScopedWriteLock locker(m_dataMutex);
+        for (int i : group)
+        {
+            routes[i] = found.value(trips[i].destinationId);
+            loadTripRoute(tripNumbers[i], routes[i]);
+        }
+    }
+
+    // Format every trip
+    QStringList messages;
+    messages.reserve(trips.size());
+    tripIds.reserve(trips.size());
+    for (int i = 0; i < trips.size(); ++i)
+    {
+        const TripRequest &trip    = trips[i];
+        const int          tripId  = tripNumbers[i];
+        const QList<int>  &linkIds = routes[i];
+
+        // Get current simulation time as start time
+        double startTime =
+            m_simulationHorizons.value(trip.networkName,
+                                       0.0);
+
+        messages.append(MessageFormatter::formatAddTrip(
+            m_sentMsgCounter++, tripId, trip.originId,
+            trip.destinationId, startTime, linkIds));
+        tripIds.append(QString::number(tripId));
+    }
+
+    // Publish in batches; trips of a failed batch fail
+    for (int first = 0; first < messages.size();
+         first += MAX_TRIPS_PER_PUBLISH)
+    {
+        QStringList batch =
+            messages.mid(first, MAX_TRIPS_PER_PUBLISH);
+        bool sent = sendCommand(
+            MessageFormatter::formatBatch(batch),
+            QJsonObject(), m_sendingRoutingKey);
+        if (!sent)
+        {
+            for (int i = first; i < first + batch.size();
+                 ++i)
+            {
+                tripIds[i].clear();
+            }
+        }
+    }
+
+    // Signals are emitted after the lock is released
+    ContainerManager::PendingSignals pending;
+    {
+        Commons::ScopedWriteLock locker(m_dataMutex);
+
+        // Track the sent trips and collect their containers
+        QMap<QString, QList<ContainerCore::Container *>>
+            assignments;
+        for (int i = 0; i < trips.size(); ++i)
+        {
+            if (tripIds[i].isEmpty())
+            {
+                unloadTripRoute(tripNumbers[i]);
+                continue;
+            }
+
+            const TripRequest &trip  = trips[i];
+            auto              *state = new TruckState(
+                trip.networkName, tripIds[i].toInt(),
+                QString::number(trip.originId),
+                QString::number(trip.destinationId), this);
+            m_truckStates[trip.networkName].insert(
+                tripIds[i], state);
+            m_changedTruckStates.insert(state);
+
+            if (!trip.containers.isEmpty())
+            {
+                assignments.insert(
+                    QString("Truck_%1").arg(tripIds[i]),
+                    trip.containers);
+            }
+        }
+
+        // Assign containers to the trips
+        m_containerManager->beginBatch();
+        m_containerManager->assignContainersToVehicles(
+            assignments);
+        pending = m_containerManager->endBatchDeferred();
+    }
+    m_containerManager->emitSignals(pending);
+
+    return tripIds;
+}
+
 QFuture<TripResult> TruckSimulationClient::addTripAsync(
     const QString &networkName, const QString &originId,
     const QString                           &destinationId,
@@ -285,39 +429,66 @@ QFuture<TripResult> TruckSimulationClient::addTripAsync(
     request.destinationId = destinationId.toInt();
     request.containers    = containers;
 
-    // Start async operation
-    QFuture<TripResult> future =
-        m_asyncTripManager->addTripAsync(request);
+    return m_asyncTripManager->addTripAsync(request);
+}
 
-    // Add trip synchronously
-    QString tripId = addTrip(networkName, originId,
-                             destinationId, containers);
+QFuture<TripResult> TruckSimulationClient::addTripsAsync(
+    const QList<TripRequest> &trips)
+{
+    return m_asyncTripManager->addTripsAsync(trips);
+}
 
-    // Register the trip with the async manager
-    if (!tripId.isEmpty())
+bool TruckSimulationClient::cancelTrip(
+    const QString &tripId)
+{
+    // Trips of the async pipeline are cancelled through
+    // it, which ends their futures and frees their slots
+    if (m_asyncTripManager->cancelTrip(tripId))
     {
-        m_asyncTripManager->registerTrip(tripId, request);
+        return true;
     }
+    return sendCancelTrip(tripId);
+}
+
+void TruckSimulationClient::setMaxTripsInFlight(
+    int maxTrips)
+{
+    m_asyncTripManager->setMaxInFlight(maxTrips);
+}
+
+void TruckSimulationClient::setTripTimeout(int seconds)
+{
+    m_asyncTripManager->setTripTimeout(seconds);
+}
+
+bool TruckSimulationClient::sendCancelTrip(
+    const QString &tripId)
+{
+    QString msg = MessageFormatter::formatCancelTrip(
+        m_sentMsgCounter++, tripId.toInt());
 
-    return future;
+    // The route stays loaded until the trip's TRIP_END;
+    // the simulator may not have stopped the truck yet
+    return sendCommand(msg.toUtf8(), QJsonObject(),
+                       m_sendingRoutingKey);
 }
 
 const TruckState *TruckSimulationClient::getTruckState(
     const QString &networkName, const QString &tripId) const
 {
     Commons::ScopedReadLock locker(m_dataMutex);
+    return findTruckState(networkName, tripId);
+}
 
-    // Look up truck state
-    for (const auto *state :
-         m_truckStates.value(networkName))
+TruckState *TruckSimulationClient::findTruckState(
+    const QString &networkName, const QString &tripId) const
+{
+    auto network = m_truckStates.constFind(networkName);
+    if (network == m_truckStates.constEnd())
     {
-        if (state->tripId() == tripId)
-        {
-            return state;
-        }
+        return nullptr;
     }
-
-    return nullptr;
+    return network->value(tripId, nullptr);
 }
 
 QList<const TruckState *>
@@ -328,9 +499,14 @@ TruckSimulationClient::getAllNetworkTrucksStates(
     QList<const TruckState *> constStates;
 
     // Convert non-const states to const states
-    for (auto *state : m_truckStates.value(networkName))
+    auto network = m_truckStates.constFind(networkName);
+    if (network != m_truckStates.constEnd())
     {
-        constStates.append(state);
+        constStates.reserve(network->size());
+        for (auto *state : *network)
+        {
+            constStates.append(state);
+        }
     }
 
     return constStates;
@@ -356,9 +532,166 @@ double TruckSimulationClient::getSimulationTime(
 }
 
 void TruckSimulationClient::setNetworkGraph(
-    const TransportationGraph<QString> *graph)
+    const TransportationGraph<int> *graph)
 {
-    m_networkGraph = graph;
+    // Build the snapshot before taking the lock
+    QSharedPointer<const TruckRoutingGraph> routingGraph;
+    if (graph)
+    {
+        routingGraph.reset(new TruckRoutingGraph(*graph));
+    }
+
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    m_routingGraph = routingGraph;
+    m_congestion   = TruckCongestionModel(routingGraph);
+    m_congestion.setAssignmentPeriod(m_rerouteInterval);
+
+    // Routes of the previous graph are stale
+    m_routeCache.clear();
+    m_tripRoutes.clear();
+}
+
+void TruckSimulationClient::setRoutingMode(
+    RoutingMode mode)
+{
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    if (m_routingMode != mode)
+    {
+        m_routingMode = mode;
+        m_routeCache.clear();
+    }
+}
+
+TruckSimulationClient::RoutingMode
+TruckSimulationClient::getRoutingMode() const
+{
+    Commons::ScopedReadLock locker(m_dataMutex);
+    return m_routingMode;
+}
+
+void TruckSimulationClient::setRerouteInterval(
+    double seconds)
+{
+    Commons::ScopedWriteLock locker(m_dataMutex);
+    m_rerouteInterval = qMax(0.0, seconds);
+    m_nextRerouteTime = 0.0;
+
+    // Trips routed within one interval share the links
+    m_congestion.setAssignmentPeriod(m_rerouteInterval);
+    if (m_routingMode == RoutingMode::CongestedTime)
+    {
+        m_routeCache.clear();
+    }
+}
+
+QList<int>
+TruckSimulationClient::findRoute(int originId,
+                                 int destinationId)
+{
+    return findRoutes(originId, {destinationId})
+        .value(destinationId);
+}
+
+QHash<int, QList<int>> TruckSimulationClient::findRoutes(
+    int originId, const QSet<int> &destinationIds)
+{
+    QHash<int, QList<int>>                  routes;
+    QSet<int>                               missing;
+    QSharedPointer<const TruckRoutingGraph> graph;
+    QVector<float>                          costs;
+    bool                                    cached;
+    {
+        Commons::ScopedReadLock locker(m_dataMutex);
+        graph  = m_routingGraph;
+        cached = m_routingMode
+                     == RoutingMode::ShortestDistance
+                 || m_rerouteInterval > 0.0;
+        if (m_routingMode == RoutingMode::CongestedTime)
+        {
+            // Shares the array; updates detach from it
+            costs = m_congestion.travelTimes();
+        }
+
+        for (int destinationId : destinationIds)
+        {
+            auto it = m_routeCache.constFind(
+                qMakePair(originId, destinationId));
+            if (cached && it != m_routeCache.constEnd())
+            {
+                routes.insert(destinationId, *it);
+            }
+            else
+            {
+                missing.insert(destinationId);
+            }
+        }
+    }
+
+    // Fallback to default link IDs if no graph is
+    // available
+    if (!graph)
+    {
+        for (int destinationId : missing)
+        {
+            routes.insert(destinationId, {1, 2, 3});
+        }
+        return routes;
+    }
+
+    if (missing.isEmpty())
+    {
+        return routes;
+    }
+
+    QHash<int, QList<int>> found = graph->findRoutes(
+        originId, missing,
+        costs.isEmpty() ? nullptr : &costs);
+
+    // Unreachable destinations get an empty route
+    for (int destinationId : missing)
+    {
+        routes.insert(destinationId,
+                      found.value(destinationId));
+    }
+
+    if (cached)
+    {
+        Commons::ScopedWriteLock locker(m_dataMutex);
+        if (m_routingGraph == graph)
+        {
+            for (int destinationId : missing)
+            {
+                m_routeCache.insert(
+                    qMakePair(originId, destinationId),
+                    routes.value(destinationId));
+            }
+        }
+    }
+    return routes;
+}
+
+void TruckSimulationClient::loadTripRoute(
+    int tripId, const QList<int> &linkIds)
+{
+    if (!m_routingGraph || linkIds.isEmpty())
+    {
+        return;
+    }
+
+    m_tripRoutes.insert(tripId, linkIds);
+    m_congestion.addRoute(linkIds);
+}
+
+void TruckSimulationClient::unloadTripRoute(int tripId)
+{
+    auto it = m_tripRoutes.find(tripId);
+    if (it == m_tripRoutes.end())
+    {
+        return;
+    }
+
+    m_congestion.removeRoute(*it);
+    m_tripRoutes.erase(it);
 }
 
 void TruckSimulationClient::registerTripEndCallback(
@@ -425,6 +758,7 @@ void TruckSimulationClient::processMessage(
                    MessageFormatter::MessageCode::SYNC_REQ))
     {
         // First, update data with the lock held
+        QList<TruckStatePointer> changed;
         {
             Commons::ScopedWriteLock locker(m_dataMutex);
             m_simulationTimes[networkName] =
@@ -432,8 +766,25 @@ void TruckSimulationClient::processMessage(
             m_simulationHorizons[networkName] =
                 parts[9].toDouble();
             m_lastRequestId = parts[0].toInt();
+
+            // Refresh congested routes once per interval
+            double time = m_simulationTimes[networkName];
+            if (m_routingMode == RoutingMode::CongestedTime
+                && m_rerouteInterval > 0.0
+                && time >= m_nextRerouteTime)
+            {
+                m_routeCache.clear();
+                m_nextRerouteTime =
+                    time + m_rerouteInterval;
+            }
+
+            changed = takeChangedTruckStates();
         }
 
+        // Readers see each sync step as one generation
+        publishTruckStates(changed);
+        flushTruckStates();
+
         // Then, run simulator without holding the lock
         runSimulator({networkName});
         return;
@@ -461,21 +812,26 @@ void TruckSimulationClient::processMessage(
             == static_cast<int>(
                 MessageFormatter::MessageCode::TRIP_END))
         {
-            TruckState *state = nullptr;
-            TripEndData tripData;
+            TruckState              *state = nullptr;
+            TripEndData              tripData;
+            QList<TruckStatePointer> changed;
 
             // First, update state with the lock held and
             // gather needed data
             {
                 Commons::ScopedWriteLock locker(
                     m_dataMutex);
-                state = const_cast<TruckState *>(
-                    getTruckState(networkName, tripId));
+                state = findTruckState(networkName, tripId);
+
+                // The truck no longer loads its route
+                unloadTripRoute(tripId.toInt());
 
                 if (state)
                 {
                     // Update state
                     state->updateFromJson(payload);
+                    recordTruckState(state);
+                    m_changedTruckStates.insert(state);
 
                     // Create trip end data for later
                     // emission
@@ -494,8 +850,12 @@ void TruckSimulationClient::processMessage(
                         payload["Travel_Time"].toDouble();
                     tripData.rawData = payload;
                 }
+
+                changed = takeChangedTruckStates();
             }
 
+            publishTruckStates(changed);
+
             // Emit signals outside the lock scope if we
             // found a valid state
             if (state)
@@ -503,6 +863,13 @@ void TruckSimulationClient::processMessage(
                 emit tripEnded(networkName, tripId);
                 emit tripEndedWithData(tripData);
             }
+            else
+            {
+                // Still free the trip's slot in the async
+                // pipeline
+                m_asyncTripManager->onTripEnded(
+                    networkName, tripId, payload);
+            }
 
             return;
         }
@@ -513,13 +880,15 @@ void TruckSimulationClient::processMessage(
                          TRIP_INFO))
         {
             Commons::ScopedWriteLock locker(m_dataMutex);
-            auto *state = const_cast<TruckState *>(
-                getTruckState(networkName, tripId));
+            auto *state =
+                findTruckState(networkName, tripId);
 
             if (state)
             {
                 // Update state with info
                 state->updateInfoFromJson(payload);
+                recordTruckState(state);
+                m_changedTruckStates.insert(state);
             }
 
             return;
@@ -527,6 +896,93 @@ void TruckSimulationClient::processMessage(
     }
 }
 
+void TruckSimulationClient::recordTruckState(
+    const TruckState *state)
+{
+    if (!stateRecorder())
+    {
+        return;
+    }
+
+    VehicleStateRecorder::Sample sample;
+    sample.time = m_simulationTimes.value(
+        state->networkName(), 0.0);
+
+    // Trucks report links, not coordinates; place them at
+    // the start of their current link
+    QPointF position;
+    if (m_routingGraph
+        && m_routingGraph->linkStart(
+            state->linkId().toInt(), position))
+    {
+        sample.x = position.x();
+        sample.y = position.y();
+    }
+
+    sample.distance = state->distance();
+    sample.speed    = state->speed();
+    sample.energy   = state->fuelConsumption();
+    sample.containers = m_containerManager->containerCount(
+        QString("Truck_%1").arg(state->tripId()));
+    recordVehicleState(state->networkName(),
+                       state->tripId(), sample);
+}
+
+QList<TruckSimulationClient::TruckStatePointer>
+TruckSimulationClient::takeChangedTruckStates()
+{
+    QList<TruckStatePointer> states;
+    states.reserve(m_changedTruckStates.size());
+    for (const TruckState *state : m_changedTruckStates)
+    {
+        states.append(TruckStatePointer(state->clone()));
+    }
+    m_changedTruckStates.clear();
+    return states;
+}
+
+void TruckSimulationClient::publishTruckStates(
+    const QList<TruckStatePointer> &states)
+{
+    if (states.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_publishMutex);
+    for (const TruckStatePointer &state : states)
+    {
+        m_truckGeneration[state->networkName()].insert(
+            state->tripId(), state);
+    }
+    m_generationChanged = true;
+
+    if (!m_flushScheduled)
+    {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(
+            this, &TruckSimulationClient::flushTruckStates,
+            Qt::QueuedConnection);
+    }
+}
+
+void TruckSimulationClient::flushTruckStates()
+{
+    QMutexLocker locker(&m_publishMutex);
+    m_flushScheduled = false;
+    if (m_generationChanged)
+    {
+        m_generationChanged = false;
+        m_truckSnapshots.publish(m_truckGeneration);
+    }
+}
+
+TruckSimulationClient::TruckStatesSnapshot
+TruckSimulationClient::getTruckStatesSnapshot() const
+{
+    return m_truckSnapshots.load();
+}
+
 bool TruckSimulationClient::launchSimulator(
     const QString &networkName,
     const QString &masterFilePath, double simTime,
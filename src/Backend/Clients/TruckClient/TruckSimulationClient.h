@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "Backend/Clients/BaseClient/ContainerManager.h"
 #include "Backend/Clients/BaseClient/SimulationClientBase.h"
 #include "Backend/Clients/TruckClient//MessageFormatter.h"
 #include "Backend/Clients/TruckClient/AsyncTripManager.h"
@@ -14,13 +15,20 @@
 #include "Backend/Clients/TruckClient/TruckState.h"
 #include "Backend/Commons/ClientType.h"
 #include "Backend/Commons/DirectedGraph.h"
+#include "Backend/Commons/SnapshotPublisher.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
-#include "ContainerManager.h"
 #include "TransportationGraph.h"
+#include "TruckCongestionModel.h"
+#include "TruckRoutingGraph.h"
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QPair>
 #include <QReadWriteLock>
 #include <QObject>
 #include <QProcess>
+#include <QSharedPointer>
+#include <QSet>
 #include <QStringList>
 #include <containerLib/container.h>
 
@@ -50,6 +58,36 @@ class TruckSimulationClient : public SimulationClientBase
     Q_OBJECT
 
 public:
+    /**
+     * @brief Cost minimized when routing new trips
+     */
+    enum class RoutingMode
+    {
+        /// Shortest length; routes are cached
+        ShortestDistance,
+        /// Least travel time under the trips currently
+        /// assigned, using BPR link times
+        CongestedTime
+    };
+
+    /**
+     * @brief Shared, immutable state of one truck
+     */
+    using TruckStatePointer =
+        QSharedPointer<const TruckState>;
+
+    /**
+     * @brief Truck states by network name and trip ID
+     */
+    using TruckStates =
+        QMap<QString, QHash<QString, TruckStatePointer>>;
+
+    /**
+     * @brief Immutable, shared generation of truck states
+     */
+    using TruckStatesSnapshot =
+        Commons::SnapshotPublisher<TruckStates>::Snapshot;
+
     /**
      * @brief Constructor
      * @param exePath Path to simulation executable
@@ -131,6 +169,22 @@ public:
                     const QList<ContainerCore::Container *>
                         &containers = {});
 
+    /**
+     * @brief Adds many trips synchronously
+     *
+     * Routes are searched once per origin for all of its
+     * destinations, and the ADD_TRIP messages are published
+     * in batches of MAX_TRIPS_PER_PUBLISH. In
+     * RoutingMode::CongestedTime the trips of each origin
+     * are loaded before the next origin is searched, so
+     * later origins route around them.
+     *
+     * @param trips Trips to add
+     * @return Trip identifiers in the order of the
+     * requests, empty strings for trips that failed
+     */
+    QStringList addTrips(const QList<TripRequest> &trips);
+
     /**
      * @brief Adds a trip asynchronously
      * @param networkName Network identifier
@@ -147,6 +201,43 @@ public:
                  const QList<ContainerCore::Container *>
                      &containers = {});
 
+    /**
+     * @brief Adds a cohort of trips asynchronously
+     *
+     * The trips wait in the async pipeline for a slot of
+     * the in-flight window and are started in batches
+     * through addTrips().
+     *
+     * @param trips Trips to add
+     * @return Future that completes when every trip has
+     * ended; result i belongs to trip i
+     */
+    QFuture<TripResult>
+    addTripsAsync(const QList<TripRequest> &trips);
+
+    /**
+     * @brief Cancels a running trip
+     * @param tripId Trip identifier
+     * @return True if the trip was cancelled
+     */
+    bool cancelTrip(const QString &tripId);
+
+    /**
+     * @brief Sets the number of async trips allowed to
+     * run in the simulator at once
+     * @param maxTrips Maximum running trips, 0 for no
+     * limit
+     */
+    void setMaxTripsInFlight(int maxTrips);
+
+    /**
+     * @brief Sets the time an async trip may run without
+     * a TRIP_END before it fails and is cancelled
+     * @param seconds Timeout in wall-clock seconds, 0 to
+     * wait forever
+     */
+    void setTripTimeout(int seconds);
+
     /**
      * @brief Gets a truck state by ID
      * @param networkName Network identifier
@@ -166,6 +257,19 @@ public:
     QList<const TruckState *> getAllNetworkTrucksStates(
         const QString &networkName) const;
 
+    /**
+     * @brief Gets the latest published truck states
+     *
+     * States changed by trip updates are published once
+     * per sync step; trip ends between steps are published
+     * together once the client's event loop pass ends.
+     * Does not take the data lock; the snapshot does not
+     * change while it is held.
+     *
+     * @return Snapshot of all networks, never null
+     */
+    TruckStatesSnapshot getTruckStatesSnapshot() const;
+
     /**
      * @brief Gets simulation progress
      * @param networkName Network identifier
@@ -184,10 +288,52 @@ public:
 
     /**
      * @brief Sets the transportation network graph
-     * @param graph Pointer to transportation graph
+     *
+     * Builds an integer-indexed routing snapshot of the
+     * graph, so later changes to it are not seen until it
+     * is set again. Passing nullptr restores the default
+     * route.
+     *
+     * @param graph Network graph, e.g. from
+     * IntegrationNetwork::getGraph()
      */
     void setNetworkGraph(
-        const TransportationGraph<QString> *graph);
+        const TransportationGraph<int> *graph);
+
+    /**
+     * @brief Sets the cost minimized by new trips
+     *
+     * Cached routes are dropped. Link loads are tracked in
+     * both modes, so switching mid-simulation routes
+     * against the trips already running.
+     *
+     * @param mode Routing mode
+     */
+    void setRoutingMode(RoutingMode mode);
+
+    /**
+     * @brief Gets the cost minimized by new trips
+     */
+    RoutingMode getRoutingMode() const;
+
+    /**
+     * @brief Sets how often congested routes are refreshed
+     *
+     * With a positive interval, RoutingMode::CongestedTime
+     * caches routes like the distance mode and drops the
+     * cache whenever the simulation time advances by the
+     * interval, trading route freshness for fewer
+     * searches. With 0, the default, every trip is routed
+     * against the latest loads. Running trips keep their
+     * routes either way.
+     *
+     * The interval is also the period over which the
+     * trucks assigned to a link are spread to get its flow
+     * (see TruckCongestionModel); 0 uses one hour.
+     *
+     * @param seconds Interval in simulation seconds
+     */
+    void setRerouteInterval(double seconds);
 
     /**
      * @brief Registers a callback for trip end events
@@ -230,6 +376,97 @@ protected:
     processMessage(const QJsonObject &message) override;
 
 private:
+    /** Maximum ADD_TRIP messages in one published batch */
+    static constexpr int MAX_TRIPS_PER_PUBLISH = 1000;
+
+    /**
+     * @brief Gets the route links of an origin-destination
+     * pair, searching the graph only on a cache miss
+     * @param originId Origin node identifier
+     * @param destinationId Destination node identifier
+     * @return Link identifiers of the route
+     */
+    QList<int> findRoute(int originId, int destinationId);
+
+    /**
+     * @brief Gets the route links from an origin to several
+     * destinations with at most one graph search
+     * @param originId Origin node identifier
+     * @param destinationIds Destination node identifiers
+     * @return Link identifiers by destination, empty for
+     * unreachable destinations
+     */
+    QHash<int, QList<int>>
+    findRoutes(int              originId,
+               const QSet<int> &destinationIds);
+
+    /**
+     * @brief Looks up a truck state; the caller holds the
+     * data lock
+     * @param networkName Network identifier
+     * @param tripId Trip identifier
+     * @return The state, nullptr if unknown
+     */
+    TruckState *findTruckState(const QString &networkName,
+                               const QString &tripId) const;
+
+    /**
+     * @brief Adds a trip's route to the link loads; the
+     * caller holds the write lock
+     */
+    void loadTripRoute(int               tripId,
+                       const QList<int> &linkIds);
+
+    /**
+     * @brief Removes a trip's route from the link loads;
+     * the caller holds the write lock
+     */
+    void unloadTripRoute(int tripId);
+
+    /**
+     * @brief Sends CANCEL_TRIP for a trip
+     *
+     * The trip's route is unloaded when its TRIP_END
+     * arrives, as for any other trip.
+     *
+     * @param tripId Trip identifier
+     * @return True if the command was sent
+     */
+    bool sendCancelTrip(const QString &tripId);
+
+    /**
+     * @brief Records a truck's latest state if recording is
+     * on; the caller holds the data lock
+     *
+     * The position is the start of the truck's current
+     * link, so it advances link by link, and stays at the
+     * origin without a routing graph.
+     */
+    void recordTruckState(const TruckState *state);
+
+    /**
+     * @brief Copies the states changed since the last call;
+     * the caller holds the write lock
+     */
+    QList<TruckStatePointer> takeChangedTruckStates();
+
+    /**
+     * @brief Stages updated states for the next generation
+     *
+     * The generation is published by flushTruckStates(),
+     * queued once per event-loop pass.
+     *
+     * @param states Copies from takeChangedTruckStates()
+     */
+    void publishTruckStates(
+        const QList<TruckStatePointer> &states);
+
+    /**
+     * @brief Publishes the staged states, if any, as one
+     * generation
+     */
+    void flushTruckStates();
+
     /**
      * @brief Launches the simulator process
      * @param networkName Network identifier
@@ -250,8 +487,31 @@ private:
     /** Map of network names to simulator processes */
     QMap<QString, QProcess *> m_processes;
 
-    /** Map of network names to truck states */
-    QMap<QString, QList<TruckState *>> m_truckStates;
+    /** Truck states by network name and trip ID */
+    QMap<QString, QHash<QString, TruckState *>>
+        m_truckStates;
+
+    /** States changed since the last publication */
+    QSet<const TruckState *> m_changedTruckStates;
+
+    /** Working copy of the next published generation,
+     * protected by m_publishMutex */
+    TruckStates m_truckGeneration;
+
+    /** Published generations of truck states */
+    Commons::SnapshotPublisher<TruckStates>
+        m_truckSnapshots;
+
+    /** Serializes publishers of m_truckSnapshots */
+    QMutex m_publishMutex;
+
+    /** Whether states were staged since the last
+     * publication, protected by m_publishMutex */
+    bool m_generationChanged = false;
+
+    /** Whether flushTruckStates() is queued, protected by
+     * m_publishMutex */
+    bool m_flushScheduled = false;
 
     /** Map of network names to current simulation times */
     QMap<QString, double> m_simulationTimes;
@@ -283,10 +543,32 @@ private:
      * performance for read-heavy workloads.
      */
     mutable QReadWriteLock m_dataMutex;
+    Commons::LockName      m_dataMutexName{
+        &m_dataMutex, "TruckClient.data"};
+
+    /** Routing snapshot of the network graph, null if
+     * none is set; searches run on a copy of the pointer
+     * outside the lock */
+    QSharedPointer<const TruckRoutingGraph> m_routingGraph;
+
+    /** Route links by origin and destination node */
+    QHash<QPair<int, int>, QList<int>> m_routeCache;
+
+    /** Cost minimized by new trips */
+    RoutingMode m_routingMode =
+        RoutingMode::ShortestDistance;
+
+    /** Vehicles and travel times of the network links */
+    TruckCongestionModel m_congestion;
+
+    /** Route links of the running trips by trip ID */
+    QHash<int, QList<int>> m_tripRoutes;
+
+    /** Congested route refresh interval, 0 if disabled */
+    double m_rerouteInterval = 0.0;
 
-    /** Pointer to transportation network graph */
-    const TransportationGraph<QString> *m_networkGraph =
-        nullptr;
+    /** Simulation time of the next route refresh */
+    double m_nextRerouteTime = 0.0;
 
     /** Manager for trip end callbacks */
     TripEndCallbackManager *m_tripEndCallbackManager;
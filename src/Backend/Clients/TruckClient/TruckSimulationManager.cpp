@@ -202,17 +202,30 @@ bool TruckSimulationManager::createClient(
     // Store client and configuration
     {
         Commons::ScopedWriteLock locker(m_mutex);
+        client->setStateRecorder(m_stateRecorder);
+        client->setRoutingMode(m_routingMode);
+        client->setRerouteInterval(m_rerouteInterval);
         m_clients[networkName]       = client;
         m_clientConfigs[networkName] = config;
         m_clientThreads[networkName] = clientThread;
     }
 
+    // Route on the configured network
+    bindClientNetwork(client, nullptr, config.network);
+
     // Move client to its thread
     client->moveToThread(clientThread);
 
     // Initialize the client in its thread
     initializeClientInThread(client, networkName);
 
+    // Its async trip pipeline exists once initialized
+    {
+        Commons::ScopedReadLock locker(m_mutex);
+        client->setMaxTripsInFlight(m_maxTripsInFlight);
+        client->setTripTimeout(m_tripTimeout);
+    }
+
     // Start the thread
     clientThread->start();
 
@@ -376,11 +389,16 @@ bool TruckSimulationManager::updateClientConfig(
     client->endSimulator({networkName});
 
     // Update configuration with write lock
+    IntegrationNetwork *previous = nullptr;
     {
         Commons::ScopedWriteLock locker(m_mutex);
+        previous = m_clientConfigs[networkName].network;
         m_clientConfigs[networkName] = config;
     }
 
+    // Rebuild the routing graph of the redefined network
+    bindClientNetwork(client, previous, config.network);
+
     // Define simulator with updated config
     bool success = client->defineSimulator(
         networkName, config.masterFilePath, config.simTime,
@@ -394,6 +412,34 @@ bool TruckSimulationManager::updateClientConfig(
     return success;
 }
 
+void TruckSimulationManager::bindClientNetwork(
+    TruckSimulationClient *client,
+    IntegrationNetwork    *previous,
+    IntegrationNetwork    *network)
+{
+    if (previous && previous != network)
+    {
+        disconnect(previous, nullptr, client, nullptr);
+    }
+
+    client->setNetworkGraph(network ? network->getGraph()
+                                    : nullptr);
+
+    if (network && previous != network)
+    {
+        // Reinitializing the network replaces its graph
+        QPointer<IntegrationNetwork> guard(network);
+        connect(network, &IntegrationNetwork::networkChanged,
+                client, [client, guard]() {
+                    if (guard)
+                    {
+                        client->setNetworkGraph(
+                            guard->getGraph());
+                    }
+                });
+    }
+}
+
 QStringList
 TruckSimulationManager::getAllClientNames() const
 {
@@ -640,6 +686,44 @@ TruckSimulationClient *TruckSimulationManager::getClient(
     return m_clients.value(networkName, nullptr);
 }
 
+void TruckSimulationManager::setStateRecorder(
+    std::shared_ptr<VehicleStateRecorder> recorder)
+{
+    Commons::ScopedWriteLock locker(m_mutex);
+    m_stateRecorder = recorder;
+    for (auto *client : m_clients.values())
+    {
+        client->setStateRecorder(recorder);
+    }
+}
+
+void TruckSimulationManager::setTripLimits(
+    int maxTripsInFlight, int tripTimeout)
+{
+    Commons::ScopedWriteLock locker(m_mutex);
+    m_maxTripsInFlight = maxTripsInFlight;
+    m_tripTimeout      = tripTimeout;
+    for (auto *client : m_clients.values())
+    {
+        client->setMaxTripsInFlight(maxTripsInFlight);
+        client->setTripTimeout(tripTimeout);
+    }
+}
+
+void TruckSimulationManager::setRouting(
+    TruckSimulationClient::RoutingMode mode,
+    double                             rerouteInterval)
+{
+    Commons::ScopedWriteLock locker(m_mutex);
+    m_routingMode     = mode;
+    m_rerouteInterval = rerouteInterval;
+    for (auto *client : m_clients.values())
+    {
+        client->setRoutingMode(mode);
+        client->setRerouteInterval(rerouteInterval);
+    }
+}
+
 QThread *TruckSimulationManager::createClientThread(
     const QString &networkName)
 {
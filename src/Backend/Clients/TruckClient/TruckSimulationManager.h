@@ -9,9 +9,11 @@
 
 #include "Backend/Commons/LoggerInterface.h"
 #include "Backend/Commons/ThreadSafetyUtils.h"
+#include "TruckNetwork.h"
 #include "TruckSimulationClient.h"
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 #include <QReadWriteLock>
 #include <QString>
 #include <QStringList>
@@ -44,6 +46,9 @@ struct ClientConfiguration
         configUpdates; ///< Custom configuration parameters
     QStringList
         argsUpdates; ///< Additional command-line arguments
+    QPointer<IntegrationNetwork>
+        network; ///< Network trips are routed on, rebuilt
+                 ///< whenever the network is reinitialized
 
     bool isValid() const
     {
@@ -215,6 +220,36 @@ public:
     TruckSimulationClient *
     getClient(const QString &networkName);
 
+    /**
+     * @brief Records the truck states of all clients,
+     * including those created later
+     * @param recorder Recorder, nullptr to stop recording;
+     * shared with the clients
+     */
+    void setStateRecorder(
+        std::shared_ptr<VehicleStateRecorder> recorder);
+
+    /**
+     * @brief Sets the async trip limits of all clients,
+     * including those created later
+     * @param maxTripsInFlight Maximum running async trips
+     * per client, 0 for no limit
+     * @param tripTimeout Seconds an async trip may run
+     * without ending, 0 to wait forever
+     */
+    void setTripLimits(int maxTripsInFlight,
+                       int tripTimeout);
+
+    /**
+     * @brief Sets how all clients, including those created
+     * later, route new trips
+     * @param mode Cost minimized by new trips
+     * @param rerouteInterval Simulation seconds between
+     * congested route refreshes, 0 to route every trip
+     */
+    void setRouting(TruckSimulationClient::RoutingMode mode,
+                    double rerouteInterval);
+
 private:
     /**
      * @brief Check if simulations should continue
@@ -247,6 +282,21 @@ private:
     initializeClientInThread(TruckSimulationClient *client,
                              const QString &networkName);
 
+    /**
+     * @brief Sets the client's routing graph from the
+     * configured network
+     *
+     * The graph is rebuilt whenever the network is
+     * reinitialized, until another network is bound.
+     *
+     * @param client The client to route
+     * @param previous Network bound before, may be null
+     * @param network Network to bind, may be null
+     */
+    void bindClientNetwork(TruckSimulationClient *client,
+                           IntegrationNetwork    *previous,
+                           IntegrationNetwork    *network);
+
     /** Global simulation time reference */
     SimulationTime *m_defaultSimulationTime = nullptr;
 
@@ -266,8 +316,23 @@ private:
     /** Map of network names to client configurations */
     QMap<QString, ClientConfiguration> m_clientConfigs;
 
+    /** Recorder set on every client */
+    std::shared_ptr<VehicleStateRecorder> m_stateRecorder;
+
+    /** Async trip limits set on every client */
+    int m_maxTripsInFlight = 0;
+    int m_tripTimeout      = 0;
+
+    /** Routing set on every client */
+    TruckSimulationClient::RoutingMode m_routingMode =
+        TruckSimulationClient::RoutingMode::
+            ShortestDistance;
+    double m_rerouteInterval = 0.0;
+
     /** Mutex for thread-safe access to internal data */
     mutable QReadWriteLock m_mutex;
+    Commons::LockName      m_mutexName{
+        &m_mutex, "TruckManager.clients"};
 
     /** Wait interval for synchronous simulation (seconds)
      */
@@ -91,6 +91,20 @@ QJsonObject TruckState::toJson() const
     return json;
 }
 
+TruckState *TruckState::clone(QObject *parent) const
+{
+    auto *copy =
+        new TruckState(m_networkName, m_tripId, m_originId,
+                       m_destinationId, parent);
+    copy->m_linkId          = m_linkId;
+    copy->m_distance        = m_distance;
+    copy->m_speed           = m_speed;
+    copy->m_fuelConsumption = m_fuelConsumption;
+    copy->m_travelTime      = m_travelTime;
+    copy->m_isCompleted     = m_isCompleted;
+    return copy;
+}
+
 void TruckState::updateFromJson(const QJsonObject &jsonData)
 {
     m_networkName =
@@ -35,6 +35,13 @@ public:
     QVariantMap info() const;
     QJsonObject toJson() const;
 
+    /**
+     * @brief Creates an independent copy of the state
+     * @param parent Parent of the copy
+     * @return The copy, owned by the caller or parent
+     */
+    TruckState *clone(QObject *parent = nullptr) const;
+
     void updateFromJson(const QJsonObject &jsonData);
     void updateInfoFromJson(const QJsonObject &jsonData);
 
@@ -0,0 +1,313 @@
+#include "ContainerBatchCodec.h"
+#include <QByteArray>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QSet>
+#include <QStringList>
+#include <QtEndian>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+const QString ContainerBatchCodec::FORMAT = "columnar-v1";
+
+QJsonObject ContainerBatchCodec::encode(
+    const QList<ContainerCore::Container *> &containers,
+    bool                                     compress)
+{
+    QJsonArray containersArray;
+    for (const auto *container : containers)
+    {
+        if (container)
+        {
+            containersArray.append(container->toJson());
+        }
+    }
+    return encodeJson(containersArray, compress);
+}
+
+QJsonObject ContainerBatchCodec::encodeJson(
+    const QJsonArray &containers, bool compress)
+{
+    QVector<QJsonObject> rows;
+    rows.reserve(containers.size());
+    for (const QJsonValue &value : containers)
+    {
+        rows.append(value.toObject());
+    }
+
+    QHash<QString, int> dictionaryIndex;
+    QJsonArray          dictionary;
+
+    QJsonObject batch;
+    batch["format"] = FORMAT;
+    batch["count"]  = rows.size();
+    batch["columns"] =
+        encodeColumns(rows, dictionaryIndex, dictionary);
+    batch["dictionary"] = dictionary;
+
+    if (!compress)
+    {
+        return batch;
+    }
+
+    QByteArray encoded =
+        QJsonDocument(batch).toJson(QJsonDocument::Compact);
+    if (encoded.size() < COMPRESSION_THRESHOLD)
+    {
+        return batch;
+    }
+
+    // Wrap the compressed batch; qCompress() prepends the
+    // uncompressed size, which is sent as a field instead
+    // so the payload is a plain zlib stream
+    QJsonObject compressed;
+    compressed["format"]      = FORMAT;
+    compressed["compression"] = "zlib";
+    compressed["size"]        = encoded.size();
+    compressed["payload"]     = QString::fromLatin1(
+        qCompress(encoded).mid(4).toBase64());
+    return compressed;
+}
+
+bool ContainerBatchCodec::isBatch(const QJsonValue &value)
+{
+    return value.isObject()
+           && value.toObject()["format"].toString()
+                  == FORMAT;
+}
+
+QJsonArray
+ContainerBatchCodec::decodeJson(const QJsonValue &value)
+{
+    // Plain arrays pass through unchanged
+    if (value.isArray())
+    {
+        return value.toArray();
+    }
+    if (!isBatch(value))
+    {
+        return QJsonArray();
+    }
+
+    QJsonObject batch = value.toObject();
+    if (batch.contains("compression"))
+    {
+        if (batch["compression"].toString() != "zlib")
+        {
+            qWarning() << "Unsupported container batch "
+                          "compression:"
+                       << batch["compression"].toString();
+            return QJsonArray();
+        }
+
+        // Restore the size header qUncompress() expects
+        const quint32 size = static_cast<quint32>(
+            batch["size"].toInteger());
+        QByteArray stream(4, '\0');
+        qToBigEndian(size, stream.data());
+        stream += QByteArray::fromBase64(
+            batch["payload"].toString().toLatin1());
+
+        QByteArray decoded = qUncompress(stream);
+        batch = QJsonDocument::fromJson(decoded).object();
+    }
+
+    QJsonArray containers;
+    for (const QJsonObject &row : decodeColumns(
+             batch["columns"].toObject(),
+             batch["count"].toInt(),
+             batch["dictionary"].toArray()))
+    {
+        containers.append(row);
+    }
+    return containers;
+}
+
+QList<ContainerCore::Container *>
+ContainerBatchCodec::decode(const QJsonValue &value)
+{
+    QList<ContainerCore::Container *> containers;
+    for (const QJsonValue &row : decodeJson(value))
+    {
+        containers.append(
+            new ContainerCore::Container(row.toObject()));
+    }
+    return containers;
+}
+
+QJsonObject ContainerBatchCodec::encodeColumns(
+    const QVector<QJsonObject> &rows,
+    QHash<QString, int>        &dictionaryIndex,
+    QJsonArray                 &dictionary)
+{
+    // Fields in order of first appearance
+    QStringList   fields;
+    QSet<QString> seenFields;
+    for (const QJsonObject &row : rows)
+    {
+        for (auto it = row.constBegin();
+             it != row.constEnd(); ++it)
+        {
+            if (!seenFields.contains(it.key()))
+            {
+                seenFields.insert(it.key());
+                fields.append(it.key());
+            }
+        }
+    }
+
+    QJsonObject columns;
+    for (const QString &field : fields)
+    {
+        bool    allStrings = true;
+        bool    allObjects = true;
+        QString mask;
+        mask.reserve(rows.size());
+        for (const QJsonObject &row : rows)
+        {
+            auto it = row.constFind(field);
+            if (it == row.constEnd())
+            {
+                mask.append(QLatin1Char('0'));
+                continue;
+            }
+            mask.append(QLatin1Char('1'));
+            allStrings &= it.value().isString();
+            allObjects &= it.value().isObject();
+        }
+
+        QJsonObject column;
+        if (mask.contains(QLatin1Char('0')))
+        {
+            column["present"] = mask;
+        }
+
+        if (allStrings)
+        {
+            // Dictionary indices shared by the batch
+            QJsonArray values;
+            for (const QJsonObject &row : rows)
+            {
+                auto it = row.constFind(field);
+                if (it == row.constEnd())
+                {
+                    continue;
+                }
+                QString text = it.value().toString();
+                int     index =
+                    dictionaryIndex.value(text, -1);
+                if (index < 0)
+                {
+                    index = dictionary.size();
+                    dictionaryIndex.insert(text, index);
+                    dictionary.append(text);
+                }
+                values.append(index);
+            }
+            column["type"]   = "s";
+            column["values"] = values;
+        }
+        else if (allObjects)
+        {
+            QVector<QJsonObject> nested;
+            for (const QJsonObject &row : rows)
+            {
+                auto it = row.constFind(field);
+                if (it != row.constEnd())
+                {
+                    nested.append(it.value().toObject());
+                }
+            }
+            column["type"]    = "o";
+            column["count"]   = nested.size();
+            column["columns"] = encodeColumns(
+                nested, dictionaryIndex, dictionary);
+        }
+        else
+        {
+            QJsonArray values;
+            for (const QJsonObject &row : rows)
+            {
+                auto it = row.constFind(field);
+                if (it != row.constEnd())
+                {
+                    values.append(it.value());
+                }
+            }
+            column["type"]   = "v";
+            column["values"] = values;
+        }
+
+        columns[field] = column;
+    }
+    return columns;
+}
+
+QVector<QJsonObject> ContainerBatchCodec::decodeColumns(
+    const QJsonObject &columns, int count,
+    const QJsonArray &dictionary)
+{
+    QVector<QJsonObject> rows(qMax(count, 0));
+
+    for (auto it = columns.constBegin();
+         it != columns.constEnd(); ++it)
+    {
+        QJsonObject column = it.value().toObject();
+        QString     type   = column["type"].toString();
+        QString     mask   = column["present"].toString();
+
+        QJsonArray           values;
+        QVector<QJsonObject> nested;
+        if (type == "o")
+        {
+            nested = decodeColumns(
+                column["columns"].toObject(),
+                column["count"].toInt(), dictionary);
+        }
+        else
+        {
+            values = column["values"].toArray();
+        }
+
+        int next = 0;
+        for (int row = 0; row < rows.size(); ++row)
+        {
+            if (!mask.isEmpty()
+                && (row >= mask.size()
+                    || mask[row] != QLatin1Char('1')))
+            {
+                continue;
+            }
+
+            if (type == "o")
+            {
+                if (next < nested.size())
+                {
+                    rows[row][it.key()] = nested[next];
+                }
+            }
+            else if (next < values.size())
+            {
+                QJsonValue value = values.at(next);
+                if (type == "s")
+                {
+                    int index = value.toInt(-1);
+                    bool known =
+                        index >= 0
+                        && index < dictionary.size();
+                    value = known ? dictionary.at(index)
+                                  : QJsonValue();
+                }
+                rows[row][it.key()] = value;
+            }
+            ++next;
+        }
+    }
+    return rows;
+}
+
+} // namespace Backend
+} // namespace CargoNetSim
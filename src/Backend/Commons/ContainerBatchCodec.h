@@ -0,0 +1,133 @@
+#pragma once
+
+/**
+ * @file ContainerBatchCodec.h
+ * @brief Columnar, compressed encoding of container lists
+ * @author Ahmed Aredah
+ * @date March 21, 2025
+ *
+ * This file declares the ContainerBatchCodec class, which
+ * converts container lists between the plain JSON array
+ * sent to the simulation servers and a compact columnar
+ * batch.
+ *
+ * @note Part of the CargoNetSim::Backend namespace.
+ */
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <containerLib/container.h>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+/**
+ * @class ContainerBatchCodec
+ * @brief Encodes container lists as columnar batches
+ *
+ * A batch stores one column per container field instead of
+ * one object per container:
+ * - String fields are dictionary-encoded into indices of a
+ *   dictionary shared by the whole batch
+ * - Object fields (e.g. custom variables) are encoded
+ *   recursively as nested columns
+ * - Other fields keep their JSON values
+ * - Fields missing on some containers carry a presence
+ *   mask
+ *
+ * Batches larger than COMPRESSION_THRESHOLD bytes are zlib
+ * compressed and base64 encoded when compression is
+ * requested. The payload is a standard zlib stream
+ * (RFC 1950) without Qt's 4-byte length prefix, readable by
+ * e.g. Python's zlib.decompress(); "size" holds the length
+ * of the uncompressed compact JSON.
+ *
+ * Layout:
+ * @code
+ * {"format": "columnar-v1", "count": N,
+ *  "dictionary": ["..."],
+ *  "columns": {"field": {"type": "s", "values": [...]}}}
+ * {"format": "columnar-v1", "compression": "zlib",
+ *  "size": <bytes>, "payload": "<base64>"}
+ * @endcode
+ *
+ * Decoding accepts both batches and plain JSON arrays, so
+ * receivers work with either sender.
+ */
+class ContainerBatchCodec
+{
+public:
+    /**
+     * @brief Batch format identifier
+     */
+    static const QString FORMAT;
+
+    /**
+     * @brief Encoded size above which batches are
+     * compressed
+     */
+    static constexpr int COMPRESSION_THRESHOLD = 64 * 1024;
+
+    /**
+     * @brief Encodes containers as a columnar batch
+     * @param containers Containers to encode, nulls skipped
+     * @param compress Compress large batches
+     * @return Batch object
+     */
+    static QJsonObject
+    encode(const QList<ContainerCore::Container *>
+                &containers,
+           bool compress = true);
+
+    /**
+     * @brief Encodes container JSON objects as a batch
+     * @param containers Array of container objects
+     * @param compress Compress large batches
+     * @return Batch object
+     */
+    static QJsonObject
+    encodeJson(const QJsonArray &containers,
+               bool              compress = true);
+
+    /**
+     * @brief Checks whether a value is a columnar batch
+     * @param value JSON value to inspect
+     * @return True if the value is a batch object
+     */
+    static bool isBatch(const QJsonValue &value);
+
+    /**
+     * @brief Decodes a batch or plain array to JSON objects
+     * @param value Batch object or array of containers
+     * @return Array of container objects, empty if invalid
+     */
+    static QJsonArray decodeJson(const QJsonValue &value);
+
+    /**
+     * @brief Decodes a batch or plain array to containers
+     * @param value Batch object or array of containers
+     * @return New containers owned by the caller
+     */
+    static QList<ContainerCore::Container *>
+    decode(const QJsonValue &value);
+
+private:
+    static QJsonObject
+    encodeColumns(const QVector<QJsonObject> &rows,
+                  QHash<QString, int> &dictionaryIndex,
+                  QJsonArray          &dictionary);
+
+    static QVector<QJsonObject>
+    decodeColumns(const QJsonObject &columns, int count,
+                  const QJsonArray &dictionary);
+};
+
+} // namespace Backend
+} // namespace CargoNetSim
@@ -12,11 +12,15 @@
 #include <QJsonObject>
 #include <QMap>
 #include <QMutex>
+#include <QHash>
 #include <QPair>
 #include <QSet>
 #include <QVector>
 #include <algorithm>
+#include <functional>
 #include <limits>
+#include <queue>
+#include <vector>
 
 namespace CargoNetSim
 {
@@ -161,6 +165,19 @@ public:
     getEdgeAttributes(const T &fromNodeId,
                       const T &toNodeId) const;
 
+    /**
+     * @brief Gets one attribute of an edge without copying
+     * the attribute map.
+     * @param fromNodeId The source node identifier.
+     * @param toNodeId The target node identifier.
+     * @param key The attribute name.
+     * @return The value, or an invalid QVariant if the edge
+     * or attribute does not exist.
+     */
+    QVariant getEdgeAttribute(const T       &fromNodeId,
+                              const T       &toNodeId,
+                              const QString &key) const;
+
     /**
      * @brief Sets or updates the attributes of an edge.
      * @param fromNodeId The source node identifier.
@@ -491,6 +508,24 @@ DirectedGraph<T>::getEdgeAttributes(const T &fromNodeId,
     return QMap<QString, QVariant>();
 }
 
+template <typename T>
+QVariant DirectedGraph<T>::getEdgeAttribute(
+    const T &fromNodeId, const T &toNodeId,
+    const QString &key) const
+{
+    auto fromIt = m_edgeAttributes.constFind(fromNodeId);
+    if (fromIt == m_edgeAttributes.constEnd())
+    {
+        return QVariant();
+    }
+    auto toIt = fromIt->constFind(toNodeId);
+    if (toIt == fromIt->constEnd())
+    {
+        return QVariant();
+    }
+    return toIt->value(key);
+}
+
 template <typename T>
 void DirectedGraph<T>::setEdgeAttributes(
     const T &fromNodeId, const T &toNodeId,
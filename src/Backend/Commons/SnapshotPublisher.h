@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file SnapshotPublisher.h
+ * @brief Read-copy-update publication of immutable
+ * snapshots
+ * @author Ahmed Aredah
+ * @date March 21, 2025
+ *
+ * This file declares the SnapshotPublisher class template,
+ * which hands the latest generation of a data set to any
+ * number of reader threads without taking the data lock of
+ * its writer.
+ *
+ * @note Part of the CargoNetSim::Backend::Commons
+ * namespace.
+ */
+
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+namespace Commons
+{
+
+/**
+ * @class SnapshotPublisher
+ * @brief Read-copy-update holder of one immutable value
+ *
+ * The writer builds the next generation privately and
+ * publishes it with a single pointer swap. Readers load
+ * the current pointer and keep the generation alive for as
+ * long as they hold it, so they never wait for the
+ * writer's data lock, never time out and never see a
+ * partly updated value. A generation is freed when its
+ * last reader releases it.
+ *
+ * The atomic shared_ptr functions are not lock-free in
+ * libstdc++: each load and store takes a mutex from a
+ * small global pool, held only for the pointer copy.
+ *
+ * Copying an implicitly shared Qt container into publish()
+ * is O(1), but the writer's working copy detaches on its
+ * next change, copying everything it holds. Publishers
+ * should therefore coalesce changes and publish once per
+ * batch rather than once per change.
+ *
+ * @tparam T Value type of a generation
+ */
+template <typename T> class SnapshotPublisher
+{
+public:
+    using Snapshot = std::shared_ptr<const T>;
+
+    /**
+     * @brief Publishes an empty generation
+     */
+    SnapshotPublisher()
+        : m_current(std::make_shared<const T>())
+    {
+    }
+
+    SnapshotPublisher(const SnapshotPublisher &) = delete;
+    SnapshotPublisher &
+    operator=(const SnapshotPublisher &) = delete;
+
+    /**
+     * @brief Gets the current generation
+     * @return Immutable snapshot, never null
+     */
+    Snapshot load() const
+    {
+        return std::atomic_load_explicit(
+            &m_current, std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Replaces the current generation
+     * @param value Next generation
+     */
+    void publish(T value)
+    {
+        Snapshot next =
+            std::make_shared<const T>(std::move(value));
+        std::atomic_store_explicit(
+            &m_current, std::move(next),
+            std::memory_order_release);
+        m_generation.fetch_add(1,
+                               std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of published generations
+     */
+    quint64 generation() const
+    {
+        return m_generation.load(std::memory_order_relaxed);
+    }
+
+private:
+    Snapshot             m_current;
+    std::atomic<quint64> m_generation{0};
+};
+
+} // namespace Commons
+} // namespace Backend
+} // namespace CargoNetSim
@@ -1,4 +1,7 @@
 #include "ThreadSafetyUtils.h"
+#include <QHash>
+#include <algorithm>
+#include <chrono>
 
 namespace CargoNetSim
 {
@@ -10,6 +13,287 @@ namespace Commons
 // Initialize static member
 QMap<QThread*, QSet<QMutex*>> DeadlockDetector::heldLocks;
 
+std::atomic<bool> LockInstrumentation::s_enabled{false};
+std::atomic<int>  LockInstrumentation::s_waitPolicy{
+    static_cast<int>(LockInstrumentation::WaitPolicy::FailFast)};
+
+namespace
+{
+
+/**
+ * @brief Counters of one lock, updated without locking
+ */
+struct LockRecord
+{
+    QString              name;
+    std::atomic<quint64> acquisitions{0};
+    std::atomic<quint64> contentions{0};
+    std::atomic<quint64> timeouts{0};
+    std::atomic<qint64>  totalWaitNs{0};
+    std::atomic<qint64>  maxWaitNs{0};
+    std::atomic<qint64>  totalHoldNs{0};
+    std::atomic<qint64>  maxHoldNs{0};
+};
+
+// Records are freed by unregisterLock(), so they are only
+// touched with the registry lock held. Names are kept apart
+// so that naming a lock does not create its record. The
+// registry lock is a plain QReadWriteLock so that it is not
+// instrumented itself.
+QReadWriteLock                     registryLock;
+QHash<const void*, LockRecord*>    registry;
+QHash<const void*, QString>        names;
+std::atomic<qint64>                dumpIntervalNs{0};
+std::atomic<qint64>                nextDumpNs{0};
+
+void updateMax(std::atomic<qint64>& max, qint64 value)
+{
+    qint64 current = max.load(std::memory_order_relaxed);
+    while (value > current
+           && !max.compare_exchange_weak(
+               current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+QString defaultName(const void* lock)
+{
+    return QString("0x%1").arg(
+        static_cast<qulonglong>(
+            reinterpret_cast<quintptr>(lock)),
+        0, 16);
+}
+
+QString lockName(const void* lock)
+{
+    return names.value(lock, defaultName(lock));
+}
+
+/**
+ * @brief Runs update on the record of a lock with the
+ * registry lock held
+ * @param create Whether a missing record is created
+ */
+template <typename Update>
+void updateRecord(const void* lock, bool create,
+                  Update update)
+{
+    {
+        QReadLocker locker(&registryLock);
+        if (LockRecord* record = registry.value(lock, nullptr))
+        {
+            update(*record);
+            return;
+        }
+    }
+
+    if (!create)
+    {
+        return;
+    }
+
+    QWriteLocker locker(&registryLock);
+    LockRecord*& record = registry[lock];
+    if (!record)
+    {
+        record       = new LockRecord;
+        record->name = lockName(lock);
+    }
+    update(*record);
+}
+
+double toMs(qint64 ns)
+{
+    return ns / 1e6;
+}
+
+} // namespace
+
+void LockInstrumentation::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void LockInstrumentation::setWaitPolicy(WaitPolicy policy)
+{
+    s_waitPolicy.store(static_cast<int>(policy),
+                       std::memory_order_relaxed);
+}
+
+void LockInstrumentation::setLockName(const void*    lock,
+                                      const QString& name)
+{
+    QWriteLocker locker(&registryLock);
+    names.insert(lock, name);
+    if (LockRecord* record = registry.value(lock, nullptr))
+    {
+        record->name = name;
+    }
+}
+
+void LockInstrumentation::unregisterLock(const void* lock)
+{
+    QWriteLocker locker(&registryLock);
+    names.remove(lock);
+    delete registry.take(lock);
+}
+
+QList<LockInstrumentation::LockStats>
+LockInstrumentation::statistics()
+{
+    QList<LockStats> result;
+    {
+        QReadLocker locker(&registryLock);
+        for (const LockRecord* record : registry)
+        {
+            LockStats stats;
+            stats.name         = record->name;
+            stats.acquisitions = record->acquisitions.load();
+            stats.contentions  = record->contentions.load();
+            stats.timeouts     = record->timeouts.load();
+            stats.totalWaitMs  = toMs(record->totalWaitNs.load());
+            stats.maxWaitMs    = toMs(record->maxWaitNs.load());
+            stats.totalHoldMs  = toMs(record->totalHoldNs.load());
+            stats.maxHoldMs    = toMs(record->maxHoldNs.load());
+            if (stats.acquisitions > 0 || stats.timeouts > 0)
+            {
+                result.append(stats);
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [](const LockStats& a, const LockStats& b) {
+                  return a.totalWaitMs > b.totalWaitMs;
+              });
+    return result;
+}
+
+QString LockInstrumentation::report()
+{
+    QString text = "Lock contention statistics:";
+    for (const LockStats& stats : statistics())
+    {
+        const double contendedPercent =
+            stats.acquisitions > 0
+                ? 100.0 * stats.contentions / stats.acquisitions
+                : 0.0;
+        text += QString("\n  %1: %2 taken, %3 contended "
+                        "(%4%), %5 timed out, wait %6 ms "
+                        "(max %7), hold %8 ms (max %9)")
+                    .arg(stats.name)
+                    .arg(stats.acquisitions)
+                    .arg(stats.contentions)
+                    .arg(contendedPercent, 0, 'f', 1)
+                    .arg(stats.timeouts)
+                    .arg(stats.totalWaitMs, 0, 'f', 3)
+                    .arg(stats.maxWaitMs, 0, 'f', 3)
+                    .arg(stats.totalHoldMs, 0, 'f', 3)
+                    .arg(stats.maxHoldMs, 0, 'f', 3);
+    }
+    return text;
+}
+
+void LockInstrumentation::reset()
+{
+    QReadLocker locker(&registryLock);
+    for (LockRecord* record : registry)
+    {
+        record->acquisitions = 0;
+        record->contentions  = 0;
+        record->timeouts     = 0;
+        record->totalWaitNs  = 0;
+        record->maxWaitNs    = 0;
+        record->totalHoldNs  = 0;
+        record->maxHoldNs    = 0;
+    }
+}
+
+void LockInstrumentation::setDumpInterval(int intervalMs)
+{
+    const qint64 intervalNs =
+        static_cast<qint64>(qMax(0, intervalMs)) * 1000000;
+    nextDumpNs.store(now() + intervalNs);
+    dumpIntervalNs.store(intervalNs);
+}
+
+qint64 LockInstrumentation::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now()
+                   .time_since_epoch())
+        .count();
+}
+
+void LockInstrumentation::recordWait(const void* lock,
+                                     bool        contended,
+                                     bool        timedOut,
+                                     bool        acquired,
+                                     qint64      waitNs)
+{
+    updateRecord(lock, true, [&](LockRecord& record) {
+        if (acquired)
+        {
+            record.acquisitions.fetch_add(
+                1, std::memory_order_relaxed);
+        }
+        if (contended)
+        {
+            record.contentions.fetch_add(
+                1, std::memory_order_relaxed);
+            record.totalWaitNs.fetch_add(
+                waitNs, std::memory_order_relaxed);
+            updateMax(record.maxWaitNs, waitNs);
+        }
+        if (timedOut)
+        {
+            record.timeouts.fetch_add(
+                1, std::memory_order_relaxed);
+        }
+    });
+}
+
+void LockInstrumentation::recordHold(const void* lock,
+                                     qint64      holdNs)
+{
+    // The lock is already released and may be unregistered
+    // by now; never recreate its record
+    updateRecord(lock, false, [holdNs](LockRecord& record) {
+        record.totalHoldNs.fetch_add(
+            holdNs, std::memory_order_relaxed);
+        updateMax(record.maxHoldNs, holdNs);
+    });
+
+    const qint64 intervalNs = dumpIntervalNs.load();
+    if (intervalNs <= 0)
+    {
+        return;
+    }
+
+    // Only the thread that moves the deadline logs
+    const qint64 current = now();
+    qint64       due     = nextDumpNs.load();
+    if (current >= due
+        && nextDumpNs.compare_exchange_strong(
+            due, current + intervalNs))
+    {
+        qDebug().noquote() << report();
+    }
+}
+
+void LockInstrumentation::warnTimeout(const void* lock,
+                                      int         timeout,
+                                      const char* kind)
+{
+    QString name;
+    {
+        QReadLocker locker(&registryLock);
+        name = lockName(lock);
+    }
+    qWarning() << "Waiting beyond" << timeout << "ms for"
+               << kind << name;
+}
+
 } // namespace Commons
 } // namespace Backend
-} // namespace CargoNetSim 
\ No newline at end of file
+} // namespace CargoNetSim
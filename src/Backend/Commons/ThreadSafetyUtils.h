@@ -8,12 +8,15 @@
 #pragma once
 
 #include <QDebug>
+#include <QList>
 #include <QMap>
 #include <QMutex>
 #include <QReadWriteLock>
 #include <QSet>
 #include <QThread>
+#include <atomic>
 #include <stdexcept>
+#include <string>
 
 namespace CargoNetSim
 {
@@ -22,6 +25,229 @@ namespace Backend
 namespace Commons
 {
 
+/**
+ * @class LockInstrumentation
+ * @brief Contention statistics and wait policy of the
+ * scoped locks
+ *
+ * While enabled, every ScopedLock, ScopedReadLock and
+ * ScopedWriteLock records per lock how often it was taken,
+ * how often it had to wait, how long it waited and how long
+ * it was held. Locks are identified by address and can be
+ * given a readable name with setLockName(). Statistics are
+ * read with statistics() or report(), and can be logged
+ * periodically with setDumpInterval().
+ *
+ * No record is created while instrumentation is disabled.
+ * Owners of instrumented locks drop the name and record in
+ * their destructor with unregisterLock(), usually through
+ * a LockName member, so that a lock later allocated at the
+ * same address starts clean.
+ *
+ * The wait policy decides what a timed-out acquisition
+ * does: FailFast throws std::runtime_error (the default),
+ * Wait logs a warning and keeps waiting.
+ *
+ * Disabled instrumentation with the FailFast policy costs
+ * two relaxed atomic loads per acquisition.
+ */
+class LockInstrumentation
+{
+public:
+    enum class WaitPolicy
+    {
+        FailFast, ///< Throw when the timeout expires
+        Wait      ///< Warn when the timeout expires
+    };
+
+    /**
+     * @brief Accumulated statistics of one lock
+     */
+    struct LockStats
+    {
+        QString name;
+        quint64 acquisitions = 0; ///< Successful acquisitions
+        quint64 contentions  = 0; ///< Acquisitions that waited
+        quint64 timeouts     = 0; ///< Waits past the timeout
+        double  totalWaitMs  = 0.0;
+        double  maxWaitMs    = 0.0;
+        double  totalHoldMs  = 0.0;
+        double  maxHoldMs    = 0.0;
+    };
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setWaitPolicy(WaitPolicy policy);
+    static WaitPolicy waitPolicy()
+    {
+        return static_cast<WaitPolicy>(
+            s_waitPolicy.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Names a lock in statistics and warnings
+     */
+    static void setLockName(const void* lock, const QString& name);
+
+    /**
+     * @brief Forgets the name and statistics of a lock;
+     * call before the lock is destroyed
+     */
+    static void unregisterLock(const void* lock);
+
+    /**
+     * @brief Gets the statistics of all locks taken while
+     * enabled, longest total wait first
+     */
+    static QList<LockStats> statistics();
+
+    /**
+     * @brief Formats statistics() as one line per lock
+     */
+    static QString report();
+
+    /**
+     * @brief Clears all statistics, keeping lock names
+     */
+    static void reset();
+
+    /**
+     * @brief Logs report() at most once per interval, from
+     * whichever thread releases a lock after it expires
+     * @param intervalMs Interval, 0 to disable
+     */
+    static void setDumpInterval(int intervalMs);
+
+    /**
+     * @brief Acquires a lock under the current policy
+     * @param lock Address identifying the lock
+     * @param timeout Milliseconds before the policy applies
+     * @param kind Lock kind used in messages
+     * @param tryLock Callable taking a timeout in ms
+     * @param blockingLock Callable waiting without timeout
+     * @return Acquisition time for release(), -1 when not
+     * instrumented
+     */
+    template <typename TryLock, typename BlockingLock>
+    static qint64 acquire(const void* lock, int timeout,
+                          const char* kind, TryLock tryLock,
+                          BlockingLock blockingLock)
+    {
+        const bool enabled = isEnabled();
+        const WaitPolicy policy = waitPolicy();
+        if (!enabled && policy == WaitPolicy::FailFast)
+        {
+            if (!tryLock(timeout))
+            {
+                throw std::runtime_error(
+                    std::string("Failed to acquire ") + kind);
+            }
+            return -1;
+        }
+
+        const qint64 start = enabled ? now() : 0;
+        bool contended = false;
+        bool timedOut = false;
+        if (!tryLock(0))
+        {
+            contended = true;
+            if (!tryLock(timeout))
+            {
+                timedOut = true;
+                if (policy == WaitPolicy::FailFast)
+                {
+                    if (enabled)
+                    {
+                        recordWait(lock, contended, timedOut,
+                                   false, now() - start);
+                    }
+                    throw std::runtime_error(
+                        std::string("Failed to acquire ") + kind);
+                }
+                warnTimeout(lock, timeout, kind);
+                blockingLock();
+            }
+        }
+
+        if (!enabled)
+        {
+            return -1;
+        }
+        const qint64 acquiredAt = now();
+        recordWait(lock, contended, timedOut, true,
+                   acquiredAt - start);
+        return acquiredAt;
+    }
+
+    /**
+     * @brief Gets the time a lock is released; call before
+     * unlocking
+     */
+    static qint64 releaseTime(qint64 acquiredAt)
+    {
+        return acquiredAt < 0 ? -1 : now();
+    }
+
+    /**
+     * @brief Records the hold time of a released lock
+     */
+    static void release(const void* lock, qint64 acquiredAt,
+                        qint64 releasedAt)
+    {
+        if (acquiredAt >= 0)
+        {
+            recordHold(lock, releasedAt - acquiredAt);
+        }
+    }
+
+private:
+    /** Monotonic time in nanoseconds */
+    static qint64 now();
+
+    static void recordWait(const void* lock, bool contended,
+                           bool timedOut, bool acquired,
+                           qint64 waitNs);
+    static void recordHold(const void* lock, qint64 holdNs);
+    static void warnTimeout(const void* lock, int timeout,
+                            const char* kind);
+
+    static std::atomic<bool> s_enabled;
+    static std::atomic<int>  s_waitPolicy;
+};
+
+/**
+ * @class LockName
+ * @brief Names a lock for the lifetime of the handle
+ *
+ * Declare it right after the lock it names: it is then
+ * destroyed first and unregisters the lock while its
+ * address is still owned.
+ */
+class LockName
+{
+public:
+    LockName(const void* lock, const QString& name)
+        : m_lock(lock)
+    {
+        LockInstrumentation::setLockName(lock, name);
+    }
+
+    ~LockName()
+    {
+        LockInstrumentation::unregisterLock(m_lock);
+    }
+
+    LockName(const LockName&)            = delete;
+    LockName& operator=(const LockName&) = delete;
+
+private:
+    const void* m_lock;
+};
+
 /**
  * @class ScopedLock
  * @brief RAII-style mutex lock with timeout
@@ -32,19 +258,24 @@ public:
     explicit ScopedLock(QMutex& mutex, int timeout = 5000)
         : m_mutex(mutex)
     {
-        if (!m_mutex.tryLock(timeout))
-        {
-            throw std::runtime_error("Failed to acquire lock");
-        }
+        m_acquiredAt = LockInstrumentation::acquire(
+            &m_mutex, timeout, "lock",
+            [this](int ms) { return m_mutex.tryLock(ms); },
+            [this]() { m_mutex.lock(); });
     }
 
     ~ScopedLock()
     {
+        const qint64 releasedAt =
+            LockInstrumentation::releaseTime(m_acquiredAt);
         m_mutex.unlock();
+        LockInstrumentation::release(&m_mutex, m_acquiredAt,
+                                     releasedAt);
     }
 
 private:
     QMutex& m_mutex;
+    qint64  m_acquiredAt;
 };
 
 /**
@@ -57,19 +288,24 @@ public:
     explicit ScopedReadLock(QReadWriteLock& lock, int timeout = 5000)
         : m_lock(lock)
     {
-        if (!m_lock.tryLockForRead(timeout))
-        {
-            throw std::runtime_error("Failed to acquire read lock");
-        }
+        m_acquiredAt = LockInstrumentation::acquire(
+            &m_lock, timeout, "read lock",
+            [this](int ms) { return m_lock.tryLockForRead(ms); },
+            [this]() { m_lock.lockForRead(); });
     }
 
     ~ScopedReadLock()
     {
+        const qint64 releasedAt =
+            LockInstrumentation::releaseTime(m_acquiredAt);
         m_lock.unlock();
+        LockInstrumentation::release(&m_lock, m_acquiredAt,
+                                     releasedAt);
     }
 
 private:
     QReadWriteLock& m_lock;
+    qint64          m_acquiredAt;
 };
 
 /**
@@ -82,19 +318,24 @@ public:
     explicit ScopedWriteLock(QReadWriteLock& lock, int timeout = 5000)
         : m_lock(lock)
     {
-        if (!m_lock.tryLockForWrite(timeout))
-        {
-            throw std::runtime_error("Failed to acquire write lock");
-        }
+        m_acquiredAt = LockInstrumentation::acquire(
+            &m_lock, timeout, "write lock",
+            [this](int ms) { return m_lock.tryLockForWrite(ms); },
+            [this]() { m_lock.lockForWrite(); });
     }
 
     ~ScopedWriteLock()
     {
+        const qint64 releasedAt =
+            LockInstrumentation::releaseTime(m_acquiredAt);
         m_lock.unlock();
+        LockInstrumentation::release(&m_lock, m_acquiredAt,
+                                     releasedAt);
     }
 
 private:
     QReadWriteLock& m_lock;
+    qint64          m_acquiredAt;
 };
 
 /**
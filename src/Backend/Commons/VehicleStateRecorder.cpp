@@ -0,0 +1,476 @@
+#include "VehicleStateRecorder.h"
+#include <QDebug>
+#include <QFile>
+#include <QTemporaryFile>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+namespace
+{
+
+using Sample = VehicleStateRecorder::Sample;
+
+constexpr int COLUMN_COUNT = 8;
+
+// Quantization factor of each column, in Sample order
+constexpr double COLUMN_SCALE[COLUMN_COUNT] = {
+    1e3, 1e6, 1e6, 1e3, 1e3, 1e3, 1e3, 1.0};
+
+const QChar KEY_SEPARATOR(0x1F);
+
+double columnValue(const Sample &sample, int column)
+{
+    switch (column)
+    {
+    case 0:
+        return sample.time;
+    case 1:
+        return sample.x;
+    case 2:
+        return sample.y;
+    case 3:
+        return sample.distance;
+    case 4:
+        return sample.speed;
+    case 5:
+        return sample.energy;
+    case 6:
+        return sample.emissions;
+    default:
+        return sample.containers;
+    }
+}
+
+void setColumnValue(Sample &sample, int column,
+                    qint64 quantized)
+{
+    double value = quantized / COLUMN_SCALE[column];
+    switch (column)
+    {
+    case 0:
+        sample.time = value;
+        break;
+    case 1:
+        sample.x = value;
+        break;
+    case 2:
+        sample.y = value;
+        break;
+    case 3:
+        sample.distance = value;
+        break;
+    case 4:
+        sample.speed = value;
+        break;
+    case 5:
+        sample.energy = value;
+        break;
+    case 6:
+        sample.emissions = value;
+        break;
+    default:
+        sample.containers = static_cast<int>(quantized);
+        break;
+    }
+}
+
+quint64 zigzag(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1)
+           ^ static_cast<quint64>(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return static_cast<qint64>(value >> 1)
+           ^ -static_cast<qint64>(value & 1);
+}
+
+void appendVarint(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        out.append(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+bool readVarint(const char *&pos, const char *end,
+                quint64 &value)
+{
+    value     = 0;
+    int shift = 0;
+    while (pos < end && shift < 64)
+    {
+        quint8 byte = static_cast<quint8>(*pos++);
+        value |= static_cast<quint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+} // namespace
+
+VehicleStateRecorder::VehicleStateRecorder(
+    const QString &spillFilePath, qint64 memoryLimit)
+    : m_memoryLimit(memoryLimit)
+{
+    if (spillFilePath.isEmpty())
+    {
+        return;
+    }
+
+    // Reserve a scratch file of our own so that recorders
+    // on the same path never remove each other's data
+    QTemporaryFile file(spillFilePath + ".XXXXXX");
+    file.setAutoRemove(false);
+    if (file.open())
+    {
+        m_spillFilePath = file.fileName();
+    }
+    else
+    {
+        qWarning() << "Cannot create a spill file at"
+                   << spillFilePath
+                   << "; keeping recorded states in memory";
+    }
+}
+
+VehicleStateRecorder::~VehicleStateRecorder()
+{
+    if (!m_spillFilePath.isEmpty())
+    {
+        QFile::remove(m_spillFilePath);
+    }
+}
+
+void VehicleStateRecorder::record(
+    const QString &networkName, const QString &vehicleId,
+    const Sample &sample)
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    Series &series =
+        m_series[seriesKey(networkName, vehicleId)];
+    if (series.pending.isEmpty())
+    {
+        series.pending.reserve(BLOCK_SAMPLES);
+    }
+    series.pending.append(sample);
+    ++m_pendingCount;
+    ++m_sampleCount;
+
+    if (series.pending.size() < BLOCK_SAMPLES)
+    {
+        return;
+    }
+
+    sealPending(series);
+    if (!m_spillFilePath.isEmpty()
+        && m_encodedBytes > m_memoryLimit)
+    {
+        spill();
+    }
+}
+
+QVector<VehicleStateRecorder::Sample>
+VehicleStateRecorder::query(const QString &networkName,
+                            const QString &vehicleId,
+                            double fromTime,
+                            double toTime) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+
+    QVector<Sample> result;
+    auto            it = m_series.constFind(
+        seriesKey(networkName, vehicleId));
+    if (it == m_series.constEnd())
+    {
+        return result;
+    }
+
+    auto inRange = [&](const Sample &sample) {
+        return sample.time >= fromTime
+               && sample.time <= toTime;
+    };
+
+    QFile           spillFile(m_spillFilePath);
+    QVector<Sample> decoded;
+    for (const Block &block : it->blocks)
+    {
+        if (block.lastTime < fromTime
+            || block.firstTime > toTime)
+        {
+            continue;
+        }
+
+        QByteArray data = block.data;
+        if (block.fileOffset >= 0)
+        {
+            if (!spillFile.isOpen()
+                && !spillFile.open(QIODevice::ReadOnly))
+            {
+                qWarning() << "Cannot read recorded states"
+                           << m_spillFilePath;
+                return result;
+            }
+            spillFile.seek(block.fileOffset);
+            data = spillFile.read(block.fileSize);
+        }
+
+        if (!decodeBlock(data, block.count, decoded))
+        {
+            qWarning() << "Corrupt recorded state block of"
+                       << vehicleId;
+            continue;
+        }
+        for (const Sample &sample : decoded)
+        {
+            if (inRange(sample))
+            {
+                result.append(sample);
+            }
+        }
+    }
+
+    for (const Sample &sample : it->pending)
+    {
+        if (inRange(sample))
+        {
+            result.append(sample);
+        }
+    }
+    return result;
+}
+
+QStringList VehicleStateRecorder::vehicles(
+    const QString &networkName) const
+{
+    Commons::ScopedReadLock locker(m_lock);
+
+    const QString prefix = networkName + KEY_SEPARATOR;
+    QStringList   ids;
+    for (auto it = m_series.constBegin();
+         it != m_series.constEnd(); ++it)
+    {
+        if (it.key().startsWith(prefix))
+        {
+            ids.append(it.key().mid(prefix.size()));
+        }
+    }
+    return ids;
+}
+
+void VehicleStateRecorder::flush()
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    for (Series &series : m_series)
+    {
+        if (!series.pending.isEmpty())
+        {
+            sealPending(series);
+        }
+    }
+    if (!m_spillFilePath.isEmpty())
+    {
+        spill();
+    }
+}
+
+void VehicleStateRecorder::clear()
+{
+    Commons::ScopedWriteLock locker(m_lock);
+
+    m_series.clear();
+    m_sampleCount  = 0;
+    m_encodedBytes = 0;
+    m_pendingCount = 0;
+    m_spilledBytes = 0;
+    if (!m_spillFilePath.isEmpty())
+    {
+        QFile::remove(m_spillFilePath);
+    }
+}
+
+qint64 VehicleStateRecorder::sampleCount() const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    return m_sampleCount;
+}
+
+qint64 VehicleStateRecorder::memoryUsage() const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    return m_encodedBytes
+           + m_pendingCount
+                 * static_cast<qint64>(sizeof(Sample));
+}
+
+qint64 VehicleStateRecorder::spilledBytes() const
+{
+    Commons::ScopedReadLock locker(m_lock);
+    return m_spilledBytes;
+}
+
+QString
+VehicleStateRecorder::seriesKey(const QString &networkName,
+                                const QString &vehicleId)
+{
+    return networkName + KEY_SEPARATOR + vehicleId;
+}
+
+void VehicleStateRecorder::sealPending(Series &series)
+{
+    Block block;
+    block.firstTime = series.pending.first().time;
+    block.lastTime  = series.pending.last().time;
+    block.count     = series.pending.size();
+    block.data      = encodeBlock(series.pending);
+
+    m_encodedBytes += block.data.size();
+    m_pendingCount -= block.count;
+    series.blocks.append(block);
+
+    // Keeps the capacity for the next block
+    series.pending.clear();
+}
+
+void VehicleStateRecorder::spill()
+{
+    QFile file(m_spillFilePath);
+    if (!file.open(QIODevice::WriteOnly
+                   | QIODevice::Append))
+    {
+        qWarning() << "Cannot spill recorded states to"
+                   << m_spillFilePath;
+        return;
+    }
+
+    // Gather every in-memory block into one chunk
+    const qint64 chunkStart = file.size();
+    QByteArray   chunk;
+    chunk.reserve(static_cast<int>(m_encodedBytes));
+    for (Series &series : m_series)
+    {
+        for (Block &block : series.blocks)
+        {
+            if (block.fileOffset >= 0)
+            {
+                continue;
+            }
+            block.fileOffset = chunkStart + chunk.size();
+            block.fileSize   = block.data.size();
+            chunk.append(block.data);
+        }
+    }
+
+    const bool written = file.write(chunk) == chunk.size()
+                         && file.flush();
+
+    for (Series &series : m_series)
+    {
+        for (Block &block : series.blocks)
+        {
+            if (block.fileOffset < chunkStart)
+            {
+                continue;
+            }
+            if (written)
+            {
+                block.data.clear();
+            }
+            else
+            {
+                // Keep the block in memory
+                block.fileOffset = -1;
+                block.fileSize   = 0;
+            }
+        }
+    }
+
+    if (!written)
+    {
+        qWarning() << "Failed to spill recorded states to"
+                   << m_spillFilePath;
+        return;
+    }
+    m_spilledBytes += chunk.size();
+    m_encodedBytes = 0;
+}
+
+QByteArray VehicleStateRecorder::encodeBlock(
+    const QVector<Sample> &samples)
+{
+    QByteArray out;
+    out.reserve(samples.size() * COLUMN_COUNT);
+
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        const double scale     = COLUMN_SCALE[column];
+        qint64       previous  = 0;
+        qint64       lastDelta = 0;
+        for (const Sample &sample : samples)
+        {
+            qint64 value = qRound64(
+                columnValue(sample, column) * scale);
+            qint64 delta = value - previous;
+            if (column == 0)
+            {
+                appendVarint(out,
+                             zigzag(delta - lastDelta));
+                lastDelta = delta;
+            }
+            else
+            {
+                appendVarint(out, zigzag(delta));
+            }
+            previous = value;
+        }
+    }
+    return out;
+}
+
+bool VehicleStateRecorder::decodeBlock(
+    const QByteArray &data, int count,
+    QVector<Sample> &samples)
+{
+    samples.resize(count);
+
+    const char *pos = data.constData();
+    const char *end = pos + data.size();
+    for (int column = 0; column < COLUMN_COUNT; ++column)
+    {
+        qint64 previous  = 0;
+        qint64 lastDelta = 0;
+        for (Sample &sample : samples)
+        {
+            quint64 encoded;
+            if (!readVarint(pos, end, encoded))
+            {
+                return false;
+            }
+
+            qint64 delta = unzigzag(encoded);
+            if (column == 0)
+            {
+                delta += lastDelta;
+                lastDelta = delta;
+            }
+            previous += delta;
+            setColumnValue(sample, column, previous);
+        }
+    }
+    return pos == end;
+}
+
+} // namespace Backend
+} // namespace CargoNetSim
@@ -0,0 +1,241 @@
+#pragma once
+
+/**
+ * @file VehicleStateRecorder.h
+ * @brief Compact time series of vehicle states
+ * @author Ahmed Aredah
+ * @date March 21, 2025
+ *
+ * This file declares the VehicleStateRecorder class, which
+ * keeps the per-tick states reported by the simulation
+ * clients for post-run analysis.
+ *
+ * @note Part of the CargoNetSim::Backend namespace.
+ */
+
+#include "ThreadSafetyUtils.h"
+#include <QByteArray>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <limits>
+
+namespace CargoNetSim
+{
+namespace Backend
+{
+
+/**
+ * @class VehicleStateRecorder
+ * @brief Append-only, columnar store of vehicle state
+ * samples
+ *
+ * Samples are grouped into one series per network and
+ * vehicle. The newest samples of a series stay uncompressed
+ * until BLOCK_SAMPLES of them are collected; the block is
+ * then encoded column by column:
+ * - Every value is quantized to the fixed precision of its
+ *   column (see Sample)
+ * - Times are stored as deltas of deltas, so a constant
+ *   tick costs one byte per sample
+ * - Other columns are stored as deltas from the previous
+ *   sample
+ * - All deltas are zigzag varints
+ *
+ * Once the encoded blocks in memory exceed the memory
+ * limit they are appended to the spill file in one chunk
+ * and only their index entry is kept. Queries read the
+ * index to skip blocks outside the requested range and
+ * decode only the rest.
+ *
+ * The recorder is thread-safe. The spill file is a scratch
+ * file of this recorder alone, created next to the given
+ * path under a unique name; it carries no index, is not
+ * meant to be reopened and is removed with the recorder.
+ *
+ * Samples are only as dense as the clients' reports: ships
+ * record every state update, trucks every trip info at
+ * link granularity, and trains only their arrivals.
+ */
+class VehicleStateRecorder
+{
+public:
+    /**
+     * @brief One recorded state of a vehicle
+     *
+     * Values are kept to the precision noted per field.
+     */
+    struct Sample
+    {
+        double time       = 0.0; ///< Sim time, 1 ms
+        double x          = 0.0; ///< Longitude or x, 1e-6
+        double y          = 0.0; ///< Latitude or y, 1e-6
+        double distance   = 0.0; ///< Travelled, 1e-3
+        double speed      = 0.0; ///< Current speed, 1e-3
+        double energy     = 0.0; ///< Consumed, 1e-3
+        double emissions  = 0.0; ///< CO2 emitted, 1e-3
+        int    containers = 0;   ///< Containers on board
+    };
+
+    /**
+     * @brief Samples per encoded block
+     */
+    static constexpr int BLOCK_SAMPLES = 128;
+
+    /**
+     * @brief Default size of the encoded blocks kept in
+     * memory before spilling
+     */
+    static constexpr qint64 DEFAULT_MEMORY_LIMIT =
+        64 * 1024 * 1024;
+
+    /**
+     * @brief Constructs an empty recorder
+     * @param spillFilePath Base path of the file receiving
+     * spilled blocks, to which a unique suffix is appended;
+     * empty to keep everything in memory
+     * @param memoryLimit Encoded bytes kept in memory
+     * before spilling
+     */
+    explicit VehicleStateRecorder(
+        const QString &spillFilePath = QString(),
+        qint64 memoryLimit = DEFAULT_MEMORY_LIMIT);
+
+    /**
+     * @brief Removes the spill file
+     */
+    ~VehicleStateRecorder();
+
+    VehicleStateRecorder(const VehicleStateRecorder &) =
+        delete;
+    VehicleStateRecorder &
+    operator=(const VehicleStateRecorder &) = delete;
+
+    /**
+     * @brief Appends a sample to a vehicle's series
+     *
+     * Samples of a vehicle are expected in time order.
+     *
+     * @param networkName Network of the vehicle
+     * @param vehicleId Vehicle or trip identifier
+     * @param sample State to record
+     */
+    void record(const QString &networkName,
+                const QString &vehicleId,
+                const Sample  &sample);
+
+    /**
+     * @brief Gets the samples of a vehicle in a time range
+     * @param networkName Network of the vehicle
+     * @param vehicleId Vehicle or trip identifier
+     * @param fromTime First time included
+     * @param toTime Last time included
+     * @return Samples in recording order
+     */
+    QVector<Sample> query(
+        const QString &networkName,
+        const QString &vehicleId,
+        double         fromTime =
+            -std::numeric_limits<double>::infinity(),
+        double toTime =
+            std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * @brief Lists the recorded vehicles of a network
+     */
+    QStringList vehicles(const QString &networkName) const;
+
+    /**
+     * @brief Encodes all pending samples and spills every
+     * encoded block if a spill file is set
+     *
+     * Call at the end of a run to bound memory use.
+     */
+    void flush();
+
+    /**
+     * @brief Removes all series and truncates the spill
+     * file
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of recorded samples
+     */
+    qint64 sampleCount() const;
+
+    /**
+     * @brief Gets the bytes of samples held in memory
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * @brief Gets the bytes written to the spill file
+     */
+    qint64 spilledBytes() const;
+
+    /**
+     * @brief Gets the spill file of this recorder
+     * @return The path, empty if nothing is spilled
+     */
+    QString spillFilePath() const
+    {
+        return m_spillFilePath;
+    }
+
+private:
+    /**
+     * @brief An encoded run of samples of one series
+     */
+    struct Block
+    {
+        double     firstTime  = 0.0;
+        double     lastTime   = 0.0;
+        int        count      = 0;
+        QByteArray data;            ///< Empty once spilled
+        qint64     fileOffset = -1; ///< -1 while in memory
+        int        fileSize   = 0;
+    };
+
+    /**
+     * @brief All samples of one vehicle
+     */
+    struct Series
+    {
+        QVector<Block>  blocks;
+        QVector<Sample> pending;
+    };
+
+    static QString seriesKey(const QString &networkName,
+                             const QString &vehicleId);
+
+    /** Encodes the pending samples of a series */
+    void sealPending(Series &series);
+
+    /** Writes all in-memory blocks to the spill file */
+    void spill();
+
+    static QByteArray
+    encodeBlock(const QVector<Sample> &samples);
+    static bool decodeBlock(const QByteArray &data,
+                            int               count,
+                            QVector<Sample>  &samples);
+
+    QString m_spillFilePath;
+    qint64  m_memoryLimit;
+
+    QHash<QString, Series> m_series;
+    qint64                 m_sampleCount  = 0;
+    qint64                 m_encodedBytes = 0;
+    qint64                 m_pendingCount = 0;
+    qint64                 m_spilledBytes = 0;
+
+    mutable QReadWriteLock m_lock;
+    Commons::LockName      m_lockName{
+        &m_lock, "VehicleStateRecorder"};
+};
+
+} // namespace Backend
+} // namespace CargoNetSim
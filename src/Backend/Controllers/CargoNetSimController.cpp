@@ -6,6 +6,7 @@
  */
 
 #include "CargoNetSimController.h"
+#include "Backend/Commons/ThreadSafetyUtils.h"
 #include "Backend/Utils/Utils.h"
 
 namespace CargoNetSim
@@ -93,6 +94,7 @@ CargoNetSimController &CargoNetSimController::getInstance(
 CargoNetSimController::~CargoNetSimController()
 {
     stopAll();
+    setClientsStateRecorder(nullptr);
 
     // Clean up threads
     if (m_truckThread)
@@ -140,11 +142,15 @@ bool CargoNetSimController::initialize(
 {
     // Create and start client threads
     bool success = true;
+    applyLockInstrumentation();
     m_simulationTime = new Backend::SimulationTime();
     success &= initializeTerminalClient();
     success &= initializeTruckClient(truckExePath);
     success &= initializeShipClient();
     success &= initializeTrainClient();
+    applyStateRecording();
+    applyTripLimits();
+    applyTruckRouting();
 
     return success;
 }
@@ -254,6 +260,13 @@ double CargoNetSimController::getTerminalCapacity(
     const QString &terminalId)
 {
     double result = -1.0;
+    // Cached values need no hop to the client thread
+    if (m_terminalClient
+        && m_terminalClient->cachedAvailableCapacity(
+            terminalId, result))
+    {
+        return result;
+    }
     emit requestTerminalCapacity(terminalId, result);
     return result;
 }
@@ -262,6 +275,12 @@ int CargoNetSimController::getTerminalContainerCount(
     const QString &terminalId)
 {
     int result = -1;
+    if (m_terminalClient
+        && m_terminalClient->cachedContainerCount(terminalId,
+                                                  result))
+    {
+        return result;
+    }
     emit requestContainerCount(terminalId, result);
     return result;
 }
@@ -276,6 +295,164 @@ bool CargoNetSimController::addContainersToTerminal(
     return result;
 }
 
+std::shared_ptr<Backend::VehicleStateRecorder>
+CargoNetSimController::getStateRecorder() const
+{
+    return m_stateRecorder;
+}
+
+void CargoNetSimController::applySimulationSettings()
+{
+    const bool columnar = useColumnarContainerPayloads();
+    if (m_shipClient)
+    {
+        m_shipClient->setColumnarContainerPayloads(
+            columnar);
+    }
+    if (m_trainClient)
+    {
+        m_trainClient->setColumnarContainerPayloads(
+            columnar);
+    }
+    if (m_terminalClient)
+    {
+        m_terminalClient->setColumnarContainerPayloads(
+            columnar);
+    }
+
+    applyLockInstrumentation();
+    applyStateRecording();
+    applyTripLimits();
+    applyTruckRouting();
+}
+
+bool CargoNetSimController::useColumnarContainerPayloads()
+    const
+{
+    return m_configController
+           && m_configController->getSimulationParams()
+                  .value("columnar_container_payloads", false)
+                  .toBool();
+}
+
+void CargoNetSimController::applyTripLimits()
+{
+    if (!m_truckManager)
+    {
+        return;
+    }
+
+    const QVariantMap params =
+        m_configController
+            ? m_configController->getSimulationParams()
+            : QVariantMap();
+    m_truckManager->setTripLimits(
+        params.value("max_trips_in_flight", 0).toInt(),
+        params.value("trip_timeout", 0).toInt());
+}
+
+void CargoNetSimController::applyTruckRouting()
+{
+    if (!m_truckManager)
+    {
+        return;
+    }
+
+    using RoutingMode = Backend::TruckClient::
+        TruckSimulationClient::RoutingMode;
+    const QVariantMap params =
+        m_configController
+            ? m_configController->getSimulationParams()
+            : QVariantMap();
+    const RoutingMode mode =
+        params.value("routing_mode").toString()
+                == "congested_time"
+            ? RoutingMode::CongestedTime
+            : RoutingMode::ShortestDistance;
+    const double interval =
+        params.value("reroute_interval", 0).toDouble();
+    m_truckManager->setRouting(mode, interval);
+}
+
+void CargoNetSimController::applyLockInstrumentation()
+{
+    using Backend::Commons::LockInstrumentation;
+    const QVariantMap params =
+        m_configController
+            ? m_configController->getSimulationParams()
+            : QVariantMap();
+    const bool enabled =
+        params.value("lock_instrumentation", false)
+            .toBool();
+    const bool wait =
+        params.value("lock_wait_policy").toString()
+        == "wait";
+
+    LockInstrumentation::setWaitPolicy(
+        wait ? LockInstrumentation::WaitPolicy::Wait
+             : LockInstrumentation::WaitPolicy::FailFast);
+    LockInstrumentation::setEnabled(enabled);
+    LockInstrumentation::setDumpInterval(
+        enabled
+            ? params.value("lock_dump_interval", 0).toInt()
+            : 0);
+}
+
+void CargoNetSimController::applyStateRecording()
+{
+    const QVariantMap params =
+        m_configController
+            ? m_configController->getSimulationParams()
+            : QVariantMap();
+    const bool record =
+        params.value("record_vehicle_states", false)
+            .toBool();
+    const QString path =
+        params.value("vehicle_states_spill_file")
+            .toString();
+
+    // Keep the recorded samples while nothing changed
+    if (record == (m_stateRecorder != nullptr)
+        && (!record || path == m_stateRecorderPath))
+    {
+        return;
+    }
+
+    std::shared_ptr<Backend::VehicleStateRecorder> recorder;
+    if (record)
+    {
+        recorder =
+            std::make_shared<Backend::VehicleStateRecorder>(
+                path);
+    }
+    setClientsStateRecorder(recorder);
+
+    if (m_stateRecorder)
+    {
+        m_stateRecorder->flush();
+    }
+    m_stateRecorder     = std::move(recorder);
+    m_stateRecorderPath = path;
+}
+
+void CargoNetSimController::setClientsStateRecorder(
+    const std::shared_ptr<Backend::VehicleStateRecorder>
+        &recorder)
+{
+    if (m_truckManager)
+    {
+        m_truckManager->setStateRecorder(recorder);
+    }
+    if (m_shipClient)
+    {
+        m_shipClient->setStateRecorder(recorder);
+    }
+    if (m_trainClient)
+    {
+        m_trainClient->setStateRecorder(recorder);
+    }
+}
+
 void CargoNetSimController::onThreadStarted()
 {
     QThread *senderThread =
@@ -395,6 +572,8 @@ bool CargoNetSimController::initializeShipClient()
     m_shipClient =
         new Backend::ShipClient::ShipSimulationClient(
             nullptr);
+    m_shipClient->setColumnarContainerPayloads(
+        useColumnarContainerPayloads());
     m_shipClient->moveToThread(m_shipThread);
 
     // Connect thread signals
@@ -427,6 +606,8 @@ bool CargoNetSimController::initializeTrainClient()
     m_trainClient =
         new Backend::TrainClient::TrainSimulationClient(
             nullptr);
+    m_trainClient->setColumnarContainerPayloads(
+        useColumnarContainerPayloads());
     m_trainClient->moveToThread(m_trainThread);
 
     // Connect thread signals
@@ -460,6 +641,8 @@ bool CargoNetSimController::initializeTerminalClient()
     // Create terminal client
     m_terminalClient =
         new Backend::TerminalSimulationClient(nullptr);
+    m_terminalClient->setColumnarContainerPayloads(
+        useColumnarContainerPayloads());
     m_terminalClient->moveToThread(m_terminalThread);
 
     // Connect thread signals
@@ -159,6 +159,23 @@ public:
     Backend::TerminalSimulationClient *
     getTerminalClient() const;
 
+    /**
+     * @brief Gets the vehicle state recorder
+     * @return The recorder, nullptr unless vehicle state
+     * recording is enabled in the settings
+     */
+    std::shared_ptr<Backend::VehicleStateRecorder>
+    getStateRecorder() const;
+
+    /**
+     * @brief Applies the simulation settings that running
+     * clients pick up without a restart
+     *
+     * Currently the container payload format, vehicle
+     * state recording and the async truck trip limits.
+     */
+    void applySimulationSettings();
+
 public slots:
     /**
      * @brief Gets terminal capacity
@@ -286,6 +303,46 @@ private:
      */
     bool initializeTerminalClient();
 
+    /**
+     * @brief Checks the configured container payload format
+     * @return True if containers are sent as columnar
+     * batches
+     */
+    bool useColumnarContainerPayloads() const;
+
+    /**
+     * @brief Sets the lock statistics, timeout policy and
+     * report interval from the settings
+     */
+    void applyLockInstrumentation();
+
+    /**
+     * @brief Creates, replaces or drops the vehicle state
+     * recorder to match the settings and sets it on all
+     * clients
+     */
+    void applyStateRecording();
+
+    /**
+     * @brief Sets the async truck trip window and timeout
+     * from the settings
+     */
+    void applyTripLimits();
+
+    /**
+     * @brief Sets the truck routing mode and reroute
+     * interval from the settings
+     */
+    void applyTruckRouting();
+
+    /**
+     * @brief Sets a recorder on every simulation client
+     * @param recorder Recorder, nullptr to stop recording
+     */
+    void setClientsStateRecorder(
+        const std::shared_ptr<Backend::VehicleStateRecorder>
+            &recorder);
+
     // SimulationTime
     Backend::SimulationTime *m_simulationTime;
 
@@ -312,6 +369,12 @@ private:
     // Logger
     Backend::LoggerInterface *m_logger;
 
+    // Vehicle state recorder and its spill file setting;
+    // a replaced recorder is freed with its last client
+    std::shared_ptr<Backend::VehicleStateRecorder>
+            m_stateRecorder;
+    QString m_stateRecorderPath;
+
     // Track client initialization status
     QMap<Backend::ClientType, bool> m_clientInitialized;
     int                    m_initializedClientCount;
@@ -160,11 +160,24 @@ void ConfigController::createDefaultConfig()
     // Create a default configuration with the values from
     // the XML example
     QVariantMap simulation;
-    simulation["time_step"]           = 15;
-    simulation["time_value_of_money"] = 20.43;
-    simulation["use_mode_specific"]   = false;
-    simulation["shortest_paths"]      = 3;
-    m_config["simulation"]            = simulation;
+    simulation["time_step"]                   = 15;
+    simulation["time_value_of_money"]         = 20.43;
+    simulation["use_mode_specific"]           = false;
+    simulation["shortest_paths"]              = 3;
+    simulation["local_path_engine"]           = false;
+    simulation["columnar_container_payloads"] = false;
+    simulation["opengl_viewport"]             = false;
+    simulation["record_vehicle_states"]       = false;
+    simulation["vehicle_states_spill_file"]   = QString();
+    simulation["lock_instrumentation"]        = false;
+    simulation["lock_wait_policy"] = QString("fail_fast");
+    simulation["lock_dump_interval"]          = 0;
+    simulation["max_trips_in_flight"]         = 0;
+    simulation["trip_timeout"]                = 0;
+    simulation["routing_mode"] =
+        QString("shortest_distance");
+    simulation["reroute_interval"]            = 0;
+    m_config["simulation"]                    = simulation;
 
     QVariantMap fuelEnergy;
     fuelEnergy["HFO"]       = 11.1;
@@ -29,6 +29,19 @@ Terminal::Terminal(
     }
 }
 
+void Terminal::updateFrom(const Terminal &other)
+{
+    if (&other == this)
+    {
+        return;
+    }
+    m_names       = other.m_names;
+    m_displayName = other.m_displayName;
+    m_config      = other.m_config;
+    m_interfaces  = other.m_interfaces;
+    m_region      = other.m_region;
+}
+
 QJsonObject Terminal::toJson() const
 {
     QJsonObject json;
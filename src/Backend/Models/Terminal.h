@@ -105,6 +105,16 @@ public:
 
     static Terminal *fromJson(const QJsonObject &json);
 
+    /**
+     * @brief Copy another terminal's data into this one
+     *
+     * Keeps the object's identity, so pointers held by
+     * paths stay valid when the terminal is refreshed.
+     *
+     * @param other Terminal to copy from
+     */
+    void updateFrom(const Terminal &other);
+
 private:
     QStringList          m_names;
     QString              m_displayName;
@@ -4,6 +4,7 @@
 #include "Backend/Controllers/RegionDataController.h"
 #include "GUI/Controllers/UtilityFunctions.h"
 #include "GUI/Controllers/ViewController.h"
+#include "GUI/Widgets/GraphicsScene.h"
 
 #include <QColor>
 #include <QFileDialog>
@@ -545,24 +546,48 @@ QList<MapLine *> NetworkController::getShortestPathMapLines(
         return pathMapLines;
     }
 
-    // Get all map lines in the scene
-    QList<MapLine *> allMapLines =
-        mainWindow->regionScene_->getItemsByType<MapLine>();
+    Backend::RegionData *regionData =
+        CargoNetSim::CargoNetSimController::getInstance()
+            .getRegionDataController()
+            ->getRegionData(regionName);
+    if (!regionData)
+    {
+        return pathMapLines;
+    }
+    QObject *network =
+        networkType == NetworkType::Train
+            ? static_cast<QObject *>(
+                  regionData->getTrainNetwork(networkName))
+            : static_cast<QObject *>(
+                  regionData->getTruckNetwork(networkName));
+    if (!network)
+    {
+        return pathMapLines;
+    }
+
+    // Layered networks only get lines for path links
+    NetworkLayerItem *layer =
+        ViewController::getNetworkLayer(mainWindow,
+                                        network);
 
-    // Find map lines that correspond to segments in the
-    // shortest path
+    // Map lines are indexed by network and link ID, so
+    // this scales with the path length only
+    GraphicsScene *scene = mainWindow->regionScene_;
+    pathMapLines.reserve(result.pathLinks.size());
     for (int linkID : result.pathLinks)
     {
+        QString linkKey = QString::number(linkID);
+        if (layer)
+        {
+            ViewController::materializeNetworkLink(
+                mainWindow, layer,
+                layer->findLinkByNetworkID(linkKey));
+        }
 
-        for (MapLine *mapLine : allMapLines)
+        if (MapLine *mapLine =
+                scene->getMapLineForLink(network, linkKey))
         {
-            if (mapLine->getReferencedNetworkLinkID()
-                == QString::number(linkID))
-            {
-                pathMapLines.append(mapLine);
-                break; // Found the line for this segment,
-                       // move to next
-            }
+            pathMapLines.append(mapLine);
         }
     }
 
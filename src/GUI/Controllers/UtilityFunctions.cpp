@@ -27,19 +27,25 @@ CargoNetSim::GUI::UtilitiesFunctions::getTerminalItems(
         return QList<CargoNetSim::GUI::TerminalItem *>();
     }
 
-    // Get all terminals upfront
-    QList<TerminalItem *> allTerminals =
-        scene->getItemsByType<TerminalItem>();
+    const bool anyRegion = region == "*";
+    const bool anyType   = terminalType == "*";
 
-    // Pre-calculate the connection and link sets only if
-    // needed
+    // Terminals of one region come from the registry
+    GraphicsItemView<TerminalItem> allTerminals =
+        anyRegion
+            ? scene->itemsOfType<TerminalItem>()
+            : scene->itemsInRegion<TerminalItem>(region);
+
+    // Pre-calculate the connection set only if needed
     QSet<TerminalItem *> connectionLineTerminalItems;
-    QSet<TerminalItem *> mapPointsLinkedTerminals;
 
     if (connectionType != ConnectionType::Any)
     {
-        QList<ConnectionLine *> connectionLines =
-            scene->getItemsByType<ConnectionLine>();
+        GraphicsItemView<ConnectionLine> connectionLines =
+            anyRegion
+                ? scene->itemsOfType<ConnectionLine>()
+                : scene->itemsInRegion<ConnectionLine>(
+                      region);
         for (auto connectionLine : connectionLines)
         {
             if (auto startTerminal =
@@ -55,36 +61,24 @@ CargoNetSim::GUI::UtilitiesFunctions::getTerminalItems(
         }
     }
 
-    if (linkType != LinkType::Any)
-    {
-        QList<MapPoint *> mapPoints =
-            scene->getItemsByType<MapPoint>();
-        for (auto mapPoint : mapPoints)
-        {
-            if (auto linkedTerminal =
-                    mapPoint->getLinkedTerminal())
-                mapPointsLinkedTerminals.insert(
-                    linkedTerminal);
-        }
-    }
+    // Link state is tracked by the network point index
+    const NetworkPointIndex &pointIndex =
+        scene->getNetworkPointIndex();
+    auto isLinked = [&pointIndex](TerminalItem *terminal) {
+        return pointIndex.isTerminalLinked(
+                   terminal, NetworkType::Train)
+               || pointIndex.isTerminalLinked(
+                   terminal, NetworkType::Truck);
+    };
 
     // Create result container with initial capacity to
     // avoid reallocations
     QList<TerminalItem *> result;
     result.reserve(allTerminals.size());
 
-    const bool anyRegion = region == "*";
-    const bool anyType   = terminalType == "*";
-
     // Filter terminals
     for (auto terminal : allTerminals)
     {
-        // Region check
-        if (!anyRegion && terminal->getRegion() != region)
-        {
-            continue;
-        }
-
         // Type check
         if (!anyType
             && terminal->getTerminalType() != terminalType)
@@ -109,13 +103,12 @@ CargoNetSim::GUI::UtilitiesFunctions::getTerminalItems(
 
         // Link check
         if (linkType == LinkType::Linked
-            && !mapPointsLinkedTerminals.contains(terminal))
+            && !isLinked(terminal))
         {
             continue;
         }
         else if (linkType == LinkType::NotLinked
-                 && mapPointsLinkedTerminals.contains(
-                     terminal))
+                 && isLinked(terminal))
         {
             continue;
         }
@@ -6,18 +6,72 @@
 #include "GUI/Items/ConnectionLine.h"
 #include "GUI/Items/MapLine.h"
 #include "GUI/Items/MapPoint.h"
+#include "GUI/Items/PathHighlightItem.h"
 #include "GUI/MainWindow.h"
 #include "GUI/Utils/ColorUtils.h"
 #include "GUI/Utils/IconCreator.h"
+#include "GUI/Utils/NetworkImportJob.h"
 #include "GUI/Widgets/GraphicsScene.h"
 #include "GUI/Widgets/GraphicsView.h"
 #include "GUI/Widgets/InterfaceSelectionDialog.h"
 #include "GUI/Widgets/PropertiesPanel.h"
 #include "GUI/Widgets/ShortestPathTable.h"
 #include "UtilityFunctions.h"
+#include <QImageReader>
+#include <QPointer>
+#include <QProgressDialog>
+#include <memory>
+#include <type_traits>
 #include <QtWidgets/qapplication.h>
 #include <QtWidgets/qfiledialog.h>
 
+namespace
+{
+
+/**
+ * @brief Shows or hides the items of the given types in a
+ * region
+ */
+template <typename... Types>
+void setRegionItemsVisible(
+    CargoNetSim::GUI::GraphicsScene *scene,
+    const QString &region, bool visible)
+{
+    auto apply = [scene, &region, visible](auto *tag) {
+        using Item = std::remove_pointer_t<decltype(tag)>;
+        for (Item *item :
+             scene->itemsInRegion<Item>(region))
+        {
+            item->setVisible(visible);
+        }
+    };
+    (apply(static_cast<Types *>(nullptr)), ...);
+}
+
+/**
+ * @brief Moves the items of the given types from one
+ * region to another
+ */
+template <typename... Types>
+void renameRegionItems(
+    CargoNetSim::GUI::GraphicsScene *scene,
+    const QString &oldName, const QString &newName)
+{
+    // setRegion moves each item to the bucket of its new
+    // region, so the view is copied before renaming
+    auto apply = [scene, &oldName, &newName](auto *tag) {
+        using Item = std::remove_pointer_t<decltype(tag)>;
+        for (Item *item :
+             scene->itemsInRegion<Item>(oldName).toList())
+        {
+            item->setRegion(newName);
+        }
+    };
+    (apply(static_cast<Types *>(nullptr)), ...);
+}
+
+} // namespace
+
 void CargoNetSim::GUI::ViewController::
     updateSceneVisibility(MainWindow *mainWindow)
 {
@@ -28,61 +82,39 @@ void CargoNetSim::GUI::ViewController::
     // Update scene visibility based on settings
     GraphicsScene *scene = mainWindow->regionScene_;
 
-    for (auto item : scene->items())
+    // Only the previously shown and the current region
+    // change; new items start hidden outside the shown
+    // region
+    QString shownRegion = scene->getShownRegion();
+    if (!shownRegion.isNull()
+        && shownRegion != currentRegion)
     {
-        // Check if item is a terminal
-        TerminalItem *terminal =
-            dynamic_cast<TerminalItem *>(item);
-        if (terminal)
-        {
-            terminal->setVisible(terminal->getRegion()
-                                 == currentRegion);
-        }
-
-        // Check if item is a connection line
-        ConnectionLine *connectionLine =
-            dynamic_cast<ConnectionLine *>(item);
-        if (connectionLine)
-        {
-            connectionLine->setVisible(
-                connectionLine->getRegion()
-                == currentRegion);
-        }
-
-        // Check if item is a region center
-        RegionCenterPoint *regionCenter =
-            dynamic_cast<RegionCenterPoint *>(item);
-        if (regionCenter)
-        {
-            regionCenter->setVisible(
-                regionCenter->getRegion() == currentRegion);
-        }
-
-        // Check if item is a map point
-        MapPoint *mapPoint = dynamic_cast<MapPoint *>(item);
-        if (mapPoint)
-        {
-            mapPoint->setVisible(mapPoint->getRegion()
-                                 == currentRegion);
-        }
-
-        // Check if item is a map line
-        MapLine *mapLine = dynamic_cast<MapLine *>(item);
-        if (mapLine)
-        {
-            mapLine->setVisible(mapLine->getRegion()
-                                == currentRegion);
-        }
-
-        BackgroundPhotoItem *backgroundPhoto =
-            dynamic_cast<BackgroundPhotoItem *>(item);
-        if (backgroundPhoto)
+        setRegionItemsVisible<TerminalItem, ConnectionLine,
+                              RegionCenterPoint, MapPoint,
+                              MapLine, NetworkLayerItem,
+                              BackgroundPhotoItem>(
+            scene, shownRegion, false);
+    }
+    else if (shownRegion.isNull())
+    {
+        for (auto item : scene->items())
         {
-            backgroundPhoto->setVisible(
-                backgroundPhoto->getRegion()
-                == currentRegion);
+            auto object =
+                dynamic_cast<GraphicsObjectBase *>(item);
+            if (object && !object->getRegion().isEmpty())
+            {
+                object->setVisible(object->getRegion()
+                                   == currentRegion);
+            }
         }
     }
+
+    setRegionItemsVisible<TerminalItem, ConnectionLine,
+                          RegionCenterPoint, MapPoint,
+                          MapLine, NetworkLayerItem,
+                          BackgroundPhotoItem>(
+        scene, currentRegion, true);
+    scene->setShownRegion(currentRegion);
 }
 
 void CargoNetSim::GUI::ViewController::updateGlobalMapItem(
@@ -336,6 +368,34 @@ void CargoNetSim::GUI::ViewController::flashPathLines(
     const QList<Backend::Terminal *> &terminals =
         pathData->path->getTerminalsInPath();
 
+    // Segments of one color pulse as a single path
+    struct PathHighlight
+    {
+        QColor       color;
+        qreal        width;
+        QPainterPath path;
+    };
+    QList<PathHighlight> highlights;
+    auto addHighlight = [&highlights](
+                            GraphicsObjectBase *item,
+                            const QColor       &color) {
+        QPainterPath path =
+            item->mapToScene(item->highlightPath());
+        for (PathHighlight &highlight : highlights)
+        {
+            if (highlight.color == color)
+            {
+                highlight.path.addPath(path);
+                highlight.width =
+                    qMax(highlight.width,
+                         item->highlightWidth());
+                return;
+            }
+        }
+        highlights.append(
+            {color, item->highlightWidth(), path});
+    };
+
     // Process each segment
     for (int i = 0; i < segments.size(); ++i)
     {
@@ -430,10 +490,9 @@ void CargoNetSim::GUI::ViewController::flashPathLines(
             == Backend::TransportationTypes::
                 TransportationMode::Ship)
         {
-            // Flash the connection line
-            connection->flash(
-                true,
-                QColor(Qt::blue)); // Blue for ship
+            // Flash the connection line, even if hidden
+            addHighlight(connection,
+                         QColor(Qt::blue)); // Blue for ship
         }
         // For train or truck, flash the network map lines
         else
@@ -573,10 +632,23 @@ void CargoNetSim::GUI::ViewController::flashPathLines(
 
             for (MapLine *mapLine : pathMapLines)
             {
-                mapLine->flash(false, flashColor);
+                if (mapLine->isVisible())
+                {
+                    addHighlight(mapLine, flashColor);
+                }
             }
         }
     }
+
+    PathHighlightItem *highlightLayer =
+        mainWindow->regionScene_->getPathHighlight();
+    for (const PathHighlight &highlight : highlights)
+    {
+        highlightLayer->highlight(
+            highlight.path, QPen(highlight.color,
+                                 highlight.width,
+                                 Qt::SolidLine));
+    }
 }
 
 bool CargoNetSim::GUI::ViewController::
@@ -589,77 +661,25 @@ bool CargoNetSim::GUI::ViewController::
         return false;
     }
 
-    QString           region = terminal->getRegion();
-    QList<MapPoint *> networkPoints;
-    QMap<NetworkType, QList<MapPoint *>>
-        alreadyLinkedPointsByType;
+    QString            region = terminal->getRegion();
+    NetworkPointIndex &index =
+        mainWindow->regionScene_->getNetworkPointIndex();
 
-    // Get all map points in the scene
-    QList<MapPoint *> allMapPoints =
-        mainWindow->regionScene_
-            ->getItemsByType<MapPoint>();
-
-    // Filter map points by network type and region
-    for (MapPoint *point : allMapPoints)
+    // Check if terminal is already linked to a network
+    // point of any requested type
+    for (NetworkType type : networkTypes)
     {
-        if (point->getRegion() != region)
-        {
-            continue;
-        }
-
-        QObject *network = point->getReferenceNetwork();
-        if (!network)
-        {
-            continue;
-        }
-
-        NetworkType matchedType =
-            NetworkType::Train; // Default, will be
-                                // overwritten
-        bool isMatchingType = false;
-
-        if (networkTypes.contains(NetworkType::Train))
-        {
-            if (dynamic_cast<
-                    Backend::TrainClient::NeTrainSimNetwork
-                        *>(network))
-            {
-                isMatchingType = true;
-                matchedType    = NetworkType::Train;
-            }
-        }
-
-        if (networkTypes.contains(NetworkType::Truck))
-        {
-            if (dynamic_cast<
-                    Backend::TruckClient::IntegrationNetwork
-                        *>(network))
-            {
-                isMatchingType = true;
-                matchedType    = NetworkType::Truck;
-            }
-        }
-
-        if (isMatchingType)
+        if (index.isTerminalLinked(terminal, type))
         {
-            // Check if this point is already linked to a
-            // terminal
-            if (point->getLinkedTerminal())
-            {
-                alreadyLinkedPointsByType[matchedType]
-                    .append(point);
-            }
-            else
-            {
-                networkPoints.append(point);
-            }
+            return false;
         }
     }
 
-    // Process events to keep UI responsive
-    QApplication::processEvents();
-
-    if (networkPoints.isEmpty())
+    // Find the closest unlinked network node
+    QVector<NetworkPointIndex::Match> matches =
+        index.nearest(terminal->pos(), region,
+                      networkTypes);
+    if (matches.isEmpty())
     {
         QString networkTypeStr;
         if (networkTypes.size() == 1)
@@ -683,53 +703,16 @@ bool CargoNetSim::GUI::ViewController::
         return false;
     }
 
-    // Check if terminal is already linked to a network
-    // point of any requested type
-    for (NetworkType type : networkTypes)
-    {
-        const QList<MapPoint *> &typeLinkedPoints =
-            alreadyLinkedPointsByType[type];
-        for (MapPoint *point : typeLinkedPoints)
-        {
-            if (point->getLinkedTerminal() == terminal)
-            {
-                QString networkTypeStr =
-                    type == NetworkType::Train ? "train"
-                                               : "truck";
-                // // This terminal is already linked to a
-                // // network point of this type
-                // mainWindow->showStatusBarError(
-                //     QString("Terminal '%1' is already "
-                //             "linked to a %2 network
-                //             point.")
-                //         .arg(terminal->getProperty("Name")
-                //                  .toString())
-                //         .arg(networkTypeStr),
-                //     3000);
-                return false;
-            }
-        }
-
-        // Process events to keep UI responsive
-        QApplication::processEvents();
-    }
-
-    // Find the closest network point
-    MapPoint *closestPoint = nullptr;
-    qreal minDistance = std::numeric_limits<qreal>::max();
-
-    QPointF terminalPos = terminal->pos();
-    for (MapPoint *point : networkPoints)
+    // Layer nodes get their point on demand
+    const NetworkPointIndex::Match &closest =
+        matches.first();
+    MapPoint *closestPoint = closest.mapPoint;
+    if (!closestPoint)
     {
-        QPointF pointPos = point->pos();
-        qreal   distance =
-            QLineF(terminalPos, pointPos).length();
-
-        if (distance < minDistance)
-        {
-            minDistance  = distance;
-            closestPoint = point;
-        }
+        closestPoint = materializeNetworkNode(
+            mainWindow,
+            getNetworkLayer(mainWindow, closest.network),
+            closest.node);
     }
 
     if (closestPoint)
@@ -992,23 +975,89 @@ void CargoNetSim::GUI::ViewController::drawNetwork(
     mainWindow->startStatusProgress();
 
     // Get the network data
+    NetworkImportJob *job = nullptr;
     if (networkType == NetworkType::Train)
     {
         auto network =
             regionData->getTrainNetwork(networkName);
-        CargoNetSim::GUI::ViewController::drawTrainNetwork(
-            mainWindow, network, regionName, linksColor);
+        if (network)
+        {
+            job = CargoNetSim::GUI::ViewController::
+                drawTrainNetwork(mainWindow, network,
+                                 regionName, linksColor);
+        }
     }
     else if (networkType == NetworkType::Truck)
     {
         auto network =
             regionData->getTruckNetworkConfig(networkName);
-        CargoNetSim::GUI::ViewController::drawTruckNetwork(
-            mainWindow, network, regionName, linksColor);
+        if (network)
+        {
+            job = CargoNetSim::GUI::ViewController::
+                drawTruckNetwork(mainWindow, network,
+                                 regionName, linksColor);
+        }
     }
 
-    ToolbarController::restoreButtonStates(mainWindow);
-    mainWindow->stopStatusProgress();
+    if (!job)
+    {
+        ToolbarController::restoreButtonStates(mainWindow);
+        mainWindow->stopStatusProgress();
+        return;
+    }
+
+    // The dialog only shows up for slow imports
+    QProgressDialog *progress = new QProgressDialog(
+        QString("Drawing network %1...").arg(networkName),
+        "Cancel", 0, 0, mainWindow);
+    progress->setWindowModality(Qt::NonModal);
+    progress->setMinimumDuration(500);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+
+    QObject::connect(
+        job, &NetworkImportJob::progress, progress,
+        [progress](int done, int total) {
+            progress->setMaximum(total);
+            progress->setValue(done);
+        });
+
+    QObject::connect(
+        job, &NetworkImportJob::finished, mainWindow,
+        [mainWindow, job, progress]() {
+            // Closing the dialog would emit canceled()
+            QObject::disconnect(progress, nullptr, job,
+                                nullptr);
+            progress->hide();
+            progress->deleteLater();
+            job->deleteLater();
+
+            ToolbarController::restoreButtonStates(
+                mainWindow);
+            mainWindow->stopStatusProgress();
+        });
+
+    // A cancelled import leaves no partial network behind
+    QString name = networkName;
+    QObject::connect(
+        progress, &QProgressDialog::canceled, job,
+        [mainWindow, job, regionData, networkType,
+         name]() mutable {
+            job->cancel();
+            NetworkController::removeNetwork(
+                mainWindow, networkType, name, regionData);
+            mainWindow->networkManagerDock_
+                ->updateNetworkList(
+                    networkType == NetworkType::Train
+                        ? "Rail Network"
+                        : "Truck Network");
+            mainWindow->showStatusBarMessage(
+                QString("Import of network %1 cancelled.")
+                    .arg(name),
+                3000);
+        });
+
+    job->start();
 }
 
 void CargoNetSim::GUI::ViewController::
@@ -1089,6 +1138,14 @@ void CargoNetSim::GUI::ViewController::
                 truckNet->getNetworkName(), mapLine);
         }
     }
+
+    auto layers = mainWindow->regionScene_
+                      ->getItemsByType<NetworkLayerItem>();
+    for (auto layer : layers)
+    {
+        checkNetworkAndSetVisibility(
+            layer->getNetworkName(), layer);
+    }
 }
 
 void CargoNetSim::GUI::ViewController::renameRegion(
@@ -1100,336 +1157,960 @@ void CargoNetSim::GUI::ViewController::renameRegion(
         return;
     }
 
-    QGraphicsScene *scene = mainWindow->regionScene_;
-    for (QGraphicsItem *item : scene->items())
+    renameRegionItems<MapPoint, MapLine, NetworkLayerItem,
+                      RegionCenterPoint, TerminalItem,
+                      ConnectionLine, BackgroundPhotoItem>(
+        mainWindow->regionScene_, oldRegionName, newName);
+    mainWindow->regionScene_->getNetworkPointIndex()
+        .renameRegion(oldRegionName, newName);
+    updateSceneVisibility(mainWindow);
+}
+
+void CargoNetSim::GUI::ViewController::changeNetworkColor(
+    MainWindow *mainWindow, const QString &networkName,
+    const QColor newColor)
+{
+    if (!mainWindow)
     {
-        if (MapPoint *mapPoint =
-                dynamic_cast<MapPoint *>(item))
+        return;
+    }
+
+    QColor newDarkerColor =
+        newColor.darker(150); // 150% darker for MapPoints
+
+    auto mapPoints = mainWindow->regionScene_
+                         ->getItemsByType<MapPoint>();
+    auto mapLines =
+        mainWindow->regionScene_->getItemsByType<MapLine>();
+
+    for (auto mapPoint : mapPoints)
+    {
+        Backend::TrainClient::NeTrainSimNetwork *trainNet =
+            dynamic_cast<
+                Backend::TrainClient::NeTrainSimNetwork *>(
+                mapPoint->getReferenceNetwork());
+        Backend::TruckClient::IntegrationNetwork *truckNet =
+            dynamic_cast<
+                Backend::TruckClient::IntegrationNetwork *>(
+                mapPoint->getReferenceNetwork());
+
+        if (trainNet)
+        {
+            if (trainNet->getNetworkName() == networkName)
+            {
+                mapPoint->setColor(newDarkerColor);
+            }
+        }
+        else if (truckNet)
+        {
+            if (truckNet->getNetworkName() == networkName)
+            {
+                mapPoint->setColor(newDarkerColor);
+            }
+        }
+    }
+
+    for (auto mapLine : mapLines)
+    {
+        Backend::TrainClient::NeTrainSimNetwork *trainNet =
+            dynamic_cast<
+                Backend::TrainClient::NeTrainSimNetwork *>(
+                mapLine->getReferenceNetwork());
+        Backend::TruckClient::IntegrationNetwork *truckNet =
+            dynamic_cast<
+                Backend::TruckClient::IntegrationNetwork *>(
+                mapLine->getReferenceNetwork());
+
+        if (trainNet)
         {
-            if (mapPoint->getRegion() == oldRegionName)
+            if (trainNet->getNetworkName() == networkName)
             {
-                mapPoint->setRegion(newName);
+                mapLine->setColor(newColor);
             }
         }
-        else if (MapLine *mapLine =
-                     dynamic_cast<MapLine *>(item))
+        else if (truckNet)
         {
-            if (mapLine->getRegion() == oldRegionName)
+            if (truckNet->getNetworkName() == networkName)
             {
-                mapLine->setRegion(newName);
+                mapLine->setColor(newColor);
             }
         }
-        else if (RegionCenterPoint *regionCenter =
-                     dynamic_cast<RegionCenterPoint *>(
-                         item))
+    }
+
+    auto layers = mainWindow->regionScene_
+                      ->getItemsByType<NetworkLayerItem>();
+    for (auto layer : layers)
+    {
+        if (layer->getNetworkName() == networkName)
+        {
+            layer->setColors(newColor, newDarkerColor);
+        }
+    }
+}
+
+CargoNetSim::GUI::NetworkImportJob *
+CargoNetSim::GUI::ViewController::drawTrainNetwork(
+    MainWindow                              *mainWindow,
+    Backend::TrainClient::NeTrainSimNetwork *network,
+    QString &regionName, QColor &linksColor)
+{
+    mainWindow->regionView_->setUsingProjectedCoords(true);
+    mainWindow->updateAllCoordinates();
+
+    // Define node color
+    QColor nodesColor = QColor(linksColor);
+    nodesColor.setHsv(nodesColor.hue(),
+                      nodesColor.saturation(),
+                      nodesColor.value() * 0.7);
+
+    // set the network Color
+    network->setVariable("color", linksColor);
+
+    auto nodes = network->getNodes();
+    auto links = network->getLinks();
+
+    // Large networks are drawn by a single layer item
+    QPointer<NetworkLayerItem> layer;
+    bool                       useLayer =
+        links.size() >= NETWORK_LAYER_MIN_LINKS;
+    if (useLayer)
+    {
+        layer = createNetworkLayer(
+            mainWindow, network, network->getNetworkName(),
+            regionName, linksColor, nodesColor,
+            nodes.size(), links.size());
+    }
+
+    // Runs on the worker: reads the network, touches no
+    // item
+    auto prepare = [nodes, links, useLayer](
+                       QVector<NetworkImportJob::Node> &out,
+                       QVector<NetworkImportJob::Link>
+                                        &outLinks,
+                       const QAtomicInt &cancelled) {
+        QHash<const void *, int> nodeIndex;
+        nodeIndex.reserve(nodes.size());
+        out.reserve(nodes.size());
+        for (auto &node : nodes)
         {
-            if (regionCenter->getRegion() == oldRegionName)
+            if (cancelled.loadRelaxed())
             {
-                regionCenter->setRegion(newName);
+                return;
             }
+            NetworkImportJob::Node data;
+            data.networkID =
+                QString::number(node->getUserId());
+            data.uniqueID = node->getInternalUniqueID();
+            data.scenePoint = projectedToScene(
+                trainNodeProjectedPoint(node));
+            data.terminal = node->isTerminal();
+            if (!useLayer || data.terminal)
+            {
+                data.properties = trainNodeProperties(node);
+            }
+            nodeIndex.insert(node, out.size());
+            out.append(data);
         }
-        else if (TerminalItem *terminal =
-                     dynamic_cast<TerminalItem *>(item))
+
+        outLinks.reserve(links.size());
+        for (auto &link : links)
         {
-            if (terminal->getRegion() == oldRegionName)
+            if (cancelled.loadRelaxed())
             {
-                terminal->setRegion(newName);
+                return;
             }
+            NetworkImportJob::Link data;
+            data.networkID =
+                QString::number(link->getUserId());
+            data.uniqueID = link->getInternalUniqueID();
+            data.fromNode =
+                nodeIndex.value(link->getFromNode(), -1);
+            data.toNode =
+                nodeIndex.value(link->getToNode(), -1);
+            if (!useLayer)
+            {
+                data.properties = trainLinkProperties(link);
+            }
+            outLinks.append(data);
         }
-        else if (ConnectionLine *connectionLine =
-                     dynamic_cast<ConnectionLine *>(item))
+    };
+
+    // Terminals created so far, removed if the import is
+    // cancelled
+    using TerminalPair =
+        QPair<QPointer<MapPoint>, QPointer<TerminalItem>>;
+    auto terminals =
+        std::make_shared<QList<TerminalPair>>();
+
+    QString region = regionName;
+    auto    insertNode =
+        [mainWindow, network, layer, useLayer, region,
+         nodesColor, terminals](
+            int, const NetworkImportJob::Node &node) {
+            if (useLayer)
+            {
+                if (!layer)
+                {
+                    return;
+                }
+                int index = layer->addNode(
+                    node.networkID, node.uniqueID,
+                    node.scenePoint);
+
+                // Terminal nodes keep their own point
+                if (!node.terminal)
+                {
+                    return;
+                }
+                layer->setNodeMaterialized(index, true);
+            }
+
+            MapPoint *point = drawSceneNode(
+                mainWindow, node.networkID, node.uniqueID,
+                node.scenePoint, region, nodesColor,
+                node.properties);
+            point->setReferenceNetwork(network);
+
+            // Link terminal to point
+            if (node.terminal)
+            {
+                auto terminal =
+                    ViewController::createTerminalAtPoint(
+                        mainWindow, region,
+                        "Intermodal Land Terminal",
+                        point->getSceneCoordinate());
+
+                point->setLinkedTerminal(terminal);
+                terminals->append({point, terminal});
+            }
+        };
+
+    auto insertLink =
+        [mainWindow, network, layer, useLayer, region,
+         linksColor](
+            int, const NetworkImportJob::Link &link,
+            const QVector<NetworkImportJob::Node> &nodes) {
+            if (useLayer)
+            {
+                if (layer)
+                {
+                    layer->addLink(link.networkID,
+                                   link.uniqueID,
+                                   link.fromNode,
+                                   link.toNode);
+                }
+                return;
+            }
+            if (link.fromNode < 0 || link.toNode < 0)
+            {
+                return;
+            }
+
+            MapLine *line = drawSceneLink(
+                mainWindow, link.networkID, link.uniqueID,
+                nodes[link.fromNode].scenePoint,
+                nodes[link.toNode].scenePoint, region,
+                linksColor, link.properties);
+            if (line)
+            {
+                line->setReferenceNetwork(network);
+            }
+        };
+
+    auto job = new NetworkImportJob(network, prepare,
+                                    insertNode, insertLink,
+                                    mainWindow);
+
+    QObject::connect(
+        job, &NetworkImportJob::finished, mainWindow,
+        [mainWindow, network, layer, region,
+         terminals](bool completed) {
+            if (!completed)
+            {
+                for (const TerminalPair &pair : *terminals)
+                {
+                    if (pair.first)
+                    {
+                        pair.first->setLinkedTerminal(
+                            nullptr);
+                    }
+                    TerminalItem *terminal = pair.second;
+                    if (!terminal)
+                    {
+                        continue;
+                    }
+                    auto global =
+                        terminal->getGlobalTerminalItem();
+                    if (global)
+                    {
+                        mainWindow->globalMapScene_
+                            ->removeItemWithId<
+                                GlobalTerminalItem>(
+                                global->getID());
+                    }
+                    mainWindow->regionScene_
+                        ->removeItemWithId<TerminalItem>(
+                            terminal->getID());
+                }
+                return;
+            }
+
+            if (layer)
+            {
+                layer->finalize();
+            }
+            indexNetworkPoints(mainWindow, network, region,
+                               layer);
+
+            // Fit the view to the scene
+            mainWindow->regionView_->fitInView(
+                mainWindow->regionScene_
+                    ->itemsBoundingRect(),
+                Qt::KeepAspectRatio);
+
+            mainWindow->showStatusBarMessage(QString(
+                "Train network imported successfully."));
+        });
+
+    return job;
+}
+
+CargoNetSim::GUI::NetworkImportJob *
+CargoNetSim::GUI::ViewController::drawTruckNetwork(
+    MainWindow *mainWindow,
+    Backend::TruckClient::IntegrationSimulationConfig
+            *networkConfig,
+    QString &regionName, QColor &linksColor)
+{
+    if (!mainWindow)
+    {
+        return nullptr;
+    }
+
+    mainWindow->regionView_->setUsingProjectedCoords(true);
+    mainWindow->updateAllCoordinates();
+
+    // Get the network object
+    auto network = networkConfig->getNetwork();
+
+    // Define node color
+    QColor nodesColor = QColor(linksColor);
+    nodesColor.setHsv(nodesColor.hue(),
+                      nodesColor.saturation(),
+                      nodesColor.value() * 0.7);
+
+    // set the network Color
+    network->setVariable("color", linksColor);
+
+    auto nodes = network->getNodes();
+    auto links = network->getLinks();
+
+    // Large networks are drawn by a single layer item
+    QPointer<NetworkLayerItem> layer;
+    bool                       useLayer =
+        links.size() >= NETWORK_LAYER_MIN_LINKS;
+    if (useLayer)
+    {
+        layer = createNetworkLayer(
+            mainWindow, network, network->getNetworkName(),
+            regionName, linksColor, nodesColor,
+            nodes.size(), links.size());
+    }
+
+    // Runs on the worker: reads the network, touches no
+    // item
+    auto prepare = [nodes, links, useLayer](
+                       QVector<NetworkImportJob::Node> &out,
+                       QVector<NetworkImportJob::Link>
+                                        &outLinks,
+                       const QAtomicInt &cancelled) {
+        QHash<int, int> nodeIndex;
+        nodeIndex.reserve(nodes.size());
+        out.reserve(nodes.size());
+        for (auto &node : nodes)
         {
-            if (connectionLine->getRegion()
-                == oldRegionName)
+            if (cancelled.loadRelaxed())
             {
-                connectionLine->setRegion(newName);
+                return;
             }
+            NetworkImportJob::Node data;
+            data.networkID =
+                QString::number(node->getNodeId());
+            data.uniqueID = node->getInternalUniqueID();
+            data.scenePoint = projectedToScene(
+                truckNodeProjectedPoint(node));
+            if (!useLayer)
+            {
+                data.properties = truckNodeProperties(node);
+            }
+            nodeIndex.insert(node->getNodeId(), out.size());
+            out.append(data);
         }
-        else if (BackgroundPhotoItem *backgroundPhoto =
-                     dynamic_cast<BackgroundPhotoItem *>(
-                         item))
+
+        // Links with missing nodes keep their index
+        outLinks.reserve(links.size());
+        for (auto &link : links)
         {
-            if (backgroundPhoto->getRegion()
-                == oldRegionName)
+            if (cancelled.loadRelaxed())
             {
-                backgroundPhoto->setRegion(newName);
+                return;
             }
+            NetworkImportJob::Link data;
+            data.networkID =
+                QString::number(link->getLinkId());
+            data.uniqueID = link->getInternalUniqueID();
+            data.fromNode = nodeIndex.value(
+                link->getUpstreamNodeId(), -1);
+            data.toNode = nodeIndex.value(
+                link->getDownstreamNodeId(), -1);
+            if (!useLayer)
+            {
+                data.properties = truckLinkProperties(link);
+            }
+            outLinks.append(data);
         }
+    };
+
+    QString region = regionName;
+    auto    insertNode =
+        [mainWindow, network, layer, useLayer, region,
+         nodesColor](int,
+                     const NetworkImportJob::Node &node) {
+            if (useLayer)
+            {
+                if (layer)
+                {
+                    layer->addNode(node.networkID,
+                                   node.uniqueID,
+                                   node.scenePoint);
+                }
+                return;
+            }
+
+            MapPoint *point = drawSceneNode(
+                mainWindow, node.networkID, node.uniqueID,
+                node.scenePoint, region, nodesColor,
+                node.properties);
+            point->setReferenceNetwork(network);
+        };
+
+    auto insertLink =
+        [mainWindow, network, layer, useLayer, region,
+         linksColor](
+            int, const NetworkImportJob::Link &link,
+            const QVector<NetworkImportJob::Node> &nodes) {
+            if (useLayer)
+            {
+                if (layer)
+                {
+                    layer->addLink(link.networkID,
+                                   link.uniqueID,
+                                   link.fromNode,
+                                   link.toNode);
+                }
+                return;
+            }
+            if (link.fromNode < 0 || link.toNode < 0)
+            {
+                return;
+            }
+
+            MapLine *line = drawSceneLink(
+                mainWindow, link.networkID, link.uniqueID,
+                nodes[link.fromNode].scenePoint,
+                nodes[link.toNode].scenePoint, region,
+                linksColor, link.properties);
+            if (line)
+            {
+                line->setReferenceNetwork(network);
+            }
+        };
+
+    auto job = new NetworkImportJob(network, prepare,
+                                    insertNode, insertLink,
+                                    mainWindow);
+
+    QObject::connect(
+        job, &NetworkImportJob::finished, mainWindow,
+        [mainWindow, network, layer,
+         region](bool completed) {
+            if (!completed)
+            {
+                return;
+            }
+
+            if (layer)
+            {
+                layer->finalize();
+            }
+            indexNetworkPoints(mainWindow, network, region,
+                               layer);
+
+            // Fit the view to the scene
+            mainWindow->regionView_->fitInView(
+                mainWindow->regionScene_
+                    ->itemsBoundingRect(),
+                Qt::KeepAspectRatio);
+
+            mainWindow->showStatusBarMessage(QString(
+                "Truck network imported successfully."));
+        });
+
+    return job;
+}
+
+CargoNetSim::GUI::NetworkLayerItem *
+CargoNetSim::GUI::ViewController::createNetworkLayer(
+    MainWindow *mainWindow, BaseObject *network,
+    const QString &networkName, const QString &regionName,
+    const QColor &linksColor, const QColor &nodesColor,
+    int nodeCount, int linkCount)
+{
+    NetworkLayerItem *layer =
+        new NetworkLayerItem(networkName, regionName);
+    layer->setReferenceNetwork(network);
+    layer->setColors(linksColor, nodesColor);
+    layer->reserve(nodeCount, linkCount);
+
+    // Only clicked elements get their own items
+    QObject::connect(
+        layer, &NetworkLayerItem::nodeClicked,
+        [mainWindow](NetworkLayerItem *layer, int index) {
+            MapPoint *point =
+                ViewController::materializeNetworkNode(
+                    mainWindow, layer, index);
+            if (!point)
+            {
+                return;
+            }
+            UtilitiesFunctions::updatePropertiesPanel(
+                mainWindow, point);
+            mainWindow->handleTerminalNodeLinking(point);
+            mainWindow->handleTerminalNodeUnlinking(point);
+        });
+
+    QObject::connect(
+        layer, &NetworkLayerItem::linkClicked,
+        [mainWindow](NetworkLayerItem *layer, int index) {
+            MapLine *line =
+                ViewController::materializeNetworkLink(
+                    mainWindow, layer, index);
+            if (line)
+            {
+                UtilitiesFunctions::updatePropertiesPanel(
+                    mainWindow, line);
+            }
+        });
+
+    mainWindow->regionScene_->addItemWithId(
+        layer, network->getInternalUniqueID());
+
+    return layer;
+}
+
+CargoNetSim::GUI::NetworkLayerItem *
+CargoNetSim::GUI::ViewController::getNetworkLayer(
+    MainWindow *mainWindow, QObject *network)
+{
+    BaseObject *object =
+        dynamic_cast<BaseObject *>(network);
+    if (!mainWindow || !mainWindow->regionScene_ || !object)
+    {
+        return nullptr;
     }
-    updateSceneVisibility(mainWindow);
+
+    return mainWindow->regionScene_
+        ->getItemById<NetworkLayerItem>(
+            object->getInternalUniqueID());
 }
 
-void CargoNetSim::GUI::ViewController::changeNetworkColor(
-    MainWindow *mainWindow, const QString &networkName,
-    const QColor newColor)
+CargoNetSim::GUI::MapPoint *
+CargoNetSim::GUI::ViewController::materializeNetworkNode(
+    MainWindow *mainWindow, NetworkLayerItem *layer,
+    int index)
 {
-    if (!mainWindow)
+    if (!mainWindow || !layer || index < 0
+        || index >= layer->nodeCount())
+    {
+        return nullptr;
+    }
+
+    MapPoint *point =
+        mainWindow->regionScene_->getItemById<MapPoint>(
+            layer->nodeUniqueID(index));
+    if (point)
+    {
+        return point;
+    }
+
+    // Layer indices follow the network node vectors
+    QString  regionName = layer->getRegion();
+    QObject *network    = layer->getReferenceNetwork();
+    if (auto trainNet = dynamic_cast<
+            Backend::TrainClient::NeTrainSimNetwork *>(
+            network))
+    {
+        auto nodes = trainNet->getNodes();
+        if (index < nodes.size())
+        {
+            point = drawTrainNode(mainWindow, trainNet,
+                                  nodes[index], regionName,
+                                  layer->getNodeColor());
+        }
+    }
+    else if (auto truckNet =
+                 dynamic_cast<Backend::TruckClient::
+                                  IntegrationNetwork *>(
+                     network))
+    {
+        auto nodes = truckNet->getNodes();
+        if (index < nodes.size())
+        {
+            point = drawTruckNode(mainWindow, truckNet,
+                                  nodes[index], regionName,
+                                  layer->getNodeColor());
+        }
+    }
+
+    if (!point)
+    {
+        return nullptr;
+    }
+
+    // The layer already holds moved positions
+    QPointF scenePoint = layer->nodePoint(index);
+    point->setSceneCoordinate(scenePoint);
+    point->updateProperties(
+        {{"x", scenePoint.x()}, {"y", scenePoint.y()}});
+    point->setVisible(layer->isVisible());
+    layer->setNodeMaterialized(index, true);
+    trackIndexedPoint(mainWindow, network, index, point);
+
+    return point;
+}
+
+void CargoNetSim::GUI::ViewController::indexNetworkPoints(
+    MainWindow *mainWindow, QObject *network,
+    const QString &regionName, NetworkLayerItem *layer)
+{
+    if (!mainWindow || !mainWindow->regionScene_
+        || !network)
+    {
+        return;
+    }
+
+    GraphicsScene *scene = mainWindow->regionScene_;
+    NetworkType    type  = NetworkType::Train;
+    QStringList    nodeIDs;
+    if (auto trainNet = dynamic_cast<
+            Backend::TrainClient::NeTrainSimNetwork *>(
+            network))
+    {
+        for (auto node : trainNet->getNodes())
+        {
+            nodeIDs.append(
+                node ? node->getInternalUniqueID()
+                     : QString());
+        }
+    }
+    else if (auto truckNet =
+                 dynamic_cast<Backend::TruckClient::
+                                  IntegrationNetwork *>(
+                     network))
+    {
+        type = NetworkType::Truck;
+        for (auto node : truckNet->getNodes())
+        {
+            nodeIDs.append(
+                node ? node->getInternalUniqueID()
+                     : QString());
+        }
+    }
+    else
     {
         return;
     }
 
-    QColor newDarkerColor =
-        newColor.darker(150); // 150% darker for MapPoints
-
-    auto mapPoints = mainWindow->regionScene_
-                         ->getItemsByType<MapPoint>();
-    auto mapLines =
-        mainWindow->regionScene_->getItemsByType<MapLine>();
-
-    for (auto mapPoint : mapPoints)
+    QVector<QPointF>    points;
+    QVector<int>        nodes;
+    QVector<MapPoint *> mapPoints(nodeIDs.size(), nullptr);
+    points.reserve(nodeIDs.size());
+    nodes.reserve(nodeIDs.size());
+    for (int i = 0; i < nodeIDs.size(); ++i)
     {
-        Backend::TrainClient::NeTrainSimNetwork *trainNet =
-            dynamic_cast<
-                Backend::TrainClient::NeTrainSimNetwork *>(
-                mapPoint->getReferenceNetwork());
-        Backend::TruckClient::IntegrationNetwork *truckNet =
-            dynamic_cast<
-                Backend::TruckClient::IntegrationNetwork *>(
-                mapPoint->getReferenceNetwork());
+        if (nodeIDs[i].isEmpty())
+        {
+            continue;
+        }
 
-        if (trainNet)
+        mapPoints[i] =
+            scene->getItemById<MapPoint>(nodeIDs[i]);
+        if (layer)
         {
-            if (trainNet->getNetworkName() == networkName)
-            {
-                mapPoint->setColor(newDarkerColor);
-            }
+            points.append(layer->nodePoint(i));
         }
-        else if (truckNet)
+        else if (mapPoints[i])
         {
-            if (truckNet->getNetworkName() == networkName)
-            {
-                mapPoint->setColor(newDarkerColor);
-            }
+            points.append(
+                mapPoints[i]->getSceneCoordinate());
+        }
+        else
+        {
+            continue;
         }
+        nodes.append(i);
     }
 
-    for (auto mapLine : mapLines)
+    scene->getNetworkPointIndex().addNetwork(
+        network, type, regionName, points, nodes);
+    for (int i = 0; i < mapPoints.size(); ++i)
     {
-        Backend::TrainClient::NeTrainSimNetwork *trainNet =
-            dynamic_cast<
-                Backend::TrainClient::NeTrainSimNetwork *>(
-                mapLine->getReferenceNetwork());
-        Backend::TruckClient::IntegrationNetwork *truckNet =
-            dynamic_cast<
-                Backend::TruckClient::IntegrationNetwork *>(
-                mapLine->getReferenceNetwork());
-
-        if (trainNet)
-        {
-            if (trainNet->getNetworkName() == networkName)
-            {
-                mapLine->setColor(newColor);
-            }
-        }
-        else if (truckNet)
+        if (mapPoints[i])
         {
-            if (truckNet->getNetworkName() == networkName)
-            {
-                mapLine->setColor(newColor);
-            }
+            trackIndexedPoint(mainWindow, network, i,
+                              mapPoints[i]);
         }
     }
 }
 
-void CargoNetSim::GUI::ViewController::drawTrainNetwork(
-    MainWindow                              *mainWindow,
-    Backend::TrainClient::NeTrainSimNetwork *network,
-    QString &regionName, QColor &linksColor)
+void CargoNetSim::GUI::ViewController::trackIndexedPoint(
+    MainWindow *mainWindow, QObject *network, int node,
+    MapPoint *point)
 {
-    mainWindow->regionView_->setUsingProjectedCoords(true);
-    mainWindow->updateAllCoordinates();
-
-    // Define node color
-    QColor nodesColor = QColor(linksColor);
-    nodesColor.setHsv(nodesColor.hue(),
-                      nodesColor.saturation(),
-                      nodesColor.value() * 0.7);
-
-    // set the network Color
-    network->setVariable("color", linksColor);
-
-    // Draw the train network
-    for (auto &node : network->getNodes())
+    if (!mainWindow || !point)
     {
+        return;
+    }
 
-        QMap<QString, QVariant> properties = {
-            {"Is_terminal", node->isTerminal()},
-            {"Dwell_time", node->getDwellTime()},
-            {"Description", node->getDescription()}};
+    mainWindow->regionScene_->getNetworkPointIndex()
+        .setMapPoint(network, node, point);
 
-        QPointF projectedPoint =
-            QPointF(node->getX() * node->getXScale(),
-                    node->getY() * node->getYScale());
+    // Keep the link status of the node in sync
+    QObject::connect(
+        point, &MapPoint::terminalChanged, point,
+        [mainWindow, network,
+         node](TerminalItem *, TerminalItem *terminal) {
+            mainWindow->regionScene_
+                ->getNetworkPointIndex()
+                .setLinkedTerminal(network, node, terminal);
+        });
+}
 
-        MapPoint *point =
-            CargoNetSim::GUI::ViewController::drawNode(
-                mainWindow,
-                QString::number(node->getUserId()),
-                node->getInternalUniqueID(), projectedPoint,
-                regionName, nodesColor, properties);
+CargoNetSim::GUI::MapLine *
+CargoNetSim::GUI::ViewController::materializeNetworkLink(
+    MainWindow *mainWindow, NetworkLayerItem *layer,
+    int index)
+{
+    int fromNode, toNode;
+    if (!mainWindow || !layer
+        || !layer->linkNodes(index, fromNode, toNode))
+    {
+        return nullptr;
+    }
 
-        point->setReferenceNetwork(network);
+    MapLine *line =
+        mainWindow->regionScene_->getItemById<MapLine>(
+            layer->linkUniqueID(index));
+    if (line)
+    {
+        return line;
+    }
 
-        // Link terminal to point
-        if (point && node->isTerminal())
+    QString  regionName = layer->getRegion();
+    QObject *network    = layer->getReferenceNetwork();
+    if (auto trainNet = dynamic_cast<
+            Backend::TrainClient::NeTrainSimNetwork *>(
+            network))
+    {
+        auto links = trainNet->getLinks();
+        if (index < links.size())
         {
-            auto terminal =
-                ViewController::createTerminalAtPoint(
-                    mainWindow, regionName,
-                    "Intermodal Land Terminal",
-                    point->getSceneCoordinate());
-
-            point->setLinkedTerminal(terminal);
+            line = drawTrainLink(mainWindow, trainNet,
+                                 links[index], regionName,
+                                 layer->getLinkColor());
+        }
+    }
+    else if (auto truckNet =
+                 dynamic_cast<Backend::TruckClient::
+                                  IntegrationNetwork *>(
+                     network))
+    {
+        auto links = truckNet->getLinks();
+        if (index < links.size())
+        {
+            line = drawTruckLink(mainWindow, truckNet,
+                                 links[index], regionName,
+                                 layer->getLinkColor());
         }
     }
 
-    // Process events to keep UI responsive
-    QApplication::processEvents();
-
-    // Draw the train network links
-    for (auto &link : network->getLinks())
+    if (!line)
     {
-        // Get the source and destination nodes
-        auto sourceNode = link->getFromNode();
-        auto destNode   = link->getToNode();
+        return nullptr;
+    }
 
-        // Create the source and destination points
-        QPointF projectedSourcePoint = QPointF(
-            sourceNode->getX() * sourceNode->getXScale(),
-            sourceNode->getY() * sourceNode->getYScale());
+    line->setPoints(layer->nodePoint(fromNode),
+                    layer->nodePoint(toNode));
+    line->setVisible(layer->isVisible());
+
+    return line;
+}
 
-        QPointF projectedDestPoint = QPointF(
-            destNode->getX() * destNode->getXScale(),
-            destNode->getY() * destNode->getYScale());
+QMap<QString, QVariant>
+CargoNetSim::GUI::ViewController::trainNodeProperties(
+    Backend::TrainClient::NeTrainSimNode *node)
+{
+    return {{"Is_terminal", node->isTerminal()},
+            {"Dwell_time", node->getDwellTime()},
+            {"Description", node->getDescription()}};
+}
 
-        QMap<QString, QVariant> properties = {
-            {"Length", link->getLength()},
+QMap<QString, QVariant>
+CargoNetSim::GUI::ViewController::trainLinkProperties(
+    Backend::TrainClient::NeTrainSimLink *link)
+{
+    return {{"Length", link->getLength()},
             {"MaxSpeed",
              link->getMaxSpeed() * link->getSpeedScale()}};
+}
 
-        auto line =
-            CargoNetSim::GUI::ViewController::drawLink(
-                mainWindow,
-                QString::number(link->getUserId()),
-                link->getInternalUniqueID(),
-                projectedSourcePoint, projectedDestPoint,
-                regionName, linksColor, properties);
-
-        line->setReferenceNetwork(network);
-    }
-
-    // Fit the view to the scene
-    mainWindow->regionView_->fitInView(
-        mainWindow->regionScene_->itemsBoundingRect(),
-        Qt::KeepAspectRatio);
+QMap<QString, QVariant>
+CargoNetSim::GUI::ViewController::truckNodeProperties(
+    Backend::TruckClient::IntegrationNode *node)
+{
+    return {{"Description", node->getDescription()}};
+}
 
-    mainWindow->showStatusBarMessage(
-        QString("Train network imported successfully."));
+QMap<QString, QVariant>
+CargoNetSim::GUI::ViewController::truckLinkProperties(
+    Backend::TruckClient::IntegrationLink *link)
+{
+    return {{"ReferenceNetworkID", link->getLinkId()},
+            {"Length", link->getLength()
+                           * link->getLengthScale()
+                           * 1000.0}, // km to m
+            {"FreeFlowTime",
+             link->getFreeSpeed() * link->getSpeedScale()},
+            {"NoOfLanes", link->getLanes()}};
 }
 
-void CargoNetSim::GUI::ViewController::drawTruckNetwork(
-    MainWindow *mainWindow,
-    Backend::TruckClient::IntegrationSimulationConfig
-            *networkConfig,
-    QString &regionName, QColor &linksColor)
+QPointF
+CargoNetSim::GUI::ViewController::trainNodeProjectedPoint(
+    Backend::TrainClient::NeTrainSimNode *node)
 {
-    if (!mainWindow)
-    {
-        return;
-    }
+    return QPointF(node->getX() * node->getXScale(),
+                   node->getY() * node->getYScale());
+}
 
-    mainWindow->regionView_->setUsingProjectedCoords(true);
-    mainWindow->updateAllCoordinates();
+QPointF
+CargoNetSim::GUI::ViewController::truckNodeProjectedPoint(
+    Backend::TruckClient::IntegrationNode *node)
+{
+    return QPointF(node->getXCoordinate()
+                       * node->getXScale()
+                       * 1000.0, // km to m
+                   node->getYCoordinate()
+                       * node->getYScale()
+                       * 1000.0); // km to m
+}
 
-    // Get the network object
-    auto network = networkConfig->getNetwork();
+CargoNetSim::GUI::MapPoint *
+CargoNetSim::GUI::ViewController::drawTrainNode(
+    MainWindow                              *mainWindow,
+    Backend::TrainClient::NeTrainSimNetwork *network,
+    Backend::TrainClient::NeTrainSimNode    *node,
+    QString &regionName, const QColor &nodesColor)
+{
+    MapPoint *point =
+        CargoNetSim::GUI::ViewController::drawNode(
+            mainWindow, QString::number(node->getUserId()),
+            node->getInternalUniqueID(),
+            trainNodeProjectedPoint(node), regionName,
+            nodesColor, trainNodeProperties(node));
 
-    // Define node color
-    QColor nodesColor = QColor(linksColor);
-    nodesColor.setHsv(nodesColor.hue(),
-                      nodesColor.saturation(),
-                      nodesColor.value() * 0.7);
+    point->setReferenceNetwork(network);
 
-    // set the network Color
-    network->setVariable("color", linksColor);
+    return point;
+}
 
-    for (auto &node : network->getNodes())
+CargoNetSim::GUI::MapLine *
+CargoNetSim::GUI::ViewController::drawTrainLink(
+    MainWindow                              *mainWindow,
+    Backend::TrainClient::NeTrainSimNetwork *network,
+    Backend::TrainClient::NeTrainSimLink    *link,
+    QString &regionName, const QColor &linksColor)
+{
+    auto line = CargoNetSim::GUI::ViewController::drawLink(
+        mainWindow, QString::number(link->getUserId()),
+        link->getInternalUniqueID(),
+        trainNodeProjectedPoint(link->getFromNode()),
+        trainNodeProjectedPoint(link->getToNode()),
+        regionName, linksColor, trainLinkProperties(link));
+
+    if (line)
     {
+        line->setReferenceNetwork(network);
+    }
 
-        QMap<QString, QVariant> properties = {
-            {"Description", node->getDescription()}};
+    return line;
+}
 
-        auto point =
-            CargoNetSim::GUI::ViewController::drawNode(
-                mainWindow,
-                QString::number(node->getNodeId()),
-                node->getInternalUniqueID(),
-                QPointF(node->getXCoordinate()
-                            * node->getXScale()
-                            * 1000.0, // km to m
-                        node->getYCoordinate()
-                            * node->getYScale()
-                            * 1000.0), // km to m
-                regionName, nodesColor, properties);
+CargoNetSim::GUI::MapPoint *
+CargoNetSim::GUI::ViewController::drawTruckNode(
+    MainWindow                               *mainWindow,
+    Backend::TruckClient::IntegrationNetwork *network,
+    Backend::TruckClient::IntegrationNode    *node,
+    QString &regionName, const QColor &nodesColor)
+{
+    auto point = CargoNetSim::GUI::ViewController::drawNode(
+        mainWindow, QString::number(node->getNodeId()),
+        node->getInternalUniqueID(),
+        truckNodeProjectedPoint(node), regionName,
+        nodesColor, truckNodeProperties(node));
 
-        point->setReferenceNetwork(network);
-    }
+    point->setReferenceNetwork(network);
 
-    // Process events to keep UI responsive
-    QApplication::processEvents();
+    return point;
+}
 
-    for (auto &link : network->getLinks())
+CargoNetSim::GUI::MapLine *
+CargoNetSim::GUI::ViewController::drawTruckLink(
+    MainWindow                               *mainWindow,
+    Backend::TruckClient::IntegrationNetwork *network,
+    Backend::TruckClient::IntegrationLink    *link,
+    QString &regionName, const QColor &linksColor)
+{
+    // Get the source and destination nodes
+    auto to = network->getNode(link->getDownstreamNodeId());
+    auto from =
+        network->getNode(link->getUpstreamNodeId());
+    if (!to || !from)
     {
-        QMap<QString, QVariant> properties = {
-            {"ReferenceNetworkID", link->getLinkId()},
-            {"Length", link->getLength()
-                           * link->getLengthScale()
-                           * 1000.0}, // km to m
-            {"FreeFlowTime",
-             link->getFreeSpeed() * link->getSpeedScale()},
-            {"NoOfLanes", link->getLanes()}};
-
-        // Get the source and destination nodes
-        auto to =
-            network->getNode(link->getDownstreamNodeId());
-        auto from =
-            network->getNode(link->getUpstreamNodeId());
-        if (!to || !from)
-        {
-            continue;
-        }
+        return nullptr;
+    }
 
-        // Create the source and destination projected
-        // points
-        QPointF projectedSourcePoint = QPointF(
-            from->getXCoordinate() * from->getXScale()
-                * 1000.0, // km to m
-            from->getYCoordinate() * from->getYScale()
-                * 1000.0); // km to m
-        QPointF projectedDestPoint =
-            QPointF(to->getXCoordinate() * to->getXScale()
-                        * 1000.0, // km to m
-                    to->getYCoordinate() * to->getYScale()
-                        * 1000.0); // km to m
-
-        auto line =
-            CargoNetSim::GUI::ViewController::drawLink(
-                mainWindow,
-                QString::number(link->getLinkId()),
-                link->getInternalUniqueID(),
-                projectedSourcePoint, projectedDestPoint,
-                regionName, linksColor, properties);
+    auto line = CargoNetSim::GUI::ViewController::drawLink(
+        mainWindow, QString::number(link->getLinkId()),
+        link->getInternalUniqueID(),
+        truckNodeProjectedPoint(from),
+        truckNodeProjectedPoint(to), regionName,
+        linksColor, truckLinkProperties(link));
 
+    if (line)
+    {
         line->setReferenceNetwork(network);
     }
 
-    // Fit the view to the scene
-    mainWindow->regionView_->fitInView(
-        mainWindow->regionScene_->itemsBoundingRect(),
-        Qt::KeepAspectRatio);
+    return line;
+}
 
-    mainWindow->showStatusBarMessage(
-        QString("Truck network imported successfully."));
+QPointF CargoNetSim::GUI::ViewController::projectedToScene(
+    const QPointF &point)
+{
+    QPointF geodeticPoint =
+        GraphicsView::convertCoordinates(point,
+                                         "to_geodetic");
+    return GraphicsView::wgs84ToScene(geodeticPoint);
 }
 
 CargoNetSim::GUI::MapPoint *
@@ -1439,14 +2120,19 @@ CargoNetSim::GUI::ViewController::drawNode(
     QString &regionName, QColor color,
     const QMap<QString, QVariant> &properties)
 {
+    return drawSceneNode(mainWindow, networkNodeID,
+                         nodeUniqueID,
+                         projectedToScene(projectedPoint),
+                         regionName, color, properties);
+}
 
-    QPointF geodeticPoint =
-        mainWindow->regionView_->convertCoordinates(
-            projectedPoint, "to_geodetic");
-    QPointF scenePoint =
-        mainWindow->regionView_->wgs84ToScene(
-            geodeticPoint);
-
+CargoNetSim::GUI::MapPoint *
+CargoNetSim::GUI::ViewController::drawSceneNode(
+    MainWindow *mainWindow, const QString &networkNodeID,
+    const QString &nodeUniqueID, const QPointF &scenePoint,
+    const QString &regionName, QColor color,
+    const QMap<QString, QVariant> &properties)
+{
     // Create projected coordinate point
     MapPoint *point =
         new MapPoint(networkNodeID, scenePoint, regionName,
@@ -1483,27 +2169,28 @@ CargoNetSim::GUI::ViewController::drawLink(
     QPointF projectedStartPoint, QPointF projectedEndPoint,
     QString &regionName, QColor color,
     const QMap<QString, QVariant> &properties)
+{
+    return drawSceneLink(
+        mainWindow, networkNodeID, linkUniqueID,
+        projectedToScene(projectedStartPoint),
+        projectedToScene(projectedEndPoint), regionName,
+        color, properties);
+}
+
+CargoNetSim::GUI::MapLine *
+CargoNetSim::GUI::ViewController::drawSceneLink(
+    MainWindow *mainWindow, const QString &networkLinkID,
+    const QString &linkUniqueID,
+    const QPointF &sceneStartPoint,
+    const QPointF &sceneEndPoint, const QString &regionName,
+    QColor color, const QMap<QString, QVariant> &properties)
 {
     MapLine *line = nullptr;
     try
     {
-        // Convert the points to geodetic coordinates
-        QPointF sourceGeodetic =
-            mainWindow->regionView_->convertCoordinates(
-                projectedStartPoint, "to_geodetic");
-        QPointF destGeodetic =
-            mainWindow->regionView_->convertCoordinates(
-                projectedEndPoint, "to_geodetic");
-        QPointF sourceScenePoint =
-            mainWindow->regionView_->wgs84ToScene(
-                sourceGeodetic);
-        QPointF destScenePoint =
-            mainWindow->regionView_->wgs84ToScene(
-                destGeodetic);
-
         // Create the link
-        line = new MapLine(networkNodeID, sourceScenePoint,
-                           destScenePoint, regionName,
+        line = new MapLine(networkLinkID, sceneStartPoint,
+                           sceneEndPoint, regionName,
                            properties);
 
         QObject::connect(
@@ -1547,6 +2234,17 @@ void CargoNetSim::GUI::ViewController::removeNetwork(
         {
             return;
         }
+        // The import must not touch the network once it
+        // is gone
+        if (auto job = NetworkImportJob::find(network))
+        {
+            job->cancel();
+        }
+        mainWindow->regionScene_->getNetworkPointIndex()
+            .removeNetwork(network);
+        mainWindow->regionScene_
+            ->removeItemWithId<NetworkLayerItem>(
+                network->getInternalUniqueID());
         for (auto &node : network->getNodes())
         {
             if (!node)
@@ -1595,6 +2293,21 @@ void CargoNetSim::GUI::ViewController::removeNetwork(
     {
         Backend::TruckClient::IntegrationNetwork *network =
             regionData->getTruckNetwork(networkName);
+        if (!network)
+        {
+            return;
+        }
+        // The import must not touch the network once it
+        // is gone
+        if (auto job = NetworkImportJob::find(network))
+        {
+            job->cancel();
+        }
+        mainWindow->regionScene_->getNetworkPointIndex()
+            .removeNetwork(network);
+        mainWindow->regionScene_
+            ->removeItemWithId<NetworkLayerItem>(
+                network->getInternalUniqueID());
         for (auto &node : network->getNodes())
         {
             // Get the point
@@ -1602,6 +2315,11 @@ void CargoNetSim::GUI::ViewController::removeNetwork(
                 mainWindow->regionScene_
                     ->getItemById<MapPoint>(
                         node->getInternalUniqueID());
+            // Layer nodes may have no point
+            if (!point)
+            {
+                continue;
+            }
 
             // Get the associated terminal of the point
             TerminalItem *terminal =
@@ -1644,8 +2362,9 @@ void CargoNetSim::GUI::ViewController::addBackgroundPhoto(
             return;
         }
 
-        QPixmap pixmap(fileName);
-        if (pixmap.isNull())
+        // Only the header is read here; tiles are built on
+        // a worker thread
+        if (QImageReader(fileName).size().isEmpty())
         {
             QMessageBox::warning(mainWindow, "Error",
                                  "Failed to load image.");
@@ -1664,7 +2383,7 @@ void CargoNetSim::GUI::ViewController::addBackgroundPhoto(
                         .getRegionDataController()
                         ->getCurrentRegion();
             BackgroundPhotoItem *background =
-                new BackgroundPhotoItem(pixmap,
+                new BackgroundPhotoItem(fileName,
                                         currentRegion);
             QObject::connect(
                 background, &BackgroundPhotoItem::clicked,
@@ -1723,7 +2442,8 @@ void CargoNetSim::GUI::ViewController::addBackgroundPhoto(
             // Create a new BackgroundPhotoItem for the
             // global map
             BackgroundPhotoItem *background =
-                new BackgroundPhotoItem(pixmap, "global");
+                new BackgroundPhotoItem(fileName,
+                                        "global");
             QObject::connect(
                 background, &BackgroundPhotoItem::clicked,
                 [mainWindow](BackgroundPhotoItem *item) {
@@ -3616,53 +4336,30 @@ bool CargoNetSim::GUI::ViewController::moveNetworkItems(
     bool usingProjectedCoords =
         mainWindow->regionView_->isUsingProjectedCoords();
 
-    // Get all network map points and lines
-    QList<MapPoint *> mapPoints =
-        scene->getItemsByType<MapPoint>();
-    QList<MapLine *> mapLines =
-        scene->getItemsByType<MapLine>();
+    // Items are registered under their reference network
+    Backend::RegionData *regionData =
+        CargoNetSim::CargoNetSimController::getInstance()
+            .getRegionDataController()
+            ->getRegionData(regionName);
+    QObject *network = nullptr;
+    if (regionData && networkType == NetworkType::Train)
+    {
+        network = regionData->getTrainNetwork(networkName);
+    }
+    else if (regionData
+             && networkType == NetworkType::Truck)
+    {
+        network = regionData->getTruckNetwork(networkName);
+    }
+    if (!network)
+        return false;
 
     int itemsUpdated = 0;
 
     // Process map points
-    for (MapPoint *point : mapPoints)
+    for (MapPoint *point :
+         scene->itemsOfNetwork<MapPoint>(network))
     {
-        // Skip points that don't belong to this region or
-        // network
-        if (point->getRegion() != regionName)
-            continue;
-
-        QObject *refNetwork = point->getReferenceNetwork();
-        if (!refNetwork)
-            continue;
-
-        // Check if this point belongs to the target network
-        bool isTargetNetwork = false;
-
-        if (networkType == NetworkType::Train)
-        {
-            auto trainNet = qobject_cast<
-                Backend::TrainClient::NeTrainSimNetwork *>(
-                refNetwork);
-            if (trainNet
-                && trainNet->getNetworkName()
-                       == networkName)
-                isTargetNetwork = true;
-        }
-        else if (networkType == NetworkType::Truck)
-        {
-            auto truckNet = qobject_cast<
-                Backend::TruckClient::IntegrationNetwork *>(
-                refNetwork);
-            if (truckNet
-                && truckNet->getNetworkName()
-                       == networkName)
-                isTargetNetwork = true;
-        }
-
-        if (!isTargetNetwork)
-            continue;
-
         // Update point position
         QPointF currentPos = point->getSceneCoordinate();
         QPointF newPos     = currentPos + offset;
@@ -3687,44 +4384,9 @@ bool CargoNetSim::GUI::ViewController::moveNetworkItems(
     }
 
     // Process map lines
-    for (MapLine *line : mapLines)
+    for (MapLine *line :
+         scene->itemsOfNetwork<MapLine>(network))
     {
-        // Skip lines that don't belong to this region or
-        // network
-        if (line->getRegion() != regionName)
-            continue;
-
-        QObject *refNetwork = line->getReferenceNetwork();
-        if (!refNetwork)
-            continue;
-
-        // Check if this line belongs to the target network
-        bool isTargetNetwork = false;
-
-        if (networkType == NetworkType::Train)
-        {
-            auto trainNet = qobject_cast<
-                Backend::TrainClient::NeTrainSimNetwork *>(
-                refNetwork);
-            if (trainNet
-                && trainNet->getNetworkName()
-                       == networkName)
-                isTargetNetwork = true;
-        }
-        else if (networkType == NetworkType::Truck)
-        {
-            auto truckNet = qobject_cast<
-                Backend::TruckClient::IntegrationNetwork *>(
-                refNetwork);
-            if (truckNet
-                && truckNet->getNetworkName()
-                       == networkName)
-                isTargetNetwork = true;
-        }
-
-        if (!isTargetNetwork)
-            continue;
-
         // Update line start and end points
         QPointF currentStart = line->getStartPoint();
         QPointF currentEnd   = line->getEndPoint();
@@ -3737,6 +4399,19 @@ bool CargoNetSim::GUI::ViewController::moveNetworkItems(
         itemsUpdated++;
     }
 
+    // Process network layers
+    for (NetworkLayerItem *layer :
+         scene->itemsOfNetwork<NetworkLayerItem>(network))
+    {
+        layer->translateGeometry(offset);
+
+        itemsUpdated++;
+    }
+
+    // Shift the indexed nodes of the moved network
+    scene->getNetworkPointIndex().translateNetwork(network,
+                                                   offset);
+
     if (itemsUpdated > 0)
     {
         // Force scene update
@@ -4,6 +4,7 @@
 #include "GUI/Items/ConnectionLine.h"
 #include "GUI/Items/MapLine.h"
 #include "GUI/Items/MapPoint.h"
+#include "GUI/Items/NetworkLayerItem.h"
 #include "GUI/Items/RegionCenterPoint.h"
 #include <QGraphicsItem>
 #include <QMainWindow>
@@ -21,6 +22,7 @@ namespace GUI
 // Forward declarations
 class MainWindow;
 class GraphicsScene;
+class NetworkImportJob;
 class TerminalItem;
 
 class ViewController
@@ -156,23 +158,165 @@ public:
                                  const QPointF &offset,
                                  const QString &regionName);
 
+    /**
+     * @brief Gets the layer item drawing a network
+     * @param mainWindow Pointer to MainWindow
+     * @param network The train or truck network
+     * @return The layer, or nullptr if the network is
+     * drawn with individual items
+     */
+    static NetworkLayerItem *
+    getNetworkLayer(MainWindow *mainWindow,
+                    QObject    *network);
+
+    /**
+     * @brief Creates the MapPoint of a layer node
+     *
+     * Returns the existing point if the node already has
+     * one.
+     */
+    static MapPoint *
+    materializeNetworkNode(MainWindow       *mainWindow,
+                           NetworkLayerItem *layer,
+                           int               index);
+
+    /**
+     * @brief Creates the MapLine of a layer link
+     *
+     * Returns the existing line if the link already has
+     * one.
+     */
+    static MapLine *
+    materializeNetworkLink(MainWindow       *mainWindow,
+                           NetworkLayerItem *layer,
+                           int               index);
+
 private:
+    /// Networks with at least this many links are drawn
+    /// by a NetworkLayerItem
+    static constexpr int NETWORK_LAYER_MIN_LINKS = 5000;
     static void updateTerminalGlobalPosition(
         MainWindow        *main_window,
         RegionCenterPoint *regionCenterPoint,
         TerminalItem      *terminal);
 
-    static void drawTrainNetwork(
+    /**
+     * @brief Creates the import job that draws a train
+     * network; the caller starts it
+     */
+    static NetworkImportJob *drawTrainNetwork(
         MainWindow                              *mainWindow,
         Backend::TrainClient::NeTrainSimNetwork *network,
         QString &regionName, QColor &linksColor);
 
-    static void drawTruckNetwork(
+    /**
+     * @brief Creates the import job that draws a truck
+     * network; the caller starts it
+     */
+    static NetworkImportJob *drawTruckNetwork(
         MainWindow *mainWindow,
         Backend::TruckClient::IntegrationSimulationConfig
                 *networkConfig,
         QString &regionName, QColor &linksColor);
 
+    static NetworkLayerItem *createNetworkLayer(
+        MainWindow *mainWindow, BaseObject *network,
+        const QString &networkName,
+        const QString &regionName, const QColor &linksColor,
+        const QColor &nodesColor, int nodeCount,
+        int linkCount);
+
+    /**
+     * @brief Adds the nodes of a drawn network to the
+     * scene's NetworkPointIndex
+     *
+     * Node positions come from the layer if the network
+     * has one, otherwise from the node MapPoints.
+     */
+    static void
+    indexNetworkPoints(MainWindow       *mainWindow,
+                       QObject          *network,
+                       const QString    &regionName,
+                       NetworkLayerItem *layer);
+
+    /**
+     * @brief Records a node MapPoint in the point index and
+     * follows its terminal links
+     */
+    static void trackIndexedPoint(MainWindow *mainWindow,
+                                  QObject    *network,
+                                  int         node,
+                                  MapPoint   *point);
+
+    static MapPoint *drawTrainNode(
+        MainWindow                              *mainWindow,
+        Backend::TrainClient::NeTrainSimNetwork *network,
+        Backend::TrainClient::NeTrainSimNode    *node,
+        QString &regionName, const QColor &nodesColor);
+
+    static MapLine *drawTrainLink(
+        MainWindow                              *mainWindow,
+        Backend::TrainClient::NeTrainSimNetwork *network,
+        Backend::TrainClient::NeTrainSimLink    *link,
+        QString &regionName, const QColor &linksColor);
+
+    static MapPoint *drawTruckNode(
+        MainWindow                               *mainWindow,
+        Backend::TruckClient::IntegrationNetwork *network,
+        Backend::TruckClient::IntegrationNode    *node,
+        QString &regionName, const QColor &nodesColor);
+
+    static MapLine *drawTruckLink(
+        MainWindow                               *mainWindow,
+        Backend::TruckClient::IntegrationNetwork *network,
+        Backend::TruckClient::IntegrationLink    *link,
+        QString &regionName, const QColor &linksColor);
+
+    /**
+     * @brief Converts a projected point to scene
+     * coordinates; safe to call off the GUI thread
+     */
+    static QPointF projectedToScene(const QPointF &point);
+
+    static QMap<QString, QVariant> trainNodeProperties(
+        Backend::TrainClient::NeTrainSimNode *node);
+    static QMap<QString, QVariant> trainLinkProperties(
+        Backend::TrainClient::NeTrainSimLink *link);
+    static QMap<QString, QVariant> truckNodeProperties(
+        Backend::TruckClient::IntegrationNode *node);
+    static QMap<QString, QVariant> truckLinkProperties(
+        Backend::TruckClient::IntegrationLink *link);
+
+    static QPointF trainNodeProjectedPoint(
+        Backend::TrainClient::NeTrainSimNode *node);
+    static QPointF truckNodeProjectedPoint(
+        Backend::TruckClient::IntegrationNode *node);
+
+    /**
+     * @brief Creates a node MapPoint at a scene position
+     */
+    static MapPoint *
+    drawSceneNode(MainWindow    *mainWindow,
+                  const QString &networkNodeID,
+                  const QString &nodeUniqueID,
+                  const QPointF &scenePoint,
+                  const QString &regionName, QColor color,
+                  const QMap<QString, QVariant>
+                      &properties);
+
+    /**
+     * @brief Creates a link MapLine between scene positions
+     */
+    static MapLine *
+    drawSceneLink(MainWindow    *mainWindow,
+                  const QString &networkLinkID,
+                  const QString &linkUniqueID,
+                  const QPointF &sceneStartPoint,
+                  const QPointF &sceneEndPoint,
+                  const QString &regionName, QColor color,
+                  const QMap<QString, QVariant>
+                      &properties);
+
     static CargoNetSim::GUI::MapPoint *
     drawNode(MainWindow    *mainWindow,
              const QString &networkNodeID,
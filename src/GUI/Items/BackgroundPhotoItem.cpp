@@ -1,16 +1,19 @@
 #include "BackgroundPhotoItem.h"
 #include "GUI/MainWindow.h"
+#include "GUI/Utils/TiledImagePyramid.h"
 #include "GUI/Widgets/GraphicsScene.h"
 #include "GUI/Widgets/GraphicsView.h"
 
 #include <QBuffer>
 #include <QByteArray>
 #include <QCursor>
+#include <QFile>
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
+#include <QtMath>
 
 namespace CargoNetSim
 {
@@ -39,7 +42,28 @@ BackgroundPhotoItem::BackgroundPhotoItem(
     // Configure flags for interaction
     setFlags(QGraphicsItem::ItemIsSelectable
              | QGraphicsItem::ItemIsMovable
-             | QGraphicsItem::ItemSendsGeometryChanges);
+             | QGraphicsItem::ItemSendsGeometryChanges
+             | QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+BackgroundPhotoItem::BackgroundPhotoItem(
+    const QString &imagePath, const QString &regionName,
+    QGraphicsItem *parent)
+    : BackgroundPhotoItem(QPixmap(), regionName, parent)
+{
+    m_pyramid = new TiledImagePyramid(imagePath, this);
+
+    // Repaint as tiles arrive
+    connect(m_pyramid, &TiledImagePyramid::ready, this,
+            [this]() { update(); });
+    connect(m_pyramid, &TiledImagePyramid::tileLoaded,
+            this, [this]() { update(); });
+}
+
+QSize BackgroundPhotoItem::imageSize() const
+{
+    return m_pyramid ? m_pyramid->imageSize()
+                     : m_pixmap.size();
 }
 
 void BackgroundPhotoItem::updateCoordinates()
@@ -103,8 +127,9 @@ void BackgroundPhotoItem::setFromWGS84(QPointF GeoPoint)
 QRectF BackgroundPhotoItem::boundingRect() const
 {
     float scale = getScale();
-    return QRectF(0, 0, m_pixmap.width() * scale,
-                  m_pixmap.height() * scale);
+    QSize size  = imageSize();
+    return QRectF(0, 0, size.width() * scale,
+                  size.height() * scale);
 }
 
 void BackgroundPhotoItem::updateScale()
@@ -121,6 +146,7 @@ void BackgroundPhotoItem::setRegion(const QString &region)
     if (m_properties["Region"] != region)
     {
         m_properties["Region"] = region;
+        updateRegistration();
         emit regionChanged(region);
     }
 }
@@ -184,13 +210,22 @@ void BackgroundPhotoItem::paint(
     float scale = getScale();
 
     // Calculate scaled dimensions
-    float scaledWidth  = m_pixmap.width() * scale;
-    float scaledHeight = m_pixmap.height() * scale;
+    QSize size         = imageSize();
+    float scaledWidth  = size.width() * scale;
+    float scaledHeight = size.height() * scale;
 
-    // Draw the scaled pixmap
-    painter->drawPixmap(
-        QRectF(0, 0, scaledWidth, scaledHeight), m_pixmap,
-        QRectF(m_pixmap.rect()));
+    if (m_pyramid)
+    {
+        paintTiles(painter, option,
+                   QRectF(0, 0, scaledWidth, scaledHeight));
+    }
+    else
+    {
+        // Draw the scaled pixmap
+        painter->drawPixmap(
+            QRectF(0, 0, scaledWidth, scaledHeight),
+            m_pixmap, QRectF(m_pixmap.rect()));
+    }
 
     // Draw selection rectangle if selected
     if (option->state & QStyle::State_Selected)
@@ -202,6 +237,112 @@ void BackgroundPhotoItem::paint(
     }
 }
 
+void BackgroundPhotoItem::paintTiles(
+    QPainter                       *painter,
+    const QStyleOptionGraphicsItem *option,
+    const QRectF                   &target)
+{
+    QPixmap overview = m_pyramid->overview();
+    if (!m_pyramid->isReady())
+    {
+        if (overview.isNull())
+        {
+            painter->fillRect(target,
+                              QColor(128, 128, 128, 60));
+        }
+        else
+        {
+            painter->drawPixmap(target, overview,
+                                QRectF(overview.rect()));
+        }
+        return;
+    }
+
+    // Pick the level with at least one image pixel per
+    // screen pixel
+    qreal screenPixels =
+        option->levelOfDetailFromTransform(
+            painter->worldTransform())
+        * getScale();
+    int topLevel = m_pyramid->levelCount() - 1;
+    int level    = topLevel;
+    if (screenPixels > 0.0)
+    {
+        level = qBound(
+            0, qFloor(std::log2(1.0 / screenPixels)),
+            topLevel);
+    }
+
+    // Loads queued for another level are no longer needed
+    if (level != m_tileLevel)
+    {
+        m_pyramid->cancelPendingLoads();
+        m_tileLevel = level;
+    }
+
+    const int tileSize  = TiledImagePyramid::TILE_SIZE;
+    QSize     levelSize = m_pyramid->levelSize(level);
+    qreal unitX = target.width() / levelSize.width();
+    qreal unitY = target.height() / levelSize.height();
+
+    QRectF exposed =
+        option->exposedRect.intersected(target);
+    if (exposed.isEmpty())
+    {
+        return;
+    }
+
+    int lastColumn = (levelSize.width() - 1) / tileSize;
+    int lastRow    = (levelSize.height() - 1) / tileSize;
+    int minX       = qBound(
+        0, int(exposed.left() / (unitX * tileSize)),
+        lastColumn);
+    int maxX = qBound(
+        0, int(exposed.right() / (unitX * tileSize)),
+        lastColumn);
+    int minY = qBound(
+        0, int(exposed.top() / (unitY * tileSize)),
+        lastRow);
+    int maxY = qBound(
+        0, int(exposed.bottom() / (unitY * tileSize)),
+        lastRow);
+
+    qreal overviewX = overview.width() / target.width();
+    qreal overviewY = overview.height() / target.height();
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            QRect source =
+                QRect(x * tileSize, y * tileSize, tileSize,
+                      tileSize)
+                    .intersected(QRect(QPoint(0, 0),
+                                       levelSize));
+            QRectF dest(source.x() * unitX,
+                        source.y() * unitY,
+                        source.width() * unitX,
+                        source.height() * unitY);
+
+            QPixmap tile = m_pyramid->tile(level, x, y);
+            if (!tile.isNull())
+            {
+                painter->drawPixmap(dest, tile,
+                                    QRectF(tile.rect()));
+            }
+            else if (!overview.isNull())
+            {
+                // Coarse fill until the tile is loaded
+                painter->drawPixmap(
+                    dest, overview,
+                    QRectF(dest.x() * overviewX,
+                           dest.y() * overviewY,
+                           dest.width() * overviewX,
+                           dest.height() * overviewY));
+            }
+        }
+    }
+}
+
 void BackgroundPhotoItem::mousePressEvent(
     QGraphicsSceneMouseEvent *event)
 {
@@ -305,11 +446,22 @@ QMap<QString, QVariant> BackgroundPhotoItem::toDict() const
     data["z_value"]     = zValue();
     data["visible"]     = isVisible();
 
+    // Tiled images are reloaded from their file; only the
+    // overview is embedded as a fallback
+    QPixmap embedded = m_pixmap;
+    if (m_pyramid)
+    {
+        QSize size          = m_pyramid->imageSize();
+        data["image_path"]  = m_pyramid->sourcePath();
+        data["image_width"] = size.width();
+        embedded            = m_pyramid->overview();
+    }
+
     // Convert pixmap to base64 for serialization
     QByteArray byteArray;
     QBuffer    buffer(&byteArray);
     buffer.open(QIODevice::WriteOnly);
-    m_pixmap.save(&buffer, "PNG");
+    embedded.save(&buffer, "PNG");
     data["image_data"] = QString(byteArray.toBase64());
 
     return data;
@@ -319,18 +471,36 @@ BackgroundPhotoItem *BackgroundPhotoItem::fromDict(
     const QMap<QString, QVariant> &data,
     QGraphicsItem                 *parent)
 {
-    // Convert base64 back to pixmap
-    QPixmap    pixmap;
-    QByteArray imageData = QByteArray::fromBase64(
-        data["image_data"].toString().toLatin1());
-    pixmap.loadFromData(imageData);
-
     QMap<QString, QVariant> prop =
         data["properties"].toMap();
 
-    // Create new instance
-    BackgroundPhotoItem *instance = new BackgroundPhotoItem(
-        pixmap, prop["Region"].toString(), parent);
+    // Create new instance, tiled if the file still exists
+    BackgroundPhotoItem *instance = nullptr;
+    QString imagePath = data.value("image_path").toString();
+    if (!imagePath.isEmpty() && QFile::exists(imagePath))
+    {
+        instance = new BackgroundPhotoItem(
+            imagePath, prop["Region"].toString(), parent);
+    }
+    else
+    {
+        // Convert base64 back to pixmap
+        QPixmap    pixmap;
+        QByteArray imageData = QByteArray::fromBase64(
+            data["image_data"].toString().toLatin1());
+        pixmap.loadFromData(imageData);
+
+        // Keep the scene size of an embedded overview
+        int fullWidth = data.value("image_width").toInt();
+        if (fullWidth > 0 && !pixmap.isNull())
+        {
+            prop["Scale"] = prop["Scale"].toDouble()
+                            * fullWidth / pixmap.width();
+        }
+
+        instance = new BackgroundPhotoItem(
+            pixmap, prop["Region"].toString(), parent);
+    }
 
     // Set position
     QMap<QString, QVariant> posMap =
@@ -13,6 +13,8 @@ namespace CargoNetSim
 namespace GUI
 {
 
+class TiledImagePyramid;
+
 /**
  * @brief A custom QGraphicsObject for displaying background
  * photos in regions
@@ -21,6 +23,11 @@ namespace GUI
  * positioned and scaled on the scene. It maintains its own
  * properties and can be serialized/deserialized for project
  * saving.
+ *
+ * Images opened from a file are drawn from a
+ * TiledImagePyramid: only the tiles covering the exposed
+ * area are loaded, at the level matching the current zoom,
+ * and the pyramid overview fills in while they load.
  */
 class BackgroundPhotoItem : public GraphicsObjectBase
 {
@@ -39,11 +46,38 @@ public:
                         const QString &regionName,
                         QGraphicsItem *parent = nullptr);
 
+    /**
+     * @brief Constructor for a tiled BackgroundPhotoItem
+     * @param imagePath Path of the image file to display
+     * @param regionName The region this background belongs
+     * to
+     * @param parent Optional parent item
+     *
+     * Tiles are generated in the background; check
+     * isValid() to know whether the file could be read.
+     */
+    BackgroundPhotoItem(const QString &imagePath,
+                        const QString &regionName,
+                        QGraphicsItem *parent = nullptr);
+
     /**
      * @brief Destructor
      */
     virtual ~BackgroundPhotoItem() = default;
 
+    /**
+     * @brief Checks whether the item has an image to draw
+     */
+    bool isValid() const
+    {
+        return !imageSize().isEmpty();
+    }
+
+    /**
+     * @brief Get the size of the image in pixels
+     */
+    QSize imageSize() const;
+
     /**
      * @brief Set the position using WGS84 (geographic)
      * coordinates
@@ -67,7 +101,7 @@ public:
      * @brief Get the current region name
      * @return The region name as a QString
      */
-    QString getRegion() const
+    QString getRegion() const override
     {
         return m_properties["Region"].toString();
     }
@@ -192,7 +226,18 @@ private:
      */
     void updateCoordinates();
 
+    /**
+     * @brief Draw the pyramid tiles covering the exposed
+     * area
+     */
+    void paintTiles(QPainter                       *painter,
+                    const QStyleOptionGraphicsItem *option,
+                    const QRectF                   &target);
+
     QPixmap m_pixmap; ///< The image to display
+    TiledImagePyramid *m_pyramid =
+        nullptr;           ///< Tiles of a file image
+    int m_tileLevel = -1;  ///< Last drawn pyramid level
     QMap<QString, QVariant>
          m_properties; ///< Properties map
     QPointF m_dragOffset;     ///< Offset for dragging
@@ -3,8 +3,6 @@
 #include "../Items/TerminalItem.h"
 #include "ConnectionLabel.h"
 
-#include "AnimationObject.h"
-#include <QGraphicsPathItem>
 #include <QGraphicsScene>
 #include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSceneMouseEvent>
@@ -19,6 +17,14 @@ namespace CargoNetSim
 namespace GUI
 {
 
+namespace
+{
+
+// Endpoint moves within one frame share a geometry update
+constexpr int POSITION_UPDATE_MS = 16;
+
+} // namespace
+
 // Initialize static members
 int ConnectionLine::CONNECTION_LINE_ID = 0;
 
@@ -53,6 +59,10 @@ ConnectionLine::ConnectionLine(
     , m_properties(properties)
     , m_id(getNewConnectionID())
     , m_isHovered(false)
+    , m_geometryDirty(true)
+    , m_shapeValid(false)
+    , m_hasPendingStart(false)
+    , m_hasPendingEnd(false)
 {
     // Set higher z-value to ensure visibility
     setZValue(4);
@@ -86,6 +96,11 @@ ConnectionLine::ConnectionLine(
     // Connect signals
     createConnections();
 
+    m_positionTimer.setSingleShot(true);
+    m_positionTimer.setInterval(POSITION_UPDATE_MS);
+    connect(&m_positionTimer, &QTimer::timeout, this,
+            &ConnectionLine::applyPendingPositions);
+
     // Initialize position and geometry
     updatePosition();
 }
@@ -100,6 +115,7 @@ void ConnectionLine::setRegion(const QString &region)
     if (m_properties["Region"].toString() != region)
     {
         m_properties["Region"] = region;
+        updateRegistration();
         emit regionChanged(region);
     }
 }
@@ -120,6 +136,7 @@ void ConnectionLine::setConnectionType(const QString &type)
         m_label->setColor(color);
 
         // Update geometry and redraw
+        m_geometryDirty = true;
         updatePosition();
         update();
 
@@ -194,22 +211,48 @@ void ConnectionLine::initializeProperties(QString region)
 void ConnectionLine::onStartItemPositionChanged(
     const QPointF &newPos)
 {
-    updatePosition(newPos, true);
+    m_pendingStart    = newPos;
+    m_hasPendingStart = true;
+    if (!m_positionTimer.isActive())
+    {
+        m_positionTimer.start();
+    }
     emit startPositionChanged(newPos);
 }
 
 void ConnectionLine::onEndItemPositionChanged(
     const QPointF &newPos)
 {
-    updatePosition(newPos, false);
+    m_pendingEnd    = newPos;
+    m_hasPendingEnd = true;
+    if (!m_positionTimer.isActive())
+    {
+        m_positionTimer.start();
+    }
     emit endPositionChanged(newPos);
 }
 
+void ConnectionLine::applyPendingPositions()
+{
+    QPointF startCenter = m_hasPendingStart
+                              ? m_pendingStart
+                              : m_startItem->scenePos();
+    QPointF endCenter   = m_hasPendingEnd
+                              ? m_pendingEnd
+                              : m_endItem->scenePos();
+    m_hasPendingStart   = false;
+    m_hasPendingEnd     = false;
+
+    QLineF baseLine(startCenter, endCenter);
+    if (m_geometryDirty || baseLine != m_baseLine)
+    {
+        rebuildGeometry(baseLine);
+    }
+}
+
 void ConnectionLine::updatePosition(const QPointF &newPos,
                                     bool           isStart)
 {
-    prepareGeometryChange();
-
     // Calculate terminal centers
     QPointF startCenter;
     QPointF endCenter;
@@ -230,9 +273,26 @@ void ConnectionLine::updatePosition(const QPointF &newPos,
         endCenter = m_endItem->scenePos();
     }
 
-    // Create base line and apply offset
+    // An immediate update supersedes pending moves
+    m_positionTimer.stop();
+    m_hasPendingStart = false;
+    m_hasPendingEnd   = false;
+
     QLineF baseLine(startCenter, endCenter);
-    m_line = calculateOffsetLine(baseLine);
+    if (m_geometryDirty || baseLine != m_baseLine)
+    {
+        rebuildGeometry(baseLine);
+    }
+}
+
+void ConnectionLine::rebuildGeometry(const QLineF &baseLine)
+{
+    prepareGeometryChange();
+
+    // Apply the connection type offset
+    m_baseLine      = baseLine;
+    m_geometryDirty = false;
+    m_line          = calculateOffsetLine(baseLine);
 
     // Calculate midpoint and line properties
     qreal midX       = (m_line.x1() + m_line.x2()) / 2;
@@ -334,6 +394,21 @@ void ConnectionLine::updatePosition(const QPointF &newPos,
                    maxY - minY + 2 * padding);
     }
 
+    // Path used by paint() and the flash highlight
+    m_path = QPainterPath();
+    m_path.moveTo(m_line.p1());
+    if (m_connectionType == "Truck")
+    {
+        m_path.lineTo(m_line.p2());
+    }
+    else
+    {
+        m_path.quadTo(m_ctrlPoint, m_line.p2());
+    }
+
+    // The label moved with the line
+    m_shapeValid = false;
+
     update();
 }
 
@@ -380,15 +455,21 @@ QRectF ConnectionLine::boundingRect() const
 
 QPainterPath ConnectionLine::shape() const
 {
+    // Hover and selection query the shape constantly; it
+    // only changes with the geometry
+    if (m_shapeValid)
+    {
+        return m_shape;
+    }
+
     // For selection purposes, use a simplified selection
     // area that focuses more on the label and less on the
     // line itself
     QPainterPath path;
 
     // Add the label's shape (with some padding)
-    QRectF labelSceneRect = m_label->sceneBoundingRect();
     QRectF labelLocalRect =
-        mapFromScene(labelSceneRect).boundingRect();
+        m_label->mapRectToParent(m_label->boundingRect());
 
     // Add padding around the label for easier selection
     int padding = 10;
@@ -438,7 +519,9 @@ QPainterPath ConnectionLine::shape() const
         path.addEllipse(end, 5, 5);
     }
 
-    return path;
+    m_shape      = path;
+    m_shapeValid = true;
+    return m_shape;
 }
 
 void ConnectionLine::paint(
@@ -461,20 +544,8 @@ void ConnectionLine::paint(
 
     painter->setPen(pen);
 
-    // Draw the path
-    QPainterPath path;
-    path.moveTo(m_line.p1());
-
-    if (m_connectionType == "Truck")
-    {
-        path.lineTo(m_line.p2());
-    }
-    else
-    {
-        path.quadTo(m_ctrlPoint, m_line.p2());
-    }
-
-    painter->drawPath(path);
+    // Draw the cached path
+    painter->drawPath(m_path);
 
     // Draw debug bounding rect if needed
     if (false)
@@ -732,42 +803,18 @@ int ConnectionLine::getNewConnectionID()
     return CONNECTION_LINE_ID;
 }
 
-void ConnectionLine::clearAnimationVisuals()
+QPainterPath ConnectionLine::highlightPath() const
 {
-    GraphicsObjectBase::clearAnimationVisuals();
+    // Follows the drawn line
+    return m_path;
 }
 
-void ConnectionLine::createAnimationVisual(
-    const QColor &color)
+qreal ConnectionLine::highlightWidth() const
 {
-    // Create a path item as an overlay to follow the line
-    QPainterPath path;
-    qreal        penWidth =
-        CONNECTION_STYLES.value(m_connectionType)
-            .value("width")
-            .toInt()
-        * 3;
-
-    path.moveTo(m_line.p1());
-
-    if (m_connectionType == "Truck")
-    {
-        path.lineTo(m_line.p2());
-    }
-    else
-    {
-        path.quadTo(m_ctrlPoint, m_line.p2());
-    }
-
-    QGraphicsPathItem *overlay = new QGraphicsPathItem();
-    overlay->setPath(path);
-    overlay->setPen(QPen(color, penWidth, Qt::SolidLine));
-    overlay->setZValue(100);
-
-    // Add to scene properly
-    overlay->setParentItem(this);
-
-    m_animObject->setOverlay(overlay);
+    return CONNECTION_STYLES.value(m_connectionType)
+               .value("width")
+               .toInt()
+           * 3;
 }
 
 } // namespace GUI
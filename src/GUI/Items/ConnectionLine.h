@@ -4,8 +4,10 @@
 #include <QGraphicsItem>
 #include <QGraphicsObject>
 #include <QMap>
+#include <QPainterPath>
 #include <QPen>
 #include <QPropertyAnimation>
+#include <QTimer>
 #include <QVariant>
 
 namespace CargoNetSim
@@ -35,10 +37,8 @@ public:
 
     virtual ~ConnectionLine();
 
-    void
-    createAnimationVisual(const QColor &color) override;
-
-    void clearAnimationVisuals() override;
+    QPainterPath highlightPath() const override;
+    qreal        highlightWidth() const override;
 
     // Access to members
     QGraphicsItem *startItem() const
@@ -74,7 +74,7 @@ public:
      * @brief Get the current region name
      * @return The region name as a QString
      */
-    QString getRegion() const
+    QString getRegion() const override
     {
         return m_properties["Region"].toString();
     }
@@ -83,6 +83,17 @@ public:
                      const QVariant &value);
 
     // Update methods
+
+    /**
+     * @brief Recomputes the geometry right away
+     *
+     * Does nothing if neither endpoint moved since the last
+     * update.
+     *
+     * @param newPos New position of the moved endpoint, or
+     * a null point to read both endpoints from the items
+     * @param isStart True if newPos is the start endpoint
+     */
     void updatePosition(const QPointF &newPos  = QPointF(),
                         bool           isStart = false);
 
@@ -135,6 +146,8 @@ private:
     calculateOffsetLine(const QLineF &originalLine) const;
     void onStartItemPositionChanged(const QPointF &newPos);
     void onEndItemPositionChanged(const QPointF &newPos);
+    void applyPendingPositions();
+    void rebuildGeometry(const QLineF &baseLine);
     void createConnections();
     void initializeProperties(QString region);
 
@@ -150,6 +163,20 @@ private:
     QLineF  m_line;
     QPointF m_ctrlPoint; // Control point for curved lines
     QRectF  m_boundingRect;
+    QLineF  m_baseLine; // Endpoints before the offset
+    bool    m_geometryDirty;
+
+    // Cached paths, rebuilt only when the geometry changes
+    QPainterPath         m_path;
+    mutable QPainterPath m_shape;
+    mutable bool         m_shapeValid;
+
+    // Endpoint moves are applied once per frame
+    QTimer  m_positionTimer;
+    QPointF m_pendingStart;
+    QPointF m_pendingEnd;
+    bool    m_hasPendingStart;
+    bool    m_hasPendingEnd;
 
     // Visual
     ConnectionLabel *m_label;
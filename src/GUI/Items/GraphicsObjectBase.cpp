@@ -1,5 +1,7 @@
 #include "GraphicsObjectBase.h"
 #include "AnimationObject.h"
+#include "GUI/Items/PathHighlightItem.h"
+#include "GUI/Widgets/GraphicsScene.h"
 #include <QBrush>
 #include <QGraphicsRectItem>
 #include <QPen>
@@ -35,10 +37,55 @@ QString GraphicsObjectBase::getID() const
     return m_id;
 }
 
+QString GraphicsObjectBase::getRegion() const
+{
+    return QString();
+}
+
+QObject *GraphicsObjectBase::getReferenceNetwork() const
+{
+    return nullptr;
+}
+
+void GraphicsObjectBase::updateRegistration()
+{
+    if (auto graphicsScene =
+            qobject_cast<GraphicsScene *>(scene()))
+    {
+        graphicsScene->updateItemRegistration(this);
+    }
+}
+
+QPainterPath GraphicsObjectBase::highlightPath() const
+{
+    return QPainterPath();
+}
+
+qreal GraphicsObjectBase::highlightWidth() const
+{
+    return 1.0;
+}
+
 void GraphicsObjectBase::flash(bool          evenIfHidden,
                                const QColor &color)
 {
     bool wasHidden = !isVisible();
+
+    QPainterPath path = highlightPath();
+    auto         graphicsScene =
+        qobject_cast<GraphicsScene *>(scene());
+    if (!path.isEmpty() && graphicsScene)
+    {
+        // The layer draws hidden items' paths as well
+        if (wasHidden && !evenIfHidden)
+        {
+            return;
+        }
+        graphicsScene->getPathHighlight()->highlight(
+            mapToScene(path),
+            QPen(color, highlightWidth(), Qt::SolidLine));
+        return;
+    }
     if (evenIfHidden && wasHidden)
     {
         setVisible(true);
@@ -4,6 +4,7 @@
 #include <QColor>
 #include <QGraphicsObject>
 #include <QGraphicsRectItem>
+#include <QPainterPath>
 #include <QPropertyAnimation>
 
 namespace CargoNetSim::GUI
@@ -20,15 +21,44 @@ public:
 
     QString getID() const;
 
+    /**
+     * @brief Gets the region the item belongs to
+     * @return An empty string for items without a region
+     */
+    virtual QString getRegion() const;
+
+    /**
+     * @brief Gets the network the item was drawn from
+     * @return nullptr for items that draw no network
+     */
+    virtual QObject *getReferenceNetwork() const;
+
     /** Pulsing highlight effect */
     void flash(bool          evenIfHidden = false,
                const QColor &color = QColor(255, 0, 0,
                                             180));
 
+    /**
+     * @brief Path traced by flash(), in item coordinates
+     *
+     * Items with a path pulse on the scene's shared
+     * highlight layer; the default empty path flashes an
+     * overlay rect on the item itself.
+     */
+    virtual QPainterPath highlightPath() const;
+
+    /** Stroke width of highlightPath() in scene units */
+    virtual qreal highlightWidth() const;
+
 signals:
     void idChanged(const QString &newId);
 
 protected:
+    /**
+     * Re-files the item in the scene registry after its
+     * region or reference network changed
+     */
+    void updateRegistration();
     /** Clear any overlay visuals */
     virtual void clearAnimationVisuals();
     /** Create the overlay */
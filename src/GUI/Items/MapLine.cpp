@@ -1,9 +1,9 @@
 #include "MapLine.h"
-#include "GUI/Items/AnimationObject.h"
 
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
+#include <QLineF>
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
 
@@ -85,14 +85,24 @@ void MapLine::paint(QPainter                       *painter,
                     QWidget                        *widget)
 {
     // Get the current view scale
-    QGraphicsScene *itemScene = scene();
-    if (!itemScene || itemScene->views().isEmpty())
+    const qreal viewScale =
+        option->levelOfDetailFromTransform(
+            painter->worldTransform());
+    if (viewScale <= 0)
     {
         return;
     }
 
-    QGraphicsView *view      = itemScene->views().first();
-    qreal          viewScale = view->transform().m11();
+    // Links shorter than a pixel are invisible when zoomed
+    // out, unless they are selected
+    const bool selected =
+        option->state & QStyle::State_Selected;
+    if (!selected
+        && QLineF(startPoint, endPoint).length() * viewScale
+               < MIN_VISIBLE_PIXELS)
+    {
+        return;
+    }
 
     // Scale the pen width inversely to maintain constant
     // visual thickness
@@ -101,7 +111,7 @@ void MapLine::paint(QPainter                       *painter,
         qMax(1, qRound(baseWidth / viewScale)));
 
     // Change pen style if selected
-    if (option->state & QStyle::State_Selected)
+    if (selected)
     {
         scaledPen.setColor(Qt::blue);
         scaledPen.setStyle(Qt::DashLine);
@@ -204,34 +214,23 @@ MapLine::fromDict(const QMap<QString, QVariant> &data)
     return instance;
 }
 
-void MapLine::clearAnimationVisuals()
-{
-    GraphicsObjectBase::clearAnimationVisuals();
-}
-
-void MapLine::createAnimationVisual(const QColor &color)
+QPainterPath MapLine::highlightPath() const
 {
-    // Create a path item as an overlay
     QPainterPath path;
     path.moveTo(startPoint);
     path.lineTo(endPoint);
+    return path;
+}
 
+qreal MapLine::highlightWidth() const
+{
+    // At least 6 px wide on screen
     QGraphicsView *view =
         scene() && !scene()->views().isEmpty()
             ? scene()->views().first()
             : nullptr;
     qreal viewScale = view ? view->transform().m11() : 1.0;
-    qreal penWidth  = qMax(5.0, 6.0 / viewScale);
-
-    QGraphicsPathItem *overlay =
-        new QGraphicsPathItem(path);
-    overlay->setPen(QPen(color, penWidth, Qt::SolidLine));
-    overlay->setZValue(100);
-
-    // Important: Don't set the parent in the constructor
-    overlay->setParentItem(this);
-
-    m_animObject->setOverlay(overlay);
+    return qMax(5.0, 6.0 / viewScale);
 }
 
 } // namespace GUI
@@ -45,10 +45,8 @@ public:
 
     virtual ~MapLine() = default;
 
-    void
-    createAnimationVisual(const QColor &color) override;
-
-    void clearAnimationVisuals() override;
+    QPainterPath highlightPath() const override;
+    qreal        highlightWidth() const override;
 
     /**
      * @brief Sets the reference network that this point is
@@ -58,6 +56,7 @@ public:
     void setReferenceNetwork(QObject *network)
     {
         m_referenceNetwork = network;
+        updateRegistration();
     }
 
     /**
@@ -65,7 +64,7 @@ public:
      * created from
      * @return QObject* The network pointer
      */
-    QObject *getReferenceNetwork()
+    QObject *getReferenceNetwork() const override
     {
         return m_referenceNetwork;
     }
@@ -89,7 +88,8 @@ public:
      */
     void setRegion(const QString region)
     {
-        m_properties.value("region") = region;
+        m_properties["region"] = region;
+        updateRegistration();
     }
 
     void setPoints(const QPointF &newStartPoint,
@@ -114,7 +114,7 @@ public:
     /**
      * @brief Get the region
      */
-    const QString getRegion() const
+    QString getRegion() const override
     {
         return m_properties.value("region").toString();
     }
@@ -145,6 +145,10 @@ public:
             || m_properties[key] != value)
         {
             m_properties[key] = value;
+            if (key == "Network_ID")
+            {
+                updateRegistration();
+            }
             emit propertyChanged(key, value);
         }
     }
@@ -198,6 +202,12 @@ protected:
           QGraphicsSceneMouseEvent *event) override;
 
 private:
+    /**
+     * @brief Screen length below which the line is not
+     * drawn
+     */
+    static constexpr qreal MIN_VISIBLE_PIXELS = 1.0;
+
     void selectNetworkLines();
 
     QPointF                 startPoint;
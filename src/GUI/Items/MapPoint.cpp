@@ -7,6 +7,7 @@
 #include <QAction>
 #include <QApplication>
 #include <QCursor>
+#include <QFont>
 #include <QGraphicsScene>
 #include <QGraphicsSceneContextMenuEvent>
 #include <QGraphicsSceneMouseEvent>
@@ -33,6 +34,8 @@ MapPoint::MapPoint(
     , m_terminal(terminal)
     , m_color(Qt::black)
     , m_properties(properties)
+    , m_referenceNetwork(nullptr)
+    , m_clusterSize(1)
 {
     // Override properties if they were given differently
     // or initialize them if they are missing
@@ -104,8 +107,23 @@ void MapPoint::setSceneCoordinate(const QPointF &newPos)
     emit positionChanged(newPos);
 }
 
+void MapPoint::setClusterSize(int size)
+{
+    if (m_clusterSize != size)
+    {
+        prepareGeometryChange();
+        m_clusterSize = size;
+        update();
+    }
+}
+
 QRectF MapPoint::boundingRect() const
 {
+    if (m_clusterSize == 0)
+    {
+        return QRectF();
+    }
+
     if (m_terminal)
     {
         const QPixmap &pixmap = m_terminal->getPixmap();
@@ -119,6 +137,12 @@ QRectF MapPoint::boundingRect() const
         }
     }
 
+    // Cluster markers are larger than single points
+    if (m_clusterSize > 1)
+    {
+        return QRectF(-11, -11, 22, 22);
+    }
+
     // Default size for shapes
     return QRectF(-7, -7, 14, 14);
 }
@@ -127,6 +151,12 @@ void MapPoint::paint(QPainter *painter,
                      const QStyleOptionGraphicsItem *option,
                      QWidget                        *widget)
 {
+    // Drawn by the cluster marker of another point
+    if (m_clusterSize == 0)
+    {
+        return;
+    }
+
     if (m_terminal)
     {
         // If linked to a m_terminal, draw m_terminal icon at
@@ -144,6 +174,24 @@ void MapPoint::paint(QPainter *painter,
             painter->setOpacity(1.0);
         }
     }
+    else if (m_clusterSize > 1)
+    {
+        // Draw a cluster marker with the point count
+        painter->setPen(QPen(Qt::white, 2));
+        painter->setBrush(QBrush(m_color));
+        painter->drawEllipse(-10.0, -10.0, 20.0, 20.0);
+
+        QFont font = painter->font();
+        font.setPixelSize(m_clusterSize < 100 ? 9 : 7);
+        font.setBold(true);
+        painter->setFont(font);
+        painter->drawText(
+            QRectF(-10.0, -10.0, 20.0, 20.0),
+            Qt::AlignCenter,
+            m_clusterSize < 1000
+                ? QString::number(m_clusterSize)
+                : QString("999+"));
+    }
     else
     {
         // Draw a shape if no terminal
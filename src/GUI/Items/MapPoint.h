@@ -69,6 +69,7 @@ public:
     void setReferenceNetwork(QObject *network)
     {
         m_referenceNetwork = network;
+        updateRegistration();
     }
 
     /**
@@ -76,7 +77,7 @@ public:
      * created from
      * @return QObject* The network pointer
      */
-    QObject *getReferenceNetwork()
+    QObject *getReferenceNetwork() const override
     {
         return m_referenceNetwork;
     }
@@ -94,6 +95,24 @@ public:
     void setRegion(const QString &region)
     {
         this->m_properties["region"] = region;
+        updateRegistration();
+    }
+
+    /**
+     * @brief Sets how many points this point stands for
+     *
+     * @param size 0 hides the point inside another
+     * point's cluster, 1 draws the point itself and larger
+     * values draw a cluster marker with the count
+     */
+    void setClusterSize(int size);
+
+    /**
+     * @brief Gets the cluster size set by the view
+     */
+    int getClusterSize() const
+    {
+        return m_clusterSize;
     }
 
     /**
@@ -139,7 +158,7 @@ public:
     /**
      * @brief Get the network m_region
      */
-    QString getRegion() const
+    QString getRegion() const override
     {
         return m_properties
             .value("region", "Default Region")
@@ -257,6 +276,7 @@ private:
     QColor                  m_color;
     QMap<QString, QVariant> m_properties;
     QObject                *m_referenceNetwork;
+    int                     m_clusterSize;
 };
 
 } // namespace GUI
@@ -0,0 +1,843 @@
+#include "NetworkLayerItem.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsSceneMouseEvent>
+#include <QGraphicsView>
+#include <QLineF>
+#include <QPair>
+#include <QPoint>
+#include <QPainter>
+#include <QSet>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+namespace
+{
+
+// Keeps the grid small for sparse, wide networks
+constexpr int MAX_GRID_CELLS_PER_SIDE = 1024;
+
+// Tile cache budget in KiB
+constexpr int TILE_CACHE_KIB = 64 * 1024;
+
+qreal distanceToSegment(const QPointF &point,
+                        const QPointF &start,
+                        const QPointF &end)
+{
+    const QPointF segment = end - start;
+    const qreal   lengthSquared =
+        QPointF::dotProduct(segment, segment);
+    if (lengthSquared <= 0.0)
+    {
+        return QLineF(point, start).length();
+    }
+
+    const qreal t = qBound(
+        0.0,
+        QPointF::dotProduct(point - start, segment)
+            / lengthSquared,
+        1.0);
+    return QLineF(point, start + t * segment).length();
+}
+
+} // namespace
+
+NetworkLayerItem::NetworkLayerItem(
+    const QString &networkName, const QString &region,
+    QGraphicsItem *parent)
+    : GraphicsObjectBase(parent)
+    , m_networkName(networkName)
+    , m_region(region)
+    , m_referenceNetwork(nullptr)
+    , m_linkColor(Qt::black)
+    , m_nodeColor(Qt::black)
+{
+    // Below individually drawn lines and points
+    setZValue(2);
+
+    m_tileCache.setMaxCost(TILE_CACHE_KIB);
+}
+
+void NetworkLayerItem::reserve(int nodeCount,
+                               int linkCount)
+{
+    m_nodePoints.reserve(nodeCount);
+    m_nodeNetworkIDs.reserve(nodeCount);
+    m_nodeUniqueIDs.reserve(nodeCount);
+    m_materializedNodes.reserve(nodeCount);
+    m_nodeIndex.reserve(nodeCount);
+    m_nodeNetworkIndex.reserve(nodeCount);
+
+    m_linkNodes.reserve(linkCount * 2);
+    m_linkNetworkIDs.reserve(linkCount);
+    m_linkUniqueIDs.reserve(linkCount);
+    m_linkNetworkIndex.reserve(linkCount);
+}
+
+int NetworkLayerItem::addNode(const QString &networkID,
+                              const QString &uniqueID,
+                              const QPointF &scenePoint)
+{
+    const int index = m_nodePoints.size();
+    m_nodePoints.append(scenePoint);
+    m_nodeNetworkIDs.append(networkID);
+    m_nodeUniqueIDs.append(uniqueID);
+    m_materializedNodes.append(false);
+    m_nodeIndex.insert(uniqueID, index);
+    m_nodeNetworkIndex.insert(networkID, index);
+    return index;
+}
+
+int NetworkLayerItem::addLink(const QString &networkID,
+                              const QString &uniqueID,
+                              int fromNode, int toNode)
+{
+    const int index = linkCount();
+    const bool valid =
+        fromNode >= 0 && fromNode < m_nodePoints.size()
+        && toNode >= 0 && toNode < m_nodePoints.size();
+    m_linkNodes.append(valid ? fromNode : -1);
+    m_linkNodes.append(valid ? toNode : -1);
+    m_linkNetworkIDs.append(networkID);
+    m_linkUniqueIDs.append(uniqueID);
+    m_linkNetworkIndex.insert(networkID, index);
+    return index;
+}
+
+bool NetworkLayerItem::linkNodes(int index, int &fromNode,
+                                 int &toNode) const
+{
+    if (index < 0 || index >= linkCount())
+    {
+        return false;
+    }
+    fromNode = m_linkNodes[index * 2];
+    toNode   = m_linkNodes[index * 2 + 1];
+    return fromNode >= 0 && toNode >= 0;
+}
+
+void NetworkLayerItem::finalize()
+{
+    prepareGeometryChange();
+    m_tileCache.clear();
+#ifdef CARGONET_HAS_OPENGL
+    m_glBatch.invalidate();
+#endif
+
+    m_bounds  = QRectF();
+    m_columns = 0;
+    m_rows    = 0;
+    m_nodeCellStart.clear();
+    m_nodeCellItems.clear();
+    m_linkCellStart.clear();
+    m_linkCellItems.clear();
+    m_linkStamps.fill(0, linkCount());
+    m_stamp = 0;
+
+    if (m_nodePoints.isEmpty())
+    {
+        update();
+        return;
+    }
+
+    qreal minX = m_nodePoints.first().x();
+    qreal maxX = minX;
+    qreal minY = m_nodePoints.first().y();
+    qreal maxY = minY;
+    for (const QPointF &point : m_nodePoints)
+    {
+        minX = qMin(minX, point.x());
+        maxX = qMax(maxX, point.x());
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+    m_bounds =
+        QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+
+    // Nodes appear once an average link is this long
+    qreal totalLength = 0.0;
+    int   validLinks  = 0;
+    for (int i = 0; i < linkCount(); ++i)
+    {
+        int from, to;
+        if (linkNodes(i, from, to))
+        {
+            totalLength +=
+                QLineF(m_nodePoints[from], m_nodePoints[to])
+                    .length();
+            ++validLinks;
+        }
+    }
+    const qreal extent =
+        qMax(m_bounds.width(), m_bounds.height());
+    qreal averageLength =
+        validLinks > 0 ? totalLength / validLinks : extent;
+    if (averageLength <= 0.0)
+    {
+        averageLength = 1.0;
+    }
+    m_nodeScale = NODE_LINK_PIXELS / averageLength;
+    m_margin    = (NODE_RADIUS + 1) / m_nodeScale;
+
+    // About four nodes per grid cell
+    const qreal area =
+        m_bounds.width() * m_bounds.height();
+    const int targetCells =
+        qMax(1, m_nodePoints.size() / 4);
+    m_cellSize = area > 0.0
+                     ? qSqrt(area / targetCells)
+                     : extent / targetCells;
+    m_cellSize = qMax(
+        m_cellSize, extent / (MAX_GRID_CELLS_PER_SIDE - 1));
+    if (m_cellSize <= 0.0)
+    {
+        m_cellSize = 1.0;
+    }
+    m_columns = int(m_bounds.width() / m_cellSize) + 1;
+    m_rows    = int(m_bounds.height() / m_cellSize) + 1;
+
+    const int cellCount = m_columns * m_rows;
+    auto      cellOf    = [this](const QPointF &point) {
+        int x = qBound(
+            0,
+            int((point.x() - m_bounds.left()) / m_cellSize),
+            m_columns - 1);
+        int y = qBound(
+            0,
+            int((point.y() - m_bounds.top()) / m_cellSize),
+            m_rows - 1);
+        return y * m_columns + x;
+    };
+
+    // Nodes, bucketed by cell
+    m_nodeCellStart.fill(0, cellCount + 1);
+    for (const QPointF &point : m_nodePoints)
+    {
+        ++m_nodeCellStart[cellOf(point) + 1];
+    }
+    for (int cell = 0; cell < cellCount; ++cell)
+    {
+        m_nodeCellStart[cell + 1] += m_nodeCellStart[cell];
+    }
+    m_nodeCellItems.resize(m_nodePoints.size());
+    QVector<int> cursor = m_nodeCellStart;
+    for (int i = 0; i < m_nodePoints.size(); ++i)
+    {
+        m_nodeCellItems[cursor[cellOf(m_nodePoints[i])]++] =
+            i;
+    }
+
+    // Links, in every cell their segment crosses
+    QVector<QVector<int>> linkCells(linkCount());
+    m_linkCellStart.fill(0, cellCount + 1);
+    for (int i = 0; i < linkCount(); ++i)
+    {
+        int from, to;
+        if (!linkNodes(i, from, to))
+        {
+            continue;
+        }
+        linkCells[i] = segmentCells(m_nodePoints[from],
+                                    m_nodePoints[to]);
+        for (int cell : linkCells[i])
+        {
+            ++m_linkCellStart[cell + 1];
+        }
+    }
+    for (int cell = 0; cell < cellCount; ++cell)
+    {
+        m_linkCellStart[cell + 1] += m_linkCellStart[cell];
+    }
+    m_linkCellItems.resize(m_linkCellStart[cellCount]);
+    cursor = m_linkCellStart;
+    for (int i = 0; i < linkCells.size(); ++i)
+    {
+        for (int cell : linkCells[i])
+        {
+            m_linkCellItems[cursor[cell]++] = i;
+        }
+    }
+
+    update();
+}
+
+void NetworkLayerItem::translateGeometry(
+    const QPointF &offset)
+{
+    for (QPointF &point : m_nodePoints)
+    {
+        point += offset;
+    }
+    finalize();
+}
+
+int NetworkLayerItem::nodeAt(const QPointF &scenePoint,
+                             qreal tolerance) const
+{
+    const QRectF area(scenePoint.x() - tolerance,
+                      scenePoint.y() - tolerance,
+                      tolerance * 2, tolerance * 2);
+
+    int   closest     = -1;
+    qreal minDistance = tolerance;
+    for (int index : queryCells(area, false))
+    {
+        const qreal distance =
+            QLineF(scenePoint, m_nodePoints[index])
+                .length();
+        if (distance <= minDistance)
+        {
+            minDistance = distance;
+            closest     = index;
+        }
+    }
+    return closest;
+}
+
+int NetworkLayerItem::linkAt(const QPointF &scenePoint,
+                             qreal tolerance) const
+{
+    const QRectF area(scenePoint.x() - tolerance,
+                      scenePoint.y() - tolerance,
+                      tolerance * 2, tolerance * 2);
+
+    int   closest     = -1;
+    qreal minDistance = tolerance;
+    for (int index : queryCells(area, true))
+    {
+        const qreal distance = distanceToSegment(
+            scenePoint,
+            m_nodePoints[m_linkNodes[index * 2]],
+            m_nodePoints[m_linkNodes[index * 2 + 1]]);
+        if (distance <= minDistance)
+        {
+            minDistance = distance;
+            closest     = index;
+        }
+    }
+    return closest;
+}
+
+int NetworkLayerItem::nearestNode(
+    const QPointF &scenePoint, bool skipMaterialized) const
+{
+    if (m_columns == 0)
+    {
+        return -1;
+    }
+
+    const int centerX = qBound(
+        0,
+        int(qFloor((scenePoint.x() - m_bounds.left())
+                   / m_cellSize)),
+        m_columns - 1);
+    const int centerY = qBound(
+        0,
+        int(qFloor((scenePoint.y() - m_bounds.top())
+                   / m_cellSize)),
+        m_rows - 1);
+
+    int   closest = -1;
+    qreal minDistance =
+        std::numeric_limits<qreal>::max();
+
+    auto visitCell = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= m_columns
+            || y >= m_rows)
+        {
+            return;
+        }
+        const int cell = y * m_columns + x;
+        for (int i = m_nodeCellStart[cell];
+             i < m_nodeCellStart[cell + 1]; ++i)
+        {
+            const int index = m_nodeCellItems[i];
+            if (skipMaterialized
+                && m_materializedNodes[index])
+            {
+                continue;
+            }
+            const qreal distance =
+                QLineF(scenePoint, m_nodePoints[index])
+                    .length();
+            if (distance < minDistance)
+            {
+                minDistance = distance;
+                closest     = index;
+            }
+        }
+    };
+
+    // Visit rings of cells around the query cell; cells
+    // beyond ring r are at least r cells away
+    const int maxRing = qMax(m_columns, m_rows);
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        if (ring == 0)
+        {
+            visitCell(centerX, centerY);
+        }
+        else
+        {
+            for (int x = centerX - ring;
+                 x <= centerX + ring; ++x)
+            {
+                visitCell(x, centerY - ring);
+                visitCell(x, centerY + ring);
+            }
+            for (int y = centerY - ring + 1;
+                 y < centerY + ring; ++y)
+            {
+                visitCell(centerX - ring, y);
+                visitCell(centerX + ring, y);
+            }
+        }
+
+        if (closest >= 0
+            && minDistance <= ring * m_cellSize)
+        {
+            break;
+        }
+    }
+    return closest;
+}
+
+void NetworkLayerItem::setNodeMaterialized(
+    int index, bool materialized)
+{
+    if (index < 0 || index >= m_materializedNodes.size()
+        || m_materializedNodes[index] == materialized)
+    {
+        return;
+    }
+    m_materializedNodes[index] = materialized;
+    m_tileCache.clear();
+#ifdef CARGONET_HAS_OPENGL
+    m_glBatch.invalidate();
+#endif
+    update();
+}
+
+void NetworkLayerItem::setColors(const QColor &linkColor,
+                                 const QColor &nodeColor)
+{
+    if (m_linkColor == linkColor
+        && m_nodeColor == nodeColor)
+    {
+        return;
+    }
+    m_linkColor = linkColor;
+    m_nodeColor = nodeColor;
+    m_tileCache.clear();
+    update();
+}
+
+QRectF NetworkLayerItem::boundingRect() const
+{
+    if (m_columns == 0)
+    {
+        return QRectF();
+    }
+    return m_bounds.adjusted(-m_margin, -m_margin,
+                             m_margin, m_margin);
+}
+
+void NetworkLayerItem::paint(
+    QPainter                       *painter,
+    const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    if (m_columns == 0)
+    {
+        return;
+    }
+
+    const qreal lod = option->levelOfDetailFromTransform(
+        painter->worldTransform());
+    if (lod <= 0.0)
+    {
+        return;
+    }
+
+#ifdef CARGONET_HAS_OPENGL
+    NetworkLayerGLBatch::Frame frame;
+    frame.nodePoints   = &m_nodePoints;
+    frame.linkNodes    = &m_linkNodes;
+    frame.materialized = &m_materializedNodes;
+    frame.origin       = m_bounds.topLeft();
+    frame.linkColor    = m_linkColor;
+    frame.nodeColor    = m_nodeColor;
+    frame.drawNodes    = lod >= m_nodeScale;
+    frame.nodeRadius   = NODE_RADIUS;
+    if (m_glBatch.draw(painter, frame))
+    {
+        return;
+    }
+#endif
+
+    // Tiles are rendered at the next power of two scale
+    // and drawn scaled down by less than half
+    const int   level = qCeil(std::log2(lod));
+    const qreal scale = std::ldexp(1.0, level);
+    const qreal span  = TILE_SIZE / scale;
+
+    const QRectF bounds = boundingRect();
+    const QRectF exposed =
+        option->exposedRect.intersected(bounds);
+    if (exposed.isEmpty())
+    {
+        return;
+    }
+
+    const int firstX = qFloor(
+        (exposed.left() - bounds.left()) / span);
+    const int lastX = qFloor(
+        (exposed.right() - bounds.left()) / span);
+    const int firstY =
+        qFloor((exposed.top() - bounds.top()) / span);
+    const int lastY = qFloor(
+        (exposed.bottom() - bounds.top()) / span);
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int y = firstY; y <= lastY; ++y)
+    {
+        for (int x = firstX; x <= lastX; ++x)
+        {
+            const TileKey key{level, x, y};
+            const QRectF  tileRect(bounds.left() + x * span,
+                                   bounds.top() + y * span,
+                                   span, span);
+
+            QPixmap  tile;
+            QPixmap *cached = m_tileCache.object(key);
+            if (cached)
+            {
+                tile = *cached;
+            }
+            else
+            {
+                tile = renderTile(tileRect, scale);
+                const int cost =
+                    tile.isNull()
+                        ? 1
+                        : TILE_SIZE * TILE_SIZE * 4 / 1024;
+                m_tileCache.insert(key, new QPixmap(tile),
+                                   cost);
+            }
+
+            if (!tile.isNull())
+            {
+                painter->drawPixmap(tileRect, tile,
+                                    QRectF(tile.rect()));
+            }
+        }
+    }
+}
+
+QPixmap NetworkLayerItem::renderTile(const QRectF &tileRect,
+                                     qreal scale) const
+{
+    const bool  drawNodes = scale >= m_nodeScale;
+    const qreal padding =
+        (drawNodes ? NODE_RADIUS + 1 : 1) / scale;
+    const QRectF area = tileRect.adjusted(
+        -padding, -padding, padding, padding);
+
+    // Zoomed out, endpoints snap to pixels so that short
+    // links collapse and duplicates are dropped
+    auto pixel = [scale](const QPointF &point) {
+        return QPoint(qFloor(point.x() * scale),
+                      qFloor(point.y() * scale));
+    };
+
+    QVector<QLineF>               lines;
+    QSet<QPair<quint64, quint64>> seenLines;
+    for (int index : queryCells(area, true))
+    {
+        const QPointF &start =
+            m_nodePoints[m_linkNodes[index * 2]];
+        const QPointF &end =
+            m_nodePoints[m_linkNodes[index * 2 + 1]];
+
+        if (drawNodes)
+        {
+            lines.append(QLineF(start, end));
+            continue;
+        }
+
+        QPoint from = pixel(start);
+        QPoint to   = pixel(end);
+        if (from == to)
+        {
+            continue;
+        }
+        if (to.x() < from.x()
+            || (to.x() == from.x() && to.y() < from.y()))
+        {
+            std::swap(from, to);
+        }
+        const auto key = qMakePair(
+            (quint64(quint32(from.x())) << 32)
+                | quint32(from.y()),
+            (quint64(quint32(to.x())) << 32)
+                | quint32(to.y()));
+        if (seenLines.contains(key))
+        {
+            continue;
+        }
+        seenLines.insert(key);
+        lines.append(
+            QLineF((from.x() + 0.5) / scale,
+                   (from.y() + 0.5) / scale,
+                   (to.x() + 0.5) / scale,
+                   (to.y() + 0.5) / scale));
+    }
+
+    QVector<QPointF> nodes;
+    if (drawNodes)
+    {
+        for (int index : queryCells(area, false))
+        {
+            if (!m_materializedNodes[index]
+                && area.contains(m_nodePoints[index]))
+            {
+                nodes.append(m_nodePoints[index]);
+            }
+        }
+    }
+
+    if (lines.isEmpty() && nodes.isEmpty())
+    {
+        return QPixmap();
+    }
+
+    QPixmap tile(TILE_SIZE, TILE_SIZE);
+    tile.fill(Qt::transparent);
+
+    QPainter painter(&tile);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.scale(scale, scale);
+    painter.translate(-tileRect.topLeft());
+
+    QPen pen(m_linkColor, 1);
+    pen.setCosmetic(true);
+    painter.setPen(pen);
+    painter.drawLines(lines);
+
+    const qreal radius = NODE_RADIUS / scale;
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(m_nodeColor);
+    for (const QPointF &node : nodes)
+    {
+        painter.drawEllipse(node, radius, radius);
+    }
+
+    return tile;
+}
+
+void NetworkLayerItem::mousePressEvent(
+    QGraphicsSceneMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+    {
+        event->ignore();
+        return;
+    }
+
+    const qreal scale     = viewScale();
+    const qreal tolerance = HIT_PIXELS / scale;
+
+    // Nodes are only clickable once they are drawn
+    if (scale >= m_nodeScale)
+    {
+        const int node = nodeAt(event->pos(), tolerance);
+        if (node >= 0)
+        {
+            emit nodeClicked(this, node);
+            event->accept();
+            return;
+        }
+    }
+
+    const int link = linkAt(event->pos(), tolerance);
+    if (link >= 0)
+    {
+        emit linkClicked(this, link);
+        event->accept();
+        return;
+    }
+
+    // Let items underneath handle the click
+    event->ignore();
+}
+
+QVector<int> NetworkLayerItem::queryCells(
+    const QRectF &sceneRect, bool links) const
+{
+    QVector<int> result;
+    int          minX, minY, maxX, maxY;
+    if (!cellRange(sceneRect, minX, minY, maxX, maxY))
+    {
+        return result;
+    }
+
+    const QVector<int> &starts =
+        links ? m_linkCellStart : m_nodeCellStart;
+    const QVector<int> &items =
+        links ? m_linkCellItems : m_nodeCellItems;
+
+    if (links && ++m_stamp == 0)
+    {
+        // Stamp counter wrapped around
+        m_linkStamps.fill(0);
+        m_stamp = 1;
+    }
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            const int cell = y * m_columns + x;
+            for (int i = starts[cell]; i < starts[cell + 1];
+                 ++i)
+            {
+                const int index = items[i];
+                if (links)
+                {
+                    // Links span several cells
+                    if (m_linkStamps[index] == m_stamp)
+                    {
+                        continue;
+                    }
+                    m_linkStamps[index] = m_stamp;
+                }
+                result.append(index);
+            }
+        }
+    }
+    return result;
+}
+
+bool NetworkLayerItem::cellRange(const QRectF &sceneRect,
+                                 int &minX, int &minY,
+                                 int &maxX, int &maxY) const
+{
+    if (m_columns == 0)
+    {
+        return false;
+    }
+
+    const QRectF grid(m_bounds.topLeft(),
+                      QSizeF(m_columns * m_cellSize,
+                             m_rows * m_cellSize));
+    const QRectF area = sceneRect.normalized();
+    if (area.right() < grid.left()
+        || area.left() > grid.right()
+        || area.bottom() < grid.top()
+        || area.top() > grid.bottom())
+    {
+        return false;
+    }
+
+    minX = qBound(0,
+                  int(qFloor((area.left() - grid.left())
+                             / m_cellSize)),
+                  m_columns - 1);
+    maxX = qBound(0,
+                  int(qFloor((area.right() - grid.left())
+                             / m_cellSize)),
+                  m_columns - 1);
+    minY = qBound(
+        0,
+        int(qFloor((area.top() - grid.top()) / m_cellSize)),
+        m_rows - 1);
+    maxY = qBound(0,
+                  int(qFloor((area.bottom() - grid.top())
+                             / m_cellSize)),
+                  m_rows - 1);
+    return true;
+}
+
+QVector<int>
+NetworkLayerItem::segmentCells(const QPointF &start,
+                               const QPointF &end) const
+{
+    // Grid traversal (Amanatides and Woo)
+    const qreal startX =
+        (start.x() - m_bounds.left()) / m_cellSize;
+    const qreal startY =
+        (start.y() - m_bounds.top()) / m_cellSize;
+    const qreal endX =
+        (end.x() - m_bounds.left()) / m_cellSize;
+    const qreal endY =
+        (end.y() - m_bounds.top()) / m_cellSize;
+
+    int x = qBound(0, int(qFloor(startX)), m_columns - 1);
+    int y = qBound(0, int(qFloor(startY)), m_rows - 1);
+    const int lastX =
+        qBound(0, int(qFloor(endX)), m_columns - 1);
+    const int lastY =
+        qBound(0, int(qFloor(endY)), m_rows - 1);
+
+    const qreal dx    = endX - startX;
+    const qreal dy    = endY - startY;
+    const int   stepX = dx >= 0 ? 1 : -1;
+    const int   stepY = dy >= 0 ? 1 : -1;
+    const qreal infinity =
+        std::numeric_limits<qreal>::infinity();
+
+    qreal tMaxX =
+        dx != 0.0
+            ? ((stepX > 0 ? x + 1 : x) - startX) / dx
+            : infinity;
+    qreal tMaxY =
+        dy != 0.0
+            ? ((stepY > 0 ? y + 1 : y) - startY) / dy
+            : infinity;
+    const qreal tDeltaX =
+        dx != 0.0 ? qAbs(1.0 / dx) : infinity;
+    const qreal tDeltaY =
+        dy != 0.0 ? qAbs(1.0 / dy) : infinity;
+
+    QVector<int> cells;
+    cells.append(y * m_columns + x);
+
+    const int steps = qAbs(lastX - x) + qAbs(lastY - y);
+    for (int i = 0; i < steps; ++i)
+    {
+        if (tMaxX < tMaxY)
+        {
+            tMaxX += tDeltaX;
+            x = qBound(0, x + stepX, m_columns - 1);
+        }
+        else
+        {
+            tMaxY += tDeltaY;
+            y = qBound(0, y + stepY, m_rows - 1);
+        }
+        cells.append(y * m_columns + x);
+    }
+    return cells;
+}
+
+qreal NetworkLayerItem::viewScale() const
+{
+    QGraphicsScene *itemScene = scene();
+    if (!itemScene || itemScene->views().isEmpty())
+    {
+        return 1.0;
+    }
+    return itemScene->views().first()->transform().m11();
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,384 @@
+#pragma once
+
+#include "GraphicsObjectBase.h"
+
+#ifdef CARGONET_HAS_OPENGL
+#include "GUI/Utils/NetworkLayerGLBatch.h"
+#endif
+
+#include <QCache>
+#include <QColor>
+#include <QHash>
+#include <QPixmap>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+/**
+ * @brief Draws a whole train or truck network as a single
+ * scene item
+ *
+ * NetworkLayerItem replaces the per-element MapPoint and
+ * MapLine items of large networks. Geometry is kept in
+ * flat arrays indexed like the network's node and link
+ * vectors:
+ * - Links are drawn in 256 px tiles that are rendered once
+ *   per zoom level and cached as pixmaps
+ * - Links shorter than a pixel are skipped and nodes are
+ *   only drawn once links are long enough on screen
+ * - A uniform grid over the network bounds answers hit
+ *   tests and nearest node queries
+ *
+ * On an OpenGL viewport the whole layer is drawn as two
+ * instanced batches instead, falling back to tiles when
+ * the context cannot run them.
+ *
+ * Clicks are reported as element indices so the caller
+ * can materialize a MapPoint or MapLine for the element
+ * that is actually used. Clicks that hit no element are
+ * ignored and reach the items underneath.
+ */
+class NetworkLayerItem : public GraphicsObjectBase
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs an empty network layer
+     *
+     * @param networkName Name of the drawn network
+     * @param region The network region this layer belongs
+     * to
+     * @param parent Optional parent item
+     */
+    NetworkLayerItem(const QString &networkName,
+                     const QString &region,
+                     QGraphicsItem *parent = nullptr);
+
+    virtual ~NetworkLayerItem() = default;
+
+    /**
+     * @brief Reserves storage for the network elements
+     */
+    void reserve(int nodeCount, int linkCount);
+
+    /**
+     * @brief Appends a node
+     *
+     * @param networkID The node ID in the network
+     * @param uniqueID The internal unique ID of the node
+     * @param scenePoint The node position in scene
+     * coordinates
+     * @return The node index
+     */
+    int addNode(const QString &networkID,
+                const QString &uniqueID,
+                const QPointF &scenePoint);
+
+    /**
+     * @brief Appends a link between two nodes
+     *
+     * @param networkID The link ID in the network
+     * @param uniqueID The internal unique ID of the link
+     * @param fromNode Index of the start node, -1 if
+     * unknown
+     * @param toNode Index of the end node, -1 if unknown
+     * @return The link index
+     *
+     * Links with an unknown endpoint keep their index but
+     * are never drawn or hit.
+     */
+    int addLink(const QString &networkID,
+                const QString &uniqueID, int fromNode,
+                int toNode);
+
+    /**
+     * @brief Builds the spatial index and bounds
+     *
+     * Must be called after the last node or link is added.
+     */
+    void finalize();
+
+    /**
+     * @brief Moves every node by a scene offset
+     */
+    void translateGeometry(const QPointF &offset);
+
+    int nodeCount() const
+    {
+        return m_nodePoints.size();
+    }
+
+    int linkCount() const
+    {
+        return m_linkNodes.size() / 2;
+    }
+
+    QString nodeNetworkID(int index) const
+    {
+        return m_nodeNetworkIDs.value(index);
+    }
+
+    QString nodeUniqueID(int index) const
+    {
+        return m_nodeUniqueIDs.value(index);
+    }
+
+    QPointF nodePoint(int index) const
+    {
+        return m_nodePoints.value(index);
+    }
+
+    QString linkNetworkID(int index) const
+    {
+        return m_linkNetworkIDs.value(index);
+    }
+
+    QString linkUniqueID(int index) const
+    {
+        return m_linkUniqueIDs.value(index);
+    }
+
+    /**
+     * @brief Gets the start and end node of a link
+     * @return False if an endpoint is unknown
+     */
+    bool linkNodes(int index, int &fromNode,
+                   int &toNode) const;
+
+    /**
+     * @brief Finds a node by its internal unique ID
+     * @return The node index, or -1 if not found
+     */
+    int findNode(const QString &uniqueID) const
+    {
+        return m_nodeIndex.value(uniqueID, -1);
+    }
+
+    /**
+     * @brief Finds a node by its network ID
+     * @return The node index, or -1 if not found
+     */
+    int findNodeByNetworkID(const QString &networkID) const
+    {
+        return m_nodeNetworkIndex.value(networkID, -1);
+    }
+
+    /**
+     * @brief Finds a link by its network ID
+     * @return The link index, or -1 if not found
+     */
+    int findLinkByNetworkID(const QString &networkID) const
+    {
+        return m_linkNetworkIndex.value(networkID, -1);
+    }
+
+    /**
+     * @brief Finds the node closest to a scene point
+     *
+     * @param scenePoint The query point
+     * @param tolerance Maximum distance in scene units
+     * @return The node index, or -1 if none is in range
+     */
+    int nodeAt(const QPointF &scenePoint,
+               qreal          tolerance) const;
+
+    /**
+     * @brief Finds the link closest to a scene point
+     *
+     * @param scenePoint The query point
+     * @param tolerance Maximum distance in scene units
+     * @return The link index, or -1 if none is in range
+     */
+    int linkAt(const QPointF &scenePoint,
+               qreal          tolerance) const;
+
+    /**
+     * @brief Finds the nearest node without a distance
+     * limit
+     *
+     * @param scenePoint The query point
+     * @param skipMaterialized Ignore nodes that have a
+     * MapPoint
+     * @return The node index, or -1 if the layer is empty
+     */
+    int nearestNode(const QPointF &scenePoint,
+                    bool skipMaterialized = false) const;
+
+    /**
+     * @brief Marks a node as drawn by its own MapPoint
+     */
+    void setNodeMaterialized(int index, bool materialized);
+
+    bool isNodeMaterialized(int index) const
+    {
+        return m_materializedNodes.value(index, false);
+    }
+
+    /**
+     * @brief Sets the reference network that this layer is
+     * created from
+     * @param network The network pointer
+     */
+    void setReferenceNetwork(QObject *network)
+    {
+        m_referenceNetwork = network;
+    }
+
+    QObject *getReferenceNetwork() const override
+    {
+        return m_referenceNetwork;
+    }
+
+    QString getNetworkName() const
+    {
+        return m_networkName;
+    }
+
+    QString getRegion() const override
+    {
+        return m_region;
+    }
+
+    void setRegion(const QString &region)
+    {
+        m_region = region;
+        updateRegistration();
+    }
+
+    /**
+     * @brief Sets the link color and the darker node color
+     */
+    void setColors(const QColor &linkColor,
+                   const QColor &nodeColor);
+
+    QColor getLinkColor() const
+    {
+        return m_linkColor;
+    }
+
+    QColor getNodeColor() const
+    {
+        return m_nodeColor;
+    }
+
+signals:
+    /**
+     * @brief Signal emitted when a node is clicked
+     */
+    void nodeClicked(NetworkLayerItem *layer, int index);
+
+    /**
+     * @brief Signal emitted when a link is clicked
+     */
+    void linkClicked(NetworkLayerItem *layer, int index);
+
+protected:
+    QRectF boundingRect() const override;
+    void   paint(QPainter                       *painter,
+                 const QStyleOptionGraphicsItem *option,
+                 QWidget *widget = nullptr) override;
+    void   mousePressEvent(
+          QGraphicsSceneMouseEvent *event) override;
+
+private:
+    /**
+     * @brief Key of a cached tile
+     */
+    struct TileKey
+    {
+        int level;
+        int x;
+        int y;
+
+        bool operator==(const TileKey &other) const
+        {
+            return level == other.level && x == other.x
+                   && y == other.y;
+        }
+    };
+
+    friend size_t qHash(const TileKey &key,
+                        size_t         seed = 0)
+    {
+        return qHashMulti(seed, key.level, key.x, key.y);
+    }
+
+    static constexpr int   TILE_SIZE        = 256;
+    static constexpr int   NODE_RADIUS      = 3;
+    static constexpr qreal NODE_LINK_PIXELS = 12.0;
+    static constexpr qreal HIT_PIXELS       = 5.0;
+
+    QPixmap renderTile(const QRectF &tileRect,
+                       qreal         scale) const;
+
+    /**
+     * @brief Collects elements whose grid cells overlap a
+     * scene rectangle, without duplicates
+     */
+    QVector<int> queryCells(const QRectF &sceneRect,
+                            bool          links) const;
+
+    bool cellRange(const QRectF &sceneRect, int &minX,
+                   int &minY, int &maxX, int &maxY) const;
+
+    /**
+     * @brief Lists the grid cells crossed by a segment
+     */
+    QVector<int> segmentCells(const QPointF &start,
+                              const QPointF &end) const;
+
+    qreal viewScale() const;
+
+    QString m_networkName;
+    QString m_region;
+    QObject *m_referenceNetwork;
+    QColor  m_linkColor;
+    QColor  m_nodeColor;
+
+    // Element arrays, indexed like the network vectors
+    QVector<QPointF> m_nodePoints;
+    QVector<QString> m_nodeNetworkIDs;
+    QVector<QString> m_nodeUniqueIDs;
+    QVector<bool>    m_materializedNodes;
+    QVector<int>     m_linkNodes; // from, to per link
+    QVector<QString> m_linkNetworkIDs;
+    QVector<QString> m_linkUniqueIDs;
+
+    QHash<QString, int> m_nodeIndex;
+    QHash<QString, int> m_nodeNetworkIndex;
+    QHash<QString, int> m_linkNetworkIndex;
+
+    // Uniform grid stored as cell offsets into item lists
+    QRectF       m_bounds;
+    qreal        m_cellSize = 1.0;
+    int          m_columns  = 0;
+    int          m_rows     = 0;
+    QVector<int> m_nodeCellStart;
+    QVector<int> m_nodeCellItems;
+    QVector<int> m_linkCellStart;
+    QVector<int> m_linkCellItems;
+
+    // Scale above which nodes are drawn
+    qreal m_nodeScale = 1.0;
+    qreal m_margin    = 0.0;
+
+    // Per-query visit stamps to skip duplicate links
+    mutable QVector<quint32> m_linkStamps;
+    mutable quint32          m_stamp = 0;
+
+    mutable QCache<TileKey, QPixmap> m_tileCache;
+
+#ifdef CARGONET_HAS_OPENGL
+    NetworkLayerGLBatch m_glBatch;
+#endif
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,155 @@
+#include "PathHighlightItem.h"
+
+#include <QPainter>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+PathHighlightItem::PathHighlightItem(QGraphicsItem *parent)
+    : QGraphicsObject(parent)
+{
+    setAcceptedMouseButtons(Qt::NoButton);
+    setAcceptHoverEvents(false);
+    setZValue(100);
+    setVisible(false);
+
+    m_timer.setInterval(FRAME_MS);
+    connect(&m_timer, &QTimer::timeout, this,
+            &PathHighlightItem::advanceFrame);
+}
+
+void PathHighlightItem::highlight(const QPainterPath &path,
+                                  const QPen         &pen)
+{
+    if (path.isEmpty())
+    {
+        return;
+    }
+
+    if (!m_clock.isValid())
+    {
+        m_clock.start();
+    }
+
+    Highlight highlight;
+    highlight.path    = path;
+    highlight.pen     = pen;
+    highlight.startMs = m_clock.elapsed();
+
+    // The pen reaches half its width past the path
+    qreal margin     = pen.widthF() / 2.0 + 1.0;
+    highlight.bounds = path.controlPointRect().adjusted(
+        -margin, -margin, margin, margin);
+    m_highlights.append(highlight);
+
+    updateBounds();
+    setVisible(true);
+    update();
+
+    if (!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
+
+void PathHighlightItem::clear()
+{
+    m_timer.stop();
+    m_highlights.clear();
+    updateBounds();
+    setVisible(false);
+}
+
+QRectF PathHighlightItem::boundingRect() const
+{
+    return m_bounds;
+}
+
+QPainterPath PathHighlightItem::shape() const
+{
+    return QPainterPath();
+}
+
+void PathHighlightItem::paint(
+    QPainter *painter, const QStyleOptionGraphicsItem *,
+    QWidget *)
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setBrush(Qt::NoBrush);
+    for (const Highlight &highlight : m_highlights)
+    {
+        if (highlight.opacity <= 0.0)
+        {
+            continue;
+        }
+        painter->setOpacity(highlight.opacity);
+        painter->setPen(highlight.pen);
+        painter->drawPath(highlight.path);
+    }
+    painter->restore();
+}
+
+void PathHighlightItem::advanceFrame()
+{
+    const qint64 now     = m_clock.elapsed();
+    const qint64 lifeMs  = qint64(PULSE_MS) * PULSE_COUNT;
+    bool         expired = false;
+
+    for (int i = m_highlights.size() - 1; i >= 0; --i)
+    {
+        Highlight &highlight = m_highlights[i];
+        qint64     elapsed   = now - highlight.startMs;
+        if (elapsed >= lifeMs)
+        {
+            m_highlights.remove(i);
+            expired = true;
+            continue;
+        }
+        highlight.opacity = pulseOpacity(elapsed);
+    }
+
+    // Repaint the old bounds so expired paths are erased
+    update();
+
+    if (expired)
+    {
+        updateBounds();
+    }
+
+    if (m_highlights.isEmpty())
+    {
+        m_timer.stop();
+        setVisible(false);
+    }
+}
+
+void PathHighlightItem::updateBounds()
+{
+    QRectF bounds;
+    for (const Highlight &highlight : m_highlights)
+    {
+        bounds |= highlight.bounds;
+    }
+
+    if (bounds != m_bounds)
+    {
+        prepareGeometryChange();
+        m_bounds = bounds;
+    }
+}
+
+qreal PathHighlightItem::pulseOpacity(qint64 elapsedMs)
+{
+    // Linear fade out over the first half of a pulse and
+    // back in over the second
+    qreal phase =
+        qreal(elapsedMs % PULSE_MS) / qreal(PULSE_MS);
+    return phase < 0.5 ? 1.0 - 2.0 * phase
+                       : 2.0 * phase - 1.0;
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QGraphicsObject>
+#include <QPainterPath>
+#include <QPen>
+#include <QRectF>
+#include <QTimer>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+/**
+ * @brief Scene-wide layer that draws pulsing highlights
+ *
+ * Each highlight is one stroked path with its own start
+ * time. A single frame timer drives all of them: every
+ * tick computes the opacities and schedules one repaint of
+ * the layer, which strokes each highlight with one draw
+ * call. Highlighting a path of any length therefore costs
+ * one path per frame instead of one animation and overlay
+ * item per segment.
+ *
+ * The layer takes no mouse input and has an empty shape,
+ * so it never hides the items underneath from hit tests.
+ */
+class PathHighlightItem : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs an empty, idle layer
+     * @param parent Optional parent item
+     */
+    explicit PathHighlightItem(
+        QGraphicsItem *parent = nullptr);
+
+    /**
+     * @brief Starts a highlight
+     *
+     * The path pulses from opaque to transparent and back
+     * PULSE_COUNT times, then disappears.
+     *
+     * @param path Path to stroke, in scene coordinates
+     * @param pen Stroke pen, widths in scene units
+     */
+    void highlight(const QPainterPath &path,
+                   const QPen         &pen);
+
+    /**
+     * @brief Removes all highlights and stops the timer
+     */
+    void clear();
+
+    bool isAnimating() const
+    {
+        return m_timer.isActive();
+    }
+
+    QRectF       boundingRect() const override;
+    QPainterPath shape() const override;
+    void paint(QPainter                       *painter,
+               const QStyleOptionGraphicsItem *option,
+               QWidget *widget = nullptr) override;
+
+    /// Duration of one opaque-transparent-opaque pulse
+    static constexpr int PULSE_MS = 1000;
+
+    /// Pulses per highlight
+    static constexpr int PULSE_COUNT = 3;
+
+    /// Interval of the frame timer
+    static constexpr int FRAME_MS = 16;
+
+private:
+    struct Highlight
+    {
+        QPainterPath path;
+        QPen         pen;
+        QRectF       bounds;
+        qint64       startMs = 0;
+        qreal        opacity = 1.0;
+    };
+
+    void         advanceFrame();
+    void         updateBounds();
+    static qreal pulseOpacity(qint64 elapsedMs);
+
+    QVector<Highlight> m_highlights;
+    QRectF             m_bounds;
+    QElapsedTimer      m_clock;
+    QTimer             m_timer;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
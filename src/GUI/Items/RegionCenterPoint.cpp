@@ -112,6 +112,7 @@ void RegionCenterPoint::setRegion(const QString &newRegion)
             properties.value("Region", "Default Region")
                 .toString();
         properties["Region"] = newRegion;
+        updateRegistration();
         emit regionChanged(newRegion);
     }
 }
@@ -72,7 +72,7 @@ public:
      *
      * @return Current region name
      */
-    QString getRegion() const
+    QString getRegion() const override
     {
         return properties.value("Region", "Default Region")
             .toString();
@@ -172,6 +172,7 @@ void TerminalItem::setRegion(const QString &newRegion)
         QString oldRegion      = m_region;
         m_region               = newRegion;
         m_properties["Region"] = newRegion;
+        updateRegistration();
         emit regionChanged(newRegion);
     }
 }
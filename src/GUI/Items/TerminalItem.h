@@ -85,7 +85,7 @@ public:
      *
      * @return Current m_region name
      */
-    QString getRegion() const
+    QString getRegion() const override
     {
         return m_region;
     }
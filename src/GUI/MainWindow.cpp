@@ -191,6 +191,13 @@ void MainWindow::initializeUI()
     setupGlobalMapScene();
     globalMapLayout->addWidget(globalMapView_);
 
+    applyViewportBackend(
+        CargoNetSim::CargoNetSimController::getInstance()
+            .getConfigController()
+            ->getSimulationParams()
+            .value("opengl_viewport", false)
+            .toBool());
+
     // Create logging tab
     loggingTab_ = new QWidget();
     setupLoggingTab();
@@ -302,6 +309,14 @@ void MainWindow::setupDocks()
     connect(
         settingsWidget_, &SettingsWidget::settingsChanged,
         [this](const QMap<QString, QVariant> &settings) {
+            auto &controller = CargoNetSim::
+                CargoNetSimController::getInstance();
+            controller.applySimulationSettings();
+            applyViewportBackend(
+                settings.value("simulation")
+                    .toMap()
+                    .value("opengl_viewport", false)
+                    .toBool());
             showStatusBarMessage(
                 "Simulation settings updated.", 2000);
         });
@@ -323,6 +338,20 @@ void MainWindow::setupDocks()
     regionManagerDock_->raise();
 }
 
+void MainWindow::applyViewportBackend(bool openGL)
+{
+    bool applied = regionView_->setOpenGLEnabled(openGL);
+    applied = globalMapView_->setOpenGLEnabled(openGL)
+              && applied;
+    if (!applied)
+    {
+        showStatusBarMessage(
+            "OpenGL rendering is unavailable, using the "
+            "raster renderer.",
+            4000);
+    }
+}
+
 void MainWindow::setupTerminalLibrary()
 {
     libraryDock_ =
@@ -252,6 +252,13 @@ private:
      */
     void setupGlobalMapScene();
 
+    /**
+     * @brief Switches both map views between the OpenGL
+     * and raster viewport
+     * @param openGL True to render through OpenGL
+     */
+    void applyViewportBackend(bool openGL);
+
     /**
      * @brief Sets up the terminal library dock
      */
@@ -0,0 +1,214 @@
+#include "NetworkImportJob.h"
+#include "ErrorHandlers.h"
+
+#include <QElapsedTimer>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+namespace
+{
+
+/**
+ * @brief Runs the worker stage of an import
+ */
+class PrepareTask : public SafeRunnable
+{
+public:
+    PrepareTask(NetworkImportJob::PrepareFunction prepare,
+                QVector<NetworkImportJob::Node> *nodes,
+                QVector<NetworkImportJob::Link> *links,
+                const QAtomicInt                *cancelled,
+                std::function<void()>            done)
+        : m_prepare(std::move(prepare))
+        , m_nodes(nodes)
+        , m_links(links)
+        , m_cancelled(cancelled)
+        , m_done(std::move(done))
+    {
+    }
+
+    void runSafe() override
+    {
+        m_prepare(*m_nodes, *m_links, *m_cancelled);
+        m_done();
+    }
+
+private:
+    NetworkImportJob::PrepareFunction m_prepare;
+    QVector<NetworkImportJob::Node>  *m_nodes;
+    QVector<NetworkImportJob::Link>  *m_links;
+    const QAtomicInt                 *m_cancelled;
+    std::function<void()>             m_done;
+};
+
+} // namespace
+
+QHash<QObject *, NetworkImportJob *>
+    NetworkImportJob::s_running;
+
+NetworkImportJob::NetworkImportJob(
+    QObject *network, PrepareFunction prepare,
+    NodeFunction insertNode, LinkFunction insertLink,
+    QObject *parent)
+    : QObject(parent)
+    , m_networkKey(network)
+    , m_network(network)
+    , m_prepare(std::move(prepare))
+    , m_insertNode(std::move(insertNode))
+    , m_insertLink(std::move(insertLink))
+{
+    m_pool.setMaxThreadCount(1);
+
+    // A zero timer lets pending events run between slices
+    m_sliceTimer.setSingleShot(true);
+    m_sliceTimer.setInterval(0);
+    connect(&m_sliceTimer, &QTimer::timeout, this,
+            &NetworkImportJob::insertSlice);
+}
+
+NetworkImportJob::~NetworkImportJob()
+{
+    m_cancelled.storeRelaxed(1);
+    m_pool.clear();
+    m_pool.waitForDone();
+    if (s_running.value(m_networkKey) == this)
+    {
+        s_running.remove(m_networkKey);
+    }
+}
+
+void NetworkImportJob::start()
+{
+    if (m_running || !m_network)
+    {
+        return;
+    }
+
+    // A new import of the same network replaces the old
+    if (NetworkImportJob *previous = find(m_networkKey))
+    {
+        previous->cancel();
+    }
+
+    m_running = true;
+    s_running.insert(m_networkKey, this);
+    m_pool.start(new PrepareTask(
+        m_prepare, &m_nodes, &m_links, &m_cancelled,
+        [this]() {
+            // Queued to the GUI thread; dropped if the job
+            // is gone
+            QMetaObject::invokeMethod(
+                this, &NetworkImportJob::onPrepared,
+                Qt::QueuedConnection);
+        }));
+}
+
+void NetworkImportJob::cancel()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_cancelled.storeRelaxed(1);
+    m_pool.clear();
+    m_pool.waitForDone();
+    finish(false);
+}
+
+NetworkImportJob *
+NetworkImportJob::find(QObject *network)
+{
+    return s_running.value(network, nullptr);
+}
+
+void NetworkImportJob::onPrepared()
+{
+    if (!m_running)
+    {
+        return;
+    }
+    if (!m_network)
+    {
+        finish(false);
+        return;
+    }
+    m_sliceTimer.start();
+}
+
+void NetworkImportJob::insertSlice()
+{
+    if (!m_running)
+    {
+        return;
+    }
+    if (!m_network)
+    {
+        finish(false);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int inserted = 0;
+    while (m_running)
+    {
+        if (m_nextNode < m_nodes.size())
+        {
+            m_insertNode(m_nextNode, m_nodes[m_nextNode]);
+            ++m_nextNode;
+        }
+        else if (m_nextLink < m_links.size())
+        {
+            m_insertLink(m_nextLink, m_links[m_nextLink],
+                         m_nodes);
+            ++m_nextLink;
+        }
+        else
+        {
+            break;
+        }
+
+        // Reading the clock per element would dominate
+        // cheap inserts
+        if (++inserted % 64 == 0
+            && timer.elapsed() >= SLICE_MS)
+        {
+            break;
+        }
+    }
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    const int total = m_nodes.size() + m_links.size();
+    emit progress(m_nextNode + m_nextLink, total);
+
+    if (m_nextNode + m_nextLink >= total)
+    {
+        finish(true);
+    }
+    else
+    {
+        m_sliceTimer.start();
+    }
+}
+
+void NetworkImportJob::finish(bool completed)
+{
+    m_running = false;
+    m_sliceTimer.stop();
+    if (s_running.value(m_networkKey) == this)
+    {
+        s_running.remove(m_networkKey);
+    }
+    emit finished(completed);
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointF>
+#include <QPointer>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+#include <functional>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+/**
+ * @brief Draws an imported network without blocking the
+ * GUI thread
+ *
+ * An import runs in two stages:
+ * - A worker thread converts every node and link of the
+ *   network into plain data: scene positions, properties
+ *   and link endpoints as node indices
+ * - The GUI thread then creates scene items from that data
+ *   in time slices of SLICE_MS, reporting progress after
+ *   each slice so events are handled in between
+ *
+ * Nodes are always inserted before links. A cancelled job
+ * stops at the next slice and never calls back again.
+ */
+class NetworkImportJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief A prepared network node
+     */
+    struct Node
+    {
+        QString                 networkID;
+        QString                 uniqueID;
+        QPointF                 scenePoint;
+        bool                    terminal = false;
+        QMap<QString, QVariant> properties;
+    };
+
+    /**
+     * @brief A prepared network link
+     *
+     * Endpoints index the prepared nodes, -1 if unknown.
+     */
+    struct Link
+    {
+        QString                 networkID;
+        QString                 uniqueID;
+        int                     fromNode = -1;
+        int                     toNode   = -1;
+        QMap<QString, QVariant> properties;
+    };
+
+    /**
+     * @brief Fills the node and link data; runs on a worker
+     * thread and should return early once the flag is set
+     */
+    using PrepareFunction = std::function<void(
+        QVector<Node> &, QVector<Link> &,
+        const QAtomicInt &cancelled)>;
+
+    /**
+     * @brief Creates the items of one node on the GUI
+     * thread
+     */
+    using NodeFunction =
+        std::function<void(int index, const Node &node)>;
+
+    /**
+     * @brief Creates the items of one link on the GUI
+     * thread
+     */
+    using LinkFunction = std::function<void(
+        int index, const Link &link,
+        const QVector<Node> &nodes)>;
+
+    /**
+     * @brief Constructs an import job
+     *
+     * @param network The network being drawn
+     * @param prepare Worker stage
+     * @param insertNode GUI stage for nodes
+     * @param insertLink GUI stage for links
+     * @param parent Parent object
+     */
+    NetworkImportJob(QObject        *network,
+                     PrepareFunction prepare,
+                     NodeFunction    insertNode,
+                     LinkFunction    insertLink,
+                     QObject        *parent = nullptr);
+
+    /**
+     * @brief Cancels the job and waits for the worker
+     */
+    ~NetworkImportJob() override;
+
+    /**
+     * @brief Starts the worker stage
+     */
+    void start();
+
+    /**
+     * @brief Stops the job
+     *
+     * Waits for the worker stage, so the network can be
+     * deleted afterwards. Emits finished(false) if the job
+     * was still running.
+     */
+    void cancel();
+
+    bool isRunning() const
+    {
+        return m_running;
+    }
+
+    QObject *getNetwork() const
+    {
+        return m_network;
+    }
+
+    /**
+     * @brief Finds the running import of a network
+     * @return The job, or nullptr if none is running
+     */
+    static NetworkImportJob *find(QObject *network);
+
+signals:
+    /**
+     * @brief Emitted after each inserted slice
+     * @param done Elements inserted so far
+     * @param total Nodes and links of the network
+     */
+    void progress(int done, int total);
+
+    /**
+     * @brief Emitted once when the job ends
+     * @param completed False if the job was cancelled
+     */
+    void finished(bool completed);
+
+private:
+    /**
+     * @brief Time budget of one insertion slice
+     */
+    static constexpr int SLICE_MS = 12;
+
+    void onPrepared();
+    void insertSlice();
+    void finish(bool completed);
+
+    // The key stays valid for s_running after the network
+    // is deleted
+    QObject          *m_networkKey;
+    QPointer<QObject> m_network;
+    PrepareFunction   m_prepare;
+    NodeFunction      m_insertNode;
+    LinkFunction      m_insertLink;
+
+    QVector<Node> m_nodes;
+    QVector<Link> m_links;
+    int           m_nextNode = 0;
+    int           m_nextLink = 0;
+
+    bool        m_running = false;
+    QAtomicInt  m_cancelled;
+    QTimer      m_sliceTimer;
+    QThreadPool m_pool;
+
+    static QHash<QObject *, NetworkImportJob *> s_running;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,489 @@
+#include "NetworkLayerGLBatch.h"
+
+#include <QDebug>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QPair>
+#include <QSizeF>
+#include <QTransform>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+namespace
+{
+
+constexpr unsigned int CORNER_LOCATION   = 0;
+constexpr unsigned int INSTANCE_LOCATION = 1;
+
+// Triangle strip corners; lines use (t, side), points
+// use (x, y) in the unit square
+const GLfloat CORNERS[] = {0.0f,  -1.0f, 0.0f,  1.0f,
+                           1.0f,  -1.0f, 1.0f,  1.0f,
+                           -1.0f, -1.0f, -1.0f, 1.0f,
+                           1.0f,  -1.0f, 1.0f,  1.0f};
+
+constexpr int POINT_CORNERS_OFFSET =
+    8 * sizeof(GLfloat);
+
+const char *LINE_VERTEX_SHADER = R"(
+in vec2 corner;
+in vec4 segment;
+uniform mat3 toDevice;
+uniform vec2 deviceSize;
+uniform float halfWidth;
+
+void main()
+{
+    vec3 a = toDevice * vec3(segment.xy, 1.0);
+    vec3 b = toDevice * vec3(segment.zw, 1.0);
+    vec2 start = a.xy / a.z;
+    vec2 end = b.xy / b.z;
+    vec2 direction = end - start;
+    float len = length(direction);
+    direction = len > 0.0 ? direction / len
+                          : vec2(1.0, 0.0);
+    vec2 normal = vec2(-direction.y, direction.x);
+    vec2 position = mix(start, end, corner.x)
+                    + normal * corner.y * halfWidth;
+    gl_Position = vec4(
+        position.x / deviceSize.x * 2.0 - 1.0,
+        1.0 - position.y / deviceSize.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char *LINE_FRAGMENT_SHADER = R"(
+uniform vec4 color;
+out vec4 fragColor;
+
+void main()
+{
+    fragColor = color;
+}
+)";
+
+const char *POINT_VERTEX_SHADER = R"(
+in vec2 corner;
+in vec2 center;
+uniform mat3 toDevice;
+uniform vec2 deviceSize;
+uniform float radius;
+out vec2 offset;
+
+void main()
+{
+    vec3 c = toDevice * vec3(center, 1.0);
+    vec2 position = c.xy / c.z + corner * radius;
+    offset = corner;
+    gl_Position = vec4(
+        position.x / deviceSize.x * 2.0 - 1.0,
+        1.0 - position.y / deviceSize.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char *POINT_FRAGMENT_SHADER = R"(
+in vec2 offset;
+uniform vec4 color;
+out vec4 fragColor;
+
+void main()
+{
+    if (dot(offset, offset) > 1.0)
+    {
+        discard;
+    }
+    fragColor = color;
+}
+)";
+
+GLuint compileShader(QOpenGLExtraFunctions *gl,
+                     bool es, GLenum type,
+                     const char *source)
+{
+    const char *header =
+        es ? "#version 300 es\nprecision mediump float;\n"
+           : "#version 330 core\n";
+    const char *sources[] = {header, source};
+
+    GLuint shader = gl->glCreateShader(type);
+    gl->glShaderSource(shader, 2, sources, nullptr);
+    gl->glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    gl->glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled)
+    {
+        char log[1024];
+        gl->glGetShaderInfoLog(shader, sizeof(log), nullptr,
+                               log);
+        qWarning() << "Network layer shader failed:" << log;
+        gl->glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint linkProgram(QOpenGLExtraFunctions *gl, bool es,
+                   const char *vertexSource,
+                   const char *fragmentSource,
+                   const char *instanceName)
+{
+    GLuint vertex = compileShader(gl, es, GL_VERTEX_SHADER,
+                                  vertexSource);
+    GLuint fragment = compileShader(
+        gl, es, GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertex || !fragment)
+    {
+        gl->glDeleteShader(vertex);
+        gl->glDeleteShader(fragment);
+        return 0;
+    }
+
+    GLuint program = gl->glCreateProgram();
+    gl->glAttachShader(program, vertex);
+    gl->glAttachShader(program, fragment);
+    gl->glBindAttribLocation(program, CORNER_LOCATION,
+                             "corner");
+    gl->glBindAttribLocation(program, INSTANCE_LOCATION,
+                             instanceName);
+    gl->glLinkProgram(program);
+    gl->glDeleteShader(vertex);
+    gl->glDeleteShader(fragment);
+
+    GLint linked = GL_FALSE;
+    gl->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        qWarning() << "Network layer program failed to"
+                      " link";
+        gl->glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+/**
+ * @brief Binds the shared corners and a per-instance
+ * buffer to a vertex array
+ */
+void setupArray(QOpenGLExtraFunctions *gl, GLuint array,
+                GLuint cornerBuffer, int cornerOffset,
+                GLuint instanceBuffer, int instanceSize)
+{
+    gl->glBindVertexArray(array);
+
+    gl->glBindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+    gl->glEnableVertexAttribArray(CORNER_LOCATION);
+    gl->glVertexAttribPointer(
+        CORNER_LOCATION, 2, GL_FLOAT, GL_FALSE, 0,
+        reinterpret_cast<const void *>(
+            quintptr(cornerOffset)));
+
+    gl->glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    gl->glEnableVertexAttribArray(INSTANCE_LOCATION);
+    gl->glVertexAttribPointer(INSTANCE_LOCATION,
+                              instanceSize, GL_FLOAT,
+                              GL_FALSE, 0, nullptr);
+    gl->glVertexAttribDivisor(INSTANCE_LOCATION, 1);
+}
+
+/**
+ * @brief Sets the uniforms shared by both programs
+ */
+void setCommonUniforms(QOpenGLExtraFunctions *gl,
+                       GLuint program,
+                       const GLfloat *toDevice,
+                       const QSizeF &deviceSize,
+                       const QColor &color)
+{
+    gl->glUniformMatrix3fv(
+        gl->glGetUniformLocation(program, "toDevice"), 1,
+        GL_FALSE, toDevice);
+    gl->glUniform2f(
+        gl->glGetUniformLocation(program, "deviceSize"),
+        GLfloat(deviceSize.width()),
+        GLfloat(deviceSize.height()));
+
+    // Qt's GL paint engine blends premultiplied colors
+    const GLfloat alpha = GLfloat(color.alphaF());
+    gl->glUniform4f(
+        gl->glGetUniformLocation(program, "color"),
+        GLfloat(color.redF()) * alpha,
+        GLfloat(color.greenF()) * alpha,
+        GLfloat(color.blueF()) * alpha, alpha);
+}
+
+} // namespace
+
+NetworkLayerGLBatch::~NetworkLayerGLBatch()
+{
+    for (auto it = m_resources.begin();
+         it != m_resources.end(); ++it)
+    {
+        QObject::disconnect(it->destroyed);
+        release(it.key(), it.value());
+    }
+}
+
+void NetworkLayerGLBatch::invalidate()
+{
+    for (Resources &resources : m_resources)
+    {
+        resources.stale = true;
+    }
+}
+
+bool NetworkLayerGLBatch::draw(QPainter    *painter,
+                               const Frame &frame)
+{
+    if (!painter->paintEngine()
+        || painter->paintEngine()->type()
+               != QPaintEngine::OpenGL2
+        || !frame.nodePoints || !frame.linkNodes
+        || !frame.materialized)
+    {
+        return false;
+    }
+
+    QOpenGLContext *context =
+        QOpenGLContext::currentContext();
+    if (!isSupported(context))
+    {
+        return false;
+    }
+
+    painter->beginNativePainting();
+
+    QOpenGLExtraFunctions *gl = context->extraFunctions();
+    GLint previousArray       = 0;
+    gl->glGetIntegerv(GL_VERTEX_ARRAY_BINDING,
+                      &previousArray);
+
+    Resources *res = resources(context);
+    if (!res)
+    {
+        painter->endNativePainting();
+        return false;
+    }
+    if (res->stale)
+    {
+        upload(*res, frame);
+    }
+
+    // Vertices are stored relative to the origin, so the
+    // double precision part of the transform stays on the
+    // CPU
+    const QTransform toDevice =
+        QTransform::fromTranslate(frame.origin.x(),
+                                  frame.origin.y())
+        * painter->deviceTransform();
+    const GLfloat matrix[] = {
+        GLfloat(toDevice.m11()), GLfloat(toDevice.m12()),
+        GLfloat(toDevice.m13()), GLfloat(toDevice.m21()),
+        GLfloat(toDevice.m22()), GLfloat(toDevice.m23()),
+        GLfloat(toDevice.m31()), GLfloat(toDevice.m32()),
+        GLfloat(toDevice.m33())};
+    const QSizeF deviceSize(painter->device()->width(),
+                            painter->device()->height());
+
+    gl->glDisable(GL_DEPTH_TEST);
+    gl->glEnable(GL_BLEND);
+    gl->glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (res->lineCount > 0)
+    {
+        gl->glUseProgram(res->lineProgram);
+        setCommonUniforms(gl, res->lineProgram, matrix,
+                          deviceSize, frame.linkColor);
+        gl->glUniform1f(gl->glGetUniformLocation(
+                            res->lineProgram, "halfWidth"),
+                        frame.linkWidth * 0.5f);
+        gl->glBindVertexArray(res->lineArray);
+        gl->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4,
+                                  res->lineCount);
+    }
+
+    if (frame.drawNodes && res->pointCount > 0)
+    {
+        gl->glUseProgram(res->pointProgram);
+        setCommonUniforms(gl, res->pointProgram, matrix,
+                          deviceSize, frame.nodeColor);
+        gl->glUniform1f(gl->glGetUniformLocation(
+                            res->pointProgram, "radius"),
+                        frame.nodeRadius);
+        gl->glBindVertexArray(res->pointArray);
+        gl->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4,
+                                  res->pointCount);
+    }
+
+    gl->glBindVertexArray(GLuint(previousArray));
+    gl->glUseProgram(0);
+    painter->endNativePainting();
+    return true;
+}
+
+bool NetworkLayerGLBatch::isSupported(
+    QOpenGLContext *context)
+{
+    if (!context)
+    {
+        return false;
+    }
+
+    const QPair<int, int> version =
+        context->format().version();
+    return context->isOpenGLES()
+               ? version >= qMakePair(3, 0)
+               : version >= qMakePair(3, 3);
+}
+
+NetworkLayerGLBatch::Resources *
+NetworkLayerGLBatch::resources(QOpenGLContext *context)
+{
+    auto it = m_resources.find(context);
+    if (it != m_resources.end())
+    {
+        return it->failed ? nullptr : &it.value();
+    }
+
+    Resources &res = m_resources[context];
+    res.destroyed  = QObject::connect(
+        context, &QOpenGLContext::aboutToBeDestroyed,
+        [this, context]() {
+            auto found = m_resources.find(context);
+            if (found != m_resources.end())
+            {
+                release(context, found.value());
+                m_resources.erase(found);
+            }
+        });
+
+    QOpenGLExtraFunctions *gl = context->extraFunctions();
+    const bool             es = context->isOpenGLES();
+    res.lineProgram =
+        linkProgram(gl, es, LINE_VERTEX_SHADER,
+                    LINE_FRAGMENT_SHADER, "segment");
+    res.pointProgram =
+        linkProgram(gl, es, POINT_VERTEX_SHADER,
+                    POINT_FRAGMENT_SHADER, "center");
+    if (!res.lineProgram || !res.pointProgram)
+    {
+        res.failed = true;
+        return nullptr;
+    }
+
+    gl->glGenBuffers(1, &res.cornerBuffer);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, res.cornerBuffer);
+    gl->glBufferData(GL_ARRAY_BUFFER, sizeof(CORNERS),
+                     CORNERS, GL_STATIC_DRAW);
+    gl->glGenBuffers(1, &res.lineBuffer);
+    gl->glGenBuffers(1, &res.pointBuffer);
+
+    gl->glGenVertexArrays(1, &res.lineArray);
+    setupArray(gl, res.lineArray, res.cornerBuffer, 0,
+               res.lineBuffer, 4);
+    gl->glGenVertexArrays(1, &res.pointArray);
+    setupArray(gl, res.pointArray, res.cornerBuffer,
+               POINT_CORNERS_OFFSET, res.pointBuffer, 2);
+
+    return &res;
+}
+
+void NetworkLayerGLBatch::upload(Resources   &res,
+                                 const Frame &frame)
+{
+    const QVector<QPointF> &points = *frame.nodePoints;
+    const QVector<int>     &links  = *frame.linkNodes;
+    const QVector<bool>    &hidden = *frame.materialized;
+    const QPointF           origin = frame.origin;
+
+    QVector<GLfloat> lineData;
+    lineData.reserve(links.size() * 2);
+    for (int i = 0; i + 1 < links.size(); i += 2)
+    {
+        if (links[i] < 0 || links[i + 1] < 0)
+        {
+            continue;
+        }
+        const QPointF start = points[links[i]] - origin;
+        const QPointF end   = points[links[i + 1]] - origin;
+        lineData << GLfloat(start.x()) << GLfloat(start.y())
+                 << GLfloat(end.x()) << GLfloat(end.y());
+    }
+
+    // Nodes with their own MapPoint are not drawn twice
+    QVector<GLfloat> pointData;
+    pointData.reserve(points.size() * 2);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        if (!hidden.value(i, false))
+        {
+            const QPointF point = points[i] - origin;
+            pointData << GLfloat(point.x())
+                      << GLfloat(point.y());
+        }
+    }
+
+    QOpenGLExtraFunctions *gl =
+        QOpenGLContext::currentContext()->extraFunctions();
+    gl->glBindBuffer(GL_ARRAY_BUFFER, res.lineBuffer);
+    gl->glBufferData(GL_ARRAY_BUFFER,
+                     lineData.size() * sizeof(GLfloat),
+                     lineData.constData(), GL_STATIC_DRAW);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, res.pointBuffer);
+    gl->glBufferData(GL_ARRAY_BUFFER,
+                     pointData.size() * sizeof(GLfloat),
+                     pointData.constData(), GL_STATIC_DRAW);
+
+    res.lineCount  = lineData.size() / 4;
+    res.pointCount = pointData.size() / 2;
+    res.stale      = false;
+}
+
+void NetworkLayerGLBatch::release(QOpenGLContext *context,
+                                  Resources      &res)
+{
+    // Deleting GL objects needs the owning context current
+    QOpenGLContext *previous =
+        QOpenGLContext::currentContext();
+    QSurface *previousSurface =
+        previous ? previous->surface() : nullptr;
+    QOffscreenSurface surface;
+    if (previous != context)
+    {
+        surface.setFormat(context->format());
+        surface.create();
+        if (!context->makeCurrent(&surface))
+        {
+            return;
+        }
+    }
+
+    QOpenGLExtraFunctions *gl = context->extraFunctions();
+    gl->glDeleteVertexArrays(1, &res.lineArray);
+    gl->glDeleteVertexArrays(1, &res.pointArray);
+    gl->glDeleteBuffers(1, &res.cornerBuffer);
+    gl->glDeleteBuffers(1, &res.lineBuffer);
+    gl->glDeleteBuffers(1, &res.pointBuffer);
+    gl->glDeleteProgram(res.lineProgram);
+    gl->glDeleteProgram(res.pointProgram);
+    res = Resources();
+
+    if (previous != context)
+    {
+        context->doneCurrent();
+        if (previous && previousSurface)
+        {
+            previous->makeCurrent(previousSurface);
+        }
+    }
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QColor>
+#include <QHash>
+#include <QMetaObject>
+#include <QPointF>
+#include <QVector>
+
+class QOpenGLContext;
+class QPainter;
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+/**
+ * @brief Instanced OpenGL batches for a network layer
+ *
+ * Links are uploaded once as one instance per segment and
+ * nodes as one instance per point. Each frame is then two
+ * instanced draw calls, expanded to screen-space quads in
+ * the vertex shader, instead of one QPainter call per
+ * element.
+ *
+ * Drawing needs an OpenGL 3.3 or OpenGL ES 3.0 context,
+ * such as Mesa llvmpipe. draw() returns false on any other
+ * paint device so the caller can fall back to raster
+ * drawing.
+ */
+class NetworkLayerGLBatch
+{
+public:
+    /**
+     * @brief Geometry and style of one frame
+     */
+    struct Frame
+    {
+        const QVector<QPointF> *nodePoints   = nullptr;
+        const QVector<int>     *linkNodes    = nullptr;
+        const QVector<bool>    *materialized = nullptr;
+        QPointF                 origin;
+        QColor                  linkColor;
+        QColor                  nodeColor;
+        bool                    drawNodes   = false;
+        float                   linkWidth   = 1.0f;
+        float                   nodeRadius  = 3.0f;
+    };
+
+    NetworkLayerGLBatch() = default;
+    ~NetworkLayerGLBatch();
+
+    NetworkLayerGLBatch(const NetworkLayerGLBatch &) =
+        delete;
+    NetworkLayerGLBatch &
+    operator=(const NetworkLayerGLBatch &) = delete;
+
+    /**
+     * @brief Marks the uploaded geometry as stale
+     */
+    void invalidate();
+
+    /**
+     * @brief Draws the layer with the painter's OpenGL
+     * context
+     *
+     * @return False if the painter does not paint on a
+     * suitable OpenGL context
+     */
+    bool draw(QPainter *painter, const Frame &frame);
+
+private:
+    /**
+     * @brief GL objects of one context
+     */
+    struct Resources
+    {
+        unsigned int lineProgram  = 0;
+        unsigned int pointProgram = 0;
+        unsigned int lineArray    = 0;
+        unsigned int pointArray   = 0;
+        unsigned int cornerBuffer = 0;
+        unsigned int lineBuffer   = 0;
+        unsigned int pointBuffer  = 0;
+        int          lineCount    = 0;
+        int          pointCount   = 0;
+        bool         stale        = true;
+        bool         failed       = false;
+
+        QMetaObject::Connection destroyed;
+    };
+
+    static bool isSupported(QOpenGLContext *context);
+
+    Resources *resources(QOpenGLContext *context);
+
+    void upload(Resources &resources, const Frame &frame);
+
+    static void release(QOpenGLContext *context,
+                        Resources      &resources);
+
+    QHash<QOpenGLContext *, Resources> m_resources;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
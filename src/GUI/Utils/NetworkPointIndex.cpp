@@ -0,0 +1,296 @@
+#include "NetworkPointIndex.h"
+#include "GUI/Items/MapPoint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+void NetworkPointIndex::addNetwork(
+    QObject *network, NetworkType type,
+    const QString &region, const QVector<QPointF> &points,
+    const QVector<int> &nodes)
+{
+    removeNetwork(network);
+    if (!network || points.size() != nodes.size())
+    {
+        return;
+    }
+
+    Tree tree;
+    tree.type   = type;
+    tree.region = region;
+    tree.points = points;
+    tree.nodes  = nodes;
+    build(tree, 0, tree.points.size(), 0);
+
+    int maxNode = -1;
+    for (int node : tree.nodes)
+    {
+        maxNode = qMax(maxNode, node);
+    }
+    tree.nodeSlots.fill(-1, maxNode + 1);
+    for (int slot = 0; slot < tree.nodes.size(); ++slot)
+    {
+        if (tree.nodes[slot] >= 0)
+        {
+            tree.nodeSlots[tree.nodes[slot]] = slot;
+        }
+    }
+    tree.mapPoints.fill(nullptr, tree.points.size());
+    tree.terminals.fill(nullptr, tree.points.size());
+
+    m_networks.insert(network, std::move(tree));
+}
+
+void NetworkPointIndex::removeNetwork(QObject *network)
+{
+    auto it = m_networks.find(network);
+    if (it == m_networks.end())
+    {
+        return;
+    }
+
+    for (TerminalItem *terminal : it->terminals)
+    {
+        if (terminal)
+        {
+            countLink(terminal, it->type, -1);
+        }
+    }
+    m_networks.erase(it);
+}
+
+void NetworkPointIndex::translateNetwork(
+    QObject *network, const QPointF &offset)
+{
+    auto it = m_networks.find(network);
+    if (it != m_networks.end())
+    {
+        it->offset += offset;
+    }
+}
+
+void NetworkPointIndex::renameRegion(
+    const QString &oldName, const QString &newName)
+{
+    for (Tree &tree : m_networks)
+    {
+        if (tree.region == oldName)
+        {
+            tree.region = newName;
+        }
+    }
+}
+
+void NetworkPointIndex::setMapPoint(QObject  *network,
+                                    int       node,
+                                    MapPoint *point)
+{
+    auto it = m_networks.find(network);
+    if (it == m_networks.end() || node < 0
+        || node >= it->nodeSlots.size()
+        || it->nodeSlots[node] < 0)
+    {
+        return;
+    }
+
+    it->mapPoints[it->nodeSlots[node]] = point;
+    setLinkedTerminal(network, node,
+                      point ? point->getLinkedTerminal()
+                            : nullptr);
+}
+
+void NetworkPointIndex::setLinkedTerminal(
+    QObject *network, int node, TerminalItem *terminal)
+{
+    auto it = m_networks.find(network);
+    if (it == m_networks.end() || node < 0
+        || node >= it->nodeSlots.size()
+        || it->nodeSlots[node] < 0)
+    {
+        return;
+    }
+
+    TerminalItem *&current =
+        it->terminals[it->nodeSlots[node]];
+    if (current == terminal)
+    {
+        return;
+    }
+    if (current)
+    {
+        countLink(current, it->type, -1);
+    }
+    current = terminal;
+    if (current)
+    {
+        countLink(current, it->type, 1);
+    }
+}
+
+bool NetworkPointIndex::isTerminalLinked(
+    const TerminalItem *terminal, NetworkType type) const
+{
+    return m_terminalLinks.value(terminal).value(int(type))
+           > 0;
+}
+
+QVector<NetworkPointIndex::Match>
+NetworkPointIndex::nearest(
+    const QPointF &scenePoint, const QString &region,
+    const QList<NetworkType> &types, int k,
+    bool unlinkedOnly) const
+{
+    QVector<Match> matches;
+    if (k <= 0)
+    {
+        return matches;
+    }
+
+    for (auto it = m_networks.constBegin();
+         it != m_networks.constEnd(); ++it)
+    {
+        const Tree &tree = it.value();
+        if (tree.region != region
+            || !types.contains(tree.type))
+        {
+            continue;
+        }
+
+        // Trees are stored unmoved
+        search(tree, it.key(), scenePoint - tree.offset, 0,
+               tree.points.size(), 0, k, unlinkedOnly,
+               matches);
+    }
+
+    for (Match &match : matches)
+    {
+        match.point +=
+            m_networks.constFind(match.network)->offset;
+        match.distance = std::sqrt(match.distance);
+    }
+    return matches;
+}
+
+void NetworkPointIndex::build(Tree &tree, int begin,
+                              int end, int depth)
+{
+    if (end - begin <= 1)
+    {
+        return;
+    }
+
+    // Sort a permutation so nodes follow their points
+    int          count = end - begin;
+    int          mid   = count / 2;
+    QVector<int> order(count);
+    std::iota(order.begin(), order.end(), begin);
+    bool byX = depth % 2 == 0;
+    std::nth_element(
+        order.begin(), order.begin() + mid, order.end(),
+        [&tree, byX](int a, int b) {
+            return byX ? tree.points[a].x()
+                             < tree.points[b].x()
+                       : tree.points[a].y()
+                             < tree.points[b].y();
+        });
+
+    QVector<QPointF> points(count);
+    QVector<int>     nodes(count);
+    for (int i = 0; i < count; ++i)
+    {
+        points[i] = tree.points[order[i]];
+        nodes[i]  = tree.nodes[order[i]];
+    }
+    std::copy(points.begin(), points.end(),
+              tree.points.begin() + begin);
+    std::copy(nodes.begin(), nodes.end(),
+              tree.nodes.begin() + begin);
+
+    build(tree, begin, begin + mid, depth + 1);
+    build(tree, begin + mid + 1, end, depth + 1);
+}
+
+void NetworkPointIndex::search(
+    const Tree &tree, QObject *network,
+    const QPointF &point, int begin, int end, int depth,
+    int k, bool unlinkedOnly, QVector<Match> &matches)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    int            mid       = begin + (end - begin) / 2;
+    const QPointF &candidate = tree.points[mid];
+    QPointF        delta     = candidate - point;
+    qreal          distance =
+        delta.x() * delta.x() + delta.y() * delta.y();
+
+    bool full = matches.size() >= k;
+    if ((!full || distance < matches.last().distance)
+        && !(unlinkedOnly && tree.terminals[mid]))
+    {
+        // Matches stay sorted by squared distance
+        Match match;
+        match.network  = network;
+        match.type     = tree.type;
+        match.node     = tree.nodes[mid];
+        match.mapPoint = tree.mapPoints[mid];
+        match.point    = candidate;
+        match.distance = distance;
+
+        auto position = std::upper_bound(
+            matches.begin(), matches.end(), distance,
+            [](qreal value, const Match &other) {
+                return value < other.distance;
+            });
+        matches.insert(position, match);
+        if (matches.size() > k)
+        {
+            matches.removeLast();
+        }
+    }
+
+    qreal split = depth % 2 == 0
+                      ? point.x() - candidate.x()
+                      : point.y() - candidate.y();
+    bool left = split < 0;
+    search(tree, network, point,
+           left ? begin : mid + 1, left ? mid : end,
+           depth + 1, k, unlinkedOnly, matches);
+
+    // The far side can only help if the split is closer
+    // than the current worst match
+    if (matches.size() < k
+        || split * split < matches.last().distance)
+    {
+        search(tree, network, point,
+               left ? mid + 1 : begin, left ? end : mid,
+               depth + 1, k, unlinkedOnly, matches);
+    }
+}
+
+void NetworkPointIndex::countLink(
+    const TerminalItem *terminal, NetworkType type,
+    int delta)
+{
+    int &count = m_terminalLinks[terminal][int(type)];
+    count += delta;
+    if (count <= 0)
+    {
+        m_terminalLinks[terminal].remove(int(type));
+        if (m_terminalLinks[terminal].isEmpty())
+        {
+            m_terminalLinks.remove(terminal);
+        }
+    }
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "GUI/Commons/NetworkType.h"
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+class MapPoint;
+class TerminalItem;
+
+/**
+ * @brief Per-network k-d trees over network node positions
+ *
+ * Each indexed network keeps its nodes in an implicit k-d
+ * tree built once on import. Moving a network only shifts
+ * its stored offset, so the tree is never rebuilt.
+ *
+ * Nodes carry the MapPoint drawn for them, if any, and the
+ * terminal that point is linked to, so nearest queries can
+ * skip linked nodes without touching the scene.
+ */
+class NetworkPointIndex
+{
+public:
+    /**
+     * @brief A node returned by a nearest query
+     */
+    struct Match
+    {
+        QObject    *network  = nullptr;
+        NetworkType type     = NetworkType::Train;
+        int         node     = -1;
+        MapPoint   *mapPoint = nullptr;
+        QPointF     point;
+        qreal       distance = 0.0;
+    };
+
+    /**
+     * @brief Indexes the nodes of a network
+     *
+     * Replaces any previous index of the same network.
+     *
+     * @param network The reference network
+     * @param type The network type
+     * @param region The region the network belongs to
+     * @param points Node positions in scene coordinates
+     * @param nodes Node indices in the network, parallel
+     * to points
+     */
+    void addNetwork(QObject *network, NetworkType type,
+                    const QString          &region,
+                    const QVector<QPointF> &points,
+                    const QVector<int>     &nodes);
+
+    /**
+     * @brief Drops the index of a network
+     */
+    void removeNetwork(QObject *network);
+
+    bool containsNetwork(QObject *network) const
+    {
+        return m_networks.contains(network);
+    }
+
+    /**
+     * @brief Moves every node of a network by an offset
+     */
+    void translateNetwork(QObject       *network,
+                          const QPointF &offset);
+
+    /**
+     * @brief Renames the region of indexed networks
+     */
+    void renameRegion(const QString &oldName,
+                      const QString &newName);
+
+    /**
+     * @brief Records the MapPoint drawn for a node
+     *
+     * The point's linked terminal is recorded too.
+     */
+    void setMapPoint(QObject *network, int node,
+                     MapPoint *point);
+
+    /**
+     * @brief Records the terminal a node is linked to
+     * @param terminal The terminal, or nullptr if unlinked
+     */
+    void setLinkedTerminal(QObject *network, int node,
+                           TerminalItem *terminal);
+
+    /**
+     * @brief Checks whether a terminal is linked to a node
+     * of a network type
+     */
+    bool isTerminalLinked(const TerminalItem *terminal,
+                          NetworkType         type) const;
+
+    /**
+     * @brief Finds the k nodes closest to a scene point
+     *
+     * @param scenePoint The query point
+     * @param region Only networks of this region are
+     * searched
+     * @param types Network types to search
+     * @param k Maximum number of matches
+     * @param unlinkedOnly Skip nodes linked to a terminal
+     * @return Matches ordered by increasing distance
+     */
+    QVector<Match>
+    nearest(const QPointF            &scenePoint,
+            const QString            &region,
+            const QList<NetworkType> &types, int k = 1,
+            bool unlinkedOnly = true) const;
+
+private:
+    struct Tree
+    {
+        NetworkType type;
+        QString     region;
+        QPointF     offset;
+
+        // Nodes in k-d tree order
+        QVector<QPointF>        points;
+        QVector<int>            nodes;
+        QVector<MapPoint *>     mapPoints;
+        QVector<TerminalItem *> terminals;
+
+        // Tree slot of each network node, -1 if absent
+        QVector<int> nodeSlots;
+    };
+
+    static void build(Tree &tree, int begin, int end,
+                      int depth);
+
+    static void search(const Tree &tree, QObject *network,
+                       const QPointF &point, int begin,
+                       int end, int depth, int k,
+                       bool            unlinkedOnly,
+                       QVector<Match> &matches);
+
+    void countLink(const TerminalItem *terminal,
+                   NetworkType type, int delta);
+
+    QHash<QObject *, Tree> m_networks;
+
+    // Linked node count per terminal and network type
+    QHash<const TerminalItem *, QHash<int, int>>
+        m_terminalLinks;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
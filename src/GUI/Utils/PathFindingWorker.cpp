@@ -29,15 +29,24 @@ void PathFindingWorker::process()
     auto &controller = CargoNetSimController::getInstance();
     auto  terminalClient = controller.getTerminalClient();
 
+    // Answer path queries in-process when configured
+    bool useLocalEngine =
+        controller.getConfigController()
+            ->getSimulationParams()
+            .value("local_path_engine", false)
+            .toBool();
+    terminalClient->setLocalEngineEnabled(useLocalEngine);
+
     auto handler = terminalClient->getRabbitMQHandler();
-    if (!handler)
+    if (!useLocalEngine && !handler)
     {
         emit error("RabbitMQ handler not found");
         emit finished();
         return;
     }
-    if (!handler->isConnected()
-        || !handler->hasCommandQueueConsumers())
+    if (!useLocalEngine
+        && (!handler->isConnected()
+            || !handler->hasCommandQueueConsumers()))
     {
         emit error("TerminalSim is not connected");
         emit finished();
@@ -46,24 +55,12 @@ void PathFindingWorker::process()
 
     try
     {
-        // Reset the terminal server to start with a clean
-        // state
-        bool resetSuccess = terminalClient->resetServer();
-        if (!resetSuccess)
-        {
-            emit error("Failed to reset terminal server");
-            emit finished();
-            return;
-        }
-
-        // Configure the server weights
+        // Server weights, sent along with the graph
         auto configurationWeights =
             CargoNetSim::CargoNetSimController::
                 getInstance()
                     .getConfigController()
                     ->getCostFunctionWeights();
-        terminalClient->setCostFunctionParameters(
-            configurationWeights);
 
         // Get the Origin and Destination terminals from
         // the region scene
@@ -145,61 +142,47 @@ void PathFindingWorker::process()
             terminals.append(terminalObj);
         }
 
-        // Add all terminals at once
-        bool terminalsAdded =
-            terminalClient->addTerminals(terminals);
+        // Now collect all route segments
+        QList<Backend::PathSegment *> routes;
+        QSet<QString> processedConnectionIds;
 
-        // Clean up Terminal objects
+        // Process region and global connections to
+        // collect routes
+        bool routesCollected =
+            processConnections(regionConnections, routes,
+                               processedConnectionIds)
+            && processConnections(globalConnections,
+                                  routes,
+                                  processedConnectionIds);
+
+        // Send only what changed since the last run
+        bool graphSynced =
+            routesCollected
+            && terminalClient->syncGraph(
+                terminals, routes, configurationWeights);
+
+        // Clean up Terminal and PathSegment objects
         for (auto terminal : terminals)
         {
             delete terminal;
         }
-
-        if (!terminalsAdded)
-        {
-            emit error(
-                "Failed to add terminals to server.");
-            emit finished();
-            return;
-        }
-
-        // Now collect all route segments for bulk addition
-        QList<Backend::PathSegment *> routes;
-        QSet<QString> processedConnectionIds;
-
-        // Process region connections to collect routes
-        if (!processConnections(regionConnections, routes,
-                                processedConnectionIds))
+        for (auto route : routes)
         {
-            emit error("Failed to process region "
-                       "connection routes.");
-            emit finished();
-            return;
+            delete route;
         }
 
-        // Process global connections to collect routes
-        if (!processConnections(globalConnections, routes,
-                                processedConnectionIds))
+        if (!routesCollected)
         {
-            emit error("Failed to process global "
-                       "connection routes.");
+            emit error("Failed to process connection "
+                       "routes.");
             emit finished();
             return;
         }
 
-        // Add all routes at once
-        bool routesAdded =
-            terminalClient->addRoutes(routes);
-
-        // Clean up PathSegment objects
-        for (auto route : routes)
-        {
-            delete route;
-        }
-
-        if (!routesAdded)
+        if (!graphSynced)
         {
-            emit error("Failed to add routes to server.");
+            emit error("Failed to synchronize the graph "
+                       "with the terminal server.");
             emit finished();
             return;
         }
@@ -1700,6 +1700,7 @@ bool SimulationValidationWorker::runSimulations(
             ""; // This needs to be filled with the correct
                 // path
         config.simTime = 3600.0; // 1 hour simulation time
+        config.network = truckNetwork; // Routes the trips
 
         // Create a truck client for this network
         truckClient->createClient(networkName, config);
@@ -1715,16 +1716,41 @@ bool SimulationValidationWorker::runSimulations(
             continue;
         }
 
-        // Add trips for each truck
+        // Add the trips of all trucks in one batch
+        QList<Backend::TruckClient::TripRequest> trips;
+        trips.reserve(truckDataList.size());
         for (const auto &truckData : truckDataList)
         {
-            // Add a trip
-            QString tripId = client->addTrip(
-                networkName,
-                QString::number(truckData.originNode),
-                QString::number(truckData.destinationNode),
-                truckData.containers);
+            Backend::TruckClient::TripRequest trip;
+            trip.networkName   = networkName;
+            trip.originId      = truckData.originNode;
+            trip.destinationId = truckData.destinationNode;
+            trip.containers    = truckData.containers;
+            trips.append(trip);
         }
+
+        // The trips start as the in-flight window allows;
+        // report once the whole cohort has ended
+        client->addTripsAsync(trips).then(
+            this,
+            [this, networkName](
+                QFuture<Backend::TruckClient::TripResult>
+                    cohort) {
+                int failed = 0;
+                for (const auto &result : cohort.results())
+                {
+                    if (!result.successful)
+                    {
+                        ++failed;
+                    }
+                }
+                emit statusMessage(
+                    QString("Truck trips on network %1 "
+                            "ended (%2 of %3 failed)")
+                        .arg(networkName)
+                        .arg(failed)
+                        .arg(cohort.resultCount()));
+            });
     }
 
     // Run the train simulations
@@ -1997,8 +2023,11 @@ double SimulationValidationWorker::calculateShipSegmentCost(
     double risk              = 0.0;
     int    shipCount         = 0;
 
-    // Get all ship states from the client
-    auto shipStates = shipClient->getAllShipsStates();
+    // Get the latest published ship states without
+    // blocking the client's message handling
+    const auto snapshot =
+        shipClient->getShipStatesSnapshot();
+    const auto &shipStates = *snapshot;
 
     // Find ships for this path segment
     for (auto networkName : shipStates.keys())
@@ -2134,8 +2163,11 @@ SimulationValidationWorker::calculateTrainSegmentCost(
     double risk              = 0.0;
     int    trainCount        = 0;
 
-    // Get all train states from the client
-    auto trainStates = trainClient->getAllTrainsStates();
+    // Get the latest published train states without
+    // blocking the client's message handling
+    const auto snapshot =
+        trainClient->getTrainStatesSnapshot();
+    const auto &trainStates = *snapshot;
 
     // Find trains for this path segment
     for (auto networkName : trainStates.keys())
@@ -0,0 +1,506 @@
+#include "TiledImagePyramid.h"
+#include "ErrorHandlers.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageIOHandler>
+#include <QImageReader>
+#include <QStandardPaths>
+#include <QtMath>
+
+#include <functional>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+namespace
+{
+
+const QString COMPLETE_MARKER = "complete";
+
+// Levels larger than this are decoded in bands when the
+// image format can clip and scale while reading
+constexpr qint64 BAND_READ_MIB = 64;
+
+// Ceiling for decoding a whole level in one piece
+constexpr qint64 MAX_DECODE_MIB = 2048;
+
+QSize halvedSize(QSize size, int times)
+{
+    for (int i = 0; i < times; ++i)
+    {
+        size = QSize((size.width() + 1) / 2,
+                     (size.height() + 1) / 2);
+    }
+    return size;
+}
+
+qint64 imageMiB(const QSize &size)
+{
+    return qint64(size.width()) * size.height() * 4
+               / (1024 * 1024)
+           + 1;
+}
+
+/**
+ * @brief Cuts the source image into tiles on disk
+ *
+ * Large levels of formats that clip while reading (such as
+ * JPEG) are decoded one tile row at a time, so the whole
+ * image is never held in memory. Other formats are decoded
+ * once, with the allocation limit raised to fit.
+ */
+class TileGenerationTask : public SafeRunnable
+{
+public:
+    using Callback = std::function<void(
+        const QImage &, const QString &)>;
+
+    TileGenerationTask(const QString &sourcePath,
+                       const QString &tileDir,
+                       int levelCount, QAtomicInt *stopping,
+                       Callback done)
+        : m_sourcePath(sourcePath)
+        , m_tileDir(tileDir)
+        , m_levelCount(levelCount)
+        , m_stopping(stopping)
+        , m_done(std::move(done))
+    {
+    }
+
+    void runSafe() override
+    {
+        QImageReader probe(m_sourcePath);
+        const QSize  sourceSize = probe.size();
+        const bool   clipping =
+            probe.supportsOption(QImageIOHandler::ClipRect)
+            && probe.supportsOption(
+                QImageIOHandler::ScaledSize);
+
+        QImage image;
+        for (int level = 0; level < m_levelCount; ++level)
+        {
+            QSize size = halvedSize(sourceSize, level);
+            QDir(m_tileDir).mkpath(QString::number(level));
+
+            if (!image.isNull())
+            {
+                image = image.scaled(
+                    size, Qt::IgnoreAspectRatio,
+                    Qt::SmoothTransformation);
+            }
+            else if (clipping
+                     && imageMiB(size) > BAND_READ_MIB)
+            {
+                if (!writeBands(level, sourceSize, size))
+                {
+                    return;
+                }
+                continue;
+            }
+            else
+            {
+                // First level small enough to hold whole
+                image =
+                    readLevel(sourceSize, size, clipping);
+                if (image.isNull())
+                {
+                    return;
+                }
+            }
+
+            if (!writeTiles(level, image, 0))
+            {
+                return;
+            }
+        }
+
+        // Mark the pyramid as complete for later sessions
+        QFile marker(m_tileDir + "/" + COMPLETE_MARKER);
+        if (marker.open(QIODevice::WriteOnly))
+        {
+            marker.write(QByteArray::number(m_levelCount));
+        }
+
+        m_done(image, QString());
+    }
+
+private:
+    /**
+     * @brief Decodes a whole level in one read
+     *
+     * Reports a failure through the callback and returns a
+     * null image when the level cannot be decoded.
+     */
+    QImage readLevel(const QSize &sourceSize,
+                     const QSize &size, bool clipping)
+    {
+        QImageReader reader(m_sourcePath);
+        if (size != sourceSize)
+        {
+            reader.setScaledSize(size);
+        }
+
+        // Without native scaling the full image is decoded
+        qint64 needed =
+            imageMiB(clipping ? size : sourceSize);
+        if (needed > MAX_DECODE_MIB)
+        {
+            m_done(QImage(),
+                   QString("Image %1 is %2x%3 px and needs "
+                           "%4 MiB to decode, more than "
+                           "the %5 MiB limit")
+                       .arg(m_sourcePath)
+                       .arg(sourceSize.width())
+                       .arg(sourceSize.height())
+                       .arg(needed)
+                       .arg(MAX_DECODE_MIB));
+            return QImage();
+        }
+        int limit = QImageReader::allocationLimit();
+        if (limit > 0 && limit < needed)
+        {
+            QImageReader::setAllocationLimit(int(needed));
+        }
+
+        QImage image = reader.read();
+        if (image.isNull())
+        {
+            m_done(QImage(), reader.errorString());
+        }
+        return image;
+    }
+
+    /**
+     * @brief Decodes and tiles a level one tile row at a
+     * time
+     */
+    bool writeBands(int level, const QSize &sourceSize,
+                    const QSize &size)
+    {
+        const int tileSize = TiledImagePyramid::TILE_SIZE;
+        const double scale =
+            double(sourceSize.height()) / size.height();
+
+        int rows =
+            (size.height() + tileSize - 1) / tileSize;
+        for (int row = 0; row < rows; ++row)
+        {
+            int top    = row * tileSize;
+            int height =
+                qMin(tileSize, size.height() - top);
+            int sourceTop = qFloor(top * scale);
+            int sourceBottom =
+                qMin(sourceSize.height(),
+                     qCeil((top + height) * scale));
+
+            QImageReader reader(m_sourcePath);
+            reader.setClipRect(
+                QRect(0, sourceTop, sourceSize.width(),
+                      sourceBottom - sourceTop));
+            if (size != sourceSize)
+            {
+                reader.setScaledSize(
+                    QSize(size.width(), height));
+            }
+
+            QImage band = reader.read();
+            if (band.isNull())
+            {
+                m_done(QImage(), reader.errorString());
+                return false;
+            }
+            if (!writeTiles(level, band, row))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Cuts an image into tiles starting at a row
+     * @return False if stopped or a tile cannot be written
+     */
+    bool writeTiles(int level, const QImage &image,
+                    int firstRow)
+    {
+        const int tileSize = TiledImagePyramid::TILE_SIZE;
+
+        int columns =
+            (image.width() + tileSize - 1) / tileSize;
+        int rows =
+            (image.height() + tileSize - 1) / tileSize;
+        for (int y = 0; y < rows; ++y)
+        {
+            for (int x = 0; x < columns; ++x)
+            {
+                if (m_stopping->loadRelaxed())
+                {
+                    return false;
+                }
+
+                QRect rect(x * tileSize, y * tileSize,
+                           tileSize, tileSize);
+                rect = rect.intersected(image.rect());
+                QString path = QString("%1/%2/%3_%4.png")
+                                   .arg(m_tileDir)
+                                   .arg(level)
+                                   .arg(x)
+                                   .arg(firstRow + y);
+                if (!image.copy(rect).save(path, "PNG"))
+                {
+                    m_done(QImage(),
+                           QString("Cannot write tile %1")
+                               .arg(path));
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    QString     m_sourcePath;
+    QString     m_tileDir;
+    int         m_levelCount;
+    QAtomicInt *m_stopping;
+    Callback    m_done;
+};
+
+/**
+ * @brief Reads one tile from the disk cache
+ */
+class TileLoadTask : public SafeRunnable
+{
+public:
+    using Callback = std::function<void(const QImage &)>;
+
+    TileLoadTask(const QString &path, QAtomicInt *epoch,
+                 Callback done)
+        : m_path(path)
+        , m_epoch(epoch)
+        , m_startEpoch(epoch->loadRelaxed())
+        , m_done(std::move(done))
+    {
+    }
+
+    void runSafe() override
+    {
+        // Skip loads cancelled while queued
+        if (m_epoch->loadRelaxed() != m_startEpoch)
+        {
+            m_done(QImage());
+            return;
+        }
+        m_done(QImage(m_path));
+    }
+
+private:
+    QString     m_path;
+    QAtomicInt *m_epoch;
+    int         m_startEpoch;
+    Callback    m_done;
+};
+
+} // namespace
+
+TiledImagePyramid::TiledImagePyramid(
+    const QString &sourcePath, QObject *parent)
+    : QObject(parent)
+    , m_sourcePath(sourcePath)
+{
+    m_tiles.setMaxCost(CACHE_KIB);
+    m_pool.setMaxThreadCount(2);
+
+    QFileInfo info(sourcePath);
+    m_imageSize = QImageReader(sourcePath).size();
+    if (!info.exists() || m_imageSize.isEmpty())
+    {
+        qWarning() << "Cannot read background image"
+                   << sourcePath;
+        return;
+    }
+
+    m_levelCount = 1;
+    QSize size   = m_imageSize;
+    while (qMax(size.width(), size.height()) > TILE_SIZE)
+    {
+        size = halvedSize(size, 1);
+        ++m_levelCount;
+    }
+
+    // Tiles are reused while the source file is unchanged
+    QString source =
+        QString("%1|%2|%3")
+            .arg(info.absoluteFilePath())
+            .arg(info.size())
+            .arg(info.lastModified().toMSecsSinceEpoch());
+    QByteArray key =
+        QCryptographicHash::hash(source.toUtf8(),
+                                 QCryptographicHash::Sha1)
+            .toHex();
+    m_cacheRoot = QStandardPaths::writableLocation(
+                      QStandardPaths::CacheLocation)
+                  + "/background_tiles";
+    m_cacheDir =
+        m_cacheRoot + "/" + QString::fromLatin1(key);
+
+    if (QFile::exists(m_cacheDir + "/" + COMPLETE_MARKER))
+    {
+        m_tileDir = m_cacheDir;
+        QImage top(tilePath(m_levelCount - 1, 0, 0));
+        if (!top.isNull())
+        {
+            m_overview = QPixmap::fromImage(top);
+            m_ready    = true;
+            return;
+        }
+    }
+
+    startGeneration();
+}
+
+TiledImagePyramid::~TiledImagePyramid()
+{
+    m_stopping.storeRelaxed(1);
+    m_loadEpoch.fetchAndAddRelaxed(1);
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QSize TiledImagePyramid::levelSize(int level) const
+{
+    return halvedSize(m_imageSize, level);
+}
+
+QPixmap TiledImagePyramid::tile(int level, int x, int y)
+{
+    TileKey key{level, x, y};
+    if (QPixmap *cached = m_tiles.object(key))
+    {
+        return *cached;
+    }
+    if (!m_ready || level < 0 || level >= m_levelCount
+        || m_pending.contains(key))
+    {
+        return QPixmap();
+    }
+
+    m_pending.insert(key);
+    m_pool.start(new TileLoadTask(
+        tilePath(level, x, y), &m_loadEpoch,
+        [this, key](const QImage &image) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, key, image]() {
+                    onTileLoaded(key, image);
+                },
+                Qt::QueuedConnection);
+        }));
+    return QPixmap();
+}
+
+void TiledImagePyramid::cancelPendingLoads()
+{
+    m_loadEpoch.fetchAndAddRelaxed(1);
+    m_pending.clear();
+}
+
+QString TiledImagePyramid::tilePath(int level, int x,
+                                    int y) const
+{
+    return QString("%1/%2/%3_%4.png")
+        .arg(m_tileDir)
+        .arg(level)
+        .arg(x)
+        .arg(y);
+}
+
+void TiledImagePyramid::startGeneration()
+{
+    // Build in a private directory so concurrent pyramids
+    // of the same image never touch each other's tiles
+    QDir().mkpath(m_cacheRoot);
+    m_buildDir = std::make_unique<QTemporaryDir>(
+        m_cacheDir + "-XXXXXX");
+    if (!m_buildDir->isValid())
+    {
+        qWarning() << "Cannot create a tile directory under"
+                   << m_cacheRoot << ":"
+                   << m_buildDir->errorString();
+        m_buildDir.reset();
+        return;
+    }
+    m_tileDir = m_buildDir->path();
+
+    m_pool.start(new TileGenerationTask(
+        m_sourcePath, m_tileDir, m_levelCount, &m_stopping,
+        [this](const QImage &overview,
+               const QString &error) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, overview, error]() {
+                    onGenerated(overview, error);
+                },
+                Qt::QueuedConnection);
+        }));
+}
+
+void TiledImagePyramid::onGenerated(const QImage  &overview,
+                                    const QString &error)
+{
+    if (overview.isNull())
+    {
+        qWarning() << "Background tile generation failed:"
+                   << error;
+        m_buildDir.reset();
+        emit failed(error);
+        return;
+    }
+
+    // Publish the tiles under the cache key for later
+    // sessions; if another pyramid published first, use
+    // its tiles and drop ours
+    if (QDir().rename(m_tileDir, m_cacheDir))
+    {
+        m_buildDir->setAutoRemove(false);
+        m_buildDir.reset();
+        m_tileDir = m_cacheDir;
+    }
+    else if (QFile::exists(m_cacheDir + "/"
+                           + COMPLETE_MARKER))
+    {
+        m_buildDir.reset();
+        m_tileDir = m_cacheDir;
+    }
+
+    m_overview = QPixmap::fromImage(overview);
+    m_ready    = true;
+    emit ready();
+}
+
+void TiledImagePyramid::onTileLoaded(const TileKey &key,
+                                     const QImage  &image)
+{
+    m_pending.remove(key);
+    if (image.isNull())
+    {
+        return;
+    }
+
+    // Pixmaps must be created on the GUI thread
+    QPixmap *pixmap =
+        new QPixmap(QPixmap::fromImage(image));
+    int cost = qMax(
+        1, pixmap->width() * pixmap->height() * 4 / 1024);
+    m_tiles.insert(key, pixmap, cost);
+    emit tileLoaded(key.level, key.x, key.y);
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <memory>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+/**
+ * @brief Tiled multi-resolution copy of a large image
+ *
+ * The source image is cut once into 256 px PNG tiles at
+ * every power-of-two downscale (level 0 is full
+ * resolution, the top level fits in a single tile). Tiles
+ * are written to a disk cache keyed by the source path,
+ * size and modification time, so reopening the same image
+ * reuses them. Each pyramid builds its tiles in a private
+ * directory under the cache root and moves it under the
+ * key once complete; only that private directory is ever
+ * deleted.
+ *
+ * Generation and tile loading run on a private thread
+ * pool. Loaded tiles are kept in an LRU pixmap cache and
+ * tileLoaded() is emitted so the owning item can repaint.
+ * The top level is kept in memory as an overview for
+ * areas whose tiles are not loaded yet.
+ */
+class TiledImagePyramid : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int TILE_SIZE = 256;
+
+    /**
+     * @brief Opens an image and starts building its tiles
+     *
+     * Only the image header is read here; decoding and
+     * tiling run on a worker thread.
+     *
+     * @param sourcePath Path of the source image
+     * @param parent Optional parent object
+     */
+    explicit TiledImagePyramid(const QString &sourcePath,
+                               QObject *parent = nullptr);
+
+    /**
+     * @brief Waits for running workers before destruction
+     */
+    ~TiledImagePyramid() override;
+
+    /**
+     * @brief Checks whether the source image is readable
+     */
+    bool isValid() const
+    {
+        return !m_imageSize.isEmpty();
+    }
+
+    /**
+     * @brief Checks whether all tiles are on disk
+     */
+    bool isReady() const
+    {
+        return m_ready;
+    }
+
+    QString sourcePath() const
+    {
+        return m_sourcePath;
+    }
+
+    /**
+     * @brief Gets the full resolution image size
+     */
+    QSize imageSize() const
+    {
+        return m_imageSize;
+    }
+
+    /**
+     * @brief Gets the number of levels in the pyramid
+     */
+    int levelCount() const
+    {
+        return m_levelCount;
+    }
+
+    /**
+     * @brief Gets the image size at a level
+     */
+    QSize levelSize(int level) const;
+
+    /**
+     * @brief Gets the whole image at the top level
+     * @return A null pixmap until generation has finished
+     */
+    QPixmap overview() const
+    {
+        return m_overview;
+    }
+
+    /**
+     * @brief Gets a tile, loading it if not cached
+     *
+     * A missing tile is queued for loading and tileLoaded()
+     * is emitted when it becomes available.
+     *
+     * @param level Pyramid level
+     * @param x Tile column
+     * @param y Tile row
+     * @return The tile, or a null pixmap if not loaded yet
+     */
+    QPixmap tile(int level, int x, int y);
+
+    /**
+     * @brief Drops queued loads that have not started
+     *
+     * Called when the view changes so only tiles that are
+     * still visible get loaded.
+     */
+    void cancelPendingLoads();
+
+signals:
+    /**
+     * @brief Signal emitted when all tiles are on disk
+     */
+    void ready();
+
+    /**
+     * @brief Signal emitted when a requested tile is cached
+     */
+    void tileLoaded(int level, int x, int y);
+
+    /**
+     * @brief Signal emitted when tile generation fails
+     */
+    void failed(const QString &message);
+
+private:
+    struct TileKey
+    {
+        int level;
+        int x;
+        int y;
+
+        bool operator==(const TileKey &other) const
+        {
+            return level == other.level && x == other.x
+                   && y == other.y;
+        }
+    };
+
+    friend size_t qHash(const TileKey &key,
+                        size_t         seed = 0)
+    {
+        return qHashMulti(seed, key.level, key.x, key.y);
+    }
+
+    // Tile cache budget in KiB
+    static constexpr int CACHE_KIB = 96 * 1024;
+
+    QString tilePath(int level, int x, int y) const;
+
+    void startGeneration();
+
+    void onGenerated(const QImage  &overview,
+                     const QString &error);
+
+    void onTileLoaded(const TileKey &key,
+                      const QImage  &image);
+
+    QString m_sourcePath;
+    QString m_cacheRoot;
+    QString m_cacheDir;
+    // Directory tiles are read from
+    QString m_tileDir;
+    QSize   m_imageSize;
+    int     m_levelCount = 0;
+    bool    m_ready      = false;
+    QPixmap m_overview;
+
+    // Private build directory, removed with the pyramid
+    std::unique_ptr<QTemporaryDir> m_buildDir;
+
+    QCache<TileKey, QPixmap> m_tiles;
+    QSet<TileKey>            m_pending;
+
+    // Raised to stop generation and skip queued loads
+    QAtomicInt m_stopping;
+    QAtomicInt m_loadEpoch;
+
+    QThreadPool m_pool;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
@@ -0,0 +1,209 @@
+#include "GraphicsItemRegistry.h"
+#include "GUI/Items/GraphicsObjectBase.h"
+#include "GUI/Items/MapLine.h"
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+void GraphicsItemRegistry::Bucket::insert(
+    QGraphicsItem *item)
+{
+    if (m_positions.contains(item))
+    {
+        return;
+    }
+    m_positions.insert(item, m_items.size());
+    m_items.append(item);
+}
+
+void GraphicsItemRegistry::Bucket::remove(
+    QGraphicsItem *item)
+{
+    auto it = m_positions.find(item);
+    if (it == m_positions.end())
+    {
+        return;
+    }
+
+    // Fill the gap with the last item
+    qsizetype      position = it.value();
+    QGraphicsItem *last     = m_items.last();
+    m_items[position]       = last;
+    m_positions[last]       = position;
+    m_items.removeLast();
+    m_positions.remove(item);
+}
+
+void GraphicsItemRegistry::insert(const QString &typeKey,
+                                  const QString &id,
+                                  GraphicsObjectBase *item)
+{
+    if (!item)
+    {
+        return;
+    }
+
+    if (QGraphicsItem *previous = this->item(typeKey, id))
+    {
+        remove(previous);
+    }
+    remove(item);
+
+    Entry entry;
+    entry.typeKey = typeKey;
+    entry.id      = id;
+    entry.region  = item->getRegion();
+    entry.network = item->getReferenceNetwork();
+    if (MapLine *line = qobject_cast<MapLine *>(item))
+    {
+        entry.linkID = line->getReferencedNetworkLinkID();
+    }
+
+    m_byId[typeKey].insert(id, item);
+    m_byType[typeKey].insert(item);
+    m_byRegion[bucketKey(typeKey, entry.region)].insert(
+        item);
+    if (entry.network)
+    {
+        m_byNetwork[bucketKey(typeKey, entry.network)]
+            .insert(item);
+        if (!entry.linkID.isEmpty())
+        {
+            m_byLink.insert(
+                linkKey(entry.network, entry.linkID), item);
+        }
+    }
+    m_entries.insert(item, entry);
+}
+
+QGraphicsItem *
+GraphicsItemRegistry::take(const QString &typeKey,
+                           const QString &id)
+{
+    QGraphicsItem *found = item(typeKey, id);
+    remove(found);
+    return found;
+}
+
+void GraphicsItemRegistry::remove(QGraphicsItem *item)
+{
+    auto it = m_entries.find(item);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+
+    const Entry &entry = it.value();
+    m_byId[entry.typeKey].remove(entry.id);
+    m_byType[entry.typeKey].remove(item);
+    m_byRegion[bucketKey(entry.typeKey, entry.region)]
+        .remove(item);
+    if (entry.network)
+    {
+        m_byNetwork[bucketKey(entry.typeKey, entry.network)]
+            .remove(item);
+        QString key = linkKey(entry.network, entry.linkID);
+        if (m_byLink.value(key) == item)
+        {
+            m_byLink.remove(key);
+        }
+    }
+    m_entries.erase(it);
+}
+
+bool GraphicsItemRegistry::refresh(GraphicsObjectBase *item)
+{
+    auto it = m_entries.constFind(item);
+    if (it == m_entries.constEnd())
+    {
+        return false;
+    }
+
+    // Re-register under the same type and ID
+    QString typeKey = it->typeKey;
+    QString id      = it->id;
+    QString region  = it->region;
+    remove(item);
+    insert(typeKey, id, item);
+    return m_entries.value(item).region != region;
+}
+
+QGraphicsItem *
+GraphicsItemRegistry::item(const QString &typeKey,
+                           const QString &id) const
+{
+    auto typeIt = m_byId.constFind(typeKey);
+    if (typeIt == m_byId.constEnd())
+    {
+        return nullptr;
+    }
+    return typeIt->value(id, nullptr);
+}
+
+const QList<QGraphicsItem *> &
+GraphicsItemRegistry::itemsOfType(
+    const QString &typeKey) const
+{
+    return bucketItems(m_byType, typeKey);
+}
+
+const QList<QGraphicsItem *> &
+GraphicsItemRegistry::itemsInRegion(
+    const QString &typeKey, const QString &region) const
+{
+    return bucketItems(m_byRegion,
+                       bucketKey(typeKey, region));
+}
+
+const QList<QGraphicsItem *> &
+GraphicsItemRegistry::itemsOfNetwork(
+    const QString &typeKey, QObject *network) const
+{
+    return bucketItems(m_byNetwork,
+                       bucketKey(typeKey, network));
+}
+
+QGraphicsItem *
+GraphicsItemRegistry::itemForLink(
+    QObject *network, const QString &linkID) const
+{
+    return m_byLink.value(linkKey(network, linkID),
+                          nullptr);
+}
+
+QString
+GraphicsItemRegistry::bucketKey(const QString &typeKey,
+                                const QString &region)
+{
+    return typeKey + QLatin1Char('|') + region;
+}
+
+QString
+GraphicsItemRegistry::bucketKey(const QString &typeKey,
+                                QObject       *network)
+{
+    return typeKey + QLatin1Char('#')
+           + QString::number(quintptr(network), 16);
+}
+
+QString GraphicsItemRegistry::linkKey(QObject *network,
+                                      const QString &linkID)
+{
+    return QString::number(quintptr(network), 16)
+           + QLatin1Char('#') + linkID;
+}
+
+const QList<QGraphicsItem *> &
+GraphicsItemRegistry::bucketItems(
+    const QHash<QString, Bucket> &buckets,
+    const QString                &key) const
+{
+    auto it = buckets.constFind(key);
+    return it == buckets.constEnd() ? m_empty
+                                    : it->items();
+}
+
+} // namespace GUI
+} // namespace CargoNetSim
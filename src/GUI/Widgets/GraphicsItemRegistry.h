@@ -0,0 +1,221 @@
+#pragma once
+
+#include <QGraphicsItem>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+namespace CargoNetSim
+{
+namespace GUI
+{
+
+class GraphicsObjectBase;
+
+/**
+ * @brief Typed, read-only view over registered items
+ *
+ * A view refers to a registry list directly instead of
+ * copying it. It is invalidated when items of the viewed
+ * type are added, removed or change region, so it must not
+ * be kept across those calls.
+ */
+template <typename T> class GraphicsItemView
+{
+public:
+    class const_iterator
+    {
+    public:
+        explicit const_iterator(
+            QList<QGraphicsItem *>::const_iterator it)
+            : m_it(it)
+        {
+        }
+
+        T *operator*() const
+        {
+            return static_cast<T *>(*m_it);
+        }
+
+        const_iterator &operator++()
+        {
+            ++m_it;
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return m_it == other.m_it;
+        }
+
+        bool operator!=(const const_iterator &other) const
+        {
+            return m_it != other.m_it;
+        }
+
+    private:
+        QList<QGraphicsItem *>::const_iterator m_it;
+    };
+
+    explicit GraphicsItemView(
+        const QList<QGraphicsItem *> &items)
+        : m_items(&items)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_items->cbegin());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_items->cend());
+    }
+
+    qsizetype size() const
+    {
+        return m_items->size();
+    }
+
+    bool isEmpty() const
+    {
+        return m_items->isEmpty();
+    }
+
+    /**
+     * @brief Copies the view, for callers that change the
+     * registry while iterating
+     */
+    QList<T *> toList() const
+    {
+        QList<T *> result;
+        result.reserve(m_items->size());
+        for (QGraphicsItem *item : *m_items)
+        {
+            result.append(static_cast<T *>(item));
+        }
+        return result;
+    }
+
+private:
+    const QList<QGraphicsItem *> *m_items;
+};
+
+/**
+ * @brief Index of the items registered with a
+ * GraphicsScene
+ *
+ * Items are keyed by their dynamic type name and ID, and
+ * additionally bucketed by region, by reference network
+ * and, for map lines, by referenced network link ID. All
+ * lookups are hash lookups and bucket removal swaps in the
+ * last element, so no operation scans every item.
+ */
+class GraphicsItemRegistry
+{
+public:
+    /**
+     * @brief Registers an item, replacing any item with the
+     * same type and ID
+     */
+    void insert(const QString &typeKey, const QString &id,
+                GraphicsObjectBase *item);
+
+    /**
+     * @brief Unregisters an item by type and ID
+     * @return The item, or nullptr if not registered
+     */
+    QGraphicsItem *take(const QString &typeKey,
+                        const QString &id);
+
+    /**
+     * @brief Unregisters an item by pointer
+     */
+    void remove(QGraphicsItem *item);
+
+    /**
+     * @brief Moves an item to the buckets of its current
+     * region and reference network
+     * @return True if the item's region changed
+     */
+    bool refresh(GraphicsObjectBase *item);
+
+    QGraphicsItem *item(const QString &typeKey,
+                        const QString &id) const;
+
+    const QList<QGraphicsItem *> &
+    itemsOfType(const QString &typeKey) const;
+
+    const QList<QGraphicsItem *> &
+    itemsInRegion(const QString &typeKey,
+                  const QString &region) const;
+
+    const QList<QGraphicsItem *> &
+    itemsOfNetwork(const QString &typeKey,
+                   QObject       *network) const;
+
+    /**
+     * @brief Finds the map line drawn for a network link
+     * @param network The reference network
+     * @param linkID The link ID in the network
+     */
+    QGraphicsItem *itemForLink(QObject       *network,
+                               const QString &linkID) const;
+
+private:
+    /**
+     * @brief Unordered item list with O(1) removal
+     */
+    class Bucket
+    {
+    public:
+        void insert(QGraphicsItem *item);
+        void remove(QGraphicsItem *item);
+
+        const QList<QGraphicsItem *> &items() const
+        {
+            return m_items;
+        }
+
+    private:
+        QList<QGraphicsItem *>            m_items;
+        QHash<QGraphicsItem *, qsizetype> m_positions;
+    };
+
+    struct Entry
+    {
+        QString  typeKey;
+        QString  id;
+        QString  region;
+        QObject *network = nullptr;
+        QString  linkID;
+    };
+
+    static QString bucketKey(const QString &typeKey,
+                             const QString &region);
+
+    static QString bucketKey(const QString &typeKey,
+                             QObject       *network);
+
+    static QString linkKey(QObject       *network,
+                           const QString &linkID);
+
+    const QList<QGraphicsItem *> &
+    bucketItems(const QHash<QString, Bucket> &buckets,
+                const QString                &key) const;
+
+    QHash<QString, QHash<QString, QGraphicsItem *>>
+                                    m_byId;
+    QHash<QString, Bucket>          m_byType;
+    QHash<QString, Bucket>          m_byRegion;
+    QHash<QString, Bucket>          m_byNetwork;
+    QHash<QString, QGraphicsItem *> m_byLink;
+    QHash<QGraphicsItem *, Entry>   m_entries;
+
+    const QList<QGraphicsItem *> m_empty;
+};
+
+} // namespace GUI
+} // namespace CargoNetSim
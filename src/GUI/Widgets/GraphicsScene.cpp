@@ -11,6 +11,9 @@
 #include "../Items/ConnectionLine.h"
 #include "../Items/DistanceMeasurementTool.h"
 #include "../Items/GlobalTerminalItem.h"
+#include "../Items/MapLine.h"
+#include "../Items/MapPoint.h"
+#include "../Items/PathHighlightItem.h"
 #include "../Items/TerminalItem.h"
 #include "../MainWindow.h"
 #include "Backend/Controllers/CargoNetSimController.h"
@@ -34,6 +37,13 @@ GraphicsScene::GraphicsScene(QObject *parent)
 {
 }
 
+GraphicsScene::~GraphicsScene()
+{
+    // Items deleted by QGraphicsScene must not reach the
+    // registry, which is already destroyed by then
+    QObject::disconnect(nullptr, nullptr, this, nullptr);
+}
+
 void GraphicsScene::addItemWithId(GraphicsObjectBase *item,
                                   const QString      &id)
 {
@@ -44,18 +54,73 @@ void GraphicsScene::addItemWithId(GraphicsObjectBase *item,
     // Take ownership
     item->setParent(this);
 
-    // Get the class key and store in type map
-    QString className = QString(typeid(*item).name());
+    // Register under the dynamic class name
+    m_registry.insert(QString(typeid(*item).name()), id,
+                      item);
+
+    // Items of other regions start hidden
+    QString region = item->getRegion();
+    if (!m_shownRegion.isNull() && !region.isEmpty()
+        && region != m_shownRegion)
+    {
+        item->setVisible(false);
+    }
+
+    // Items deleted elsewhere leave the registry too
+    QGraphicsItem *graphicsItem = item;
+    connect(item, &QObject::destroyed, this,
+            [this, graphicsItem]() {
+                m_registry.remove(graphicsItem);
+                ++m_itemGeneration;
+            });
+
+    // Moved or relinked points change the clusters
+    if (MapPoint *point = qobject_cast<MapPoint *>(item))
+    {
+        connect(point, &MapPoint::positionChanged, this,
+                [this]() { ++m_itemGeneration; });
+        connect(point, &MapPoint::terminalChanged, this,
+                [this]() { ++m_itemGeneration; });
+    }
+    ++m_itemGeneration;
+}
+
+MapLine *GraphicsScene::getMapLineForLink(
+    QObject *network, const QString &linkID) const
+{
+    return static_cast<MapLine *>(
+        m_registry.itemForLink(network, linkID));
+}
+
+PathHighlightItem *GraphicsScene::getPathHighlight()
+{
+    // clear() deletes the layer along with the other items
+    if (!m_pathHighlight)
+    {
+        m_pathHighlight = new PathHighlightItem();
+        addItem(m_pathHighlight);
+    }
+    return m_pathHighlight;
+}
 
-    // Initialize the inner map if needed
-    if (!itemsByType.contains(className))
+void GraphicsScene::updateItemRegistration(
+    GraphicsObjectBase *item)
+{
+    if (m_registry.refresh(item))
     {
-        itemsByType[className] =
-            QMap<QString, QGraphicsItem *>();
+        applyRegionVisibility(item);
     }
+    ++m_itemGeneration;
+}
 
-    // Add to type-specific map
-    itemsByType[className][id] = item;
+void GraphicsScene::applyRegionVisibility(
+    GraphicsObjectBase *item)
+{
+    QString region = item->getRegion();
+    if (!m_shownRegion.isNull() && !region.isEmpty())
+    {
+        item->setVisible(region == m_shownRegion);
+    }
 }
 
 void GraphicsScene::mousePressEvent(
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "GUI/Items/GraphicsObjectBase.h"
+#include "GUI/Utils/NetworkPointIndex.h"
+#include "GraphicsItemRegistry.h"
 #include <QGraphicsScene>
 #include <QPointF>
+#include <QPointer>
 #include <QVariant>
 
 namespace CargoNetSim
@@ -14,6 +17,8 @@ namespace GUI
 class TerminalItem;
 class ConnectionLine;
 class DistanceMeasurementTool;
+class MapLine;
+class PathHighlightItem;
 
 /**
  * @brief Custom graphics scene for the CargoNetSim
@@ -34,68 +39,121 @@ public:
      */
     explicit GraphicsScene(QObject *parent = nullptr);
 
+    /**
+     * @brief Destructor, stops registry updates before the
+     * base class deletes the items
+     */
+    ~GraphicsScene() override;
+
     void addItemWithId(GraphicsObjectBase *item,
                        const QString      &id);
 
     // Get item by type and ID
     template <typename T> T *getItemById(const QString &id)
     {
-        // Get the class key
-        QString className = QString(typeid(T).name());
-
-        // Check if this type and ID exist
-        if (itemsByType.contains(className)
-            && itemsByType[className].contains(id))
-        {
-            // Return the item if it's of the correct type
-            return qgraphicsitem_cast<T *>(
-                itemsByType[className][id]);
-        }
-        return nullptr;
+        return static_cast<T *>(
+            m_registry.item(typeKey<T>(), id));
     }
 
     // Get all items of a specific type
     template <typename T> QList<T *> getItemsByType()
     {
-        QList<T *> result;
-        QString    className = QString(typeid(T).name());
+        return itemsOfType<T>().toList();
+    }
 
-        // Check if this type exists
-        if (itemsByType.contains(className))
-        {
-            // Iterate through all items of this type and
-            // them to result
-            for (auto item :
-                 itemsByType[className].values())
-            {
-                // Check if the item is of the correct type
-                T *typedItem =
-                    qgraphicsitem_cast<T *>(item);
-                if (typedItem)
-                {
-                    // Append to the result list
-                    result.append(typedItem);
-                }
-            }
-        }
-        return result;
+    /**
+     * @brief Views the items of a type without copying
+     *
+     * The view must not be kept across adding or removing
+     * items; use getItemsByType() to modify the scene while
+     * iterating.
+     */
+    template <typename T>
+    GraphicsItemView<T> itemsOfType() const
+    {
+        return GraphicsItemView<T>(
+            m_registry.itemsOfType(typeKey<T>()));
+    }
+
+    /**
+     * @brief Views the items of a type in a region
+     */
+    template <typename T>
+    GraphicsItemView<T>
+    itemsInRegion(const QString &region) const
+    {
+        return GraphicsItemView<T>(m_registry.itemsInRegion(
+            typeKey<T>(), region));
+    }
+
+    /**
+     * @brief Views the items of a type drawn from a network
+     */
+    template <typename T>
+    GraphicsItemView<T>
+    itemsOfNetwork(QObject *network) const
+    {
+        return GraphicsItemView<T>(
+            m_registry.itemsOfNetwork(typeKey<T>(),
+                                      network));
+    }
+
+    /**
+     * @brief Finds the map line drawn for a network link
+     * @return The line, or nullptr if the link has none
+     */
+    MapLine *getMapLineForLink(QObject       *network,
+                               const QString &linkID) const;
+
+    /**
+     * @brief Re-files an item whose region or reference
+     * network changed
+     *
+     * An item moved to another region is shown or hidden
+     * according to the shown region.
+     */
+    void updateItemRegistration(GraphicsObjectBase *item);
+
+    /**
+     * @brief Sets the region whose items are visible
+     *
+     * Items registered later outside this region start
+     * hidden.
+     */
+    void setShownRegion(const QString &region)
+    {
+        m_shownRegion = region;
+    }
+
+    QString getShownRegion() const
+    {
+        return m_shownRegion;
+    }
+
+    /**
+     * @brief Counts item additions, removals, re-filings
+     * and map point moves
+     *
+     * Views compare it with the value they last built point
+     * clusters for to tell whether the clusters are stale.
+     */
+    quint64 getItemGeneration() const
+    {
+        return m_itemGeneration;
     }
 
     // Handle item removal
     template <typename T>
     bool removeItemWithId(const QString &id)
     {
-        QString className = QString(typeid(T).name());
-
-        // Check if this type and ID exist
-        if (!itemsByType.contains(className)
-            || !itemsByType[className].contains(id))
+        // Unregister the item
+        QGraphicsItem *item =
+            m_registry.take(typeKey<T>(), id);
+        if (!item)
         {
             return false;
         }
-
-        // Get the item
-        QGraphicsItem *item = itemsByType[className][id];
+        ++m_itemGeneration;
 
         // Disconnect all signals from this item to prevent
         // callback errors
@@ -104,9 +162,6 @@ public:
             QObject::disconnect(obj);
         }
 
-        // Remove from type map
-        itemsByType[className].remove(id);
-
         // Remove from scene
         QGraphicsScene::removeItem(item);
 
@@ -117,6 +172,21 @@ public:
         return true;
     }
 
+    /**
+     * @brief Gets the nearest-node index of the networks
+     * drawn in this scene
+     */
+    NetworkPointIndex &getNetworkPointIndex()
+    {
+        return m_networkPointIndex;
+    }
+
+    /**
+     * @brief Gets the layer that draws flash highlights,
+     * creating it on first use
+     */
+    PathHighlightItem *getPathHighlight();
+
     bool isInConnectMode()
     {
         return m_connectMode;
@@ -189,10 +259,28 @@ protected:
     void keyPressEvent(QKeyEvent *event) override;
 
 private:
-    // Nested map structure: outer key is class name, inner
-    // key is item ID
-    QMap<QString, QMap<QString, QGraphicsItem *>>
-        itemsByType;
+    /** Shows a regional item only in the shown region */
+    void applyRegionVisibility(GraphicsObjectBase *item);
+
+    template <typename T> static QString typeKey()
+    {
+        return QString(typeid(T).name());
+    }
+
+    // Items by class name, ID, region, network and link
+    GraphicsItemRegistry m_registry;
+
+    // Region shown by the view, null until first set
+    QString m_shownRegion;
+
+    // Bumped whenever the registered items change
+    quint64 m_itemGeneration = 0;
+
+    // Network nodes for nearest point queries
+    NetworkPointIndex m_networkPointIndex;
+
+    // Shared flash layer, deleted with the scene items
+    QPointer<PathHighlightItem> m_pathHighlight;
 
     // Mode flags
     bool m_connectMode; ///< Flag indicating if connection
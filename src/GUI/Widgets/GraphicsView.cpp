@@ -2,10 +2,15 @@
 
 #include <QApplication>
 #include <QDrag>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QListWidget>
+#include <QLoggingCategory>
 #include <QMimeData>
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
+#include <QPair>
 #include <QScrollBar>
 #include <QStatusBar>
 #include <QWheelEvent>
@@ -14,16 +19,28 @@
 
 #include "../Controllers/ViewController.h"
 #include "../Items/DistanceMeasurementTool.h"
+#include "../Items/MapPoint.h"
 #include "../Items/TerminalItem.h"
 #include "../MainWindow.h"
 #include "Backend/Controllers/CargoNetSimController.h"
 #include "GUI/Widgets/GraphicsScene.h"
 
+#ifdef CARGONET_HAS_OPENGL
+#include <QOpenGLContext>
+#include <QOpenGLWidget>
+#include <QSurfaceFormat>
+#endif
+
 namespace CargoNetSim
 {
 namespace GUI
 {
 
+// Frame times of pans and zooms, enabled with
+// QT_LOGGING_RULES="cargonetsim.rendering.debug=true"
+Q_LOGGING_CATEGORY(lcRendering, "cargonetsim.rendering",
+                   QtWarningMsg)
+
 GraphicsView::GraphicsView(QGraphicsScene *scene,
                            QWidget        *parent)
     : QGraphicsView(scene, parent)
@@ -41,6 +58,13 @@ GraphicsView::GraphicsView(QGraphicsScene *scene,
     , _maxLon(180.0)
     , _minLat(-90.0)
     , _maxLat(90.0)
+    , _interactionTimer(nullptr)
+    , _interacting(false)
+    , _clusterScale(0.0)
+    , _clusterGeneration(0)
+    , _openGL(false)
+    , _interactionPaintNs(0)
+    , _interactionFrames(0)
 {
     // Set up drag mode for left mouse
     setDragMode(QGraphicsView::RubberBandDrag);
@@ -53,7 +77,14 @@ GraphicsView::GraphicsView(QGraphicsScene *scene,
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setRenderHint(QPainter::Antialiasing);
     setViewportUpdateMode(
-        QGraphicsView::FullViewportUpdate);
+        QGraphicsView::SmartViewportUpdate);
+
+    // End pan and zoom interactions once input stops
+    _interactionTimer = new QTimer(this);
+    _interactionTimer->setSingleShot(true);
+    _interactionTimer->setInterval(INTERACTION_SETTLE_MS);
+    connect(_interactionTimer, &QTimer::timeout, this,
+            &GraphicsView::endInteraction);
 
     // Enable mouse tracking for coordinate display
     setMouseTracking(true);
@@ -92,7 +123,7 @@ GraphicsView::~GraphicsView()
     delete _coordinateLabel;
 }
 
-double GraphicsView::latToMercator(double lat) const
+double GraphicsView::latToMercator(double lat)
 {
     // Standard Web Mercator formula
     // Convert latitude to Mercator Y coordinate, avoiding
@@ -104,7 +135,7 @@ double GraphicsView::latToMercator(double lat) const
     return std::log(std::tan(M_PI / 4 + latRad / 2));
 }
 
-double GraphicsView::mercatorToLat(double mercatorY) const
+double GraphicsView::mercatorToLat(double mercatorY)
 {
     // Standard inverse Web Mercator formula
     // Clamp mercator_y to avoid math domain errors
@@ -117,7 +148,7 @@ double GraphicsView::mercatorToLat(double mercatorY) const
 }
 
 QPointF
-GraphicsView::sceneToWGS84(const QPointF &scenePos) const
+GraphicsView::sceneToWGS84(const QPointF &scenePos)
 {
     try
     {
@@ -189,7 +220,7 @@ GraphicsView::sceneToWGS84(const QPointF &scenePos) const
     }
 }
 
-QPointF GraphicsView::wgs84ToScene(QPointF point) const
+QPointF GraphicsView::wgs84ToScene(QPointF point)
 {
     try
     {
@@ -252,7 +283,7 @@ QPointF GraphicsView::wgs84ToScene(QPointF point) const
 }
 
 QPointF GraphicsView::convertCoordinates(
-    const QPointF &point, const QString &direction) const
+    const QPointF &point, const QString &direction)
 {
     try
     {
@@ -715,6 +746,242 @@ void GraphicsView::drawBackground(QPainter     *painter,
     painter->restore();
 }
 
+void GraphicsView::paintEvent(QPaintEvent *event)
+{
+    if (_wheelOverview.isNull())
+    {
+        QElapsedTimer timer;
+        timer.start();
+        QGraphicsView::paintEvent(event);
+        if (_interacting)
+        {
+            _interactionPaintNs += timer.nsecsElapsed();
+            ++_interactionFrames;
+        }
+        return;
+    }
+
+    // Stretch the overview over the area it now covers
+    QPainter painter(viewport());
+    painter.fillRect(event->rect(),
+                     palette().brush(QPalette::Base));
+    painter.drawPixmap(
+        mapFromScene(_wheelOverviewRect).boundingRect(),
+        _wheelOverview);
+}
+
+void GraphicsView::beginInteraction(bool wheel)
+{
+    if (!_interacting)
+    {
+        _interacting = true;
+        setRenderHint(QPainter::Antialiasing, false);
+    }
+
+    // OpenGL redraws the scene faster than the overview
+    // capture would take
+    if (wheel && !_openGL && _wheelOverview.isNull())
+    {
+        QPixmap overview(viewport()->size()
+                         * OVERVIEW_SCALE);
+        if (!overview.isNull())
+        {
+            overview.fill(Qt::transparent);
+            QPainter painter(&overview);
+            render(&painter, QRectF(overview.rect()),
+                   viewport()->rect());
+            painter.end();
+
+            _wheelOverviewRect =
+                mapToScene(viewport()->rect())
+                    .boundingRect();
+            _wheelOverview = overview;
+        }
+    }
+
+    _interactionTimer->start();
+}
+
+void GraphicsView::endInteraction()
+{
+    if (_interactionFrames > 0)
+    {
+        qCDebug(lcRendering).nospace()
+            << (_openGL ? "OpenGL" : "Raster") << ": "
+            << _interactionFrames << " frames, "
+            << _interactionPaintNs / _interactionFrames
+                   / 1000.0
+            << " us average";
+    }
+    _interactionPaintNs = 0;
+    _interactionFrames  = 0;
+
+    _interacting = false;
+    _wheelOverview = QPixmap();
+    setRenderHint(QPainter::Antialiasing, true);
+
+    updatePointClusters();
+    viewport()->update();
+}
+
+bool GraphicsView::setOpenGLEnabled(bool enabled)
+{
+    if (enabled == _openGL)
+    {
+        return true;
+    }
+
+    if (!enabled)
+    {
+        setViewport(new QWidget());
+        setViewportUpdateMode(
+            QGraphicsView::SmartViewportUpdate);
+        _openGL = false;
+        return true;
+    }
+
+#ifdef CARGONET_HAS_OPENGL
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CompatibilityProfile);
+    format.setSamples(4);
+
+    // Probe the context before replacing the viewport
+    QOpenGLContext probe;
+    probe.setFormat(format);
+    bool supported = probe.create();
+    if (supported)
+    {
+        const QPair<int, int> version =
+            probe.format().version();
+        supported = probe.isOpenGLES()
+                        ? version >= qMakePair(3, 0)
+                        : version >= qMakePair(3, 3);
+    }
+    if (!supported)
+    {
+        qWarning() << "OpenGL 3.3 is not available, "
+                      "keeping the raster viewport";
+        return false;
+    }
+
+    QOpenGLWidget *glViewport = new QOpenGLWidget();
+    glViewport->setFormat(format);
+    setViewport(glViewport);
+
+    // A GL frame is redrawn whole on every update
+    setViewportUpdateMode(
+        QGraphicsView::FullViewportUpdate);
+    _openGL = true;
+    return true;
+#else
+    qWarning() << "Built without OpenGL support, keeping "
+                  "the raster viewport";
+    return false;
+#endif
+}
+
+void GraphicsView::updatePointClusters()
+{
+    GraphicsScene *graphicsScene = getScene();
+    if (!graphicsScene)
+    {
+        return;
+    }
+
+    const double viewScale = transform().m11();
+    if (viewScale <= 0)
+    {
+        return;
+    }
+
+    // Added, removed or moved points invalidate the
+    // clusters even if the view is unchanged
+    const quint64 generation =
+        graphicsScene->getItemGeneration();
+    const QString region = graphicsScene->getShownRegion();
+    const QRectF  visible =
+        mapToScene(viewport()->rect()).boundingRect();
+    if (viewScale == _clusterScale
+        && region == _clusterRegion
+        && generation == _clusterGeneration
+        && _clusterRect.contains(visible))
+    {
+        return;
+    }
+
+    // Cover half a viewport around the visible area so
+    // small pans reuse the clusters, snapped to cells
+    const double cellSize = CLUSTER_CELL_PIXELS / viewScale;
+    const QRectF margin   = visible.adjusted(
+        -visible.width() / 2, -visible.height() / 2,
+        visible.width() / 2, visible.height() / 2);
+    const QRectF area(
+        QPointF(std::floor(margin.left() / cellSize)
+                    * cellSize,
+                std::floor(margin.top() / cellSize)
+                    * cellSize),
+        QPointF(std::ceil(margin.right() / cellSize)
+                    * cellSize,
+                std::ceil(margin.bottom() / cellSize)
+                    * cellSize));
+
+    _clusterScale  = viewScale;
+    _clusterRegion     = region;
+    _clusterRect       = area;
+    _clusterGeneration = generation;
+
+    // Points of other regions are hidden anyway
+    const GraphicsItemView<MapPoint> points =
+        region.isNull()
+            ? graphicsScene->itemsOfType<MapPoint>()
+            : graphicsScene->itemsInRegion<MapPoint>(
+                  region);
+
+    // Fully zoomed in, every point is drawn on its own
+    const bool separate = _zoom >= MAX_ZOOM;
+
+    // Group by network and screen cell
+    QHash<QPair<quintptr, quint64>, QList<MapPoint *>>
+        clusters;
+    for (MapPoint *point : points)
+    {
+        const QPointF position =
+            point->getSceneCoordinate();
+        if (!area.contains(position))
+        {
+            continue;
+        }
+
+        if (separate || point->getLinkedTerminal())
+        {
+            point->setClusterSize(1);
+            continue;
+        }
+
+        const qint64 cellX =
+            qint64(std::floor(position.x() / cellSize));
+        const qint64 cellY =
+            qint64(std::floor(position.y() / cellSize));
+        const quint64 cell =
+            (quint64(cellX) << 32) ^ quint32(cellY);
+        clusters[qMakePair(
+                     quintptr(point->getReferenceNetwork()),
+                     cell)]
+            .append(point);
+    }
+
+    // The first point of a cell draws the marker
+    for (const QList<MapPoint *> &cluster : clusters)
+    {
+        cluster.first()->setClusterSize(cluster.size());
+        for (int i = 1; i < cluster.size(); ++i)
+        {
+            cluster[i]->setClusterSize(0);
+        }
+    }
+}
+
 void GraphicsView::wheelEvent(QWheelEvent *event)
 {
     try
@@ -748,6 +1015,8 @@ void GraphicsView::wheelEvent(QWheelEvent *event)
             return;
         }
 
+        beginInteraction(true);
+
         // Apply zoom
         scale(zoomFactor, zoomFactor);
         _zoom = newZoom;
@@ -876,6 +1145,8 @@ void GraphicsView::mouseMoveEvent(QMouseEvent *event)
             QPointF delta  = event->pos() - _lastDragPoint;
             _lastDragPoint = event->pos();
 
+            beginInteraction(false);
+
             // Use horizontal and vertical scrollbars for
             // smooth scrolling
             horizontalScrollBar()->setValue(
@@ -1406,6 +1677,8 @@ void GraphicsView::fitInView(
 
         // Update scrollbar ranges for the new zoom level
         updateScrollBarRanges();
+
+        updatePointClusters();
     }
     catch (const std::exception &e)
     {
@@ -2,7 +2,9 @@
 
 #include <QGraphicsView>
 #include <QLabel>
+#include <QPixmap>
 #include <QPointF>
+#include <QRectF>
 #include <QTimer>
 #include <cmath>
 
@@ -52,9 +54,9 @@ public:
      * @return QPointF Point(x, y) for projected or
      * Point(lon, lat) for geodetic
      */
-    QPointF convertCoordinates(
+    static QPointF convertCoordinates(
         const QPointF &point,
-        const QString &direction = "to_projected") const;
+        const QString &direction = "to_projected");
 
     /**
      * @brief Convert scene coordinates to WGS84
@@ -64,7 +66,7 @@ public:
      * @return sQPointF of (longitude, latitude) in
      * degrees
      */
-    QPointF sceneToWGS84(const QPointF &scenePos) const;
+    static QPointF sceneToWGS84(const QPointF &scenePos);
 
     /**
      * @brief Convert WGS84 coordinates to scene coordinates
@@ -73,21 +75,21 @@ public:
      * Longitude in degrees)
      * @return QPointF Position in scene coordinates
      */
-    QPointF wgs84ToScene(QPointF point) const;
+    static QPointF wgs84ToScene(QPointF point);
 
     /**
      * @brief Convert latitude to Mercator Y coordinate
      * @param lat Latitude in degrees
      * @return double Mercator Y coordinate
      */
-    double latToMercator(double lat) const;
+    static double latToMercator(double lat);
 
     /**
      * @brief Convert Mercator Y coordinate to latitude
      * @param mercatorY Mercator Y coordinate
      * @return double Latitude in degrees
      */
-    double mercatorToLat(double mercatorY) const;
+    static double mercatorToLat(double mercatorY);
 
     /**
      * @brief Update scroll bar ranges based on current zoom
@@ -160,6 +162,38 @@ public:
                    Qt::AspectRatioMode aspectRatioMode =
                        Qt::KeepAspectRatio);
 
+    /**
+     * @brief Merge map points that overlap on screen into
+     * cluster markers
+     *
+     * Points are grouped per network into square cells of
+     * CLUSTER_CELL_PIXELS at the current zoom. Points
+     * linked to terminals are never merged. Called when a
+     * zoom or pan settles.
+     *
+     * Only points of the shown region around the visible
+     * area are regrouped, and only when the zoom, the
+     * region or the area changed. The area is snapped to
+     * the cell grid so no cell is split.
+     */
+    void updatePointClusters();
+
+    /**
+     * @brief Switch between the OpenGL and raster viewport
+     * @param enabled True to render through OpenGL
+     * @return True if the requested backend is in use
+     *
+     * OpenGL needs a 3.3 context (Mesa llvmpipe is
+     * enough). Without one, or in builds without OpenGL
+     * support, the view keeps the raster viewport.
+     */
+    bool setOpenGLEnabled(bool enabled);
+
+    bool isOpenGLEnabled() const
+    {
+        return _openGL;
+    }
+
 signals:
     void coordinateSystemChanged(bool isProjected);
 
@@ -172,6 +206,13 @@ protected:
     void drawBackground(QPainter     *painter,
                         const QRectF &rect) override;
 
+    /**
+     * @brief Paint the viewport, or the cached overview
+     * while the wheel is moving
+     * @param event Paint event
+     */
+    void paintEvent(QPaintEvent *event) override;
+
     /**
      * @brief Handle mouse wheel events for zooming
      * @param event Mouse wheel event
@@ -256,6 +297,39 @@ protected:
     void keyReleaseEvent(QKeyEvent *event) override;
 
 private:
+    /**
+     * @brief Start or extend an interactive pan or zoom
+     * @param wheel True if the interaction is a wheel zoom
+     *
+     * Antialiasing is disabled until the interaction
+     * settles. A wheel zoom also captures a low resolution
+     * overview of the viewport that is drawn instead of the
+     * scene until then.
+     */
+    void beginInteraction(bool wheel);
+
+    /**
+     * @brief Restore full quality rendering after an
+     * interaction
+     */
+    void endInteraction();
+
+    /**
+     * @brief Idle time after which an interaction ends
+     */
+    static constexpr int INTERACTION_SETTLE_MS = 150;
+
+    /**
+     * @brief Resolution of the wheel overview relative to
+     * the viewport
+     */
+    static constexpr double OVERVIEW_SCALE = 0.5;
+
+    /**
+     * @brief Screen size of a point cluster cell
+     */
+    static constexpr int CLUSTER_CELL_PIXELS = 24;
+
     /**
      * @brief Current zoom level
      */
@@ -348,6 +422,59 @@ private:
      * @brief Pointer to current measurement tool
      */
     DistanceMeasurementTool *m_measurementTool;
+
+    /**
+     * @brief Timer that ends an interaction when idle
+     */
+    QTimer *_interactionTimer;
+
+    /**
+     * @brief Flag indicating whether a pan or zoom is in
+     * progress
+     */
+    bool _interacting;
+
+    /**
+     * @brief Low resolution viewport capture shown during
+     * wheel zoom
+     */
+    QPixmap _wheelOverview;
+
+    /**
+     * @brief Scene area covered by the wheel overview
+     */
+    QRectF _wheelOverviewRect;
+
+    /**
+     * @brief View scale the point clusters were built for
+     */
+    double _clusterScale;
+
+    /**
+     * @brief Scene area and region the point clusters were
+     * built for
+     */
+    QRectF  _clusterRect;
+    QString _clusterRegion;
+
+    /**
+     * @brief Scene item generation the point clusters were
+     * built for
+     */
+    quint64 _clusterGeneration;
+
+    /**
+     * @brief Flag indicating whether the viewport renders
+     * through OpenGL
+     */
+    bool _openGL;
+
+    /**
+     * @brief Paint time and frame count of the current
+     * interaction, logged when it ends
+     */
+    qint64 _interactionPaintNs;
+    int    _interactionFrames;
 };
 
 } // namespace GUI
@@ -102,6 +102,97 @@ void SettingsWidget::initUI()
     simLayout->addRow(tr("Number of Shortest Paths:"),
                       shortestPathsSpin);
 
+    // Embedded path engine instead of TerminalSim
+    useLocalPathEngine = new QCheckBox(
+        tr("Use local path engine (no TerminalSim server)"),
+        simulationGroup);
+    simLayout->addRow("", useLocalPathEngine);
+
+    // Compact container payloads for large transfers
+    useColumnarContainers = new QCheckBox(
+        tr("Send containers as columnar batches"),
+        simulationGroup);
+    simLayout->addRow("", useColumnarContainers);
+
+    // GPU map rendering, raster if OpenGL is unavailable
+    useOpenGLViewport = new QCheckBox(
+        tr("Render maps with OpenGL"), simulationGroup);
+    simLayout->addRow("", useOpenGLViewport);
+
+    // Per-vehicle state history for post-run analysis
+    recordVehicleStates = new QCheckBox(
+        tr("Record vehicle states"), simulationGroup);
+    simLayout->addRow("", recordVehicleStates);
+
+    vehicleStatesSpillFile = new QLineEdit(simulationGroup);
+    vehicleStatesSpillFile->setPlaceholderText(
+        tr("Keep in memory"));
+    vehicleStatesSpillFile->setEnabled(false);
+    connect(recordVehicleStates, &QCheckBox::toggled,
+            vehicleStatesSpillFile, &QWidget::setEnabled);
+    simLayout->addRow(tr("Vehicle State Spill File:"),
+                      vehicleStatesSpillFile);
+
+    // Contention statistics of the backend locks, and
+    // what a lock wait past its timeout does
+    lockInstrumentation = new QCheckBox(
+        tr("Collect lock contention statistics"),
+        simulationGroup);
+    simLayout->addRow("", lockInstrumentation);
+
+    lockWaitPolicyCombo = new QComboBox(simulationGroup);
+    lockWaitPolicyCombo->addItem(tr("Fail on timeout"),
+                                 "fail_fast");
+    lockWaitPolicyCombo->addItem(
+        tr("Warn and keep waiting"), "wait");
+    simLayout->addRow(tr("Lock Timeout Policy:"),
+                      lockWaitPolicyCombo);
+
+    lockDumpIntervalSpin = new QSpinBox(simulationGroup);
+    lockDumpIntervalSpin->setRange(0, 3600000);
+    lockDumpIntervalSpin->setSingleStep(1000);
+    lockDumpIntervalSpin->setSpecialValueText(tr("Never"));
+    lockDumpIntervalSpin->setSuffix(tr(" ms"));
+    lockDumpIntervalSpin->setEnabled(false);
+    connect(lockInstrumentation, &QCheckBox::toggled,
+            lockDumpIntervalSpin, &QWidget::setEnabled);
+    simLayout->addRow(tr("Lock Report Interval:"),
+                      lockDumpIntervalSpin);
+
+    // Async truck trips running at once, and how long
+    // one may run without ending
+    maxTripsInFlightSpin = new QSpinBox(simulationGroup);
+    maxTripsInFlightSpin->setRange(0, 1000000);
+    maxTripsInFlightSpin->setSpecialValueText(
+        tr("Unlimited"));
+    maxTripsInFlightSpin->setSuffix(tr(" trips"));
+    simLayout->addRow(tr("Max Truck Trips in Flight:"),
+                      maxTripsInFlightSpin);
+
+    tripTimeoutSpin = new QSpinBox(simulationGroup);
+    tripTimeoutSpin->setRange(0, 604800);
+    tripTimeoutSpin->setSpecialValueText(tr("None"));
+    tripTimeoutSpin->setSuffix(tr(" s"));
+    simLayout->addRow(tr("Truck Trip Timeout:"),
+                      tripTimeoutSpin);
+
+    // Cost minimized by new truck trips
+    routingModeCombo = new QComboBox(simulationGroup);
+    routingModeCombo->addItem(tr("Shortest distance"),
+                              "shortest_distance");
+    routingModeCombo->addItem(tr("Congested travel time"),
+                              "congested_time");
+    simLayout->addRow(tr("Truck Routing:"),
+                      routingModeCombo);
+
+    rerouteIntervalSpin = new QSpinBox(simulationGroup);
+    rerouteIntervalSpin->setRange(0, 86400);
+    rerouteIntervalSpin->setSpecialValueText(
+        tr("Every trip"));
+    rerouteIntervalSpin->setSuffix(tr(" s"));
+    simLayout->addRow(tr("Truck Reroute Interval:"),
+                      rerouteIntervalSpin);
+
     containerLayout->addWidget(simulationGroup);
 
     // --- Fuel Types Table ---
@@ -690,6 +781,78 @@ bool SettingsWidget::loadSettings()
             if (simSettings.contains("shortest_paths"))
                 shortestPathsSpin->setValue(
                     simSettings["shortest_paths"].toInt());
+
+            if (simSettings.contains("local_path_engine"))
+                useLocalPathEngine->setChecked(
+                    simSettings["local_path_engine"]
+                        .toBool());
+
+            if (simSettings.contains(
+                    "columnar_container_payloads"))
+                useColumnarContainers->setChecked(
+                    simSettings["columnar_container_payloads"]
+                        .toBool());
+
+            if (simSettings.contains("opengl_viewport"))
+                useOpenGLViewport->setChecked(
+                    simSettings["opengl_viewport"]
+                        .toBool());
+
+            if (simSettings.contains(
+                    "record_vehicle_states"))
+                recordVehicleStates->setChecked(
+                    simSettings["record_vehicle_states"]
+                        .toBool());
+
+            if (simSettings.contains(
+                    "vehicle_states_spill_file"))
+                vehicleStatesSpillFile->setText(
+                    simSettings["vehicle_states_spill_file"]
+                        .toString());
+
+            if (simSettings.contains(
+                    "lock_instrumentation"))
+                lockInstrumentation->setChecked(
+                    simSettings["lock_instrumentation"]
+                        .toBool());
+
+            if (simSettings.contains("lock_wait_policy"))
+            {
+                int index = lockWaitPolicyCombo->findData(
+                    simSettings["lock_wait_policy"]
+                        .toString());
+                if (index >= 0)
+                    lockWaitPolicyCombo->setCurrentIndex(
+                        index);
+            }
+
+            if (simSettings.contains("lock_dump_interval"))
+                lockDumpIntervalSpin->setValue(
+                    simSettings["lock_dump_interval"]
+                        .toInt());
+
+            if (simSettings.contains("max_trips_in_flight"))
+                maxTripsInFlightSpin->setValue(
+                    simSettings["max_trips_in_flight"]
+                        .toInt());
+
+            if (simSettings.contains("trip_timeout"))
+                tripTimeoutSpin->setValue(
+                    simSettings["trip_timeout"].toInt());
+
+            if (simSettings.contains("routing_mode"))
+            {
+                int index = routingModeCombo->findData(
+                    simSettings["routing_mode"].toString());
+                if (index >= 0)
+                    routingModeCombo->setCurrentIndex(
+                        index);
+            }
+
+            if (simSettings.contains("reroute_interval"))
+                rerouteIntervalSpin->setValue(
+                    simSettings["reroute_interval"]
+                        .toInt());
         }
 
         // Apply carbon tax settings
@@ -1001,6 +1164,29 @@ void SettingsWidget::applySettings()
         useSpecificTimeValues->isChecked();
     simulation["shortest_paths"] =
         shortestPathsSpin->value();
+    simulation["local_path_engine"] =
+        useLocalPathEngine->isChecked();
+    simulation["columnar_container_payloads"] =
+        useColumnarContainers->isChecked();
+    simulation["opengl_viewport"] =
+        useOpenGLViewport->isChecked();
+    simulation["record_vehicle_states"] =
+        recordVehicleStates->isChecked();
+    simulation["vehicle_states_spill_file"] =
+        vehicleStatesSpillFile->text().trimmed();
+    simulation["lock_instrumentation"] =
+        lockInstrumentation->isChecked();
+    simulation["lock_wait_policy"] =
+        lockWaitPolicyCombo->currentData().toString();
+    simulation["lock_dump_interval"] =
+        lockDumpIntervalSpin->value();
+    simulation["max_trips_in_flight"] =
+        maxTripsInFlightSpin->value();
+    simulation["trip_timeout"] = tripTimeoutSpin->value();
+    simulation["routing_mode"] =
+        routingModeCombo->currentData().toString();
+    simulation["reroute_interval"] =
+        rerouteIntervalSpin->value();
     newSettings["simulation"] = simulation;
 
     // Fuel data
@@ -5,6 +5,7 @@
 #include <QDoubleSpinBox>
 #include <QFormLayout>
 #include <QGroupBox>
+#include <QLineEdit>
 #include <QMap>
 #include <QPushButton>
 #include <QSpinBox>
@@ -146,6 +147,18 @@ private:
     QDoubleSpinBox *truckMultiplierSpin;
     QDoubleSpinBox *trainMultiplierSpin;
     QCheckBox      *useSpecificTimeValues;
+    QCheckBox      *useLocalPathEngine;
+    QCheckBox      *useColumnarContainers;
+    QCheckBox      *useOpenGLViewport;
+    QCheckBox      *recordVehicleStates;
+    QLineEdit      *vehicleStatesSpillFile;
+    QCheckBox      *lockInstrumentation;
+    QComboBox      *lockWaitPolicyCombo;
+    QSpinBox       *lockDumpIntervalSpin;
+    QSpinBox       *maxTripsInFlightSpin;
+    QSpinBox       *tripTimeoutSpin;
+    QComboBox      *routingModeCombo;
+    QSpinBox       *rerouteIntervalSpin;
     QDoubleSpinBox *averageTimeValueSpin;
 
     // Ship settings
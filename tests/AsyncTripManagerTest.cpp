@@ -0,0 +1,242 @@
+#include <QTest>
+#include "Backend/Clients/TruckClient/AsyncTripManager.h"
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QObject>
+#include <QSignalSpy>
+
+using namespace CargoNetSim::Backend::TruckClient;
+
+/**
+ * @class AsyncTripManagerTest
+ * @brief Checks the in-flight window, batch cancellation
+ * and trip ends racing their launch
+ *
+ * Trip i goes from node i to node i + 100 and is started
+ * as "trip_i". flush() is called directly instead of
+ * waiting for the event loop.
+ */
+class AsyncTripManagerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    AsyncTripManager *manager = nullptr;
+    QStringList       launched;
+    QStringList       cancelled;
+
+    static TripRequest makeRequest(int i)
+    {
+        TripRequest request;
+        request.networkName   = "net";
+        request.originId      = i;
+        request.destinationId = i + 100;
+        return request;
+    }
+
+    static QList<TripRequest> makeRequests(int count)
+    {
+        QList<TripRequest> requests;
+        for (int i = 0; i < count; ++i)
+        {
+            requests.append(makeRequest(i));
+        }
+        return requests;
+    }
+
+    static QString tripId(int i)
+    {
+        return QString("trip_%1").arg(i);
+    }
+
+    void endTrip(int i)
+    {
+        QJsonObject data;
+        data["Origin"]      = i;
+        data["Destination"] = i + 100;
+        manager->onTripEnded("net", tripId(i), data);
+    }
+
+private slots:
+    void init()
+    {
+        launched.clear();
+        cancelled.clear();
+
+        manager = new AsyncTripManager();
+        manager->setLauncher(
+            [this](const QList<TripRequest> &requests) {
+                QStringList ids;
+                for (const TripRequest &request : requests)
+                {
+                    ids.append(tripId(request.originId));
+                }
+                launched.append(ids);
+                return ids;
+            });
+        manager->setCanceller([this](const QString &id) {
+            cancelled.append(id);
+            return true;
+        });
+    }
+
+    void cleanup()
+    {
+        delete manager;
+        manager = nullptr;
+    }
+
+    void testWindowLimitsRunningTrips()
+    {
+        QSignalSpy spy(manager,
+                       &AsyncTripManager::tripsCompleted);
+        manager->setMaxInFlight(2);
+        QFuture<TripResult> future =
+            manager->addTripsAsync(makeRequests(5));
+
+        QCOMPARE(launched,
+                 QStringList({tripId(0), tripId(1)}));
+        QCOMPARE(manager->inFlightCount(), 2);
+        QCOMPARE(manager->queuedCount(), 3);
+
+        // Each end frees a slot for the next request
+        endTrip(1);
+        manager->flush();
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(launched.last(), tripId(2));
+        QCOMPARE(manager->queuedCount(), 2);
+        QCOMPARE(future.progressValue(), 1);
+        QVERIFY(!future.isFinished());
+
+        // Widening the window dispatches right away
+        manager->setMaxInFlight(0);
+        QCOMPARE(manager->inFlightCount(), 4);
+        QCOMPARE(manager->queuedCount(), 0);
+
+        for (int i : {0, 2, 3, 4})
+        {
+            endTrip(i);
+        }
+        manager->flush();
+        QCOMPARE(spy.count(), 2);
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.resultCount(), 5);
+        for (int i = 0; i < 5; ++i)
+        {
+            QVERIFY(future.resultAt(i).successful);
+            QCOMPARE(future.resultAt(i).originId, i);
+        }
+    }
+
+    void testCancelledBatchStopsItsTrips()
+    {
+        manager->setMaxInFlight(2);
+        QFuture<TripResult> future =
+            manager->addTripsAsync(makeRequests(4));
+        QFuture<TripResult> other =
+            manager->addTripAsync(makeRequest(10));
+        QCOMPARE(manager->inFlightCount(), 2);
+
+        // The next flush stops the running trips of the
+        // batch and drops its queued ones
+        future.cancel();
+        endTrip(0);
+        manager->flush();
+        manager->flush();
+
+        QCOMPARE(cancelled, QStringList({tripId(1)}));
+        QCOMPARE(launched.last(), tripId(10));
+        QCOMPARE(manager->inFlightCount(), 1);
+        QCOMPARE(manager->queuedCount(), 0);
+
+        // Other batches are not affected
+        endTrip(10);
+        manager->flush();
+        QVERIFY(other.isFinished());
+        QVERIFY(other.result().successful);
+    }
+
+    void testCancelTrip()
+    {
+        QFuture<TripResult> future =
+            manager->addTripAsync(makeRequest(3));
+        QVERIFY(manager->cancelTrip(tripId(3)));
+        QVERIFY(!manager->cancelTrip(tripId(3)));
+        QCOMPARE(cancelled, QStringList({tripId(3)}));
+
+        manager->flush();
+        QVERIFY(future.isFinished());
+        QVERIFY(!future.result().successful);
+        QCOMPARE(future.result().destinationId, 103);
+    }
+
+    void testEndBeforeLaunchReturns()
+    {
+        // The simulator reports the end while the launcher
+        // is still running
+        manager->setLauncher(
+            [this](const QList<TripRequest> &requests) {
+                endTrip(requests.first().originId);
+                return QStringList(
+                    {tripId(requests.first().originId)});
+            });
+
+        QFuture<TripResult> future =
+            manager->addTripAsync(makeRequest(7));
+        QCOMPARE(manager->inFlightCount(), 0);
+
+        manager->flush();
+        QVERIFY(future.isFinished());
+        QVERIFY(future.result().successful);
+        QCOMPARE(future.result().originId, 7);
+    }
+
+    void testFailedLaunchFailsTheTrip()
+    {
+        manager->setLauncher(
+            [](const QList<TripRequest> &requests) {
+                const int second = requests[1].originId;
+                return QStringList(
+                    {QString(), tripId(second)});
+            });
+
+        QFuture<TripResult> future =
+            manager->addTripsAsync(makeRequests(2));
+        QCOMPARE(manager->inFlightCount(), 1);
+
+        endTrip(1);
+        manager->flush();
+        QVERIFY(future.isFinished());
+        QVERIFY(!future.resultAt(0).successful);
+        QVERIFY(future.resultAt(1).successful);
+    }
+
+    void testContinuationMayCallBack()
+    {
+        // Finishing a future runs its continuation in the
+        // flushing thread, which must not hold the lock
+        int running = -1;
+        QFuture<TripResult> future =
+            manager->addTripAsync(makeRequest(1));
+        QFuture<void> next =
+            future.then([&](QFuture<TripResult>) {
+                manager->addTripAsync(makeRequest(2));
+                running = manager->inFlightCount();
+            });
+
+        endTrip(1);
+        manager->flush();
+        QVERIFY(next.isFinished());
+        QCOMPARE(running, 1);
+        QCOMPARE(launched.last(), tripId(2));
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication     app(argc, argv);
+    AsyncTripManagerTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "AsyncTripManagerTest.moc"
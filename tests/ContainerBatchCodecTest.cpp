@@ -0,0 +1,163 @@
+#include <QTest>
+#include "Backend/Commons/ContainerBatchCodec.h"
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QtEndian>
+
+using namespace CargoNetSim::Backend;
+
+/**
+ * @class ContainerBatchCodecTest
+ * @brief Round-trips container objects through columnar
+ * batches, with and without compression
+ */
+class ContainerBatchCodecTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    /**
+     * @brief Build the i-th container object
+     *
+     * Strings repeat across containers, the custom
+     * variables are nested objects, and some fields are
+     * set on a part of the containers only.
+     */
+    static QJsonObject makeContainer(int i)
+    {
+        QJsonObject custom;
+        custom["commodity"] = i % 2 ? "grain" : "steel";
+        custom["weight"]    = 1000.5 + i;
+        if (i % 4 == 0)
+        {
+            custom["hazmat"] = true;
+        }
+
+        QJsonObject container;
+        container["containerID"] = QString("C%1").arg(i);
+        container["containerSize"] = i % 3;
+        container["containerCurrentLocation"] =
+            QString("Terminal_%1").arg(i % 5);
+        container["customVariables"] = custom;
+        if (i % 3 == 0)
+        {
+            container["nextDestination"] = "Port_A";
+        }
+        if (i % 7 == 0)
+        {
+            // Mixed value types keep their JSON values
+            container["note"] =
+                i % 2 ? QJsonValue(i) : QJsonValue("late");
+        }
+        return container;
+    }
+
+    static QJsonArray makeContainers(int count)
+    {
+        QJsonArray containers;
+        for (int i = 0; i < count; ++i)
+        {
+            containers.append(makeContainer(i));
+        }
+        return containers;
+    }
+
+private slots:
+    void testRoundTrip()
+    {
+        const QJsonArray containers = makeContainers(50);
+        const QJsonObject batch =
+            ContainerBatchCodec::encodeJson(containers);
+
+        QVERIFY(ContainerBatchCodec::isBatch(batch));
+        QVERIFY(!batch.contains("compression"));
+        QCOMPARE(batch["count"].toInt(), 50);
+
+        // Each distinct string is stored once: 50 IDs, 5
+        // locations, 2 commodities and one destination
+        const QJsonArray dictionary =
+            batch["dictionary"].toArray();
+        QCOMPARE(dictionary.size(), 58);
+        QVERIFY(dictionary.contains("Port_A"));
+
+        QCOMPARE(ContainerBatchCodec::decodeJson(batch),
+                 containers);
+    }
+
+    void testEmptyAndPlainInput()
+    {
+        const QJsonObject empty =
+            ContainerBatchCodec::encodeJson(QJsonArray());
+        QVERIFY(ContainerBatchCodec::isBatch(empty));
+        QVERIFY(ContainerBatchCodec::decodeJson(empty)
+                    .isEmpty());
+
+        // Plain arrays pass through unchanged
+        const QJsonArray plain = makeContainers(3);
+        QVERIFY(!ContainerBatchCodec::isBatch(plain));
+        QCOMPARE(ContainerBatchCodec::decodeJson(plain),
+                 plain);
+
+        // Other objects are not batches
+        QJsonObject other;
+        other["format"] = "columnar-v0";
+        QVERIFY(!ContainerBatchCodec::isBatch(other));
+        QVERIFY(ContainerBatchCodec::decodeJson(other)
+                    .isEmpty());
+    }
+
+    void testLargeBatchesAreCompressed()
+    {
+        const QJsonArray containers = makeContainers(5000);
+        const QJsonObject batch =
+            ContainerBatchCodec::encodeJson(containers);
+
+        QCOMPARE(batch["compression"].toString(),
+                 QString("zlib"));
+        QVERIFY(!batch.contains("columns"));
+        QCOMPARE(ContainerBatchCodec::decodeJson(batch),
+                 containers);
+
+        // The payload is a plain zlib stream of "size"
+        // bytes of compact JSON
+        const int  size = batch["size"].toInt();
+        QByteArray stream(4, '\0');
+        qToBigEndian(static_cast<quint32>(size),
+                     stream.data());
+        stream += QByteArray::fromBase64(
+            batch["payload"].toString().toLatin1());
+        const QByteArray json = qUncompress(stream);
+        QCOMPARE(json.size(), size);
+        QVERIFY(ContainerBatchCodec::isBatch(
+            QJsonDocument::fromJson(json).object()));
+
+        // Compression can be turned off
+        const QJsonObject plain =
+            ContainerBatchCodec::encodeJson(containers,
+                                            false);
+        QVERIFY(!plain.contains("compression"));
+        QCOMPARE(ContainerBatchCodec::decodeJson(plain),
+                 containers);
+    }
+
+    void testUnknownCompressionIsRejected()
+    {
+        QJsonObject batch = ContainerBatchCodec::encodeJson(
+            makeContainers(5000));
+        batch["compression"] = "lz4";
+        QVERIFY(ContainerBatchCodec::decodeJson(batch)
+                    .isEmpty());
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication        app(argc, argv);
+    ContainerBatchCodecTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "ContainerBatchCodecTest.moc"
@@ -0,0 +1,309 @@
+#include <QTest>
+#include "Backend/Clients/BaseClient/ContainerManager.h"
+#include <QCoreApplication>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include <algorithm>
+
+using namespace CargoNetSim::Backend;
+
+using Container = ContainerCore::Container;
+
+/**
+ * @class ContainerManagerTest
+ * @brief Checks the slot bookkeeping against a plain map
+ * and the signals merged by batches
+ */
+class ContainerManagerTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    ContainerManager   *manager = nullptr;
+    QObject            *owner   = nullptr;
+    QList<Container *>  containers;
+
+    static QStringList sortedIds(const QStringList &ids)
+    {
+        QStringList sorted = ids;
+        sorted.sort();
+        return sorted;
+    }
+
+    static QStringList
+    idsOf(const QList<Container *> &list)
+    {
+        QStringList ids;
+        for (const Container *container : list)
+        {
+            ids.append(container->getContainerID());
+        }
+        return sortedIds(ids);
+    }
+
+    /**
+     * @brief Compare every query with the expected
+     * vehicle of each container
+     */
+    void compareWith(
+        const QHash<Container *, QString> &expected,
+        const QStringList                 &vehicles)
+    {
+        for (const QString &vehicle : vehicles)
+        {
+            QList<Container *> carried;
+            for (auto it = expected.constBegin();
+                 it != expected.constEnd(); ++it)
+            {
+                if (it.value() == vehicle)
+                {
+                    carried.append(it.key());
+                }
+            }
+            QCOMPARE(manager->containerCount(vehicle),
+                     carried.size());
+            QCOMPARE(idsOf(manager->getContainersForVehicle(
+                         vehicle)),
+                     idsOf(carried));
+        }
+        for (Container *container : containers)
+        {
+            const QString vehicle =
+                expected.value(container);
+            QCOMPARE(manager->getVehicleForContainer(
+                         container),
+                     vehicle);
+            if (!vehicle.isEmpty())
+            {
+                QVERIFY(
+                    manager->isContainerAssignedToVehicle(
+                        vehicle, container));
+            }
+        }
+    }
+
+private slots:
+    void init()
+    {
+        manager = new ContainerManager();
+        owner   = new QObject();
+        for (int i = 0; i < 40; ++i)
+        {
+            containers.append(new Container(
+                QString("C%1").arg(i),
+                Container::twentyFT, owner));
+        }
+    }
+
+    void cleanup()
+    {
+        delete manager;
+        manager = nullptr;
+        delete owner;
+        owner = nullptr;
+        containers.clear();
+    }
+
+    void testSlotsFollowRandomChanges()
+    {
+        const QStringList vehicles = {"truck_1", "truck_2",
+                                      "train_1"};
+        QHash<Container *, QString> expected;
+        QRandomGenerator            random(7);
+
+        auto pick = [&](int count) {
+            QList<Container *> picked;
+            for (int i = 0; i < count; ++i)
+            {
+                picked.append(containers[random.bounded(
+                    containers.size())]);
+            }
+            return picked;
+        };
+
+        for (int step = 0; step < 2000; ++step)
+        {
+            const QString vehicle =
+                vehicles[random.bounded(vehicles.size())];
+            const QList<Container *> picked =
+                pick(1 + random.bounded(5));
+
+            switch (random.bounded(5))
+            {
+            case 0:
+                // Reassigning moves containers over
+                manager->assignContainersToVehicle(vehicle,
+                                                   picked);
+                for (Container *container : picked)
+                {
+                    expected[container] = vehicle;
+                }
+                break;
+            case 1:
+            {
+                const QList<Container *> removed =
+                    manager->removeContainersFromVehicle(
+                        vehicle, picked);
+                for (Container *container : removed)
+                {
+                    QCOMPARE(expected.take(container),
+                             vehicle);
+                }
+                break;
+            }
+            case 2:
+            {
+                QStringList ids;
+                for (Container *container : picked)
+                {
+                    ids.append(container->getContainerID());
+                }
+                manager->removeContainersById(ids);
+                for (Container *container : picked)
+                {
+                    expected.remove(container);
+                }
+                break;
+            }
+            case 3:
+            {
+                // Only containers all on the source move
+                QList<Container *> onVehicle;
+                for (Container *container : picked)
+                {
+                    if (expected.value(container)
+                        == vehicle)
+                    {
+                        onVehicle.append(container);
+                    }
+                }
+                const QString target = vehicles[
+                    random.bounded(vehicles.size())];
+                const bool moved =
+                    manager->transferContainers(
+                        vehicle, target, onVehicle);
+                QCOMPARE(moved, !onVehicle.isEmpty());
+                for (Container *container : onVehicle)
+                {
+                    expected[container] = target;
+                }
+                break;
+            }
+            default:
+                if (random.bounded(10) == 0)
+                {
+                    manager->removeAllContainersFromVehicle(
+                        vehicle);
+                    for (auto it = expected.begin();
+                         it != expected.end();)
+                    {
+                        it = it.value() == vehicle
+                                 ? expected.erase(it)
+                                 : std::next(it);
+                    }
+                }
+                break;
+            }
+
+            compareWith(expected, vehicles);
+        }
+
+        manager->clear();
+        compareWith({}, vehicles);
+    }
+
+    void testTransferRejectsForeignContainers()
+    {
+        manager->assignContainersToVehicle(
+            "truck_1", {containers[0], containers[1]});
+        manager->assignContainersToVehicle("truck_2",
+                                           {containers[2]});
+
+        QVERIFY(!manager->transferContainers(
+            "truck_1", "ship_1",
+            {containers[0], containers[2]}));
+        QCOMPARE(manager->containerCount("truck_1"), 2);
+        QCOMPARE(manager->containerCount("ship_1"), 0);
+
+        QVERIFY(manager->transferContainers(
+            "truck_1", "ship_1", {containers[1]}));
+        QCOMPARE(manager->getVehicleForContainer(
+                     containers[1]),
+                 QString("ship_1"));
+    }
+
+    void testBatchesMergeSignals()
+    {
+        QSignalSpy assigned(
+            manager, &ContainerManager::containersAssigned);
+        QSignalSpy removed(
+            manager, &ContainerManager::containersRemoved);
+
+        // One signal per vehicle
+        QMap<QString, QList<Container *>> assignments;
+        assignments["truck_1"] = {containers[0],
+                                  containers[1]};
+        assignments["truck_2"] = {containers[2]};
+        manager->assignContainersToVehicles(assignments);
+        QCOMPARE(assigned.count(), 2);
+
+        // Nested batches emit once, when the outer closes
+        assigned.clear();
+        manager->beginBatch();
+        manager->assignContainersToVehicle("truck_1",
+                                           {containers[3]});
+        manager->beginBatch();
+        manager->assignContainersToVehicle("truck_1",
+                                           {containers[4]});
+        manager->removeContainersFromVehicle(
+            "truck_2", {containers[2]});
+        manager->endBatch();
+        QCOMPARE(assigned.count(), 0);
+        QCOMPARE(removed.count(), 0);
+        manager->endBatch();
+
+        QCOMPARE(assigned.count(), 1);
+        QCOMPARE(assigned[0][0].toString(),
+                 QString("truck_1"));
+        QCOMPARE(sortedIds(assigned[0][1].toStringList()),
+                 QStringList({"C3", "C4"}));
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(removed[0][1].toStringList(),
+                 QStringList({"C2"}));
+    }
+
+    void testDeferredSignals()
+    {
+        QSignalSpy removed(
+            manager, &ContainerManager::containersRemoved);
+        manager->assignContainersToVehicle(
+            "train_1", {containers[0], containers[1]});
+
+        // Closed under the client's lock, emitted after
+        manager->beginBatch();
+        manager->removeContainersById({"C0", "C1", "C9"});
+        const ContainerManager::PendingSignals pending =
+            manager->endBatchDeferred();
+        QCOMPARE(removed.count(), 0);
+        QCOMPARE(manager->containerCount("train_1"), 0);
+
+        manager->emitSignals(pending);
+        QCOMPARE(removed.count(), 1);
+        QCOMPARE(sortedIds(removed[0][1].toStringList()),
+                 QStringList({"C0", "C1"}));
+
+        // Unbalanced ends are ignored
+        QVERIFY(manager->endBatchDeferred()
+                    .removed.isEmpty());
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication     app(argc, argv);
+    ContainerManagerTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "ContainerManagerTest.moc"
@@ -0,0 +1,266 @@
+#include <QTest>
+#include "Backend/Clients/TerminalClient/LocalTerminalGraph.h"
+#include "Backend/Models/Terminal.h"
+#include "Backend/Models/PathSegment.h"
+#include "Backend/BackendInit.h"
+#include <QCoreApplication>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QObject>
+#include <algorithm>
+#include <functional>
+
+using namespace CargoNetSim::Backend;
+
+using Mode = TransportationTypes::TransportationMode;
+
+/**
+ * @class LocalTerminalGraphTest
+ * @brief Checks the embedded top-k search against brute force
+ *
+ * The graph is small enough to enumerate every loopless path
+ * between two terminals, so the k cheapest costs returned by
+ * findTopPaths() can be compared with the exhaustive ranking.
+ */
+class LocalTerminalGraphTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Link
+    {
+        QString from;
+        QString to;
+        Mode    mode;
+        double  distance;
+    };
+
+    LocalTerminalGraph      *graph = nullptr;
+    QMap<QString, double>    fees;
+    QList<Link>              links;
+
+    /**
+     * @brief Create a terminal charging a fixed handling fee
+     */
+    Terminal *createTerminal(const QString &name, double fee)
+    {
+        QJsonObject cost;
+        cost["fixed_fees"] = fee;
+        QJsonObject config;
+        config["cost"] = cost;
+
+        QMap<TerminalTypes::TerminalInterface, QSet<Mode>>
+            interfaces;
+        interfaces[TerminalTypes::TerminalInterface::
+                       LAND_SIDE] =
+            QSet<Mode>() << Mode::Truck << Mode::Train;
+        interfaces[TerminalTypes::TerminalInterface::
+                       SEA_SIDE] = QSet<Mode>() << Mode::Ship;
+
+        return new Terminal({name}, "test", config, interfaces,
+                            "TestRegion");
+    }
+
+    /**
+     * @brief Rank every loopless path by its total cost
+     *
+     * Mirrors the graph's cost model: the origin and the
+     * destination are always charged, an intermediate
+     * terminal unless delays are skipped and the mode is
+     * kept.
+     */
+    QList<double> bruteForceCosts(const QString &start,
+                                  const QString &end,
+                                  Mode modeFilter,
+                                  bool skipDelays) const
+    {
+        QList<double> costs;
+        QSet<QString> visited{start};
+
+        std::function<void(const QString &, int, double)>
+            walk = [&](const QString &node, int inMode,
+                       double cost) {
+                if (node == end)
+                {
+                    costs.append(cost + fees[end]);
+                    return;
+                }
+                for (const Link &link : links)
+                {
+                    if (modeFilter != Mode::Any
+                        && link.mode != modeFilter)
+                    {
+                        continue;
+                    }
+
+                    QString next;
+                    if (link.from == node)
+                    {
+                        next = link.to;
+                    }
+                    else if (link.to == node)
+                    {
+                        next = link.from;
+                    }
+                    if (next.isEmpty()
+                        || visited.contains(next))
+                    {
+                        continue;
+                    }
+
+                    int    mode = TransportationTypes::toInt(
+                        link.mode);
+                    double transfer =
+                        inMode < 0
+                            || (skipDelays && inMode == mode)
+                            ? 0.0
+                            : fees[node];
+
+                    visited.insert(next);
+                    walk(next, mode,
+                         cost + transfer + link.distance);
+                    visited.remove(next);
+                }
+            };
+
+        walk(start, -1, fees[start]);
+        std::sort(costs.begin(), costs.end());
+        return costs;
+    }
+
+    /**
+     * @brief Compare findTopPaths() with the brute force
+     */
+    void compareWithBruteForce(const QString &start,
+                               const QString &end, Mode mode,
+                               bool skipDelays)
+    {
+        const QList<double> expected =
+            bruteForceCosts(start, end, mode, skipDelays);
+        const QJsonArray paths =
+            graph->findTopPaths(start, end, 100, mode,
+                                skipDelays);
+
+        // Every loopless path, each exactly once
+        QCOMPARE(paths.size(), expected.size());
+        for (int i = 0; i < paths.size(); ++i)
+        {
+            double cost = paths[i]
+                              .toObject()["total_path_cost"]
+                              .toDouble();
+            QVERIFY2(qFuzzyCompare(cost, expected[i]),
+                     qPrintable(
+                         QString("path %1: %2 != %3")
+                             .arg(i)
+                             .arg(cost)
+                             .arg(expected[i])));
+        }
+    }
+
+private slots:
+    void init()
+    {
+        graph = new LocalTerminalGraph();
+
+        QVariantMap weights;
+        weights["distance"]       = 1.0;
+        weights["terminal_delay"] = 1.0;
+        weights["terminal_cost"]  = 1.0;
+        QVariantMap parameters;
+        parameters["default"] = weights;
+        graph->setCostFunctionParameters(parameters);
+
+        // Fees stay below the shortest link so that no
+        // detour through a terminal can undercut a transfer
+        fees = {{"A", 1.0},
+                {"B", 2.0},
+                {"C", 2.5},
+                {"D", 1.5},
+                {"E", 0.5}};
+        for (auto it = fees.constBegin(); it != fees.constEnd();
+             ++it)
+        {
+            Terminal *terminal =
+                createTerminal(it.key(), it.value());
+            QVERIFY(graph->addTerminal(terminal));
+            delete terminal;
+        }
+
+        links = {{"A", "B", Mode::Truck, 10.0},
+                 {"A", "B", Mode::Train, 7.0},
+                 {"B", "C", Mode::Truck, 4.0},
+                 {"A", "C", Mode::Train, 15.0},
+                 {"C", "D", Mode::Truck, 6.0},
+                 {"B", "D", Mode::Train, 12.0},
+                 {"D", "E", Mode::Truck, 3.0},
+                 {"C", "E", Mode::Train, 9.0},
+                 {"A", "D", Mode::Ship, 20.0},
+                 {"D", "E", Mode::Ship, 5.0}};
+        int id = 0;
+        for (const Link &link : links)
+        {
+            QJsonObject attributes;
+            attributes["distance"] = link.distance;
+            PathSegment segment(
+                QString("route_%1").arg(id++), link.from,
+                link.to, link.mode, attributes);
+            QVERIFY(graph->addRoute(&segment));
+        }
+    }
+
+    void cleanup()
+    {
+        delete graph;
+        graph = nullptr;
+    }
+
+    void testTopPathsMatchBruteForce()
+    {
+        compareWithBruteForce("A", "E", Mode::Any, false);
+        compareWithBruteForce("E", "A", Mode::Any, false);
+        compareWithBruteForce("B", "D", Mode::Any, false);
+    }
+
+    void testTopPathsSkippingDelays()
+    {
+        compareWithBruteForce("A", "E", Mode::Any, true);
+        compareWithBruteForce("C", "A", Mode::Any, true);
+    }
+
+    void testTopPathsWithModeFilter()
+    {
+        compareWithBruteForce("A", "E", Mode::Truck, false);
+        compareWithBruteForce("A", "E", Mode::Train, true);
+    }
+
+    void testPathsAreLoopless()
+    {
+        const QJsonArray paths =
+            graph->findTopPaths("A", "E", 100, Mode::Any,
+                                true);
+        QVERIFY(!paths.isEmpty());
+        for (const QJsonValue &value : paths)
+        {
+            QSet<QString> terminals;
+            for (const QJsonValue &terminal :
+                 value.toObject()["terminals_in_path"]
+                     .toArray())
+            {
+                QString name =
+                    terminal.toObject()["terminal"].toString();
+                QVERIFY(!terminals.contains(name));
+                terminals.insert(name);
+            }
+        }
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    CargoNetSim::Backend::initializeBackend();
+    QCoreApplication      app(argc, argv);
+    LocalTerminalGraphTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "LocalTerminalGraphTest.moc"
@@ -0,0 +1,240 @@
+#include <QTest>
+#include "GUI/Utils/NetworkPointIndex.h"
+#include <QCoreApplication>
+#include <QObject>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+
+using namespace CargoNetSim::GUI;
+
+/**
+ * @class NetworkPointIndexTest
+ * @brief Checks nearest-node queries against brute force
+ *
+ * Networks are plain QObjects with random node positions;
+ * node IDs are sparse so that tree slots and network nodes
+ * differ.
+ */
+class NetworkPointIndexTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Network
+    {
+        QObject         *object = nullptr;
+        NetworkType      type   = NetworkType::Train;
+        QString          region;
+        QVector<QPointF> points;
+        QVector<int>     nodes;
+        QPointF          offset;
+    };
+
+    NetworkPointIndex *index = nullptr;
+    QList<Network>     networks;
+
+    void addNetwork(NetworkType type, const QString &region,
+                    int count, quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        Network          network;
+        network.object = new QObject();
+        network.type   = type;
+        network.region = region;
+        for (int i = 0; i < count; ++i)
+        {
+            network.points.append(
+                QPointF(random.bounded(1000.0),
+                        random.bounded(1000.0)));
+            network.nodes.append(i * 3 + 1);
+        }
+        index->addNetwork(network.object, type, region,
+                          network.points, network.nodes);
+        networks.append(network);
+    }
+
+    /**
+     * @brief Distances of the k closest nodes, by scanning
+     * every node
+     */
+    QList<qreal>
+    bruteForce(const QPointF &point, const QString &region,
+               const QList<NetworkType> &types,
+               int                       k) const
+    {
+        QList<qreal> distances;
+        for (const Network &network : networks)
+        {
+            if (network.region != region
+                || !types.contains(network.type))
+            {
+                continue;
+            }
+            for (int i = 0; i < network.points.size(); ++i)
+            {
+                QPointF delta = network.points[i]
+                                + network.offset - point;
+                distances.append(
+                    std::hypot(delta.x(), delta.y()));
+            }
+        }
+        std::sort(distances.begin(), distances.end());
+        return distances.mid(0, k);
+    }
+
+    void compareWithBruteForce(
+        const QPointF &point, const QString &region,
+        const QList<NetworkType> &types, int k)
+    {
+        const QList<qreal> expected =
+            bruteForce(point, region, types, k);
+        const QVector<NetworkPointIndex::Match> matches =
+            index->nearest(point, region, types, k);
+
+        QCOMPARE(matches.size(), expected.size());
+        for (int i = 0; i < matches.size(); ++i)
+        {
+            QVERIFY(qFuzzyCompare(matches[i].distance,
+                                  expected[i]));
+            QVERIFY(types.contains(matches[i].type));
+
+            // The match reports the node's moved position
+            QPointF delta = matches[i].point - point;
+            QVERIFY(qFuzzyCompare(
+                std::hypot(delta.x(), delta.y()),
+                expected[i]));
+        }
+    }
+
+private slots:
+    void init()
+    {
+        index = new NetworkPointIndex();
+        addNetwork(NetworkType::Train, "West", 300, 1);
+        addNetwork(NetworkType::Truck, "West", 200, 2);
+        addNetwork(NetworkType::Truck, "East", 100, 3);
+    }
+
+    void cleanup()
+    {
+        delete index;
+        index = nullptr;
+        for (const Network &network : networks)
+        {
+            delete network.object;
+        }
+        networks.clear();
+    }
+
+    void testNearestMatchesBruteForce()
+    {
+        QRandomGenerator random(42);
+        for (int query = 0; query < 50; ++query)
+        {
+            const QPointF point(
+                random.bounded(1200.0) - 100.0,
+                random.bounded(1200.0) - 100.0);
+            compareWithBruteForce(point, "West",
+                                  {NetworkType::Train}, 1);
+            compareWithBruteForce(
+                point, "West",
+                {NetworkType::Train, NetworkType::Truck},
+                7);
+            compareWithBruteForce(point, "East",
+                                  {NetworkType::Truck}, 3);
+        }
+
+        // Other regions and types are not searched
+        QVERIFY(index
+                    ->nearest(QPointF(), "North",
+                              {NetworkType::Truck})
+                    .isEmpty());
+        QVERIFY(index
+                    ->nearest(QPointF(), "West",
+                              {NetworkType::Ship})
+                    .isEmpty());
+        QVERIFY(index
+                    ->nearest(QPointF(), "West",
+                              {NetworkType::Train}, 0)
+                    .isEmpty());
+    }
+
+    void testTranslatedNetwork()
+    {
+        const QPointF offset(2500.0, -400.0);
+        index->translateNetwork(networks[0].object, offset);
+        networks[0].offset = offset;
+
+        compareWithBruteForce(QPointF(2900.0, 100.0),
+                              "West", {NetworkType::Train},
+                              5);
+        compareWithBruteForce(
+            QPointF(1800.0, 300.0), "West",
+            {NetworkType::Train, NetworkType::Truck}, 10);
+    }
+
+    void testLinkedNodesAreSkipped()
+    {
+        // The terminal is only used as a key, never
+        // dereferenced
+        int   marker   = 0;
+        auto *terminal =
+            reinterpret_cast<TerminalItem *>(&marker);
+
+        const QPointF point(500.0, 500.0);
+        const QVector<NetworkPointIndex::Match> before =
+            index->nearest(point, "West",
+                           {NetworkType::Train}, 2);
+        QCOMPARE(before.size(), 2);
+
+        index->setLinkedTerminal(before[0].network,
+                                 before[0].node, terminal);
+        QVERIFY(index->isTerminalLinked(
+            terminal, NetworkType::Train));
+        QVERIFY(!index->isTerminalLinked(
+            terminal, NetworkType::Truck));
+
+        const QVector<NetworkPointIndex::Match> unlinked =
+            index->nearest(point, "West",
+                           {NetworkType::Train}, 1);
+        QCOMPARE(unlinked.first().node, before[1].node);
+
+        const QVector<NetworkPointIndex::Match> all =
+            index->nearest(point, "West",
+                           {NetworkType::Train}, 1, false);
+        QCOMPARE(all.first().node, before[0].node);
+
+        // Dropping the network forgets its links
+        index->removeNetwork(networks[0].object);
+        QVERIFY(!index->isTerminalLinked(
+            terminal, NetworkType::Train));
+        QVERIFY(index
+                    ->nearest(point, "West",
+                              {NetworkType::Train})
+                    .isEmpty());
+    }
+
+    void testRenameRegion()
+    {
+        index->renameRegion("East", "Central");
+        networks[2].region = "Central";
+
+        QVERIFY(index
+                    ->nearest(QPointF(), "East",
+                              {NetworkType::Truck})
+                    .isEmpty());
+        compareWithBruteForce(QPointF(10.0, 20.0),
+                              "Central",
+                              {NetworkType::Truck}, 4);
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication      app(argc, argv);
+    NetworkPointIndexTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "NetworkPointIndexTest.moc"
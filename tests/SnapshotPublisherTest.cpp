@@ -0,0 +1,125 @@
+#include <QTest>
+#include "Backend/Commons/SnapshotPublisher.h"
+#include <QCoreApplication>
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace CargoNetSim::Backend::Commons;
+
+/**
+ * @class SnapshotPublisherTest
+ * @brief Checks that readers keep whole generations while
+ * the writer publishes new ones
+ */
+class SnapshotPublisherTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testStartsEmpty()
+    {
+        SnapshotPublisher<QHash<QString, int>> publisher;
+        QVERIFY(publisher.load() != nullptr);
+        QVERIFY(publisher.load()->isEmpty());
+        QCOMPARE(publisher.generation(), quint64(0));
+    }
+
+    void testHeldSnapshotsOutliveNewGenerations()
+    {
+        SnapshotPublisher<QHash<QString, int>> publisher;
+
+        QHash<QString, int> states;
+        states["truck_1"] = 1;
+        publisher.publish(states);
+        auto first = publisher.load();
+        QCOMPARE(publisher.generation(), quint64(1));
+
+        // The writer keeps changing its working copy
+        states["truck_1"] = 2;
+        states["truck_2"] = 3;
+        publisher.publish(states);
+        QCOMPARE(publisher.generation(), quint64(2));
+
+        QCOMPARE(first->size(), 1);
+        QCOMPARE(first->value("truck_1"), 1);
+        QCOMPARE(publisher.load()->size(), 2);
+        QCOMPARE(publisher.load()->value("truck_1"), 2);
+
+        // A generation goes with its last reader
+        std::weak_ptr<const QHash<QString, int>> released =
+            first;
+        first.reset();
+        QVERIFY(released.expired());
+    }
+
+    void testConcurrentReadersSeeWholeGenerations()
+    {
+        // Generation g holds SIZE copies of g
+        constexpr int SIZE        = 256;
+        constexpr int GENERATIONS = 2000;
+        constexpr int READERS     = 4;
+
+        SnapshotPublisher<QVector<int>> publisher;
+        std::atomic<bool>               done{false};
+        std::atomic<int>                torn{0};
+        std::atomic<int>                backwards{0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < READERS; ++r)
+        {
+            readers.emplace_back([&]() {
+                int last = -1;
+                while (!done.load())
+                {
+                    auto snapshot = publisher.load();
+                    if (snapshot->isEmpty())
+                    {
+                        continue;
+                    }
+                    const int value = snapshot->first();
+                    if (snapshot->size() != SIZE
+                        || snapshot->count(value) != SIZE)
+                    {
+                        ++torn;
+                    }
+                    if (value < last)
+                    {
+                        ++backwards;
+                    }
+                    last = value;
+                }
+            });
+        }
+
+        QVector<int> working(SIZE, 0);
+        for (int g = 1; g <= GENERATIONS; ++g)
+        {
+            working.fill(g);
+            publisher.publish(working);
+        }
+        done = true;
+        for (std::thread &reader : readers)
+        {
+            reader.join();
+        }
+
+        QCOMPARE(torn.load(), 0);
+        QCOMPARE(backwards.load(), 0);
+        QCOMPARE(publisher.generation(),
+                 quint64(GENERATIONS));
+        QCOMPARE(publisher.load()->first(), GENERATIONS);
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication      app(argc, argv);
+    SnapshotPublisherTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "SnapshotPublisherTest.moc"
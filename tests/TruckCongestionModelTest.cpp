@@ -0,0 +1,144 @@
+#include <QTest>
+#include "Backend/Clients/TruckClient/TransportationGraph.h"
+#include "Backend/Clients/TruckClient/TruckCongestionModel.h"
+#include "Backend/Clients/TruckClient/TruckRoutingGraph.h"
+#include <QCoreApplication>
+#include <QObject>
+#include <QSharedPointer>
+
+using namespace CargoNetSim::Backend::TruckClient;
+
+/**
+ * @class TruckCongestionModelTest
+ * @brief Checks the BPR link times of the congestion model
+ * and the routes they lead to
+ *
+ * Links are 1 km at 60 km/h, so the free-flow time is
+ * 1/60 h; capacity is lanes times the saturation flow.
+ */
+class TruckCongestionModelTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr float FREE_TIME = 1.0f / 60.0f;
+
+    QSharedPointer<const TruckRoutingGraph> graph;
+
+    /**
+     * @brief Add a link with INTEGRATION-style attributes
+     */
+    static void addLink(TransportationGraph<int> &network,
+                        int from, int to, int linkId,
+                        float length, float lanes = 1.0f)
+    {
+        QMap<QString, QVariant> attributes;
+        attributes["link_id"]         = linkId;
+        attributes["free_speed"]      = 60.0f;
+        attributes["lanes"]           = lanes;
+        attributes["saturation_flow"] = 1000.0f;
+        network.addEdge(from, to, length, attributes);
+    }
+
+    static bool nearlyEqual(float actual, float expected)
+    {
+        return qAbs(actual - expected) < 1e-6f;
+    }
+
+private slots:
+    void init()
+    {
+        // A short way through node 2 and a longer direct
+        // link, plus a two-lane link out of node 3
+        TransportationGraph<int> network;
+        for (int node = 1; node <= 4; ++node)
+        {
+            network.addNode(node);
+        }
+        addLink(network, 1, 2, 10, 1.0f);
+        addLink(network, 2, 3, 11, 1.0f);
+        addLink(network, 1, 3, 12, 3.0f);
+        addLink(network, 3, 4, 13, 1.0f, 2.0f);
+
+        graph.reset(new TruckRoutingGraph(network));
+    }
+
+    void cleanup()
+    {
+        graph.reset();
+    }
+
+    void testFreeFlowWithoutLoad()
+    {
+        TruckCongestionModel model(graph);
+        QVERIFY(nearlyEqual(model.linkTravelTime(10),
+                            FREE_TIME));
+        QCOMPARE(model.linkVehicles(10), 0);
+
+        // Unknown links are ignored
+        model.addRoute({999});
+        QCOMPARE(model.linkVehicles(999), 0);
+        QCOMPARE(model.linkTravelTime(999), -1.0f);
+    }
+
+    void testBprUsesHourlyFlow()
+    {
+        // 1000 vehicles within an hour on 1000 veh/h
+        TruckCongestionModel model(graph);
+        model.addRoute({10}, 1000);
+        QCOMPARE(model.linkVehicles(10), 1000);
+        QVERIFY(nearlyEqual(model.linkTravelTime(10),
+                            FREE_TIME * 1.15f));
+
+        // Two lanes halve the volume to capacity ratio
+        model.addRoute({13}, 1000);
+        QVERIFY(nearlyEqual(
+            model.linkTravelTime(13),
+            FREE_TIME * (1.0f + 0.15f * 0.0625f)));
+
+        model.removeRoute({10}, 1000);
+        QVERIFY(nearlyEqual(model.linkTravelTime(10),
+                            FREE_TIME));
+    }
+
+    void testAssignmentPeriodScalesFlow()
+    {
+        TruckCongestionModel model(graph);
+        model.addRoute({10}, 1000);
+
+        // The same vehicles within half an hour double
+        // the flow
+        model.setAssignmentPeriod(1800.0);
+        QVERIFY(nearlyEqual(model.linkTravelTime(10),
+                            FREE_TIME * 3.4f));
+
+        model.setAssignmentPeriod(0.0);
+        QVERIFY(nearlyEqual(model.linkTravelTime(10),
+                            FREE_TIME * 1.15f));
+    }
+
+    void testCongestedRoutesAvoidLoadedLinks()
+    {
+        TruckCongestionModel model(graph);
+        QCOMPARE(graph->findRoute(1, 3), QList<int>({10, 11}));
+
+        // At twice the capacity the way through node 2 takes
+        // 2 * 3.4 / 60 h, longer than the direct 3 / 60 h
+        model.addRoute({10, 11}, 2000);
+        const QVector<float> times = model.travelTimes();
+        QCOMPARE(graph->findRoute(1, 3, &times),
+                 QList<int>({12}));
+
+        // Distance routing ignores the load
+        QCOMPARE(graph->findRoute(1, 3), QList<int>({10, 11}));
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication         app(argc, argv);
+    TruckCongestionModelTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "TruckCongestionModelTest.moc"
@@ -0,0 +1,143 @@
+#include <QTest>
+#include "Backend/Clients/TruckClient/TransportationGraph.h"
+#include "Backend/Clients/TruckClient/TruckRoutingGraph.h"
+#include <QCoreApplication>
+#include <QObject>
+
+using namespace CargoNetSim::Backend::TruckClient;
+
+/**
+ * @class TruckRoutingGraphTest
+ * @brief Checks the route searches of the compact truck
+ * routing graph
+ */
+class TruckRoutingGraphTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void addLink(TransportationGraph<int> &network,
+                        int from, int to, int linkId,
+                        float length)
+    {
+        QMap<QString, QVariant> attributes;
+        attributes["link_id"] = linkId;
+        network.addEdge(from, to, length, attributes);
+    }
+
+    static void addNodes(TransportationGraph<int> &network,
+                         int                       count)
+    {
+        for (int node = 1; node <= count; ++node)
+        {
+            QMap<QString, QVariant> attributes;
+            attributes["x"] = node * 10.0;
+            attributes["y"] = node * 20.0;
+            network.addNode(node, attributes);
+        }
+    }
+
+private slots:
+    void testShortestRouteByLength()
+    {
+        TransportationGraph<int> network;
+        addNodes(network, 4);
+        addLink(network, 1, 2, 12, 1.0f);
+        addLink(network, 2, 4, 24, 1.0f);
+        addLink(network, 1, 3, 13, 0.5f);
+        addLink(network, 3, 4, 34, 2.0f);
+
+        TruckRoutingGraph graph(network);
+        QCOMPARE(graph.edgeCount(), 4);
+        QCOMPARE(graph.findRoute(1, 4), QList<int>({12, 24}));
+
+        // Links are directed
+        QVERIFY(graph.findRoute(4, 1).isEmpty());
+
+        QPointF start;
+        QVERIFY(graph.linkStart(24, start));
+        QCOMPARE(start, QPointF(20.0, 40.0));
+        QVERIFY(!graph.linkStart(99, start));
+    }
+
+    void testEdgesWithoutLinkIdAreSkipped()
+    {
+        TransportationGraph<int> network;
+        addNodes(network, 3);
+        addLink(network, 1, 2, 12, 1.0f);
+        network.addEdge(2, 3, 1.0f);
+
+        TruckRoutingGraph graph(network);
+        QCOMPARE(graph.edgeCount(), 1);
+        QCOMPARE(graph.edgeOfLink(12), 0);
+        QVERIFY(graph.findRoute(1, 3).isEmpty());
+    }
+
+    void testManyDestinationsInOneSearch()
+    {
+        TransportationGraph<int> network;
+        addNodes(network, 5);
+        addLink(network, 1, 2, 12, 1.0f);
+        addLink(network, 2, 3, 23, 1.0f);
+        addLink(network, 1, 4, 14, 5.0f);
+        addLink(network, 3, 4, 34, 1.0f);
+
+        TruckRoutingGraph graph(network);
+        const QHash<int, QList<int>> routes =
+            graph.findRoutes(1, {1, 3, 4, 5, 42});
+
+        // Unreachable and unknown destinations are omitted
+        QCOMPARE(routes.size(), 3);
+        QVERIFY(routes.value(1).isEmpty());
+        QCOMPARE(routes.value(3), QList<int>({12, 23}));
+        QCOMPARE(routes.value(4), QList<int>({12, 23, 34}));
+        QVERIFY(!routes.contains(5));
+    }
+
+    void testEdgeCosts()
+    {
+        TransportationGraph<int> network;
+        addNodes(network, 3);
+        addLink(network, 1, 2, 12, 1.0f);
+        addLink(network, 2, 3, 23, 1.0f);
+        addLink(network, 1, 3, 13, 3.0f);
+
+        TruckRoutingGraph graph(network);
+        QVector<float> costs(graph.edgeCount(), 1.0f);
+        QCOMPARE(graph.findRoute(1, 3, &costs),
+                 QList<int>({13}));
+
+        // Costs of another graph are ignored
+        QVector<float> wrongSize(1, 100.0f);
+        QCOMPARE(graph.findRoute(1, 3, &wrongSize),
+                 QList<int>({12, 23}));
+    }
+
+    void testLongRoutesAccumulateExactly()
+    {
+        // At 2^24 a float cannot add 1; the route through
+        // nodes 2 and 3 would look as short as the first
+        // link alone and win over the truly shorter one
+        const float big = 16777216.0f;
+
+        TransportationGraph<int> network;
+        addNodes(network, 5);
+        addLink(network, 1, 2, 12, big);
+        addLink(network, 2, 3, 23, 1.0f);
+        addLink(network, 3, 4, 34, 1.0f);
+        addLink(network, 1, 5, 15, big);
+        addLink(network, 5, 4, 54, 1.5f);
+
+        TruckRoutingGraph graph(network);
+        QCOMPARE(graph.findRoute(1, 4), QList<int>({15, 54}));
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication      app(argc, argv);
+    TruckRoutingGraphTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "TruckRoutingGraphTest.moc"
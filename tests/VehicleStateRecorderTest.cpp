@@ -0,0 +1,193 @@
+#include <QTest>
+#include "Backend/Commons/VehicleStateRecorder.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <memory>
+
+using namespace CargoNetSim::Backend;
+
+using Sample = VehicleStateRecorder::Sample;
+
+/**
+ * @class VehicleStateRecorderTest
+ * @brief Round-trips samples through the columnar encoding
+ * and the spill file
+ */
+class VehicleStateRecorderTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir *dir = nullptr;
+
+    /**
+     * @brief Build the i-th sample of a vehicle
+     *
+     * Values use the full precision of each column and
+     * change irregularly so every delta encoding is used.
+     */
+    static Sample makeSample(int i, double offset = 0.0)
+    {
+        Sample sample;
+        sample.time       = 10.0 + i * 0.5 + (i % 7) * 0.001;
+        sample.x          = -71.123456 + i * 1e-6 + offset;
+        sample.y          = 42.654321 - (i % 13) * 1e-5;
+        sample.distance   = i * 12.345;
+        sample.speed      = (i % 11) * 1.5;
+        sample.energy     = i * 0.125;
+        sample.emissions  = i * 0.375;
+        sample.containers = i % 5;
+        return sample;
+    }
+
+    static void compareSamples(const Sample &actual,
+                               const Sample &expected)
+    {
+        QVERIFY(qAbs(actual.time - expected.time) < 1e-3);
+        QVERIFY(qAbs(actual.x - expected.x) < 1e-6);
+        QVERIFY(qAbs(actual.y - expected.y) < 1e-6);
+        QVERIFY(qAbs(actual.distance - expected.distance)
+                < 1e-3);
+        QVERIFY(qAbs(actual.speed - expected.speed) < 1e-3);
+        QVERIFY(qAbs(actual.energy - expected.energy) < 1e-3);
+        QVERIFY(qAbs(actual.emissions - expected.emissions)
+                < 1e-3);
+        QCOMPARE(actual.containers, expected.containers);
+    }
+
+    static void recordSeries(VehicleStateRecorder &recorder,
+                             const QString &vehicle, int count,
+                             double offset = 0.0)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            recorder.record("net", vehicle,
+                            makeSample(i, offset));
+        }
+    }
+
+private slots:
+    void init()
+    {
+        dir = new QTemporaryDir();
+        QVERIFY(dir->isValid());
+    }
+
+    void cleanup()
+    {
+        delete dir;
+        dir = nullptr;
+    }
+
+    void testEncodeDecodeInMemory()
+    {
+        // Several full blocks plus pending samples
+        const int count =
+            VehicleStateRecorder::BLOCK_SAMPLES * 3 + 17;
+        VehicleStateRecorder recorder;
+        recordSeries(recorder, "truck_1", count);
+        recordSeries(recorder, "truck_2", 5, 0.5);
+
+        QCOMPARE(recorder.sampleCount(), qint64(count + 5));
+        QCOMPARE(recorder.spilledBytes(), qint64(0));
+        QCOMPARE(recorder.vehicles("net").size(), 2);
+
+        const QVector<Sample> samples =
+            recorder.query("net", "truck_1");
+        QCOMPARE(samples.size(), count);
+        for (int i = 0; i < count; ++i)
+        {
+            compareSamples(samples[i], makeSample(i));
+        }
+
+        const QVector<Sample> other =
+            recorder.query("net", "truck_2");
+        QCOMPARE(other.size(), 5);
+        compareSamples(other[4], makeSample(4, 0.5));
+    }
+
+    void testTimeRangeQuery()
+    {
+        const int count = VehicleStateRecorder::BLOCK_SAMPLES * 2;
+        VehicleStateRecorder recorder;
+        recordSeries(recorder, "ship", count);
+
+        const double from = makeSample(100).time;
+        const double to   = makeSample(200).time;
+        const QVector<Sample> samples =
+            recorder.query("net", "ship", from, to);
+        QCOMPARE(samples.size(), 101);
+        compareSamples(samples.first(), makeSample(100));
+        compareSamples(samples.last(), makeSample(200));
+    }
+
+    void testSpillAndDecode()
+    {
+        const int count =
+            VehicleStateRecorder::BLOCK_SAMPLES * 4 + 3;
+        QString spillFile;
+        {
+            // Spill every sealed block
+            VehicleStateRecorder recorder(
+                dir->filePath("states.bin"), 1);
+            recordSeries(recorder, "train", count);
+            recorder.flush();
+
+            spillFile = recorder.spillFilePath();
+            QVERIFY(!spillFile.isEmpty());
+            QVERIFY(QFile::exists(spillFile));
+            QVERIFY(recorder.spilledBytes() > 0);
+
+            const QVector<Sample> samples =
+                recorder.query("net", "train");
+            QCOMPARE(samples.size(), count);
+            for (int i = 0; i < count; ++i)
+            {
+                compareSamples(samples[i], makeSample(i));
+            }
+        }
+
+        // The scratch file goes with the recorder
+        QVERIFY(!QFile::exists(spillFile));
+    }
+
+    void testRecordersOnSamePathKeepTheirData()
+    {
+        const QString base  = dir->filePath("states.bin");
+        const int     count =
+            VehicleStateRecorder::BLOCK_SAMPLES * 2;
+
+        auto first =
+            std::make_unique<VehicleStateRecorder>(base, 1);
+        recordSeries(*first, "truck", count);
+        first->flush();
+
+        // A replacement on the same path must not remove
+        // the spilled data of the recorder still in use
+        VehicleStateRecorder second(base, 1);
+        recordSeries(second, "truck", count, 1.0);
+        second.flush();
+
+        QVERIFY(first->spillFilePath()
+                != second.spillFilePath());
+        QCOMPARE(first->query("net", "truck").size(), count);
+        compareSamples(first->query("net", "truck").last(),
+                       makeSample(count - 1));
+
+        first.reset();
+        QVERIFY(QFile::exists(second.spillFilePath()));
+        compareSamples(second.query("net", "truck").last(),
+                       makeSample(count - 1, 1.0));
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication         app(argc, argv);
+    VehicleStateRecorderTest testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+#include "VehicleStateRecorderTest.moc"